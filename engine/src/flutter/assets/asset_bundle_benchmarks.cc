@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/assets/compressed_asset_bundle.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/file_mapping_cache.h"
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+namespace {
+
+// Writes `count` small assets into `directory`, both as files and packed
+// into an archive, and returns their names.
+std::vector<std::string> WriteAssets(const fml::UniqueFD& directory,
+                                     size_t count) {
+  fml::CreateDirectory(directory, {"images"}, fml::FilePermission::kReadWrite);
+  std::vector<std::string> names;
+  std::vector<PackedAssetBundle::Asset> assets;
+  for (size_t i = 0; i < count; i++) {
+    std::string name = "images/" + std::to_string(i) + ".png";
+    auto data = std::make_shared<fml::DataMapping>(std::string(512 + i, 'a'));
+    fml::WriteAtomically(directory, name.c_str(), *data);
+    names.push_back(name);
+    assets.push_back({std::move(name), std::move(data)});
+  }
+  fml::WriteAtomically(directory, PackedAssetBundle::kFileName,
+                       *PackedAssetBundle::Pack(assets));
+  return names;
+}
+
+void LoadAssets(benchmark::State& state,
+                const AssetResolver& resolver,
+                const std::vector<std::string>& names) {
+  for (const std::string& name : names) {
+    auto mapping = resolver.GetAsMapping(name);
+    if (!mapping) {
+      state.SkipWithError("Missing asset.");
+      return;
+    }
+    benchmark::DoNotOptimize(mapping->GetMapping()[0]);
+  }
+}
+
+// A bundle with a compressed asset "data.json" of `size` bytes.
+std::unique_ptr<AssetResolver> CreateCompressedBundle(size_t size) {
+  std::string json = "[";
+  for (size_t i = 0; json.size() < size; i++) {
+    json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item" +
+            std::to_string(i * 7919 % 10007) + "\"},";
+  }
+  json.resize(size);
+  return std::make_unique<CompressedAssetBundle>(
+      std::make_unique<PackedAssetBundle>(
+          PackedAssetBundle::Pack(
+              {{std::string("data.json") + CompressedAssetBundle::kSuffix,
+                CompressedAssetBundle::Compress(fml::DataMapping(json))}}),
+          false));
+}
+
+}  // namespace
+
+// Decompresses an 8 MiB asset with a new bundle each time, so that it is
+// not cached. The argument is the number of workers, besides the calling
+// thread, that decompress chunks.
+static void BM_CompressedAssetBundleDecompress(benchmark::State& state) {
+  const size_t size = 8 * 1024 * 1024;
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop;
+  if (state.range(0) > 0) {
+    loop = fml::ConcurrentMessageLoop::Create(state.range(0));
+    CompressedAssetBundle::SetWorkerTaskRunner(loop->GetTaskRunner());
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<AssetResolver> bundle = CreateCompressedBundle(size);
+    state.ResumeTiming();
+    LoadAssets(state, *bundle, {"data.json"});
+  }
+  CompressedAssetBundle::SetWorkerTaskRunner(nullptr);
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_CompressedAssetBundleDecompress)
+    ->Arg(0)
+    ->Arg(3)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Reads the first 64 KiB of an 8 MiB compressed asset, as the first chunk
+// of a stream.
+static void BM_CompressedAssetBundleRange(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<AssetResolver> bundle =
+        CreateCompressedBundle(8 * 1024 * 1024);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        bundle->GetAsMappingRange("data.json", 0, 64 * 1024));
+  }
+}
+BENCHMARK(BM_CompressedAssetBundleRange)->Unit(benchmark::kMicrosecond);
+
+// Opens a bundle and loads every asset of it once, as an app does when it
+// starts. The argument is the number of assets.
+static void BM_DirectoryAssetBundleStartup(benchmark::State& state) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  const std::vector<std::string> names =
+      WriteAssets(temp_dir.fd(), state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    FileMappingCache::GetInstance().Clear();
+    state.ResumeTiming();
+    DirectoryAssetBundle bundle(
+        fml::OpenDirectory(temp_dir.path().c_str(), false,
+                           fml::FilePermission::kRead),
+        false);
+    LoadAssets(state, bundle, names);
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_DirectoryAssetBundleStartup)->Arg(100)->Arg(2000);
+
+static void BM_PackedAssetBundleStartup(benchmark::State& state) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  const std::vector<std::string> names =
+      WriteAssets(temp_dir.fd(), state.range(0));
+  for (auto _ : state) {
+    PackedAssetBundle bundle(
+        fml::FileMapping::CreateReadOnly(temp_dir.fd(),
+                                         PackedAssetBundle::kFileName),
+        false);
+    LoadAssets(state, bundle, names);
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_PackedAssetBundleStartup)->Arg(100)->Arg(2000);
+
+}  // namespace flutter
@@ -5,6 +5,8 @@
 #include "flutter/assets/asset_manager.h"
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/engine_metrics.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -67,9 +69,12 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  const fml::TimePoint start = fml::TimePoint::Now();
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
+      EngineMetrics::GetInstance().RecordAssetLoad(fml::TimePoint::Now() -
+                                                   start);
       return mapping;
     }
   }
@@ -96,6 +101,29 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> AssetManager::GetAsMappingRange(
+    const std::string& asset_name,
+    size_t offset,
+    size_t length) const {
+  if (asset_name.empty()) {
+    return nullptr;
+  }
+  TRACE_EVENT1("flutter", "AssetManager::GetAsMappingRange", "name",
+               asset_name.c_str());
+  const fml::TimePoint start = fml::TimePoint::Now();
+  for (const auto& resolver : resolvers_) {
+    auto mapping = resolver->GetAsMappingRange(asset_name, offset, length);
+    if (mapping != nullptr) {
+      EngineMetrics::GetInstance().RecordAssetLoad(fml::TimePoint::Now() -
+                                                   start);
+      return mapping;
+    }
+  }
+  FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
+  return nullptr;
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
   return !resolvers_.empty();
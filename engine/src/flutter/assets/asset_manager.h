@@ -88,6 +88,12 @@ class AssetManager final : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMappingRange(
+      const std::string& asset_name,
+      size_t offset,
+      size_t length) const override;
+
   // |AssetResolver|
   bool operator==(const AssetResolver& other) const override;
 
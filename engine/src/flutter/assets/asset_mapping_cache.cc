@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_mapping_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter {
+
+AssetMappingCache::AssetMappingCache(size_t max_entries, size_t max_bytes)
+    : max_entries_(max_entries), max_bytes_(max_bytes) {}
+
+AssetMappingCache::~AssetMappingCache() = default;
+
+std::shared_ptr<const fml::Mapping> AssetMappingCache::Get(
+    const std::string& asset_name) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(asset_name);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->mapping;
+}
+
+void AssetMappingCache::Put(const std::string& asset_name,
+                            std::shared_ptr<const fml::Mapping> mapping) {
+  if (!mapping || max_entries_ == 0) {
+    return;
+  }
+  size_t charged_bytes = mapping->GetSize();
+  if (charged_bytes > max_bytes_) {
+    // Pages of file mappings can be dropped and read back by the OS, so
+    // they only take up address space.
+    if (!mapping->IsDontNeedSafe()) {
+      return;
+    }
+    charged_bytes = 0;
+  }
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(asset_name);
+  if (found != index_.end()) {
+    byte_size_ -= found->second->charged_bytes;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  byte_size_ += charged_bytes;
+  entries_.push_front({asset_name, std::move(mapping), charged_bytes});
+  index_[asset_name] = entries_.begin();
+  EvictLocked();
+}
+
+void AssetMappingCache::EvictLocked() {
+  while (!entries_.empty() &&
+         (entries_.size() > max_entries_ || byte_size_ > max_bytes_)) {
+    const Entry& victim = entries_.back();
+    byte_size_ -= victim.charged_bytes;
+    index_.erase(victim.name);
+    entries_.pop_back();
+  }
+}
+
+void AssetMappingCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  byte_size_ = 0;
+}
+
+size_t AssetMappingCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t AssetMappingCache::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  return byte_size_;
+}
+
+std::unique_ptr<fml::Mapping> AssetMappingCache::Slice(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t offset,
+    size_t length) {
+  if (!mapping) {
+    return nullptr;
+  }
+  const size_t size = mapping->GetSize();
+  offset = std::min(offset, size);
+  length = std::min(length, size - offset);
+  const uint8_t* data = mapping->GetMapping();
+  return std::make_unique<fml::NonOwnedMapping>(
+      data == nullptr ? nullptr : data + offset, length,
+      [mapping = std::move(mapping)](const uint8_t*, size_t) {});
+}
+
+}  // namespace flutter
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_ASSET_MAPPING_CACHE_H_
+#define FLUTTER_ASSETS_ASSET_MAPPING_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A thread safe, least recently used cache of asset mappings keyed
+///             by asset name.
+///
+///             Entries are shared. Callers that need to hand out an owning
+///             |fml::Mapping| (for instance to complete a platform message
+///             response) can use |Slice| to create a view that keeps the
+///             cached mapping alive for as long as the view exists.
+///
+class AssetMappingCache {
+ public:
+  //----------------------------------------------------------------------------
+  /// @param[in]  max_entries  The maximum number of mappings retained.
+  /// @param[in]  max_bytes    The maximum combined size of the mappings
+  ///                          retained. Mappings larger than this are only
+  ///                          cached if they are safe to madvise with
+  ///                          DONTNEED (such as read-only file mappings),
+  ///                          in which case they count only against
+  ///                          `max_entries`.
+  ///
+  AssetMappingCache(size_t max_entries, size_t max_bytes);
+
+  ~AssetMappingCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the cached mapping for the asset and marks it as the
+  ///             most recently used, or nullptr on a miss.
+  ///
+  std::shared_ptr<const fml::Mapping> Get(const std::string& asset_name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Inserts (or replaces) the mapping for an asset and evicts the
+  ///             least recently used entries until the cache is within its
+  ///             limits again.
+  ///
+  void Put(const std::string& asset_name,
+           std::shared_ptr<const fml::Mapping> mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all entries.
+  ///
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The combined size of the mappings counted against the byte
+  ///             budget.
+  ///
+  size_t GetByteSize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a mapping for `length` bytes of `mapping` starting at
+  ///             `offset` without copying. The slice keeps `mapping` alive.
+  ///             The range is clamped to the size of `mapping`.
+  ///
+  static std::unique_ptr<fml::Mapping> Slice(
+      std::shared_ptr<const fml::Mapping> mapping,
+      size_t offset,
+      size_t length);
+
+ private:
+  struct Entry {
+    std::string name;
+    std::shared_ptr<const fml::Mapping> mapping;
+    // The bytes counted against |max_bytes_|.
+    size_t charged_bytes;
+  };
+
+  const size_t max_entries_;
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t byte_size_ = 0;
+
+  void EvictLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AssetMappingCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_ASSET_MAPPING_CACHE_H_
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_mapping_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::shared_ptr<const fml::Mapping> MakeMapping(const std::string& contents) {
+  return std::make_shared<fml::DataMapping>(contents);
+}
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+}  // namespace
+
+TEST(AssetMappingCacheTest, ReturnsCachedMappings) {
+  AssetMappingCache cache(4, 1024);
+  EXPECT_EQ(cache.Get("a"), nullptr);
+
+  auto mapping = MakeMapping("hello");
+  cache.Put("a", mapping);
+  EXPECT_EQ(cache.Get("a"), mapping);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteSize(), 5u);
+
+  cache.Put("a", MakeMapping("hi"));
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteSize(), 2u);
+
+  cache.Clear();
+  EXPECT_EQ(cache.Get("a"), nullptr);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(AssetMappingCacheTest, EvictsLeastRecentlyUsedEntry) {
+  AssetMappingCache cache(2, 1024);
+  cache.Put("a", MakeMapping("a"));
+  cache.Put("b", MakeMapping("b"));
+  // Touch "a" so that "b" becomes the least recently used entry.
+  EXPECT_NE(cache.Get("a"), nullptr);
+  cache.Put("c", MakeMapping("c"));
+
+  EXPECT_NE(cache.Get("a"), nullptr);
+  EXPECT_EQ(cache.Get("b"), nullptr);
+  EXPECT_NE(cache.Get("c"), nullptr);
+}
+
+TEST(AssetMappingCacheTest, RespectsByteBound) {
+  AssetMappingCache cache(8, 10);
+  cache.Put("a", MakeMapping("aaaa"));
+  cache.Put("b", MakeMapping("bbbb"));
+  cache.Put("c", MakeMapping("cccc"));
+  EXPECT_EQ(cache.Get("a"), nullptr);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(), 8u);
+
+  // Mappings larger than the whole budget are not cached at all.
+  cache.Put("large", MakeMapping("01234567890"));
+  EXPECT_EQ(cache.Get("large"), nullptr);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST(AssetMappingCacheTest, CachesLargeFileMappingsOutsideByteBound) {
+  AssetMappingCache cache(8, 10);
+  cache.Put("a", MakeMapping("aaaa"));
+
+  // Stands in for a read-only file mapping.
+  static const std::string kContents = "01234567890";
+  auto large = std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(kContents.data()), kContents.size(),
+      nullptr, /*dontneed_safe=*/true);
+  cache.Put("large", large);
+  EXPECT_EQ(cache.Get("large"), large);
+  EXPECT_NE(cache.Get("a"), nullptr);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(), 4u);
+
+  // It is still subject to the entry bound.
+  AssetMappingCache single_entry_cache(1, 10);
+  single_entry_cache.Put("large", large);
+  single_entry_cache.Put("a", MakeMapping("aaaa"));
+  EXPECT_EQ(single_entry_cache.Get("large"), nullptr);
+  EXPECT_EQ(single_entry_cache.GetByteSize(), 4u);
+}
+
+TEST(AssetMappingCacheTest, SliceClampsRangeAndRetainsMapping) {
+  std::weak_ptr<const fml::Mapping> weak;
+  std::unique_ptr<fml::Mapping> slice;
+  {
+    auto mapping = MakeMapping("0123456789");
+    weak = mapping;
+    slice = AssetMappingCache::Slice(mapping, 2, 3);
+    EXPECT_EQ(ToString(*slice), "234");
+    EXPECT_EQ(ToString(*AssetMappingCache::Slice(mapping, 8, 100)), "89");
+    EXPECT_EQ(AssetMappingCache::Slice(mapping, 20, 1)->GetSize(), 0u);
+  }
+  EXPECT_FALSE(weak.expired());
+  EXPECT_EQ(ToString(*slice), "234");
+  slice.reset();
+  EXPECT_TRUE(weak.expired());
+
+  EXPECT_EQ(AssetMappingCache::Slice(nullptr, 0, 1), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,26 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_resolver.h"
+
+#include <utility>
+
+#include "flutter/assets/asset_mapping_cache.h"
+
+namespace flutter {
+
+std::unique_ptr<fml::Mapping> AssetResolver::GetAsMappingRange(
+    const std::string& asset_name,
+    size_t offset,
+    size_t length) const {
+  std::shared_ptr<const fml::Mapping> mapping = GetAsMapping(asset_name);
+  if (!mapping) {
+    return nullptr;
+  }
+  const size_t size = mapping->GetSize();
+  return AssetMappingCache::Slice(std::move(mapping), offset,
+                                  length == 0 ? size : length);
+}
+
+}  // namespace flutter
@@ -16,7 +16,9 @@ namespace flutter {
 
 class AssetManager;
 class APKAssetProvider;
+class CompressedAssetBundle;
 class DirectoryAssetBundle;
+class PackedAssetBundle;
 
 class AssetResolver {
  public:
@@ -30,7 +32,8 @@ class AssetResolver {
   enum AssetResolverType {
     kAssetManager,
     kApkAssetProvider,
-    kDirectoryAssetBundle
+    kDirectoryAssetBundle,
+    kPackedAssetBundle
   };
 
   virtual const AssetManager* as_asset_manager() const { return nullptr; }
@@ -40,6 +43,12 @@ class AssetResolver {
   virtual const DirectoryAssetBundle* as_directory_asset_bundle() const {
     return nullptr;
   }
+  virtual const PackedAssetBundle* as_packed_asset_bundle() const {
+    return nullptr;
+  }
+  virtual const CompressedAssetBundle* as_compressed_asset_bundle() const {
+    return nullptr;
+  }
 
   virtual bool IsValid() const = 0;
 
@@ -93,6 +102,22 @@ class AssetResolver {
     return {};
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief      Same as GetAsMapping() but only returns `length` bytes of
+  ///             the asset from `offset`, where a `length` of zero reads to
+  ///             the end of the asset. The range is clamped to the asset.
+  ///
+  ///             Resolvers that decode their assets override this to decode
+  ///             only the part of the asset that is read. The default
+  ///             implementation returns a view of |GetAsMapping|.
+  ///
+  /// @return     Returns the range, or nullptr if the asset is not found.
+  ///
+  [[nodiscard]] virtual std::unique_ptr<fml::Mapping> GetAsMappingRange(
+      const std::string& asset_name,
+      size_t offset,
+      size_t length) const;
+
   virtual bool operator==(const AssetResolver& other) const = 0;
 
   bool operator!=(const AssetResolver& other) const {
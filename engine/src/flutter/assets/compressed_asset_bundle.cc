@@ -0,0 +1,461 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/compressed_asset_bundle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+// A compressed asset is laid out as follows, with little-endian integers:
+//
+//   char magic[4]
+//   uint32_t chunk_size
+//   uint64_t size, the size of the decompressed asset
+//   uint64_t chunk_ends[chunk_count], the end of each compressed chunk,
+//       relative to the first one
+//   The chunks, each a zlib stream, whose checksum catches corruption
+//
+// Every chunk but the last decompresses to `chunk_size` bytes.
+struct CompressedAssetBundle::Archive {
+  std::shared_ptr<const fml::Mapping> mapping;
+  size_t size = 0;
+  size_t chunk_size = 0;
+  size_t chunk_count = 0;
+  const uint8_t* chunk_ends = nullptr;
+  const uint8_t* chunks = nullptr;
+  size_t chunks_size = 0;
+
+  static std::optional<Archive> Parse(
+      std::shared_ptr<const fml::Mapping> mapping);
+
+  // The size of chunk `index` once decompressed.
+  size_t GetChunkSize(size_t index) const {
+    return std::min(chunk_size, size - index * chunk_size);
+  }
+
+  // Decompresses chunk `index` into `destination`, which must have room for
+  // |GetChunkSize| bytes.
+  bool DecompressChunk(size_t index, uint8_t* destination) const;
+};
+
+namespace {
+
+constexpr char kMagic[4] = {'F', 'L', 'T', 'Z'};
+constexpr size_t kHeaderSize = 16;
+constexpr size_t kMaxCacheEntries = 256;
+
+// The highest ratio deflate compresses data by, which bounds the size a
+// corrupt archive can claim relative to its own size. It does not keep that
+// size addressable, which is checked separately.
+constexpr uint64_t kMaxCompressionRatio = 1032;
+
+uint64_t ReadUint64(const uint8_t* data) {
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+struct WorkerTaskRunner {
+  std::mutex mutex;
+  std::shared_ptr<fml::BasicTaskRunner> task_runner;
+};
+
+WorkerTaskRunner& GetWorkerTaskRunner() {
+  static WorkerTaskRunner* worker_task_runner = new WorkerTaskRunner();
+  return *worker_task_runner;
+}
+
+// Runs `task` for every index below `count`, spread over the worker task
+// runner and the calling thread, and returns whether it succeeded for all of
+// them.
+//
+// The calling thread takes indices like the workers do and only waits for
+// the tasks that workers have started, so this can't deadlock when it is
+// called from a worker, and tasks that start after every index is taken
+// return immediately.
+bool RunInParallel(size_t count, const std::function<bool(size_t)>& task) {
+  struct State {
+    State(size_t count, const std::function<bool(size_t)>& task)
+        : count(count), task(task), latch(count) {}
+
+    const size_t count;
+    const std::function<bool(size_t)>& task;
+    std::atomic_size_t next = 0;
+    std::atomic_bool failed = false;
+    fml::CountDownLatch latch;
+  };
+  auto state = std::make_shared<State>(count, task);
+  auto work = [state]() {
+    for (size_t index = state->next++; index < state->count;
+         index = state->next++) {
+      if (!state->task(index)) {
+        state->failed = true;
+      }
+      state->latch.CountDown();
+    }
+  };
+
+  std::shared_ptr<fml::BasicTaskRunner> task_runner;
+  {
+    WorkerTaskRunner& worker_task_runner = GetWorkerTaskRunner();
+    std::scoped_lock lock(worker_task_runner.mutex);
+    task_runner = worker_task_runner.task_runner;
+  }
+  if (task_runner && count > 1) {
+    const size_t helper_count =
+        std::min<size_t>(count - 1, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < helper_count; i++) {
+      task_runner->PostTask(work);
+    }
+  }
+  work();
+  state->latch.Wait();
+  return !state->failed;
+}
+
+std::unique_ptr<fml::Mapping> CreateEmptyMapping() {
+  return std::make_unique<fml::DataMapping>(std::vector<uint8_t>());
+}
+
+std::string GetChunkKey(const std::string& asset_name, size_t index) {
+  std::string key = asset_name;
+  key.push_back('\0');
+  key.append(std::to_string(index));
+  return key;
+}
+
+}  // namespace
+
+std::optional<CompressedAssetBundle::Archive>
+CompressedAssetBundle::Archive::Parse(
+    std::shared_ptr<const fml::Mapping> mapping) {
+  if (!mapping || mapping->GetMapping() == nullptr ||
+      mapping->GetSize() < kHeaderSize ||
+      std::memcmp(mapping->GetMapping(), kMagic, sizeof(kMagic)) != 0) {
+    return std::nullopt;
+  }
+  const uint8_t* data = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  Archive archive;
+  uint32_t chunk_size = 0;
+  std::memcpy(&chunk_size, data + sizeof(kMagic), sizeof(chunk_size));
+  const uint64_t decompressed_size = ReadUint64(data + 8);
+  // The decompressed asset is allocated in one piece and written a chunk at
+  // a time, so both its size and the chunks must fit in a size_t, which on
+  // 32-bit targets is narrower than the header field.
+  if (chunk_size == 0 || decompressed_size > SIZE_MAX) {
+    return std::nullopt;
+  }
+  archive.size = decompressed_size;
+  archive.chunk_size = chunk_size;
+  const uint64_t chunk_count =
+      archive.size / chunk_size + (archive.size % chunk_size != 0);
+  if (chunk_count > SIZE_MAX / chunk_size ||
+      chunk_count > (size - kHeaderSize) / sizeof(uint64_t)) {
+    return std::nullopt;
+  }
+  archive.chunk_count = chunk_count;
+  archive.chunk_ends = data + kHeaderSize;
+  archive.chunks = archive.chunk_ends + chunk_count * sizeof(uint64_t);
+  archive.chunks_size = data + size - archive.chunks;
+  if (decompressed_size >
+      (uint64_t{archive.chunks_size} + chunk_count) * kMaxCompressionRatio) {
+    return std::nullopt;
+  }
+  archive.mapping = std::move(mapping);
+  return archive;
+}
+
+bool CompressedAssetBundle::Archive::DecompressChunk(
+    size_t index,
+    uint8_t* destination) const {
+  TRACE_EVENT0("flutter", "CompressedAssetBundle::DecompressChunk");
+  const uint64_t begin =
+      index == 0 ? 0 : ReadUint64(chunk_ends + (index - 1) * sizeof(uint64_t));
+  const uint64_t end = ReadUint64(chunk_ends + index * sizeof(uint64_t));
+  const size_t destination_size = GetChunkSize(index);
+  if (begin > end || end > chunks_size || end - begin > UINT_MAX ||
+      destination_size > UINT_MAX) {
+    return false;
+  }
+
+  z_stream stream = {};
+  if (inflateInit(&stream) != Z_OK) {
+    return false;
+  }
+  stream.next_in = const_cast<Bytef*>(chunks + begin);
+  stream.avail_in = end - begin;
+  stream.next_out = destination;
+  stream.avail_out = destination_size;
+  const int result = inflate(&stream, Z_FINISH);
+  const bool decompressed = result == Z_STREAM_END && stream.avail_out == 0;
+  inflateEnd(&stream);
+  return decompressed;
+}
+
+std::unique_ptr<fml::Mapping> CompressedAssetBundle::Compress(
+    const fml::Mapping& data,
+    size_t chunk_size) {
+  TRACE_EVENT0("flutter", "CompressedAssetBundle::Compress");
+  FML_CHECK(chunk_size > 0 && chunk_size <= UINT32_MAX);
+  const size_t size = data.GetSize();
+  const size_t chunk_count = size / chunk_size + (size % chunk_size != 0);
+  const size_t chunks_offset = kHeaderSize + chunk_count * sizeof(uint64_t);
+  std::vector<uint8_t> result(chunks_offset);
+  std::memcpy(result.data(), kMagic, sizeof(kMagic));
+  const uint32_t header_chunk_size = chunk_size;
+  std::memcpy(result.data() + sizeof(kMagic), &header_chunk_size,
+              sizeof(header_chunk_size));
+  const uint64_t header_size = size;
+  std::memcpy(result.data() + 8, &header_size, sizeof(header_size));
+
+  for (size_t i = 0; i < chunk_count; i++) {
+    const size_t chunk_begin = i * chunk_size;
+    const size_t chunk_length = std::min(chunk_size, size - chunk_begin);
+    z_stream stream = {};
+    FML_CHECK(deflateInit(&stream, Z_BEST_COMPRESSION) == Z_OK);
+    const size_t offset = result.size();
+    result.resize(offset + deflateBound(&stream, chunk_length));
+    stream.next_in = const_cast<Bytef*>(data.GetMapping() + chunk_begin);
+    stream.avail_in = chunk_length;
+    stream.next_out = result.data() + offset;
+    stream.avail_out = result.size() - offset;
+    FML_CHECK(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+    result.resize(offset + stream.total_out);
+    deflateEnd(&stream);
+
+    const uint64_t chunk_end = result.size() - chunks_offset;
+    std::memcpy(result.data() + kHeaderSize + i * sizeof(uint64_t), &chunk_end,
+                sizeof(chunk_end));
+  }
+  return std::make_unique<fml::DataMapping>(std::move(result));
+}
+
+void CompressedAssetBundle::SetWorkerTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  WorkerTaskRunner& worker_task_runner = GetWorkerTaskRunner();
+  std::scoped_lock lock(worker_task_runner.mutex);
+  worker_task_runner.task_runner = std::move(task_runner);
+}
+
+CompressedAssetBundle::CompressedAssetBundle(
+    std::unique_ptr<AssetResolver> source,
+    size_t max_cache_bytes)
+    : source_(std::move(source)), cache_(kMaxCacheEntries, max_cache_bytes) {}
+
+CompressedAssetBundle::~CompressedAssetBundle() = default;
+
+std::unique_ptr<fml::Mapping> CompressedAssetBundle::Decompress(
+    const std::string& asset_name,
+    std::shared_ptr<const fml::Mapping> compressed) const {
+  TRACE_EVENT0("flutter", "CompressedAssetBundle::Decompress");
+  std::optional<Archive> archive = Archive::Parse(std::move(compressed));
+  if (!archive.has_value()) {
+    FML_LOG(ERROR) << "Compressed asset " << asset_name << " is corrupt.";
+    return nullptr;
+  }
+  if (archive->size == 0) {
+    return CreateEmptyMapping();
+  }
+
+  auto* data = static_cast<uint8_t*>(std::malloc(archive->size));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  const bool decompressed =
+      RunInParallel(archive->chunk_count, [&archive, data](size_t index) {
+        return archive->DecompressChunk(index,
+                                        data + index * archive->chunk_size);
+      });
+  if (!decompressed) {
+    std::free(data);
+    FML_LOG(ERROR) << "Compressed asset " << asset_name << " is corrupt.";
+    return nullptr;
+  }
+
+  std::shared_ptr<const fml::Mapping> mapping =
+      std::make_shared<fml::MallocMapping>(data, archive->size);
+  if (!asset_name.empty()) {
+    cache_.Put(asset_name, mapping);
+  }
+  return AssetMappingCache::Slice(std::move(mapping), 0, archive->size);
+}
+
+std::vector<std::shared_ptr<const fml::Mapping>>
+CompressedAssetBundle::GetChunks(const std::string& asset_name,
+                                 const Archive& archive,
+                                 size_t first,
+                                 size_t last) const {
+  std::vector<std::shared_ptr<const fml::Mapping>> chunks(last - first + 1);
+  std::vector<size_t> missing;
+  for (size_t i = first; i <= last; i++) {
+    chunks[i - first] = cache_.Get(GetChunkKey(asset_name, i));
+    if (!chunks[i - first]) {
+      missing.push_back(i);
+    }
+  }
+
+  const bool decompressed =
+      RunInParallel(missing.size(), [&](size_t missing_index) {
+        const size_t index = missing[missing_index];
+        const size_t size = archive.GetChunkSize(index);
+        auto* data = static_cast<uint8_t*>(std::malloc(size));
+        if (data == nullptr) {
+          return false;
+        }
+        if (!archive.DecompressChunk(index, data)) {
+          std::free(data);
+          return false;
+        }
+        chunks[index - first] =
+            std::make_shared<fml::MallocMapping>(data, size);
+        return true;
+      });
+  if (!decompressed) {
+    FML_LOG(ERROR) << "Compressed asset " << asset_name << " is corrupt.";
+    return {};
+  }
+  for (size_t index : missing) {
+    cache_.Put(GetChunkKey(asset_name, index), chunks[index - first]);
+  }
+  return chunks;
+}
+
+// |AssetResolver|
+bool CompressedAssetBundle::IsValid() const {
+  return source_ && source_->IsValid();
+}
+
+// |AssetResolver|
+bool CompressedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return source_->IsValidAfterAssetManagerChange();
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType CompressedAssetBundle::GetType() const {
+  // Replaced along with resolvers of the type of its source.
+  return source_->GetType();
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> CompressedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (std::shared_ptr<const fml::Mapping> cached = cache_.Get(asset_name)) {
+    const size_t size = cached->GetSize();
+    return AssetMappingCache::Slice(std::move(cached), 0, size);
+  }
+  std::shared_ptr<const fml::Mapping> compressed =
+      source_->GetAsMapping(asset_name + kSuffix);
+  if (!compressed) {
+    return source_->GetAsMapping(asset_name);
+  }
+  return Decompress(asset_name, std::move(compressed));
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>>
+CompressedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  // Whether an asset is compressed is decided by its name, not its contents.
+  // Names ending in the suffix are how compressed assets are stored, so they
+  // are never served as they are.
+  const std::string suffix_pattern = std::string("\\") + kSuffix;
+  std::vector<std::unique_ptr<fml::Mapping>> result = source_->GetAsMappings(
+      "(?!.*" + suffix_pattern + "$)(?:" + asset_pattern + ")", subdir);
+  for (std::unique_ptr<fml::Mapping>& compressed : source_->GetAsMappings(
+           "(?:" + asset_pattern + ")" + suffix_pattern, subdir)) {
+    if (auto decompressed = Decompress({}, std::move(compressed))) {
+      result.push_back(std::move(decompressed));
+    }
+  }
+  return result;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> CompressedAssetBundle::GetAsMappingRange(
+    const std::string& asset_name,
+    size_t offset,
+    size_t length) const {
+  if (std::shared_ptr<const fml::Mapping> cached = cache_.Get(asset_name)) {
+    const size_t size = cached->GetSize();
+    return AssetMappingCache::Slice(std::move(cached), offset,
+                                    length == 0 ? size : length);
+  }
+  std::shared_ptr<const fml::Mapping> compressed =
+      source_->GetAsMapping(asset_name + kSuffix);
+  if (!compressed) {
+    return source_->GetAsMappingRange(asset_name, offset, length);
+  }
+  std::optional<Archive> archive = Archive::Parse(compressed);
+  if (!archive.has_value()) {
+    FML_LOG(ERROR) << "Compressed asset " << asset_name << " is corrupt.";
+    return nullptr;
+  }
+
+  const uint64_t size = archive->size;
+  const uint64_t begin = std::min<uint64_t>(offset, size);
+  const uint64_t end =
+      length == 0 || length > size - begin ? size : begin + length;
+  if (begin == 0 && end == size) {
+    return Decompress(asset_name, std::move(compressed));
+  }
+  if (begin == end) {
+    return CreateEmptyMapping();
+  }
+
+  TRACE_EVENT0("flutter", "CompressedAssetBundle::GetAsMappingRange");
+  const size_t chunk_size = archive->chunk_size;
+  const size_t first = begin / chunk_size;
+  const size_t last = (end - 1) / chunk_size;
+  std::vector<std::shared_ptr<const fml::Mapping>> chunks =
+      GetChunks(asset_name, *archive, first, last);
+  if (chunks.empty()) {
+    return nullptr;
+  }
+  if (first == last) {
+    return AssetMappingCache::Slice(std::move(chunks[0]),
+                                    begin - first * chunk_size, end - begin);
+  }
+
+  auto* data = static_cast<uint8_t*>(std::malloc(end - begin));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  for (size_t i = first; i <= last; i++) {
+    const uint64_t chunk_begin = std::max<uint64_t>(begin, i * chunk_size);
+    const uint64_t chunk_end = std::min<uint64_t>(end, (i + 1) * chunk_size);
+    std::memcpy(
+        data + (chunk_begin - begin),
+        chunks[i - first]->GetMapping() + (chunk_begin - i * chunk_size),
+        chunk_end - chunk_begin);
+  }
+  return std::make_unique<fml::MallocMapping>(data, end - begin);
+}
+
+// |AssetResolver|
+bool CompressedAssetBundle::operator==(const AssetResolver& other) const {
+  auto other_bundle = other.as_compressed_asset_bundle();
+  if (!other_bundle) {
+    return false;
+  }
+  return *source_ == *other_bundle->source_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_COMPRESSED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_COMPRESSED_ASSET_BUNDLE_H_
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_mapping_cache.h"
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver that decompresses the assets of another one
+///             transparently.
+///
+///             An asset is compressed by storing it in the other resolver
+///             with |kSuffix| appended to its name, in the format written by
+///             |Compress|: the asset is split into chunks that are deflated
+///             separately, so that chunks can be inflated in parallel, and a
+///             range of the asset can be read by inflating only the chunks it
+///             overlaps. Assets that are not compressed are served by the
+///             other resolver as they are. Whether an asset is compressed is
+///             decided by the names the other resolver has, never by the
+///             contents of an asset, and names ending in |kSuffix| are not
+///             served as they are.
+///
+///             Chunks are inflated on the task runner set with
+///             |SetWorkerTaskRunner|, which is the concurrent worker pool of
+///             the Dart VM while it runs, with the calling thread taking part.
+///             Decompressed assets and chunks are retained in a cache of a
+///             bounded size.
+///
+class CompressedAssetBundle : public AssetResolver {
+ public:
+  /// The suffix of the names of compressed assets.
+  static constexpr char kSuffix[] = ".fz";
+
+  static constexpr size_t kDefaultChunkSize = 256 * 1024;
+
+  static constexpr size_t kDefaultMaxCacheBytes = 32 * 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Compresses `data` in chunks of `chunk_size` bytes.
+  ///
+  static std::unique_ptr<fml::Mapping> Compress(
+      const fml::Mapping& data,
+      size_t chunk_size = kDefaultChunkSize);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner that all the bundles in the process
+  ///             inflate chunks on, or clears it if `task_runner` is null, in
+  ///             which case chunks are inflated on the calling thread.
+  ///
+  static void SetWorkerTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  source          The resolver of the compressed assets.
+  /// @param[in]  max_cache_bytes The maximum combined size of the
+  ///                             decompressed assets and chunks retained.
+  ///
+  explicit CompressedAssetBundle(
+      std::unique_ptr<AssetResolver> source,
+      size_t max_cache_bytes = kDefaultMaxCacheBytes);
+
+  ~CompressedAssetBundle() override;
+
+ private:
+  struct Archive;
+
+  const std::unique_ptr<AssetResolver> source_;
+  mutable AssetMappingCache cache_;
+
+  // Returns the decompressed asset, or nullptr if it is corrupt.
+  std::unique_ptr<fml::Mapping> Decompress(
+      const std::string& asset_name,
+      std::shared_ptr<const fml::Mapping> compressed) const;
+
+  // Returns chunks `first` to `last` of the asset, or an empty vector if
+  // they are corrupt.
+  std::vector<std::shared_ptr<const fml::Mapping>> GetChunks(
+      const std::string& asset_name,
+      const Archive& archive,
+      size_t first,
+      size_t last) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMappingRange(
+      const std::string& asset_name,
+      size_t offset,
+      size_t length) const override;
+
+  // |AssetResolver|
+  bool operator==(const AssetResolver& other) const override;
+
+  // |AssetResolver|
+  const CompressedAssetBundle* as_compressed_asset_bundle() const override {
+    return this;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompressedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_COMPRESSED_ASSET_BUNDLE_H_
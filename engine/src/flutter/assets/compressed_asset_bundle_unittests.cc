@@ -0,0 +1,207 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/compressed_asset_bundle.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+std::string CreateContents(size_t size) {
+  std::string contents(size, '\0');
+  for (size_t i = 0; i < size; i++) {
+    contents[i] = static_cast<char>((i * 7) % 251);
+  }
+  return contents;
+}
+
+std::shared_ptr<const fml::Mapping> Compress(const std::string& contents,
+                                             size_t chunk_size) {
+  return CompressedAssetBundle::Compress(fml::DataMapping(contents),
+                                         chunk_size);
+}
+
+// Serves `assets` compressed in chunks of `chunk_size` bytes, with the
+// names in `uncompressed` left as they are.
+std::unique_ptr<AssetResolver> CreateBundle(
+    const std::vector<std::pair<std::string, std::string>>& assets,
+    size_t chunk_size,
+    const std::vector<std::string>& uncompressed = {}) {
+  std::vector<PackedAssetBundle::Asset> packed_assets;
+  for (const auto& [name, contents] : assets) {
+    if (std::find(uncompressed.begin(), uncompressed.end(), name) !=
+        uncompressed.end()) {
+      packed_assets.push_back(
+          {name, std::make_shared<fml::DataMapping>(contents)});
+    } else {
+      packed_assets.push_back({name + CompressedAssetBundle::kSuffix,
+                               Compress(contents, chunk_size)});
+    }
+  }
+  return std::make_unique<CompressedAssetBundle>(
+      std::make_unique<PackedAssetBundle>(
+          PackedAssetBundle::Pack(packed_assets), true));
+}
+}  // namespace
+
+TEST(CompressedAssetBundleTest, DecompressesAssets) {
+  const std::string large = CreateContents(100000);
+  auto bundle = CreateBundle({{"large", large},
+                              {"small", "hello"},
+                              {"empty", ""},
+                              {"plain", "not compressed"}},
+                             4096, {"plain"});
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kPackedAssetBundle);
+
+  auto mapping = bundle->GetAsMapping("large");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(*mapping), large);
+  // Served from the cache.
+  auto cached = bundle->GetAsMapping("large");
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(cached->GetMapping(), mapping->GetMapping());
+
+  mapping = bundle->GetAsMapping("small");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(*mapping), "hello");
+  mapping = bundle->GetAsMapping("empty");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(mapping->GetSize(), 0u);
+  mapping = bundle->GetAsMapping("plain");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(*mapping), "not compressed");
+  EXPECT_EQ(bundle->GetAsMapping("missing"), nullptr);
+}
+
+TEST(CompressedAssetBundleTest, DecompressesChunksOnWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  CompressedAssetBundle::SetWorkerTaskRunner(loop->GetTaskRunner());
+  const std::string contents = CreateContents(1 << 20);
+  auto bundle = CreateBundle({{"a", contents}}, 1000);
+  auto mapping = bundle->GetAsMapping("a");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(*mapping), contents);
+
+  // Called from a worker, which must not wait on the other workers.
+  fml::AutoResetWaitableEvent done;
+  loop->GetTaskRunner()->PostTask([&]() {
+    auto other_bundle = CreateBundle({{"a", contents}}, 1000);
+    auto other_mapping = other_bundle->GetAsMapping("a");
+    EXPECT_TRUE(other_mapping && ToString(*other_mapping) == contents);
+    done.Signal();
+  });
+  done.Wait();
+  CompressedAssetBundle::SetWorkerTaskRunner(nullptr);
+}
+
+TEST(CompressedAssetBundleTest, DecompressesRanges) {
+  const std::string contents = CreateContents(10000);
+  auto bundle = CreateBundle({{"a", contents}, {"plain", contents}}, 1000,
+                             {"plain"});
+  for (const char* name : {"a", "plain"}) {
+    for (auto [offset, length] : std::vector<std::pair<size_t, size_t>>{
+             {0, 10},
+             {10, 100},
+             {990, 20},
+             {1000, 1000},
+             {1500, 3000},
+             {9990, 100},
+             {9000, 0},
+             {20000, 10}}) {
+      auto range = bundle->GetAsMappingRange(name, offset, length);
+      ASSERT_NE(range, nullptr);
+      const size_t begin = std::min<size_t>(offset, contents.size());
+      EXPECT_EQ(ToString(*range),
+                contents.substr(begin, length == 0 ? std::string::npos
+                                                   : length))
+          << name << " " << offset << ":" << length;
+    }
+  }
+  EXPECT_EQ(bundle->GetAsMappingRange("missing", 0, 10), nullptr);
+
+  auto whole = bundle->GetAsMappingRange("a", 0, 0);
+  ASSERT_NE(whole, nullptr);
+  EXPECT_EQ(ToString(*whole), contents);
+}
+
+TEST(CompressedAssetBundleTest, GetsMappingsMatchingAPattern) {
+  auto bundle = CreateBundle({{"shaders/a.frag", "a"},
+                              {"shaders/b.frag", "b"},
+                              {"shaders/c.vert", "c"}},
+                             16, {"shaders/b.frag"});
+  std::vector<std::string> contents;
+  for (const auto& mapping : bundle->GetAsMappings(".*\\.frag", "shaders")) {
+    contents.push_back(ToString(*mapping));
+  }
+  std::sort(contents.begin(), contents.end());
+  EXPECT_EQ(contents, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(bundle->GetAsMappings(".*", "shaders").size(), 3u);
+}
+
+TEST(CompressedAssetBundleTest, DecidesCompressionByName) {
+  // An uncompressed asset that happens to start like a compressed one.
+  const std::string lookalike = ToString(*Compress("x", 16)) + "trailer";
+  auto bundle = CreateBundle({{"shaders/a.frag", "a"},
+                              {"shaders/b.frag", lookalike}},
+                             16, {"shaders/b.frag"});
+  std::vector<std::string> contents;
+  for (const auto& mapping : bundle->GetAsMappings(".*\\.frag", "shaders")) {
+    contents.push_back(ToString(*mapping));
+  }
+  std::sort(contents.begin(), contents.end());
+  EXPECT_EQ(contents, (std::vector<std::string>{lookalike, "a"}));
+
+  auto mapping = bundle->GetAsMapping("shaders/b.frag");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(*mapping), lookalike);
+
+  // The stored form of compressed assets is not served, even to patterns
+  // that match its name.
+  EXPECT_TRUE(bundle->GetAsMappings(".*\\.fz", "shaders").empty());
+  EXPECT_EQ(bundle->GetAsMappings("a\\.frag.*", "shaders").size(), 1u);
+}
+
+TEST(CompressedAssetBundleTest, RejectsCorruptAssets) {
+  const std::string contents = CreateContents(5000);
+  auto compressed = Compress(contents, 1000);
+  std::vector<uint8_t> data(compressed->GetMapping(),
+                            compressed->GetMapping() + compressed->GetSize());
+  // A corrupt chunk, a size larger than the chunks hold, and missing chunks.
+  std::vector<uint8_t> bad_chunk = data;
+  bad_chunk[bad_chunk.size() - 4] ^= 0xff;
+  std::vector<uint8_t> bad_size = data;
+  bad_size[8] = 0xff;
+  std::vector<uint8_t> truncated(data.begin(), data.begin() + 40);
+
+  for (auto& corrupt : {bad_chunk, bad_size, truncated}) {
+    auto bundle = std::make_unique<CompressedAssetBundle>(
+        std::make_unique<PackedAssetBundle>(
+            PackedAssetBundle::Pack(
+                {{std::string("a") + CompressedAssetBundle::kSuffix,
+                  std::make_shared<fml::DataMapping>(corrupt)}}),
+            true));
+    const AssetResolver& resolver = *bundle;
+    EXPECT_EQ(resolver.GetAsMapping("a"), nullptr);
+    EXPECT_EQ(resolver.GetAsMappingRange("a", 4500, 100), nullptr);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
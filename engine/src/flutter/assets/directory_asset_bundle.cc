@@ -7,6 +7,7 @@
 #include <regex>
 #include <utility>
 
+#include "flutter/assets/file_mapping_cache.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
@@ -50,14 +51,7 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
-  auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
-      descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
-
-  if (!mapping->IsValid()) {
-    return nullptr;
-  }
-
-  return mapping;
+  return FileMappingCache::GetInstance().GetMapping(descriptor_, asset_name);
 }
 
 std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
@@ -84,9 +78,9 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
         return true;
       }
 
-      auto mapping = std::make_unique<fml::FileMapping>(fd);
+      auto mapping = FileMappingCache::GetInstance().GetMapping(fd);
 
-      if (mapping && mapping->IsValid()) {
+      if (mapping) {
         mappings.push_back(std::move(mapping));
       } else {
         FML_LOG(ERROR) << "Mapping " << filename << " failed";
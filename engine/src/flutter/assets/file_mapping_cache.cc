@@ -0,0 +1,207 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/file_mapping_cache.h"
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+
+#if !FML_OS_WIN
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif  // !FML_OS_WIN
+
+namespace flutter {
+
+namespace {
+
+// Mappings only take address space until they are read, so this is large
+// enough for all the assets of most apps.
+constexpr size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+// Returns a view of `mapping` that keeps it alive.
+std::unique_ptr<fml::Mapping> CreateView(
+    std::shared_ptr<const fml::Mapping> mapping) {
+  const uint8_t* data = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  const bool dontneed_safe = mapping->IsDontNeedSafe();
+  return std::make_unique<fml::NonOwnedMapping>(
+      data, size, [mapping = std::move(mapping)](const uint8_t*, size_t) {},
+      dontneed_safe);
+}
+
+}  // namespace
+
+FileMappingCache& FileMappingCache::GetInstance() {
+  static FileMappingCache* cache = new FileMappingCache(kDefaultMaxBytes);
+  return *cache;
+}
+
+FileMappingCache::FileMappingCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+FileMappingCache::~FileMappingCache() = default;
+
+bool FileMappingCache::Key::operator<(const Key& other) const {
+  return std::tie(device, inode, modification_time, size) <
+         std::tie(other.device, other.inode, other.modification_time,
+                  other.size);
+}
+
+#if FML_OS_WIN
+
+std::optional<FileMappingCache::Key> FileMappingCache::GetKey(
+    const fml::UniqueFD& directory,
+    const std::string& path) {
+  return std::nullopt;
+}
+
+std::optional<FileMappingCache::Key> FileMappingCache::GetKey(
+    const fml::UniqueFD& file) {
+  return std::nullopt;
+}
+
+#else  // FML_OS_WIN
+
+namespace {
+
+std::optional<FileMappingCache::Key> ToKey(const struct stat& file_stat) {
+  if (!S_ISREG(file_stat.st_mode)) {
+    return std::nullopt;
+  }
+#if FML_OS_MACOSX || FML_OS_IOS
+  const struct timespec& modification_time = file_stat.st_mtimespec;
+#else
+  const struct timespec& modification_time = file_stat.st_mtim;
+#endif
+  FileMappingCache::Key key;
+  key.device = file_stat.st_dev;
+  key.inode = file_stat.st_ino;
+  key.modification_time =
+      static_cast<int64_t>(modification_time.tv_sec) * 1000000000 +
+      modification_time.tv_nsec;
+  key.size = file_stat.st_size;
+  return key;
+}
+
+}  // namespace
+
+std::optional<FileMappingCache::Key> FileMappingCache::GetKey(
+    const fml::UniqueFD& directory,
+    const std::string& path) {
+  struct stat file_stat = {};
+  if (::fstatat(directory.get(), path.c_str(), &file_stat, 0) != 0) {
+    return std::nullopt;
+  }
+  return ToKey(file_stat);
+}
+
+std::optional<FileMappingCache::Key> FileMappingCache::GetKey(
+    const fml::UniqueFD& file) {
+  struct stat file_stat = {};
+  if (::fstat(file.get(), &file_stat) != 0) {
+    return std::nullopt;
+  }
+  return ToKey(file_stat);
+}
+
+#endif  // FML_OS_WIN
+
+std::unique_ptr<fml::Mapping> FileMappingCache::GetMapping(
+    const fml::UniqueFD& directory,
+    const std::string& path) {
+  TRACE_EVENT0("flutter", "FileMappingCache::GetMapping");
+  if (std::optional<Key> key = GetKey(directory, path)) {
+    if (std::shared_ptr<const fml::Mapping> mapping = Find(*key)) {
+      return CreateView(std::move(mapping));
+    }
+  }
+  return MapAndInsert(fml::OpenFile(directory, path.c_str(), false,
+                                    fml::FilePermission::kRead));
+}
+
+std::unique_ptr<fml::Mapping> FileMappingCache::GetMapping(
+    const fml::UniqueFD& file) {
+  TRACE_EVENT0("flutter", "FileMappingCache::GetMapping");
+  if (std::optional<Key> key = GetKey(file)) {
+    if (std::shared_ptr<const fml::Mapping> mapping = Find(*key)) {
+      return CreateView(std::move(mapping));
+    }
+  }
+  return MapAndInsert(file);
+}
+
+std::shared_ptr<const fml::Mapping> FileMappingCache::Find(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->mapping;
+}
+
+std::unique_ptr<fml::Mapping> FileMappingCache::MapAndInsert(
+    const fml::UniqueFD& file) {
+  auto file_mapping = std::make_unique<fml::FileMapping>(file);
+  if (!file_mapping->IsValid()) {
+    return nullptr;
+  }
+  // The key is read from the file that was mapped, which may not be the one
+  // looked up if it was replaced in between.
+  std::optional<Key> key = GetKey(file);
+  const size_t size = file_mapping->GetSize();
+  if (!key.has_value() || size == 0 || size > max_bytes_) {
+    return file_mapping;
+  }
+
+  std::shared_ptr<const fml::Mapping> mapping = std::move(file_mapping);
+  // Unmapped once the cache is unlocked.
+  std::vector<std::shared_ptr<const fml::Mapping>> unused;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = index_.find(*key);
+    if (found != index_.end()) {
+      // Another thread mapped the file first.
+      entries_.splice(entries_.begin(), entries_, found->second);
+      unused.push_back(std::exchange(mapping, found->second->mapping));
+    } else {
+      entries_.push_front({*key, mapping});
+      index_[*key] = entries_.begin();
+      stats_.mapped_bytes += size;
+      while (stats_.mapped_bytes > max_bytes_) {
+        Entry& victim = entries_.back();
+        stats_.mapped_bytes -= victim.mapping->GetSize();
+        stats_.evictions++;
+        index_.erase(victim.key);
+        unused.push_back(std::move(victim.mapping));
+        entries_.pop_back();
+      }
+    }
+  }
+  return CreateView(std::move(mapping));
+}
+
+void FileMappingCache::Clear() {
+  std::list<Entry> entries;
+  std::scoped_lock lock(mutex_);
+  entries.swap(entries_);
+  index_.clear();
+  stats_.mapped_bytes = 0;
+}
+
+FileMappingCache::Stats FileMappingCache::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  Stats stats = stats_;
+  stats.entry_count = entries_.size();
+  return stats;
+}
+
+}  // namespace flutter
@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_FILE_MAPPING_CACHE_H_
+#define FLUTTER_ASSETS_FILE_MAPPING_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A thread safe, least recently used cache of read-only file
+///             mappings, keyed by the identity of the files mapped.
+///
+///             Files are identified by their device, inode, modification time
+///             and size, so every asset bundle in the process that reads the
+///             same file gets a view of the same mapping, and a file that has
+///             been modified or replaced since it was mapped is mapped again.
+///             Looking up a cached file takes a single |fstatat|.
+///
+///             The cache retains mappings up to a combined size, evicting the
+///             least recently used ones first. Mappings it hands out stay
+///             valid after they are evicted.
+///
+///             Files are not cached on Windows, where they have no inode that
+///             can be read without opening them.
+///
+class FileMappingCache {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      The number of lookups since the cache was created, and the
+  ///             mappings it currently retains.
+  ///
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entry_count = 0;
+    size_t mapped_bytes = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Identifies the contents of a file.
+  ///
+  struct Key {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    int64_t modification_time = 0;
+    uint64_t size = 0;
+
+    bool operator<(const Key& other) const;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache shared by all the engines in the process.
+  ///
+  static FileMappingCache& GetInstance();
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  max_bytes  The maximum combined size of the mappings
+  ///                        retained. Files larger than this are mapped but
+  ///                        never cached.
+  ///
+  explicit FileMappingCache(size_t max_bytes);
+
+  ~FileMappingCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a read-only mapping of the file at `path` relative
+  ///             to `directory`, or nullptr if it can't be mapped.
+  ///
+  std::unique_ptr<fml::Mapping> GetMapping(const fml::UniqueFD& directory,
+                                           const std::string& path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a read-only mapping of the open file `file`, or
+  ///             nullptr if it can't be mapped.
+  ///
+  std::unique_ptr<fml::Mapping> GetMapping(const fml::UniqueFD& file);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all the mappings retained.
+  ///
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    Key key;
+    std::shared_ptr<const fml::Mapping> mapping;
+  };
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<Key, std::list<Entry>::iterator> index_;
+  Stats stats_;
+
+  static std::optional<Key> GetKey(const fml::UniqueFD& directory,
+                                   const std::string& path);
+
+  static std::optional<Key> GetKey(const fml::UniqueFD& file);
+
+  std::shared_ptr<const fml::Mapping> Find(const Key& key);
+
+  std::unique_ptr<fml::Mapping> MapAndInsert(const fml::UniqueFD& file);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FileMappingCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_FILE_MAPPING_CACHE_H_
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/file_mapping_cache.h"
+
+#include <string>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+void WriteFile(const fml::UniqueFD& directory,
+               const char* name,
+               const std::string& contents) {
+  ASSERT_TRUE(fml::WriteAtomically(directory, name,
+                                   fml::DataMapping(contents)));
+}
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+}  // namespace
+
+TEST(FileMappingCacheTest, SharesMappingsOfTheSameFile) {
+#if FML_OS_WIN
+  GTEST_SKIP() << "Files are not cached on Windows.";
+#endif  // FML_OS_WIN
+  fml::ScopedTemporaryDirectory temp_dir;
+  WriteFile(temp_dir.fd(), "a", "hello");
+  FileMappingCache cache(1024);
+
+  auto first = cache.GetMapping(temp_dir.fd(), "a");
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(ToString(*first), "hello");
+
+  // The same file opened through another directory, as another engine would.
+  fml::UniqueFD other_dir = fml::OpenDirectory(
+      temp_dir.path().c_str(), false, fml::FilePermission::kRead);
+  auto second = cache.GetMapping(other_dir, "a");
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(second->GetMapping(), first->GetMapping());
+
+  auto third = cache.GetMapping(
+      fml::OpenFile(temp_dir.fd(), "a", false, fml::FilePermission::kRead));
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(third->GetMapping(), first->GetMapping());
+
+  const FileMappingCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.entry_count, 1u);
+  EXPECT_EQ(stats.mapped_bytes, 5u);
+}
+
+TEST(FileMappingCacheTest, MapsReplacedFilesAgain) {
+#if FML_OS_WIN
+  GTEST_SKIP() << "Files are not cached on Windows.";
+#endif  // FML_OS_WIN
+  fml::ScopedTemporaryDirectory temp_dir;
+  WriteFile(temp_dir.fd(), "a", "hello");
+  FileMappingCache cache(1024);
+  auto old_mapping = cache.GetMapping(temp_dir.fd(), "a");
+  ASSERT_NE(old_mapping, nullptr);
+
+  WriteFile(temp_dir.fd(), "a", "goodbye");
+  auto new_mapping = cache.GetMapping(temp_dir.fd(), "a");
+  ASSERT_NE(new_mapping, nullptr);
+  EXPECT_EQ(ToString(*new_mapping), "goodbye");
+  EXPECT_EQ(ToString(*old_mapping), "hello");
+  EXPECT_EQ(cache.GetStats().misses, 2u);
+}
+
+TEST(FileMappingCacheTest, EvictsLeastRecentlyUsedFiles) {
+#if FML_OS_WIN
+  GTEST_SKIP() << "Files are not cached on Windows.";
+#endif  // FML_OS_WIN
+  fml::ScopedTemporaryDirectory temp_dir;
+  WriteFile(temp_dir.fd(), "a", "aaaa");
+  WriteFile(temp_dir.fd(), "b", "bbbb");
+  WriteFile(temp_dir.fd(), "c", "cccc");
+  WriteFile(temp_dir.fd(), "large", "01234567890");
+  FileMappingCache cache(10);
+
+  auto a = cache.GetMapping(temp_dir.fd(), "a");
+  EXPECT_NE(cache.GetMapping(temp_dir.fd(), "b"), nullptr);
+  // Touch "a" so that "b" becomes the least recently used file.
+  EXPECT_NE(cache.GetMapping(temp_dir.fd(), "a"), nullptr);
+  EXPECT_NE(cache.GetMapping(temp_dir.fd(), "c"), nullptr);
+  FileMappingCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.entry_count, 2u);
+  EXPECT_EQ(stats.mapped_bytes, 8u);
+
+  EXPECT_EQ(cache.GetMapping(temp_dir.fd(), "a")->GetMapping(),
+            a->GetMapping());
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+  EXPECT_NE(cache.GetMapping(temp_dir.fd(), "b"), nullptr);
+  EXPECT_EQ(cache.GetStats().misses, 4u);
+
+  // Files larger than the whole budget are mapped but not cached.
+  auto large = cache.GetMapping(temp_dir.fd(), "large");
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(ToString(*large), "01234567890");
+  EXPECT_EQ(cache.GetStats().mapped_bytes, 8u);
+
+  // Evicted mappings stay valid while they are used.
+  cache.Clear();
+  EXPECT_EQ(cache.GetStats().mapped_bytes, 0u);
+  EXPECT_EQ(ToString(*a), "aaaa");
+}
+
+TEST(FileMappingCacheTest, ReturnsNullForMissingFiles) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  FileMappingCache cache(1024);
+  EXPECT_EQ(cache.GetMapping(temp_dir.fd(), "missing"), nullptr);
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
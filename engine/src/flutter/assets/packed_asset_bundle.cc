@@ -0,0 +1,390 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <regex>
+#include <set>
+#include <utility>
+
+#include "flutter/assets/asset_mapping_cache.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// An archive is laid out as follows, with little-endian integers:
+//
+//   Header
+//   uint32_t seeds[seed_count], padded to 8 bytes
+//   Entry entries[entry_count], in the order of the perfect hash
+//   char names[names_size]
+//   The data of the assets, from a page boundary
+//
+// The perfect hash is a "hash and displace" one: the hash of a name selects
+// a seed, and hashing the name again with that seed selects its entry.
+struct PackedAssetBundle::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t seed_count;
+  uint32_t names_size;
+};
+
+struct PackedAssetBundle::Entry {
+  uint64_t hash;
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint32_t name_offset;
+  uint32_t name_size;
+};
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'L', 'T', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kVersion = 1;
+
+// The largest page size of the platforms the engine runs on.
+constexpr size_t kPageSize = 16384;
+constexpr size_t kDataAlignment = 16;
+
+// Packing fails after trying this many seeds for a bucket, which only
+// happens if two names have the same hash.
+constexpr uint32_t kMaxSeed = 1 << 20;
+
+size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// FNV-1a.
+uint64_t HashName(std::string_view name) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+  }
+  return hash;
+}
+
+// The finalizer of SplitMix64, which spreads the bits of the hash so that
+// it can be reduced with a modulo.
+uint64_t Mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+
+size_t GetBucket(uint64_t hash, uint32_t seed_count) {
+  return Mix(hash) % seed_count;
+}
+
+size_t GetSlot(uint64_t hash, uint32_t seed, uint32_t entry_count) {
+  return Mix(hash + (static_cast<uint64_t>(seed) + 1) * 0x9e3779b97f4a7c15) %
+         entry_count;
+}
+
+// The seeds follow the header.
+constexpr size_t kSeedsOffset = 24;
+
+size_t GetEntriesOffset(uint32_t seed_count) {
+  return AlignUp(kSeedsOffset + seed_count * sizeof(uint32_t), 8);
+}
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::Pack(
+    const std::vector<Asset>& assets) {
+  static_assert(sizeof(Header) == kSeedsOffset);
+  static_assert(sizeof(Entry) == 32);
+  TRACE_EVENT0("flutter", "PackedAssetBundle::Pack");
+  std::set<std::string_view> names;
+  for (const Asset& asset : assets) {
+    if (!names.insert(asset.name).second) {
+      FML_LOG(ERROR) << "Asset " << asset.name << " was packed twice.";
+      return nullptr;
+    }
+  }
+
+  // Two names per seed keeps the search for seeds short.
+  const uint32_t entry_count = assets.size();
+  const uint32_t seed_count = std::max<uint32_t>(1, (entry_count + 1) / 2);
+  std::vector<uint64_t> hashes(entry_count);
+  std::vector<std::vector<uint32_t>> buckets(seed_count);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    hashes[i] = HashName(assets[i].name);
+    buckets[GetBucket(hashes[i], seed_count)].push_back(i);
+  }
+
+  // Buckets are placed largest first, while most slots are free.
+  std::vector<uint32_t> order(seed_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&buckets](uint32_t a, uint32_t b) {
+                     return buckets[a].size() > buckets[b].size();
+                   });
+  std::vector<uint32_t> seeds(seed_count, 0);
+  std::vector<bool> occupied(entry_count, false);
+  // The asset in each slot.
+  std::vector<uint32_t> slot_assets(entry_count, 0);
+  std::vector<size_t> bucket_slots;
+  for (uint32_t bucket : order) {
+    const std::vector<uint32_t>& members = buckets[bucket];
+    if (members.empty()) {
+      break;
+    }
+    for (uint32_t seed = 0;; seed++) {
+      if (seed == kMaxSeed) {
+        FML_LOG(ERROR) << "Could not find a perfect hash of the asset names.";
+        return nullptr;
+      }
+      bucket_slots.clear();
+      for (uint32_t member : members) {
+        const size_t slot = GetSlot(hashes[member], seed, entry_count);
+        if (occupied[slot] || std::find(bucket_slots.begin(),
+                                        bucket_slots.end(),
+                                        slot) != bucket_slots.end()) {
+          break;
+        }
+        bucket_slots.push_back(slot);
+      }
+      if (bucket_slots.size() == members.size()) {
+        for (size_t i = 0; i < members.size(); i++) {
+          occupied[bucket_slots[i]] = true;
+          slot_assets[bucket_slots[i]] = members[i];
+        }
+        seeds[bucket] = seed;
+        break;
+      }
+    }
+  }
+
+  // Lays out the archive. The data of the assets is in the order they were
+  // given in, so that related assets can be kept together.
+  const size_t entries_offset = GetEntriesOffset(seed_count);
+  const size_t names_offset = entries_offset + entry_count * sizeof(Entry);
+  size_t names_size = 0;
+  for (const Asset& asset : assets) {
+    names_size += asset.name.size();
+  }
+  std::vector<size_t> data_offsets(entry_count);
+  size_t size = AlignUp(names_offset + names_size, kPageSize);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    const size_t data_size = assets[i].data ? assets[i].data->GetSize() : 0;
+    size = AlignUp(size, data_size >= kPageSize ? kPageSize : kDataAlignment);
+    data_offsets[i] = size;
+    size += data_size;
+  }
+  if (names_size > std::numeric_limits<uint32_t>::max()) {
+    FML_LOG(ERROR) << "The asset names are too long to pack.";
+    return nullptr;
+  }
+
+  std::vector<uint8_t> archive(size, 0);
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.entry_count = entry_count;
+  header.seed_count = seed_count;
+  header.names_size = names_size;
+  std::memcpy(archive.data(), &header, sizeof(header));
+  std::memcpy(archive.data() + kSeedsOffset, seeds.data(),
+              seeds.size() * sizeof(uint32_t));
+
+  std::vector<uint32_t> name_offsets(entry_count);
+  size_t name_offset = 0;
+  for (uint32_t i = 0; i < entry_count; i++) {
+    const std::string& name = assets[i].name;
+    std::memcpy(archive.data() + names_offset + name_offset, name.data(),
+                name.size());
+    name_offsets[i] = name_offset;
+    name_offset += name.size();
+    if (assets[i].data && assets[i].data->GetSize() > 0) {
+      std::memcpy(archive.data() + data_offsets[i],
+                  assets[i].data->GetMapping(), assets[i].data->GetSize());
+    }
+  }
+  for (uint32_t slot = 0; slot < entry_count; slot++) {
+    const uint32_t i = slot_assets[slot];
+    Entry entry = {};
+    entry.hash = hashes[i];
+    entry.data_offset = data_offsets[i];
+    entry.data_size = assets[i].data ? assets[i].data->GetSize() : 0;
+    entry.name_offset = name_offsets[i];
+    entry.name_size = assets[i].name.size();
+    std::memcpy(archive.data() + entries_offset + slot * sizeof(Entry), &entry,
+                sizeof(entry));
+  }
+  return std::make_unique<fml::DataMapping>(std::move(archive));
+}
+
+PackedAssetBundle::PackedAssetBundle(
+    std::shared_ptr<const fml::Mapping> archive,
+    bool is_valid_after_asset_manager_change)
+    : archive_(std::move(archive)) {
+  if (!archive_ || archive_->GetMapping() == nullptr ||
+      archive_->GetSize() < sizeof(Header)) {
+    return;
+  }
+  const uint8_t* data = archive_->GetMapping();
+  const size_t size = archive_->GetSize();
+  // The index is read in place.
+  if (reinterpret_cast<uintptr_t>(data) % alignof(Entry) != 0) {
+    FML_LOG(ERROR) << "Asset archive is not aligned.";
+    return;
+  }
+  const Header* header = reinterpret_cast<const Header*>(data);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion) {
+    FML_LOG(ERROR) << "Not an asset archive.";
+    return;
+  }
+  if (header->entry_count > 0 && header->seed_count == 0) {
+    return;
+  }
+  const uint64_t entries_offset = GetEntriesOffset(header->seed_count);
+  const uint64_t names_offset =
+      entries_offset + static_cast<uint64_t>(header->entry_count) *
+                           sizeof(Entry);
+  if (names_offset + header->names_size > size) {
+    FML_LOG(ERROR) << "Asset archive is truncated.";
+    return;
+  }
+  const Entry* entries = reinterpret_cast<const Entry*>(data + entries_offset);
+  for (uint32_t i = 0; i < header->entry_count; i++) {
+    const Entry& entry = entries[i];
+    if (entry.name_offset > header->names_size ||
+        entry.name_size > header->names_size - entry.name_offset ||
+        entry.data_offset > size ||
+        entry.data_size > size - entry.data_offset) {
+      FML_LOG(ERROR) << "Asset archive is corrupt.";
+      return;
+    }
+  }
+
+  entries_ = entries;
+  entry_count_ = header->entry_count;
+  seeds_ = reinterpret_cast<const uint32_t*>(data + kSeedsOffset);
+  seed_count_ = header->seed_count;
+  names_ = reinterpret_cast<const char*>(data + names_offset);
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+std::vector<std::string> PackedAssetBundle::GetAssetNames() const {
+  std::vector<std::string> names;
+  names.reserve(entry_count_);
+  for (uint32_t i = 0; i < entry_count_; i++) {
+    names.emplace_back(GetName(entries_[i]));
+  }
+  return names;
+}
+
+const PackedAssetBundle::Entry* PackedAssetBundle::Find(
+    std::string_view asset_name) const {
+  if (entry_count_ == 0) {
+    return nullptr;
+  }
+  const uint64_t hash = HashName(asset_name);
+  const uint32_t seed = seeds_[GetBucket(hash, seed_count_)];
+  const Entry& entry = entries_[GetSlot(hash, seed, entry_count_)];
+  if (entry.hash != hash || GetName(entry) != asset_name) {
+    return nullptr;
+  }
+  return &entry;
+}
+
+std::string_view PackedAssetBundle::GetName(const Entry& entry) const {
+  return std::string_view(names_ + entry.name_offset, entry.name_size);
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetData(
+    const Entry& entry) const {
+  return AssetMappingCache::Slice(archive_, entry.data_offset, entry.data_size);
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+  const Entry* entry = Find(asset_name);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return GetData(*entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  std::optional<std::string_view> directory;
+  if (subdir.has_value()) {
+    directory = subdir.value();
+    while (!directory->empty() && directory->back() == '/') {
+      directory->remove_suffix(1);
+    }
+  }
+  std::regex asset_regex(asset_pattern);
+  for (uint32_t i = 0; i < entry_count_; i++) {
+    const std::string_view name = GetName(entries_[i]);
+    const size_t separator = name.rfind('/');
+    const std::string_view filename =
+        separator == std::string_view::npos ? name : name.substr(separator + 1);
+    // Like DirectoryAssetBundle, matches the files directly in `subdir`, or
+    // in any directory if there is none.
+    if (directory.has_value() &&
+        name.substr(0, name.size() - filename.size()) !=
+            std::string(directory.value()) + "/") {
+      continue;
+    }
+    if (std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      mappings.push_back(GetData(entries_[i]));
+    }
+  }
+  return mappings;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::operator==(const AssetResolver& other) const {
+  auto other_bundle = other.as_packed_asset_bundle();
+  if (!other_bundle) {
+    return false;
+  }
+  // Archives mapped through |FileMappingCache| share their data.
+  return is_valid_after_asset_manager_change_ ==
+             other_bundle->is_valid_after_asset_manager_change_ &&
+         archive_ && other_bundle->archive_ &&
+         archive_->GetMapping() == other_bundle->archive_->GetMapping();
+}
+
+}  // namespace flutter
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver for the assets packed into a single archive,
+///             which is mapped once and serves each asset as a view of it.
+///
+///             The archive starts with an index of its assets, ordered by a
+///             minimal perfect hash of their names, so finding an asset
+///             hashes its name once and compares it with a single entry.
+///             The data of each asset is aligned to 16 bytes, and that of
+///             assets of a page or more to a page.
+///
+///             Archives are created with |Pack|, which the asset_packer tool
+///             runs on an assets directory.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  /// The name of the archive that |RunConfiguration::InferFromSettings| looks
+  /// for in the assets directory.
+  static constexpr char kFileName[] = "assets.pack";
+
+  /// An asset to pack.
+  struct Asset {
+    /// The name that the asset is looked up by, which is its path relative
+    /// to the assets directory, with '/' separators.
+    std::string name;
+    std::shared_ptr<const fml::Mapping> data;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs `assets` into an archive.
+  ///
+  /// @return     The archive, or nullptr if two assets have the same name.
+  ///
+  static std::unique_ptr<fml::Mapping> Pack(const std::vector<Asset>& assets);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  archive  A mapping of an archive created by |Pack|. The
+  ///                      bundle is invalid if it isn't one.
+  ///
+  PackedAssetBundle(std::shared_ptr<const fml::Mapping> archive,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The names of the assets in the archive.
+  ///
+  std::vector<std::string> GetAssetNames() const;
+
+ private:
+  struct Header;
+  struct Entry;
+
+  const std::shared_ptr<const fml::Mapping> archive_;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+  const Entry* entries_ = nullptr;
+  uint32_t entry_count_ = 0;
+  const uint32_t* seeds_ = nullptr;
+  uint32_t seed_count_ = 0;
+  const char* names_ = nullptr;
+
+  // Returns the entry for `asset_name`, or null.
+  const Entry* Find(std::string_view asset_name) const;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> GetData(const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  // |AssetResolver|
+  bool operator==(const AssetResolver& other) const override;
+
+  // |AssetResolver|
+  const PackedAssetBundle* as_packed_asset_bundle() const override {
+    return this;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,166 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+PackedAssetBundle::Asset CreateAsset(const std::string& name,
+                                     const std::string& contents) {
+  return {name, std::make_shared<fml::DataMapping>(contents)};
+}
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+std::unique_ptr<AssetResolver> CreateBundle(
+    const std::vector<PackedAssetBundle::Asset>& assets) {
+  std::shared_ptr<fml::Mapping> archive = PackedAssetBundle::Pack(assets);
+  EXPECT_NE(archive, nullptr);
+  return std::make_unique<PackedAssetBundle>(std::move(archive), true);
+}
+
+bool IsValidArchive(std::vector<uint8_t> data) {
+  std::unique_ptr<AssetResolver> bundle = std::make_unique<PackedAssetBundle>(
+      std::make_shared<fml::DataMapping>(std::move(data)), true);
+  return bundle->IsValid();
+}
+}  // namespace
+
+TEST(PackedAssetBundleTest, FindsEveryAsset) {
+  std::vector<PackedAssetBundle::Asset> assets;
+  for (int i = 0; i < 1000; i++) {
+    assets.push_back(CreateAsset("assets/image_" + std::to_string(i) + ".png",
+                                 std::string(i % 37, 'a' + i % 26)));
+  }
+  auto bundle = CreateBundle(assets);
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kPackedAssetBundle);
+
+  for (const PackedAssetBundle::Asset& asset : assets) {
+    auto mapping = bundle->GetAsMapping(asset.name);
+    ASSERT_NE(mapping, nullptr) << asset.name;
+    EXPECT_EQ(ToString(*mapping), ToString(*asset.data));
+  }
+  EXPECT_EQ(bundle->GetAsMapping("assets/image_1000.png"), nullptr);
+  EXPECT_EQ(bundle->GetAsMapping("image_1.png"), nullptr);
+  EXPECT_EQ(bundle->GetAsMapping(""), nullptr);
+
+  std::vector<std::string> names =
+      bundle->as_packed_asset_bundle()->GetAssetNames();
+  std::sort(names.begin(), names.end());
+  std::vector<std::string> expected_names;
+  for (const PackedAssetBundle::Asset& asset : assets) {
+    expected_names.push_back(asset.name);
+  }
+  std::sort(expected_names.begin(), expected_names.end());
+  EXPECT_EQ(names, expected_names);
+}
+
+TEST(PackedAssetBundleTest, AlignsAssets) {
+  auto bundle = CreateBundle({
+      CreateAsset("a", "1"),
+      CreateAsset("b", "22"),
+      CreateAsset("large", std::string(20000, 'x')),
+      CreateAsset("c", "333"),
+  });
+  ASSERT_TRUE(bundle->IsValid());
+  for (const char* name : {"a", "b", "c"}) {
+    auto mapping = bundle->GetAsMapping(name);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapping->GetMapping()) % 16, 0u);
+  }
+  auto large = bundle->GetAsMapping("large");
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(large->GetSize(), 20000u);
+  // Relative to the start of the archive, which is page aligned once mapped.
+  auto a = bundle->GetAsMapping("a");
+  EXPECT_EQ((large->GetMapping() - a->GetMapping()) % 16384, 0);
+}
+
+TEST(PackedAssetBundleTest, GetsMappingsMatchingAPattern) {
+  auto bundle = CreateBundle({
+      CreateAsset("shaders/a.frag", "a"),
+      CreateAsset("shaders/b.frag", "b"),
+      CreateAsset("shaders/c.vert", "c"),
+      CreateAsset("shaders/nested/d.frag", "d"),
+      CreateAsset("e.frag", "e"),
+  });
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto to_strings = [](std::vector<std::unique_ptr<fml::Mapping>> mappings) {
+    std::vector<std::string> strings;
+    for (const auto& mapping : mappings) {
+      strings.push_back(ToString(*mapping));
+    }
+    std::sort(strings.begin(), strings.end());
+    return strings;
+  };
+  EXPECT_EQ(to_strings(bundle->GetAsMappings(".*\\.frag", std::nullopt)),
+            (std::vector<std::string>{"a", "b", "d", "e"}));
+  EXPECT_EQ(to_strings(bundle->GetAsMappings(".*\\.frag", "shaders")),
+            (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(to_strings(bundle->GetAsMappings(".*", "shaders/nested/")),
+            (std::vector<std::string>{"d"}));
+  EXPECT_TRUE(bundle->GetAsMappings(".*", "missing").empty());
+}
+
+TEST(PackedAssetBundleTest, PacksEmptyArchives) {
+  auto bundle = CreateBundle({});
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetAsMapping("a"), nullptr);
+  EXPECT_TRUE(bundle->GetAsMappings(".*", std::nullopt).empty());
+}
+
+TEST(PackedAssetBundleTest, RejectsDuplicateNames) {
+  EXPECT_EQ(PackedAssetBundle::Pack(
+                {CreateAsset("a", "1"), CreateAsset("a", "2")}),
+            nullptr);
+}
+
+TEST(PackedAssetBundleTest, RejectsInvalidArchives) {
+  EXPECT_FALSE(IsValidArchive({}));
+  EXPECT_FALSE(IsValidArchive(std::vector<uint8_t>(64, 'a')));
+
+  auto archive = PackedAssetBundle::Pack(
+      {CreateAsset("a", "1"), CreateAsset("b", std::string(100, 'b'))});
+  ASSERT_NE(archive, nullptr);
+  std::vector<uint8_t> data(archive->GetMapping(),
+                            archive->GetMapping() + archive->GetSize());
+  EXPECT_TRUE(IsValidArchive(data));
+
+  // The data of the last asset is cut off.
+  EXPECT_FALSE(IsValidArchive({data.begin(), data.end() - 1}));
+
+  std::vector<uint8_t> bad_version = data;
+  bad_version[8]++;
+  EXPECT_FALSE(IsValidArchive(std::move(bad_version)));
+}
+
+TEST(PackedAssetBundleTest, ComparesByArchive) {
+  std::shared_ptr<fml::Mapping> archive =
+      PackedAssetBundle::Pack({CreateAsset("a", "1")});
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<PackedAssetBundle>(archive, true);
+  std::unique_ptr<AssetResolver> same =
+      std::make_unique<PackedAssetBundle>(archive, true);
+  std::unique_ptr<AssetResolver> invalid_after_change =
+      std::make_unique<PackedAssetBundle>(archive, false);
+  EXPECT_TRUE(*bundle == *same);
+  EXPECT_FALSE(*bundle == *invalid_after_change);
+  EXPECT_FALSE(*bundle == *CreateBundle({CreateAsset("a", "1")}));
+}
+
+}  // namespace testing
+}  // namespace flutter
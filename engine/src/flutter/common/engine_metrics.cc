@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/engine_metrics.h"
+
+namespace flutter {
+
+EngineMetrics& EngineMetrics::GetInstance() {
+  static EngineMetrics* metrics = new EngineMetrics();
+  return *metrics;
+}
+
+EngineMetrics::EngineMetrics() = default;
+
+EngineMetrics::~EngineMetrics() = default;
+
+void EngineMetrics::RecordChannelMessage(uint32_t channel_id,
+                                         Direction direction,
+                                         size_t bytes) {
+  if (channel_id >= kMaxChannels) {
+    channel_id = 0;
+  }
+  std::atomic<Channel*>& slot = channels_[channel_id];
+  Channel* channel = slot.load(std::memory_order_acquire);
+  if (channel == nullptr) {
+    auto* new_channel = new Channel();
+    if (slot.compare_exchange_strong(channel, new_channel,
+                                     std::memory_order_acq_rel)) {
+      channel = new_channel;
+    } else {
+      // Another thread allocated the channel first.
+      delete new_channel;
+    }
+  }
+  const size_t index = static_cast<size_t>(direction);
+  channel->messages[index].fetch_add(1, std::memory_order_relaxed);
+  channel->bytes[index].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void EngineMetrics::RecordPlatformMessageRoundTrip(Direction direction,
+                                                   fml::TimeDelta latency) {
+  round_trips_[static_cast<size_t>(direction)].Record(
+      latency.ToMicroseconds());
+}
+
+void EngineMetrics::RecordAssetLoad(fml::TimeDelta latency) {
+  asset_loads_.Record(latency.ToMicroseconds());
+}
+
+std::vector<EngineMetrics::ChannelCounts> EngineMetrics::GetChannelCounts()
+    const {
+  constexpr size_t kTo = static_cast<size_t>(Direction::kToFramework);
+  constexpr size_t kFrom = static_cast<size_t>(Direction::kFromFramework);
+  std::vector<ChannelCounts> counts;
+  for (size_t id = 0; id < kMaxChannels; id++) {
+    const Channel* channel = channels_[id].load(std::memory_order_acquire);
+    if (channel == nullptr) {
+      continue;
+    }
+    ChannelCounts& channel_counts = counts.emplace_back();
+    channel_counts.channel_id = id;
+    channel_counts.messages_to_framework =
+        channel->messages[kTo].load(std::memory_order_relaxed);
+    channel_counts.bytes_to_framework =
+        channel->bytes[kTo].load(std::memory_order_relaxed);
+    channel_counts.messages_from_framework =
+        channel->messages[kFrom].load(std::memory_order_relaxed);
+    channel_counts.bytes_from_framework =
+        channel->bytes[kFrom].load(std::memory_order_relaxed);
+  }
+  return counts;
+}
+
+fml::Histogram::Snapshot EngineMetrics::GetPlatformMessageRoundTrips(
+    Direction direction) const {
+  return round_trips_[static_cast<size_t>(direction)].GetSnapshot();
+}
+
+fml::Histogram::Snapshot EngineMetrics::GetAssetLoads() const {
+  return asset_loads_.GetSnapshot();
+}
+
+}  // namespace flutter
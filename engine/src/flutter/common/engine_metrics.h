@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_ENGINE_METRICS_H_
+#define FLUTTER_COMMON_ENGINE_METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/histogram.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Process-wide counters and latency histograms describing the work done by
+/// all engines in the process.
+///
+/// Metrics are recorded on hot paths, so recording never locks or allocates,
+/// except for the first message on each channel. All methods are
+/// thread-safe.
+class EngineMetrics {
+ public:
+  /// The number of channels whose messages are counted separately, which
+  /// matches the number of channel names the engine interns. Messages on
+  /// channels with larger ids are counted with those on channel 0.
+  static constexpr size_t kMaxChannels = 4096;
+
+  /// The direction in which a platform message is sent.
+  enum class Direction {
+    /// From the platform to the framework.
+    kToFramework,
+    /// From the framework to the platform.
+    kFromFramework,
+  };
+
+  /// The number of messages sent on a channel, and the number of bytes of
+  /// data they carried, in each direction.
+  struct ChannelCounts {
+    uint32_t channel_id = 0;
+    uint64_t messages_to_framework = 0;
+    uint64_t bytes_to_framework = 0;
+    uint64_t messages_from_framework = 0;
+    uint64_t bytes_from_framework = 0;
+  };
+
+  static EngineMetrics& GetInstance();
+
+  /// Counts a message carrying `bytes` bytes sent on the channel with the
+  /// interned id `channel_id`.
+  void RecordChannelMessage(uint32_t channel_id,
+                            Direction direction,
+                            size_t bytes);
+
+  /// Records the time between sending a platform message in `direction` and
+  /// completing its response.
+  void RecordPlatformMessageRoundTrip(Direction direction,
+                                      fml::TimeDelta latency);
+
+  /// Records the time taken to load an asset.
+  void RecordAssetLoad(fml::TimeDelta latency);
+
+  /// Returns the counts of the channels on which messages were sent, ordered
+  /// by channel id.
+  std::vector<ChannelCounts> GetChannelCounts() const;
+
+  /// The platform message round-trip latencies in `direction`, in
+  /// microseconds.
+  fml::Histogram::Snapshot GetPlatformMessageRoundTrips(
+      Direction direction) const;
+
+  /// The asset load latencies, in microseconds.
+  fml::Histogram::Snapshot GetAssetLoads() const;
+
+ private:
+  struct Channel {
+    std::atomic<uint64_t> messages[2] = {};
+    std::atomic<uint64_t> bytes[2] = {};
+  };
+
+  // Allocated when the first message is sent on each channel, and never
+  // freed.
+  std::array<std::atomic<Channel*>, kMaxChannels> channels_ = {};
+  fml::Histogram round_trips_[2];
+  fml::Histogram asset_loads_;
+
+  EngineMetrics();
+
+  ~EngineMetrics();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EngineMetrics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_ENGINE_METRICS_H_
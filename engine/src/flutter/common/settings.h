@@ -157,6 +157,9 @@ struct Settings {
   bool profile_startup = false;
   bool disable_dart_asserts = false;
   bool enable_serial_gc = false;
+  // Pin the UI thread to the fastest cores and the concurrent workers to the
+  // remaining ones, on platforms where |fml::RequestAffinity| is supported.
+  bool enable_cpu_affinity = false;
   bool profile_microtasks = false;
 
   // Whether embedder only allows secure connections.
@@ -25,6 +25,27 @@ std::pair<bool, std::string> Base32Encode(std::string_view input) {
   const size_t encoded_length = (input.size() * 8 + 4) / 5;
   output.reserve(encoded_length);
 
+  // Groups of 5 bytes are encoded into 8 characters at a time, as they end
+  // on a character boundary.
+  const size_t group_count = input.size() / 5;
+  output.resize(group_count * 8);
+  for (size_t group = 0; group < group_count; group++) {
+    const uint8_t* src =
+        reinterpret_cast<const uint8_t*>(input.data()) + group * 5;
+    const uint64_t bits = static_cast<uint64_t>(src[0]) << 32 |
+                          static_cast<uint64_t>(src[1]) << 24 |
+                          static_cast<uint64_t>(src[2]) << 16 |
+                          static_cast<uint64_t>(src[3]) << 8 | src[4];
+    char* dst = output.data() + group * 8;
+    for (int i = 0; i < 8; i++) {
+      dst[i] = kEncoding[(bits >> (35 - i * 5)) & 0x1f];
+    }
+  }
+  input.remove_prefix(group_count * 5);
+  if (input.empty()) {
+    return {true, output};
+  }
+
   Base32EncodeConverter converter;
   converter.Append(static_cast<uint8_t>(input[0]));
   size_t next_byte_index = 1;
@@ -52,10 +73,52 @@ static constexpr signed char kDecodeMap[] = {
 static constexpr int kDecodeMapSize =
     sizeof(kDecodeMap) / sizeof(kDecodeMap[0]);
 
+// The value of each character of the alphabet, or -1.
+static constexpr auto kDecodeTable = [] {
+  struct {
+    signed char values[256] = {};
+  } table;
+  for (int c = 0; c < 256; c++) {
+    const int map_index = c - '2';
+    table.values[c] = map_index >= 0 && map_index < kDecodeMapSize
+                          ? kDecodeMap[map_index]
+                          : -1;
+  }
+  return table;
+}();
+
 std::pair<bool, std::string> Base32Decode(const std::string& input) {
   std::string result;
+  result.reserve(input.size() * 5 / 8);
+  result.resize(input.size() / 8 * 5);
+
+  // Groups of 8 characters are decoded into 5 bytes at a time, as they end
+  // on a byte boundary. The first group with a character that isn't in the
+  // alphabet is left to the loop below, which reports it.
+  size_t decoded = 0;
+  while (input.size() - decoded >= 8) {
+    const uint8_t* src =
+        reinterpret_cast<const uint8_t*>(input.data()) + decoded;
+    uint64_t bits = 0;
+    int invalid = 0;
+    for (int i = 0; i < 8; i++) {
+      const int value = kDecodeTable.values[src[i]];
+      invalid |= value;
+      bits = bits << 5 | (value & 0x1f);
+    }
+    if (invalid < 0) {
+      break;
+    }
+    char* dst = result.data() + decoded / 8 * 5;
+    for (int i = 0; i < 5; i++) {
+      dst[i] = static_cast<char>(bits >> (32 - i * 8));
+    }
+    decoded += 8;
+  }
+  result.resize(decoded / 8 * 5);
+
   Base32DecodeConverter converter;
-  for (char c : input) {
+  for (char c : std::string_view(input).substr(decoded)) {
     int map_index = c - '2';
     if (map_index < 0 || map_index >= kDecodeMapSize ||
         kDecodeMap[map_index] == -1) {
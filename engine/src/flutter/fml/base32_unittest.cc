@@ -91,3 +91,31 @@ TEST(Base32Test, CanDecodeSkSLKeys) {
     ASSERT_EQ(encode_result.second, input);
   }
 }
+
+TEST(Base32Test, CanEncodeDecodeLongStrings) {
+  // Long enough to be encoded and decoded in groups, with a remainder of
+  // every length.
+  for (size_t size = 0; size < 40; size++) {
+    std::string input;
+    for (size_t i = 0; i < size; i++) {
+      input.push_back(static_cast<char>(i * 37 + size));
+    }
+    auto encode_result = fml::Base32Encode(input);
+    ASSERT_TRUE(encode_result.first);
+    ASSERT_EQ(encode_result.second.size(), (size * 8 + 4) / 5);
+    auto decode_result = fml::Base32Decode(encode_result.second);
+    ASSERT_TRUE(decode_result.first);
+    ASSERT_EQ(decode_result.second, input);
+  }
+}
+
+TEST(Base32Test, DecodeReturnsDecodedPrefixForInvalidInput) {
+  // "NBSWY3DP" is "hello".
+  auto decode_result = fml::Base32Decode("NBSWY3DPNBSW1");
+  ASSERT_FALSE(decode_result.first);
+  ASSERT_EQ(decode_result.second, "hellohe");
+
+  decode_result = fml::Base32Decode("NBSWY3DPNBSWY3D1");
+  ASSERT_FALSE(decode_result.first);
+  ASSERT_EQ(decode_result.second, "hellohell");
+}
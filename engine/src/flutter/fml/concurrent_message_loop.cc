@@ -11,12 +11,17 @@
 
 namespace fml {
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
+ConcurrentMessageLoop::ConcurrentMessageLoop(
+    size_t worker_count,
+    std::optional<CpuAffinity> worker_affinity)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
+    workers_.emplace_back([i, worker_affinity, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
+      if (worker_affinity.has_value()) {
+        fml::RequestAffinity(worker_affinity.value());
+      }
       WorkerMain();
     });
   }
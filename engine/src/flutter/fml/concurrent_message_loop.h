@@ -7,10 +7,12 @@
 
 #include <condition_variable>
 #include <map>
+#include <optional>
 #include <queue>
 #include <thread>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -21,8 +23,14 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a loop with `worker_count` worker threads. If
+  ///             `worker_affinity` is set, each worker requests that affinity
+  ///             via |fml::RequestAffinity| before running tasks.
+  ///
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      std::optional<CpuAffinity> worker_affinity = std::nullopt);
 
   virtual ~ConcurrentMessageLoop();
 
@@ -37,7 +45,8 @@ class ConcurrentMessageLoop
   bool RunsTasksOnCurrentThread();
 
  protected:
-  explicit ConcurrentMessageLoop(size_t worker_count);
+  ConcurrentMessageLoop(size_t worker_count,
+                        std::optional<CpuAffinity> worker_affinity);
   virtual void ExecuteTask(const fml::closure& task);
 
  private:
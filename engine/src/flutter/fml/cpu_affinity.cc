@@ -14,11 +14,17 @@
 #include "flutter/fml/platform/android/cpu_affinity.h"
 #endif  // FML_OS_ANDROID
 
+#ifdef FML_OS_LINUX
+#include "flutter/fml/platform/linux/cpu_affinity.h"
+#endif  // FML_OS_LINUX
+
 namespace fml {
 
 std::optional<size_t> EfficiencyCoreCount() {
 #ifdef FML_OS_ANDROID
   return AndroidEfficiencyCoreCount();
+#elif defined(FML_OS_LINUX)
+  return LinuxEfficiencyCoreCount();
 #else
   return std::nullopt;
 #endif
@@ -27,6 +33,8 @@ std::optional<size_t> EfficiencyCoreCount() {
 bool RequestAffinity(CpuAffinity affinity) {
 #ifdef FML_OS_ANDROID
   return AndroidRequestAffinity(affinity);
+#elif defined(FML_OS_LINUX)
+  return LinuxRequestAffinity(affinity);
 #else
   return true;
 #endif
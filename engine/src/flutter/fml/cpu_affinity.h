@@ -43,11 +43,14 @@ std::optional<size_t> EfficiencyCoreCount();
 /// @brief Request the given affinity for the current thread.
 ///
 ///        Returns true if successfull, or if it was a no-op. This function is
-///        only supported on Android devices.
+///        only supported on Android and Linux.
 ///
 ///        Affinity requests are based on documented CPU speed. This speed data
 ///        is parsed from cpuinfo_max_freq files, see also:
 ///        https://www.kernel.org/doc/Documentation/cpu-freq/user-guide.txt
+///
+///        On Linux, requests are additionally confined to the NUMA node the
+///        engine started on, see |LinuxCpuAffinityTracker|.
 bool RequestAffinity(CpuAffinity affinity);
 
 struct CpuIndexAndSpeed {
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/base32.h"
+#include "flutter/fml/hex_codec.h"
+#include "flutter/fml/string_conversion.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+std::string MakeBytes(size_t size) {
+  std::mt19937 random(size);
+  std::string bytes(size, '\0');
+  for (char& byte : bytes) {
+    byte = static_cast<char>(random());
+  }
+  return bytes;
+}
+
+// Text of |size| bytes. If |ascii| is false, a quarter of its words are
+// outside ASCII, as in text in many European languages, and some of those
+// outside the BMP.
+std::string MakeText(size_t size, bool ascii) {
+  const char* const kWords[] = {"The ",  "quick ", "brown ", "fox ", "jumps ",
+                                "over ", "the ",   "lazy ",  "dog. "};
+  const char* const kNonAsciiWords[] = {"\xc3\xa9t\xc3\xa9 ", "\xe2\x98\x83 ",
+                                        "na\xc3\xafve ", "\xf0\x9f\x98\x80 "};
+  std::string text;
+  for (size_t i = 0;; i++) {
+    const char* word =
+        ascii || i % 4 != 0 ? kWords[i % 9] : kNonAsciiWords[i / 4 % 4];
+    if (text.size() + strlen(word) > size) {
+      break;
+    }
+    text += word;
+  }
+  text.resize(size, ' ');
+  return text;
+}
+
+}  // namespace
+
+// The first argument is the size of the input in bytes.
+#define ENCODING_BENCHMARK(name) \
+  BENCHMARK(name)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgNames({"bytes"})
+
+static void BM_HexEncode(benchmark::State& state) {
+  const std::string bytes = MakeBytes(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(HexEncode(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+ENCODING_BENCHMARK(BM_HexEncode);
+
+static void BM_Base32Encode(benchmark::State& state) {
+  const std::string bytes = MakeBytes(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base32Encode(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+ENCODING_BENCHMARK(BM_Base32Encode);
+
+static void BM_Base32Decode(benchmark::State& state) {
+  const std::string text = Base32Encode(MakeBytes(state.range(0))).second;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base32Decode(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+ENCODING_BENCHMARK(BM_Base32Decode);
+
+// The second argument is 1 for ASCII text.
+static void BM_Utf8ToUtf16(benchmark::State& state) {
+  const std::string text = MakeText(state.range(0), state.range(1) == 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Utf8ToUtf16(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Utf8ToUtf16)
+    ->ArgsProduct({{64, 4096, 1 << 20}, {0, 1}})
+    ->ArgNames({"bytes", "ascii"});
+
+static void BM_Utf16ToUtf8(benchmark::State& state) {
+  const std::u16string text =
+      Utf8ToUtf16(MakeText(state.range(0), state.range(1) == 1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Utf16ToUtf8(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size() *
+                          sizeof(char16_t));
+}
+BENCHMARK(BM_Utf16ToUtf8)
+    ->ArgsProduct({{64, 4096, 1 << 20}, {0, 1}})
+    ->ArgNames({"bytes", "ascii"});
+
+}  // namespace benchmarking
+}  // namespace fml
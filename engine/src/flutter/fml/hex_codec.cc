@@ -2,22 +2,70 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include "flutter/fml/base32.h"
+#include "flutter/fml/hex_codec.h"
 
 #include <cstdint>  // uint8_t
 #include <string>
 
+#include "flutter/fml/build_config.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FML_HEX_CODEC_SSE2 1
+#elif defined(FML_ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FML_HEX_CODEC_NEON 1
+#endif
+
 namespace fml {
 
 static constexpr char kEncoding[] = "0123456789abcdef";
 
+#if FML_HEX_CODEC_SSE2 || FML_HEX_CODEC_NEON
+// The number of bytes encoded at a time where vector instructions are
+// available.
+static constexpr size_t kBlockSize = 16;
+#endif
+
 std::string HexEncode(std::string_view input) {
-  std::string result;
-  result.reserve(input.size() * 2);
-  for (char c : input) {
-    uint8_t b = static_cast<uint8_t>(c);
-    result.push_back(kEncoding[b >> 4]);
-    result.push_back(kEncoding[b & 0xF]);
+  std::string result(input.size() * 2, '\0');
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(input.data());
+  char* dst = result.data();
+  size_t i = 0;
+#if FML_HEX_CODEC_SSE2
+  const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+  const __m128i nine = _mm_set1_epi8(9);
+  for (; input.size() - i >= kBlockSize; i += kBlockSize) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(in, 4), nibble_mask);
+    const __m128i low = _mm_and_si128(in, nibble_mask);
+    // Nibbles above 9 are moved from after '9' to 'a'.
+    auto to_digits = [nine](__m128i nibbles) {
+      const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine),
+                                            _mm_set1_epi8('a' - '0' - 10));
+      return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+    };
+    const __m128i high_digits = to_digits(high);
+    const __m128i low_digits = to_digits(low);
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i * 2);
+    _mm_storeu_si128(out, _mm_unpacklo_epi8(high_digits, low_digits));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(high_digits, low_digits));
+  }
+#elif FML_HEX_CODEC_NEON
+  const uint8x16_t table =
+      vld1q_u8(reinterpret_cast<const uint8_t*>(kEncoding));
+  for (; input.size() - i >= kBlockSize; i += kBlockSize) {
+    const uint8x16_t in = vld1q_u8(src + i);
+    uint8x16x2_t out;
+    out.val[0] = vqtbl1q_u8(table, vshrq_n_u8(in, 4));
+    out.val[1] = vqtbl1q_u8(table, vandq_u8(in, vdupq_n_u8(0x0f)));
+    vst2q_u8(reinterpret_cast<uint8_t*>(dst + i * 2), out);
+  }
+#endif
+  for (; i < input.size(); i++) {
+    dst[i * 2] = kEncoding[src[i] >> 4];
+    dst[i * 2 + 1] = kEncoding[src[i] & 0xF];
   }
   return result;
 }
@@ -29,3 +29,17 @@ TEST(HexCodecTest, CanEncode) {
     ASSERT_EQ(result, "fffe0001");
   }
 }
+
+TEST(HexCodecTest, CanEncodeLongInput) {
+  // Long enough to be encoded in blocks where vector instructions are
+  // available, with a remainder.
+  std::string input;
+  std::string expected;
+  for (int i = 0; i < 256 + 7; i++) {
+    input.push_back(static_cast<char>(i));
+    const char* digits = "0123456789abcdef";
+    expected.push_back(digits[(i >> 4) & 0xF]);
+    expected.push_back(digits[i & 0xF]);
+  }
+  ASSERT_EQ(fml::HexEncode(input), expected);
+}
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+// The index of the most significant set bit of `value`, which must not be 0.
+int MostSignificantBit(uint64_t value) {
+  int bit = 0;
+  while (value >>= 1) {
+    bit++;
+  }
+  return bit;
+}
+
+}  // namespace
+
+Histogram::Histogram() : min_(std::numeric_limits<int64_t>::max()) {}
+
+Histogram::~Histogram() = default;
+
+size_t Histogram::GetBucketIndex(int64_t value) {
+  if (value < kSubBuckets) {
+    return value < 0 ? 0 : static_cast<size_t>(value);
+  }
+  const int bit = MostSignificantBit(static_cast<uint64_t>(value));
+  if (bit >= kMaxValueBits) {
+    return kBucketCount - 1;
+  }
+  // Values in [2^bit, 2^(bit + 1)) are split into |kSubBuckets| buckets of
+  // width 2^(bit - kSubBucketBits).
+  const int shift = bit - kSubBucketBits;
+  return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+}
+
+int64_t Histogram::GetBucketUpperBound(size_t index) {
+  FML_DCHECK(index < kBucketCount);
+  if (index < static_cast<size_t>(kSubBuckets)) {
+    return static_cast<int64_t>(index);
+  }
+  if (index == kBucketCount - 1) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  const int shift = static_cast<int>(index / kSubBuckets) - 1;
+  const int64_t sub_bucket = kSubBuckets + index % kSubBuckets;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void Histogram::Record(int64_t value) {
+  value = std::max<int64_t>(value, 0);
+  buckets_[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+  int64_t min = min_.load(std::memory_order_relaxed);
+  while (value < min && !min_.compare_exchange_weak(
+                            min, value, std::memory_order_relaxed)) {
+  }
+  int64_t max = max_.load(std::memory_order_relaxed);
+  while (value > max && !max_.compare_exchange_weak(
+                            max, value, std::memory_order_relaxed)) {
+  }
+  count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::GetSnapshot() const {
+  Snapshot snapshot;
+  snapshot.count = count_.load(std::memory_order_relaxed);
+  if (snapshot.count == 0) {
+    return snapshot;
+  }
+  snapshot.sum = sum_.load(std::memory_order_relaxed);
+  snapshot.min = min_.load(std::memory_order_relaxed);
+  snapshot.max = max_.load(std::memory_order_relaxed);
+  snapshot.buckets.reserve(kBucketCount);
+  for (const auto& bucket : buckets_) {
+    snapshot.buckets.push_back(bucket.load(std::memory_order_relaxed));
+  }
+  return snapshot;
+}
+
+double Histogram::Snapshot::Mean() const {
+  return count == 0 ? 0 : static_cast<double>(sum) / count;
+}
+
+int64_t Histogram::Snapshot::ValueAtPercentile(double percentile) const {
+  uint64_t total = 0;
+  for (uint64_t bucket : buckets) {
+    total += bucket;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(total * percentile / 100.0)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(GetBucketUpperBound(i), max);
+    }
+  }
+  return max;
+}
+
+}  // namespace fml
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_HISTOGRAM_H_
+#define FLUTTER_FML_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// A histogram of non-negative integer values, such as latencies in
+/// microseconds, that can be recorded from any thread without locking.
+///
+/// Like an HDR histogram, values are counted in buckets whose width grows
+/// with the magnitude of the value, so that every value is recorded with a
+/// relative error of at most 1/|kSubBuckets| while the histogram keeps a
+/// small, fixed size. Values of 2^|kMaxValueBits| and above are counted in
+/// an extra, unbounded last bucket.
+class Histogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int64_t kSubBuckets = int64_t{1} << kSubBucketBits;
+  static constexpr int kMaxValueBits = 36;
+  static constexpr size_t kBucketCount =
+      (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets + 1;
+
+  /// A copy of the contents of a histogram at some point in time.
+  ///
+  /// Values recorded while the snapshot was taken may be partially
+  /// reflected, e.g. in the count but not yet in the buckets.
+  struct Snapshot {
+    uint64_t count = 0;
+    int64_t sum = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+    std::vector<uint64_t> buckets;
+
+    double Mean() const;
+
+    /// Returns an upper bound of the value below which `percentile` percent
+    /// of the recorded values lie, or 0 if no values were recorded.
+    int64_t ValueAtPercentile(double percentile) const;
+  };
+
+  Histogram();
+
+  ~Histogram();
+
+  /// Records `value`. Negative values are recorded as 0.
+  void Record(int64_t value);
+
+  Snapshot GetSnapshot() const;
+
+  /// Returns the index of the bucket counting `value`.
+  static size_t GetBucketIndex(int64_t value);
+
+  /// Returns the largest value counted by the bucket at `index`.
+  static int64_t GetBucketUpperBound(size_t index);
+
+ private:
+  std::atomic<uint64_t> count_ = 0;
+  std::atomic<int64_t> sum_ = 0;
+  std::atomic<int64_t> min_;
+  std::atomic<int64_t> max_ = 0;
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_ = {};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Histogram);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_HISTOGRAM_H_
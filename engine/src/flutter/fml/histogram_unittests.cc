@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/histogram.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(HistogramTest, EmptySnapshot) {
+  Histogram histogram;
+  Histogram::Snapshot snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(snapshot.count, 0u);
+  EXPECT_EQ(snapshot.Mean(), 0);
+  EXPECT_EQ(snapshot.ValueAtPercentile(50), 0);
+}
+
+TEST(HistogramTest, BucketsBoundTheRelativeError) {
+  size_t last_index = 0;
+  for (int64_t value : {0ll, 1ll, 15ll, 16ll, 17ll, 31ll, 32ll, 33ll, 1000ll,
+                        123456789ll, (1ll << 36) - 1}) {
+    const size_t index = Histogram::GetBucketIndex(value);
+    EXPECT_GE(index, last_index);
+    EXPECT_LT(index, Histogram::kBucketCount);
+    last_index = index;
+    const int64_t upper_bound = Histogram::GetBucketUpperBound(index);
+    EXPECT_GE(upper_bound, value);
+    EXPECT_LE(upper_bound - value, value / Histogram::kSubBuckets) << value;
+    EXPECT_EQ(Histogram::GetBucketIndex(upper_bound), index) << value;
+    EXPECT_EQ(Histogram::GetBucketIndex(upper_bound + 1), index + 1) << value;
+  }
+  EXPECT_EQ(Histogram::GetBucketIndex(-5), 0u);
+  EXPECT_EQ(Histogram::GetBucketIndex(1ll << 40), Histogram::kBucketCount - 1);
+}
+
+TEST(HistogramTest, ComputesStatistics) {
+  Histogram histogram;
+  for (int64_t value = 1; value <= 1000; value++) {
+    histogram.Record(value);
+  }
+  Histogram::Snapshot snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(snapshot.count, 1000u);
+  EXPECT_EQ(snapshot.min, 1);
+  EXPECT_EQ(snapshot.max, 1000);
+  EXPECT_DOUBLE_EQ(snapshot.Mean(), 500.5);
+  EXPECT_NEAR(snapshot.ValueAtPercentile(50), 500, 500 / 16);
+  EXPECT_NEAR(snapshot.ValueAtPercentile(99), 990, 990 / 16);
+  EXPECT_EQ(snapshot.ValueAtPercentile(100), 1000);
+}
+
+TEST(HistogramTest, CanRecordFromManyThreads) {
+  Histogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&histogram, i] {
+      for (int64_t value = 0; value < 10000; value++) {
+        histogram.Record(value * (i + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  Histogram::Snapshot snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(snapshot.count, 40000u);
+  EXPECT_EQ(snapshot.min, 0);
+  EXPECT_EQ(snapshot.max, 9999 * 4);
+  uint64_t total = 0;
+  for (uint64_t bucket : snapshot.buckets) {
+    total += bucket;
+  }
+  EXPECT_EQ(total, 40000u);
+}
+
+}  // namespace testing
+}  // namespace fml
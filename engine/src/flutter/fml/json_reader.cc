@@ -0,0 +1,729 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/json_reader.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <limits>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FML_JSON_READER_SSE2 1
+#elif defined(FML_ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FML_JSON_READER_NEON 1
+#endif
+
+namespace fml {
+
+namespace {
+
+// The input is scanned 16 bytes at a time where vector instructions are
+// available. These are the two hot loops of the parser: validating the
+// encoding, where almost all of a typical message is ASCII, and finding the
+// end of a string, where almost all of a typical string needs no unescaping.
+constexpr size_t kBlockSize = 16;
+
+// Returns the length of the valid multi-byte UTF-8 sequence at the start of
+// |data|, or 0 if there isn't one.
+size_t ValidUtf8SequenceLength(const uint8_t* data, size_t size) {
+  const uint8_t lead = data[0];
+  size_t length;
+  // The valid range of the second byte, which excludes overlong encodings,
+  // surrogates and code points above U+10FFFF.
+  uint8_t min = 0x80;
+  uint8_t max = 0xbf;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    length = 2;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    length = 3;
+    if (lead == 0xe0) {
+      min = 0xa0;
+    } else if (lead == 0xed) {
+      max = 0x9f;
+    }
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    length = 4;
+    if (lead == 0xf0) {
+      min = 0x90;
+    } else if (lead == 0xf4) {
+      max = 0x8f;
+    }
+  } else {
+    return 0;
+  }
+  if (size < length || data[1] < min || data[1] > max) {
+    return 0;
+  }
+  for (size_t i = 2; i < length; i++) {
+    if ((data[i] & 0xc0) != 0x80) {
+      return 0;
+    }
+  }
+  return length;
+}
+
+// Returns true if the block of |kBlockSize| bytes at |data| is all ASCII.
+bool IsAsciiBlock(const uint8_t* data) {
+#if FML_JSON_READER_SSE2
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  return _mm_movemask_epi8(block) == 0;
+#elif FML_JSON_READER_NEON
+  return vmaxvq_u8(vld1q_u8(data)) < 0x80;
+#else
+  uint64_t words[2];
+  std::memcpy(words, data, sizeof(words));
+  return ((words[0] | words[1]) & 0x8080808080808080u) == 0;
+#endif
+}
+
+bool IsValidUtf8(const uint8_t* data, size_t size) {
+  size_t i = 0;
+  while (i < size) {
+    if (size - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      i += kBlockSize;
+      continue;
+    }
+    // Validate at least a block's worth of bytes one at a time before
+    // trying the fast path again.
+    const size_t block_end = std::min(size, i + kBlockSize);
+    while (i < block_end) {
+      if (data[i] < 0x80) {
+        i++;
+        continue;
+      }
+      const size_t length = ValidUtf8SequenceLength(data + i, size - i);
+      if (length == 0) {
+        return false;
+      }
+      i += length;
+    }
+  }
+  return true;
+}
+
+// Returns true for the characters that end a run of string contents that can
+// be copied verbatim: the closing quote, the start of an escape sequence, and
+// the control characters, which are not allowed in strings.
+bool IsStringSpecial(uint8_t c) {
+  return c == '"' || c == '\\' || c < 0x20;
+}
+
+// Returns the offset of the first special character in the |size| bytes at
+// |data|, or |size| if there is none.
+size_t FindStringSpecial(const uint8_t* data, size_t size) {
+  size_t i = 0;
+#if FML_JSON_READER_SSE2
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i max_control = _mm_set1_epi8(0x1f);
+  for (; size - i >= kBlockSize; i += kBlockSize) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // A byte is a control character if it is unchanged by an unsigned
+    // minimum with 0x1f.
+    const __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(block, quote),
+                     _mm_cmpeq_epi8(block, backslash)),
+        _mm_cmpeq_epi8(_mm_min_epu8(block, max_control), block));
+    const int mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#elif FML_JSON_READER_NEON
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t max_control = vdupq_n_u8(0x1f);
+  for (; size - i >= kBlockSize; i += kBlockSize) {
+    const uint8x16_t block = vld1q_u8(data + i);
+    const uint8x16_t special =
+        vorrq_u8(vorrq_u8(vceqq_u8(block, quote), vceqq_u8(block, backslash)),
+                 vcleq_u8(block, max_control));
+    if (vmaxvq_u8(special) != 0) {
+      break;
+    }
+  }
+#endif
+  while (i < size && !IsStringSpecial(data[i])) {
+    i++;
+  }
+  return i;
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Returns the value of a hexadecimal digit, or -1.
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+void AppendUtf8(std::string* output, uint32_t code_point) {
+  if (code_point < 0x80) {
+    output->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    output->push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else if (code_point < 0x10000) {
+    output->push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else {
+    output->push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  }
+}
+
+}  // namespace
+
+// Builds the tape of a |JsonDocument|.
+//
+// Nesting is tracked on an explicit stack rather than by recursion, so deeply
+// nested input cannot overflow the native stack.
+class JsonParser {
+ public:
+  JsonParser(JsonDocument* document, const char* data, size_t size)
+      : document_(document),
+        tape_(document->tape_),
+        data_(data),
+        size_(size) {}
+
+  JsonParseStatus Parse() {
+    if (size_ > std::numeric_limits<uint32_t>::max()) {
+      return JsonParseStatus::kInvalidJson;
+    }
+    if (!IsValidUtf8(reinterpret_cast<const uint8_t*>(data_), size_)) {
+      return JsonParseStatus::kInvalidUtf8;
+    }
+    return ParseValues() ? JsonParseStatus::kOk
+                         : JsonParseStatus::kInvalidJson;
+  }
+
+ private:
+  using Tag = JsonDocument::Tag;
+
+  // The number of decimal digits that always fit in a uint64_t.
+  static constexpr size_t kMaxMantissaDigits = 19;
+
+  bool ParseValues() {
+    std::vector<size_t>& open = document_->open_containers_;
+    bool need_value = true;
+    while (true) {
+      if (need_value) {
+        SkipWhitespace();
+        if (pos_ >= size_) {
+          return false;
+        }
+        const char c = data_[pos_];
+        if (c == '[' || c == '{') {
+          const bool object = c == '{';
+          pos_++;
+          open.push_back(tape_.size());
+          Emit(object ? Tag::kStartObject : Tag::kStartArray, 0, 0);
+          SkipWhitespace();
+          if (!Consume(object ? '}' : ']')) {
+            if (object && !ParseKey()) {
+              return false;
+            }
+            continue;
+          }
+          CloseContainer();
+        } else if (!ParseScalar()) {
+          return false;
+        }
+      }
+
+      // A value is complete; see what follows it.
+      if (open.empty()) {
+        SkipWhitespace();
+        return pos_ == size_;
+      }
+      const size_t start = open.back();
+      const bool object = document_->TagAt(start) == Tag::kStartObject;
+      tape_[start + 1]++;
+      SkipWhitespace();
+      if (Consume(',')) {
+        if (object && !ParseKey()) {
+          return false;
+        }
+        need_value = true;
+      } else if (Consume(object ? '}' : ']')) {
+        CloseContainer();
+        need_value = false;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  void CloseContainer() {
+    std::vector<size_t>& open = document_->open_containers_;
+    const size_t start = open.back();
+    open.pop_back();
+    const Tag end_tag = document_->TagAt(start) == Tag::kStartObject
+                            ? Tag::kEndObject
+                            : Tag::kEndArray;
+    tape_[start] |= tape_.size();
+    tape_.push_back(JsonDocument::MakeWord(end_tag, start));
+  }
+
+  bool ParseKey() {
+    SkipWhitespace();
+    if (!Consume('"') || !ParseString(Tag::kKey)) {
+      return false;
+    }
+    SkipWhitespace();
+    return Consume(':');
+  }
+
+  bool ParseScalar() {
+    switch (data_[pos_]) {
+      case '"':
+        pos_++;
+        return ParseString(Tag::kString);
+      case 'n':
+        return ParseLiteral("null", Tag::kNull);
+      case 't':
+        return ParseLiteral("true", Tag::kTrue);
+      case 'f':
+        return ParseLiteral("false", Tag::kFalse);
+      default:
+        return ParseNumber();
+    }
+  }
+
+  bool ParseLiteral(std::string_view literal, Tag tag) {
+    if (size_ - pos_ < literal.size() ||
+        std::memcmp(data_ + pos_, literal.data(), literal.size()) != 0) {
+      return false;
+    }
+    pos_ += literal.size();
+    tape_.push_back(JsonDocument::MakeWord(tag, 0));
+    return true;
+  }
+
+  // Parses the contents of a string after its opening quote.
+  bool ParseString(Tag tag) {
+    const size_t start = pos_;
+    pos_ += FindStringSpecial(Bytes() + pos_, size_ - pos_);
+    if (pos_ < size_ && data_[pos_] == '"') {
+      // The common case: the contents can be used in place.
+      Emit(tag, start, pos_ - start);
+      pos_++;
+      return true;
+    }
+
+    // Unescape the contents into the document.
+    std::string& strings = document_->strings_;
+    const size_t offset = strings.size();
+    strings.append(data_ + start, pos_ - start);
+    while (true) {
+      if (pos_ >= size_) {
+        return false;
+      }
+      const char c = data_[pos_];
+      if (c == '"') {
+        pos_++;
+        break;
+      }
+      if (c != '\\' || !ParseEscape(&strings)) {
+        // A control character, or an invalid escape sequence.
+        return false;
+      }
+      const size_t run = FindStringSpecial(Bytes() + pos_, size_ - pos_);
+      strings.append(data_ + pos_, run);
+      pos_ += run;
+    }
+    Emit(tag, offset | JsonDocument::kEscapedBit, strings.size() - offset);
+    return true;
+  }
+
+  // Parses the escape sequence starting at the backslash at |pos_|.
+  bool ParseEscape(std::string* output) {
+    pos_++;
+    if (pos_ >= size_) {
+      return false;
+    }
+    const char c = data_[pos_++];
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        output->push_back(c);
+        return true;
+      case 'b':
+        output->push_back('\b');
+        return true;
+      case 'f':
+        output->push_back('\f');
+        return true;
+      case 'n':
+        output->push_back('\n');
+        return true;
+      case 'r':
+        output->push_back('\r');
+        return true;
+      case 't':
+        output->push_back('\t');
+        return true;
+      case 'u':
+        break;
+      default:
+        return false;
+    }
+
+    uint32_t code_point;
+    if (!ParseHex4(&code_point)) {
+      return false;
+    }
+    if (code_point >= 0xdc00 && code_point <= 0xdfff) {
+      // A low surrogate without a high surrogate.
+      return false;
+    }
+    if (code_point >= 0xd800 && code_point <= 0xdbff) {
+      uint32_t low;
+      if (!Consume('\\') || !Consume('u') || !ParseHex4(&low) ||
+          low < 0xdc00 || low > 0xdfff) {
+        return false;
+      }
+      code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+    }
+    AppendUtf8(output, code_point);
+    return true;
+  }
+
+  bool ParseHex4(uint32_t* value) {
+    if (size_ - pos_ < 4) {
+      return false;
+    }
+    *value = 0;
+    for (size_t i = 0; i < 4; i++) {
+      const int digit = HexValue(data_[pos_ + i]);
+      if (digit < 0) {
+        return false;
+      }
+      *value = (*value << 4) | digit;
+    }
+    pos_ += 4;
+    return true;
+  }
+
+  bool ParseNumber() {
+    const size_t start = pos_;
+    const bool negative = Consume('-');
+
+    // The significant digits are accumulated into |mantissa| as they are
+    // read, so that integers and short decimals need no second pass. The
+    // number is |mantissa| * 10^|exponent|, unless |exact| is false because
+    // non-zero digits had to be dropped.
+    uint64_t mantissa = 0;
+    size_t mantissa_digits = 0;
+    int64_t exponent = 0;
+    bool exact = true;
+    auto accumulate_digit = [&]() {
+      const uint64_t digit = data_[pos_++] - '0';
+      if (mantissa_digits < kMaxMantissaDigits) {
+        mantissa = mantissa * 10 + digit;
+        // Leading zeros of a fraction do not use up the precision.
+        mantissa_digits += mantissa != 0;
+        return true;
+      }
+      exact &= digit == 0;
+      return false;
+    };
+
+    if (Consume('0')) {
+      // Leading zeros are not allowed.
+    } else if (pos_ < size_ && IsDigit(data_[pos_])) {
+      while (pos_ < size_ && IsDigit(data_[pos_])) {
+        if (!accumulate_digit()) {
+          exponent++;
+        }
+      }
+    } else {
+      return false;
+    }
+
+    bool integer = true;
+    if (Consume('.')) {
+      integer = false;
+      if (pos_ >= size_ || !IsDigit(data_[pos_])) {
+        return false;
+      }
+      while (pos_ < size_ && IsDigit(data_[pos_])) {
+        if (accumulate_digit()) {
+          exponent--;
+        }
+      }
+    }
+    if (Consume('e') || Consume('E')) {
+      integer = false;
+      const bool negative_exponent = Consume('-');
+      if (!negative_exponent) {
+        Consume('+');
+      }
+      if (pos_ >= size_ || !IsDigit(data_[pos_])) {
+        return false;
+      }
+      int64_t explicit_exponent = 0;
+      while (pos_ < size_ && IsDigit(data_[pos_])) {
+        // Saturate; anything this large is out of range anyway.
+        explicit_exponent = std::min<int64_t>(
+            explicit_exponent * 10 + (data_[pos_++] - '0'), 1 << 20);
+      }
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (integer && exponent <= 1) {
+      uint64_t value = mantissa;
+      bool fits = true;
+      if (exponent == 1) {
+        // Twenty digits, which may still fit in a uint64_t.
+        const uint64_t digit = data_[pos_ - 1] - '0';
+        fits = mantissa <= (std::numeric_limits<uint64_t>::max() - digit) / 10;
+        value = mantissa * 10 + digit;
+      }
+      constexpr uint64_t kInt64Max = std::numeric_limits<int64_t>::max();
+      if (fits && !negative) {
+        Emit(value <= kInt64Max ? Tag::kInt64 : Tag::kUint64, 0, value);
+        return true;
+      }
+      if (fits && value <= kInt64Max + 1) {
+        Emit(Tag::kInt64, 0, ~value + 1);
+        return true;
+      }
+    }
+
+    double result = 0.0;
+#if FLT_EVAL_METHOD == 0
+    // Clinger's fast path: both the mantissa and the power of ten are exact
+    // doubles, so a single multiplication or division rounds correctly.
+    static constexpr double kPowersOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int64_t kMaxExactPowerOfTen = 22;
+    if (exact && mantissa <= (uint64_t{1} << 53) &&
+        exponent >= -kMaxExactPowerOfTen && exponent <= kMaxExactPowerOfTen) {
+      result = static_cast<double>(mantissa);
+      result = exponent < 0 ? result / kPowersOfTen[-exponent]
+                            : result * kPowersOfTen[exponent];
+      EmitDouble(negative ? -result : result);
+      return true;
+    }
+#endif  // FLT_EVAL_METHOD == 0
+
+    // Everything else is converted with correct rounding, independent of the
+    // current locale.
+    const std::from_chars_result converted =
+        std::from_chars(data_ + start, data_ + pos_, result);
+    if (converted.ec == std::errc::result_out_of_range) {
+      // Underflow rounds to zero, while overflow is an error, as in rapidjson.
+      if (static_cast<int64_t>(mantissa_digits) + exponent > 0) {
+        return false;
+      }
+      result = negative ? -0.0 : 0.0;
+    } else if (converted.ec != std::errc() || converted.ptr != data_ + pos_) {
+      return false;
+    }
+    EmitDouble(result);
+    return true;
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < size_) {
+      const char c = data_[pos_];
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+        return;
+      }
+      pos_++;
+    }
+  }
+
+  bool Consume(char c) {
+    if (pos_ < size_ && data_[pos_] == c) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  void Emit(Tag tag, uint64_t payload, uint64_t second_word) {
+    tape_.push_back(JsonDocument::MakeWord(tag, payload));
+    tape_.push_back(second_word);
+  }
+
+  void EmitDouble(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Emit(Tag::kDouble, 0, bits);
+  }
+
+  const uint8_t* Bytes() const {
+    return reinterpret_cast<const uint8_t*>(data_);
+  }
+
+  JsonDocument* document_;
+  std::vector<uint64_t>& tape_;
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+JsonDocument::JsonDocument() = default;
+
+JsonDocument::~JsonDocument() = default;
+
+JsonParseStatus JsonDocument::Parse(const char* data, size_t size) {
+  data_ = data;
+  tape_.clear();
+  strings_.clear();
+  open_containers_.clear();
+  // Typical messages need about one word of tape for every four bytes.
+  tape_.reserve(size / 4 + 2);
+  JsonParseStatus status = JsonParser(this, data, size).Parse();
+  if (status != JsonParseStatus::kOk) {
+    tape_.clear();
+  }
+  return status;
+}
+
+size_t JsonDocument::NextIndex(size_t index) const {
+  switch (TagAt(index)) {
+    case kNull:
+    case kTrue:
+    case kFalse:
+    case kEndArray:
+    case kEndObject:
+      return index + 1;
+    case kStartArray:
+    case kStartObject:
+      return PayloadAt(index) + 1;
+    default:
+      return index + 2;
+  }
+}
+
+JsonType JsonValue::GetType() const {
+  switch (document_->TagAt(index_)) {
+    case JsonDocument::kNull:
+      return JsonType::kNull;
+    case JsonDocument::kTrue:
+    case JsonDocument::kFalse:
+      return JsonType::kBool;
+    case JsonDocument::kInt64:
+      return JsonType::kInt64;
+    case JsonDocument::kUint64:
+      return JsonType::kUint64;
+    case JsonDocument::kDouble:
+      return JsonType::kDouble;
+    case JsonDocument::kStartArray:
+      return JsonType::kArray;
+    case JsonDocument::kStartObject:
+      return JsonType::kObject;
+    default:
+      return JsonType::kString;
+  }
+}
+
+bool JsonValue::IsNumber() const {
+  const JsonType type = GetType();
+  return type == JsonType::kInt64 || type == JsonType::kUint64 ||
+         type == JsonType::kDouble;
+}
+
+bool JsonValue::GetBool() const {
+  FML_DCHECK(IsBool());
+  return document_->TagAt(index_) == JsonDocument::kTrue;
+}
+
+int64_t JsonValue::GetInt64() const {
+  FML_DCHECK(IsInt64());
+  return static_cast<int64_t>(document_->tape_[index_ + 1]);
+}
+
+uint64_t JsonValue::GetUint64() const {
+  FML_DCHECK(GetType() == JsonType::kUint64);
+  return document_->tape_[index_ + 1];
+}
+
+double JsonValue::GetDouble() const {
+  FML_DCHECK(IsNumber());
+  const uint64_t bits = document_->tape_[index_ + 1];
+  switch (document_->TagAt(index_)) {
+    case JsonDocument::kInt64:
+      return static_cast<double>(static_cast<int64_t>(bits));
+    case JsonDocument::kUint64:
+      return static_cast<double>(bits);
+    default: {
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+  }
+}
+
+std::string_view JsonValue::GetString() const {
+  FML_DCHECK(IsString());
+  return std::string_view(document_->StringAt(index_),
+                          document_->tape_[index_ + 1]);
+}
+
+size_t JsonValue::Size() const {
+  FML_DCHECK(IsArray() || IsObject());
+  return document_->tape_[index_ + 1];
+}
+
+std::optional<JsonValue> JsonValue::Find(std::string_view key) const {
+  FML_DCHECK(IsObject());
+  for (Iterator it = begin(); it != end(); ++it) {
+    if (it.key() == key) {
+      return *it;
+    }
+  }
+  return std::nullopt;
+}
+
+JsonValue::Iterator JsonValue::begin() const {
+  FML_DCHECK(IsArray() || IsObject());
+  return Iterator(document_, index_ + 2, IsObject());
+}
+
+JsonValue::Iterator JsonValue::end() const {
+  FML_DCHECK(IsArray() || IsObject());
+  return Iterator(document_, document_->PayloadAt(index_), IsObject());
+}
+
+JsonValue JsonValue::Iterator::operator*() const {
+  return JsonValue(document_, object_ ? index_ + 2 : index_);
+}
+
+std::string_view JsonValue::Iterator::key() const {
+  FML_DCHECK(object_);
+  return std::string_view(document_->StringAt(index_),
+                          document_->tape_[index_ + 1]);
+}
+
+JsonValue::Iterator& JsonValue::Iterator::operator++() {
+  index_ = document_->NextIndex(object_ ? index_ + 2 : index_);
+  return *this;
+}
+
+}  // namespace fml
@@ -0,0 +1,317 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_JSON_READER_H_
+#define FLUTTER_FML_JSON_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+enum class JsonType {
+  kNull,
+  kBool,
+  // An integer that fits in an int64_t.
+  kInt64,
+  // A positive integer that only fits in a uint64_t.
+  kUint64,
+  // Any other number.
+  kDouble,
+  kString,
+  kArray,
+  kObject,
+};
+
+enum class JsonParseStatus {
+  kOk,
+  // The input is not valid UTF-8.
+  kInvalidUtf8,
+  // The input is valid UTF-8 but not a single valid JSON value.
+  kInvalidJson,
+};
+
+class JsonDocument;
+
+/// A handle to a value in a parsed |JsonDocument|.
+///
+/// Values are only valid while the document that produced them is alive and
+/// has not been reused to parse another message.
+class JsonValue {
+ public:
+  class Iterator;
+
+  JsonType GetType() const;
+
+  bool IsNull() const { return GetType() == JsonType::kNull; }
+  bool IsBool() const { return GetType() == JsonType::kBool; }
+  bool IsInt64() const { return GetType() == JsonType::kInt64; }
+  bool IsNumber() const;
+  bool IsString() const { return GetType() == JsonType::kString; }
+  bool IsArray() const { return GetType() == JsonType::kArray; }
+  bool IsObject() const { return GetType() == JsonType::kObject; }
+
+  /// The value of a |JsonType::kBool|.
+  bool GetBool() const;
+
+  /// The value of a |JsonType::kInt64|.
+  int64_t GetInt64() const;
+
+  /// The value of a |JsonType::kUint64|.
+  uint64_t GetUint64() const;
+
+  /// The value of any number, converted to a double if it is an integer.
+  double GetDouble() const;
+
+  /// The unescaped contents of a |JsonType::kString|.
+  ///
+  /// Strings without escape sequences point directly into the parsed input.
+  std::string_view GetString() const;
+
+  /// The number of elements of an array or members of an object.
+  size_t Size() const;
+
+  /// Returns the value of the first member of an object named `key`, if any.
+  std::optional<JsonValue> Find(std::string_view key) const;
+
+  /// Iterates over the elements of an array or the members of an object.
+  Iterator begin() const;
+  Iterator end() const;
+
+ private:
+  friend class JsonDocument;
+
+  JsonValue(const JsonDocument* document, size_t index)
+      : document_(document), index_(index) {}
+
+  const JsonDocument* document_;
+  // The index of the value in the tape of |document_|.
+  size_t index_;
+};
+
+class JsonValue::Iterator {
+ public:
+  /// The current element of an array, or value of the current member of an
+  /// object.
+  JsonValue operator*() const;
+
+  /// The key of the current member of an object.
+  std::string_view key() const;
+
+  Iterator& operator++();
+
+  bool operator==(const Iterator& other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+ private:
+  friend class JsonValue;
+
+  Iterator(const JsonDocument* document, size_t index, bool object)
+      : document_(document), index_(index), object_(object) {}
+
+  const JsonDocument* document_;
+  size_t index_;
+  bool object_;
+};
+
+/// A JSON document parsed into a flat array of tokens, the "tape".
+///
+/// Parsing validates the whole input up front and allocates only for the
+/// tape, for strings containing escape sequences and for the nesting stack,
+/// whose capacity is reused when the document is. Values are then read on
+/// demand through |JsonValue| handles, or replayed to a SAX-style handler
+/// with |Accept|.
+///
+/// Strings are not copied out of the input unless they contain escape
+/// sequences, so the input must outlive the document.
+class JsonDocument {
+ public:
+  JsonDocument();
+
+  ~JsonDocument();
+
+  /// Parses `size` bytes at `data` as UTF-8 encoded JSON text containing a
+  /// single value, discarding the result of any previous parse.
+  JsonParseStatus Parse(const char* data, size_t size);
+
+  JsonParseStatus Parse(std::string_view text) {
+    return Parse(text.data(), text.size());
+  }
+
+  /// The top level value. Only valid after a successful |Parse|.
+  JsonValue GetRoot() const {
+    FML_DCHECK(!tape_.empty());
+    return JsonValue(this, 0);
+  }
+
+  /// Replays the document to `handler` in document order.
+  ///
+  /// The handler implements the subset of the rapidjson SAX interface that
+  /// is needed to rebuild the document:
+  ///
+  ///   bool Null();
+  ///   bool Bool(bool value);
+  ///   bool Int64(int64_t value);
+  ///   bool Uint64(uint64_t value);  // Only for values above INT64_MAX.
+  ///   bool Double(double value);
+  ///   bool String(const char* string, uint32_t length, bool copy);
+  ///   bool StartObject();
+  ///   bool Key(const char* string, uint32_t length, bool copy);
+  ///   bool EndObject(uint32_t member_count);
+  ///   bool StartArray();
+  ///   bool EndArray(uint32_t element_count);
+  ///
+  /// so a rapidjson::Document can be built with |Populate|. Strings are
+  /// passed with `copy` set, since they are not null terminated. The walk is
+  /// not recursive, so documents of any depth can be replayed.
+  ///
+  /// Returns false as soon as a handler method does.
+  template <typename Handler>
+  bool Accept(Handler& handler) const;
+
+ private:
+  friend class JsonValue;
+  friend class JsonValue::Iterator;
+  friend class JsonParser;
+
+  // Each value is one or two words of the tape. The first word holds the tag
+  // in its top byte and a payload in the rest:
+  //
+  //  * kNull, kTrue, kFalse: no payload, no second word.
+  //  * kInt64, kUint64, kDouble: no payload; the second word holds the bits
+  //    of the number.
+  //  * kString, kKey: the offset of the contents in the input, or in
+  //    |strings_| if |kEscapedBit| is set; the second word holds the
+  //    length.
+  //  * kStartArray, kStartObject: the index of the matching end word; the
+  //    second word holds the number of elements or members.
+  //  * kEndArray, kEndObject: the index of the matching start word.
+  //
+  // Object members are a kKey followed by the value.
+  enum Tag : uint8_t {
+    kNull,
+    kTrue,
+    kFalse,
+    kInt64,
+    kUint64,
+    kDouble,
+    kString,
+    kKey,
+    kStartArray,
+    kEndArray,
+    kStartObject,
+    kEndObject,
+  };
+
+  static constexpr int kTagShift = 56;
+  static constexpr uint64_t kPayloadMask = (uint64_t{1} << kTagShift) - 1;
+  static constexpr uint64_t kEscapedBit = uint64_t{1} << (kTagShift - 1);
+
+  static uint64_t MakeWord(Tag tag, uint64_t payload) {
+    return (static_cast<uint64_t>(tag) << kTagShift) | payload;
+  }
+
+  Tag TagAt(size_t index) const {
+    return static_cast<Tag>(tape_[index] >> kTagShift);
+  }
+
+  uint64_t PayloadAt(size_t index) const {
+    return tape_[index] & kPayloadMask;
+  }
+
+  // The contents of the string or key at |index|.
+  const char* StringAt(size_t index) const {
+    const uint64_t payload = PayloadAt(index);
+    if (payload & kEscapedBit) {
+      return strings_.data() + (payload & ~kEscapedBit);
+    }
+    return data_ + payload;
+  }
+
+  // The index of the value following the one at |index|.
+  size_t NextIndex(size_t index) const;
+
+  const char* data_ = nullptr;
+  std::vector<uint64_t> tape_;
+  // The unescaped contents of strings containing escape sequences.
+  std::string strings_;
+  // The indices of the start words of the open containers while parsing.
+  std::vector<size_t> open_containers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(JsonDocument);
+};
+
+template <typename Handler>
+bool JsonDocument::Accept(Handler& handler) const {
+  for (size_t i = 0; i < tape_.size(); i++) {
+    bool result = true;
+    switch (TagAt(i)) {
+      case kNull:
+        result = handler.Null();
+        break;
+      case kTrue:
+        result = handler.Bool(true);
+        break;
+      case kFalse:
+        result = handler.Bool(false);
+        break;
+      case kInt64:
+        result = handler.Int64(static_cast<int64_t>(tape_[++i]));
+        break;
+      case kUint64:
+        result = handler.Uint64(tape_[++i]);
+        break;
+      case kDouble: {
+        double value;
+        std::memcpy(&value, &tape_[++i], sizeof(value));
+        result = handler.Double(value);
+        break;
+      }
+      case kString:
+        result = handler.String(StringAt(i),
+                                static_cast<uint32_t>(tape_[i + 1]), true);
+        i++;
+        break;
+      case kKey:
+        result =
+            handler.Key(StringAt(i), static_cast<uint32_t>(tape_[i + 1]), true);
+        i++;
+        break;
+      case kStartArray:
+        result = handler.StartArray();
+        i++;
+        break;
+      case kEndArray:
+        result = handler.EndArray(
+            static_cast<uint32_t>(tape_[PayloadAt(i) + 1]));
+        break;
+      case kStartObject:
+        result = handler.StartObject();
+        i++;
+        break;
+      case kEndObject:
+        result = handler.EndObject(
+            static_cast<uint32_t>(tape_[PayloadAt(i) + 1]));
+        break;
+    }
+    if (!result) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_JSON_READER_H_
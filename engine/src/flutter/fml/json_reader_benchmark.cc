@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/json_reader.h"
+
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "rapidjson/document.h"
+#include "rapidjson/reader.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// Payloads resembling the JSON messages sent over the engine's channels.
+enum Payload {
+  // flutter/keyevent on Linux.
+  kKeyEvent,
+  // TextInputClient.updateEditingState on flutter/textinput.
+  kEditingState,
+  // setLocale on flutter/localization, for a user with many locales.
+  kLocales,
+  // A large reply, such as a list of records from a plugin, with some
+  // escaped strings.
+  kRecords,
+};
+
+std::string MakePayload(Payload payload) {
+  switch (payload) {
+    case kKeyEvent:
+      return R"({"type":"keydown","keymap":"linux","toolkit":"gtk",)"
+             R"("scanCode":38,"keyCode":65,"modifiers":0,)"
+             R"("unicodeScalarValues":97,"specifiedLogicalKey":0})";
+    case kEditingState:
+      return R"({"method":"TextInputClient.updateEditingState","args":[1,)"
+             R"({"text":"The quick brown fox jumps over the lazy dog",)"
+             R"("selectionBase":43,"selectionExtent":43,)"
+             R"("selectionAffinity":"TextAffinity.downstream",)"
+             R"("selectionIsDirectional":false,"composingBase":-1,)"
+             R"("composingExtent":-1}]})";
+    case kLocales: {
+      std::string text = R"({"method":"setLocale","args":[)";
+      const char* languages[] = {"en", "fr", "de", "es", "pt", "ja", "zh"};
+      for (size_t i = 0; i < 7; i++) {
+        text += i == 0 ? "" : ",";
+        text += std::string("\"") + languages[i] + R"(","","","")";
+      }
+      return text + "]}";
+    }
+    case kRecords: {
+      std::string text = "[";
+      for (size_t i = 0; i < 256; i++) {
+        text += i == 0 ? "" : ",";
+        text += R"({"id":)" + std::to_string(i) + R"(,"title":"Record )" +
+                std::to_string(i) + R"(","path":"C:\\Users\\flutter\\)" +
+                std::to_string(i) + R"(.txt","size":)" +
+                std::to_string(i * 1024) + R"(,"ratio":)" +
+                std::to_string(i / 7.0) + R"(,"hidden":false,"tags":[]})";
+      }
+      return text + "]";
+    }
+  }
+  FML_UNREACHABLE();
+}
+
+const char* kPayloadNames[] = {"key_event", "editing_state", "locales",
+                               "records"};
+
+// A SAX handler that discards everything, to measure only the parsers.
+using NullHandler = rapidjson::BaseReaderHandler<rapidjson::UTF8<>>;
+
+}  // namespace
+
+// The first argument selects the payload.
+#define JSON_BENCHMARK(name)                                                 \
+  BENCHMARK(name)->DenseRange(kKeyEvent, kRecords)->ArgNames({"payload"})
+
+// What the C++ client wrapper's JsonMessageCodec did before it validated
+// UTF-8.
+static void BM_JsonRapidJsonDocument(benchmark::State& state) {
+  const std::string text = MakePayload(static_cast<Payload>(state.range(0)));
+  for (auto _ : state) {
+    rapidjson::Document document;
+    document.Parse(text.data(), text.size());
+    benchmark::DoNotOptimize(document.HasParseError());
+  }
+  state.SetLabel(kPayloadNames[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+JSON_BENCHMARK(BM_JsonRapidJsonDocument);
+
+// What JsonMessageCodec does now.
+static void BM_JsonRapidJsonDocumentValidated(benchmark::State& state) {
+  const std::string text = MakePayload(static_cast<Payload>(state.range(0)));
+  for (auto _ : state) {
+    rapidjson::Document document;
+    document.Parse<rapidjson::kParseValidateEncodingFlag>(text.data(),
+                                                          text.size());
+    benchmark::DoNotOptimize(document.HasParseError());
+  }
+  state.SetLabel(kPayloadNames[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+JSON_BENCHMARK(BM_JsonRapidJsonDocumentValidated);
+
+// Building a rapidjson DOM from the tape, which JsonMessageCodec does not do
+// because it is slower than parsing straight into the DOM.
+static void BM_JsonTapeToRapidJsonDocument(benchmark::State& state) {
+  const std::string text = MakePayload(static_cast<Payload>(state.range(0)));
+  for (auto _ : state) {
+    JsonDocument tape;
+    benchmark::DoNotOptimize(tape.Parse(text));
+    rapidjson::Document document;
+    auto generator = [&tape](auto& handler) { return tape.Accept(handler); };
+    document.Populate(generator);
+    benchmark::DoNotOptimize(document.IsObject());
+  }
+  state.SetLabel(kPayloadNames[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+JSON_BENCHMARK(BM_JsonTapeToRapidJsonDocument);
+
+// What the Linux shell's FlJsonMessageCodec did before the tape reader.
+static void BM_JsonRapidJsonSax(benchmark::State& state) {
+  const std::string text = MakePayload(static_cast<Payload>(state.range(0)));
+  for (auto _ : state) {
+    NullHandler handler;
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream stream(text.data(), text.size());
+    benchmark::DoNotOptimize(reader.Parse(stream, handler));
+  }
+  state.SetLabel(kPayloadNames[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+JSON_BENCHMARK(BM_JsonRapidJsonSax);
+
+// What FlJsonMessageCodec does now.
+static void BM_JsonTapeSax(benchmark::State& state) {
+  const std::string text = MakePayload(static_cast<Payload>(state.range(0)));
+  for (auto _ : state) {
+    NullHandler handler;
+    JsonDocument document;
+    benchmark::DoNotOptimize(document.Parse(text));
+    benchmark::DoNotOptimize(document.Accept(handler));
+  }
+  state.SetLabel(kPayloadNames[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+JSON_BENCHMARK(BM_JsonTapeSax);
+
+// Looking up the method of a message, as the engine does for
+// flutter/localization.
+static void BM_JsonRapidJsonFindMember(benchmark::State& state) {
+  const std::string text = MakePayload(kLocales);
+  for (auto _ : state) {
+    rapidjson::Document document;
+    document.Parse(text.data(), text.size());
+    auto method = document.FindMember("method");
+    benchmark::DoNotOptimize(method->value == "setLocale");
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_JsonRapidJsonFindMember);
+
+static void BM_JsonTapeFind(benchmark::State& state) {
+  const std::string text = MakePayload(kLocales);
+  for (auto _ : state) {
+    JsonDocument document;
+    document.Parse(text);
+    std::optional<JsonValue> method = document.GetRoot().Find("method");
+    benchmark::DoNotOptimize(method->GetString() == "setLocale");
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_JsonTapeFind);
+
+// Parsing alone, reusing the document's buffers as a long-lived decoder
+// could.
+static void BM_JsonTapeParseReused(benchmark::State& state) {
+  const std::string text = MakePayload(static_cast<Payload>(state.range(0)));
+  JsonDocument document;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(document.Parse(text));
+  }
+  state.SetLabel(kPayloadNames[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+JSON_BENCHMARK(BM_JsonTapeParseReused);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,245 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/json_reader.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+// Writes the events of |JsonDocument::Accept| in a compact notation.
+struct RecordingHandler {
+  std::string events;
+
+  bool Null() { return Add("null"); }
+  bool Bool(bool value) { return Add(value ? "true" : "false"); }
+  bool Int64(int64_t value) { return Add("i" + std::to_string(value)); }
+  bool Uint64(uint64_t value) { return Add("u" + std::to_string(value)); }
+  bool Double(double value) { return Add("d" + std::to_string(value)); }
+  bool String(const char* string, uint32_t length, bool copy) {
+    return Add("\"" + std::string(string, length) + "\"");
+  }
+  bool StartObject() { return Add("{"); }
+  bool Key(const char* string, uint32_t length, bool copy) {
+    return Add("k" + std::string(string, length));
+  }
+  bool EndObject(uint32_t member_count) {
+    return Add("}" + std::to_string(member_count));
+  }
+  bool StartArray() { return Add("["); }
+  bool EndArray(uint32_t element_count) {
+    return Add("]" + std::to_string(element_count));
+  }
+
+  bool Add(const std::string& event) {
+    if (!events.empty()) {
+      events += " ";
+    }
+    events += event;
+    return true;
+  }
+};
+
+std::string Replay(std::string_view text) {
+  JsonDocument document;
+  EXPECT_EQ(document.Parse(text), JsonParseStatus::kOk) << text;
+  RecordingHandler handler;
+  EXPECT_TRUE(document.Accept(handler));
+  return handler.events;
+}
+
+JsonParseStatus ParseStatus(std::string_view text) {
+  JsonDocument document;
+  return document.Parse(text);
+}
+
+}  // namespace
+
+TEST(JsonReaderTest, ParsesScalars) {
+  EXPECT_EQ(Replay("null"), "null");
+  EXPECT_EQ(Replay(" true "), "true");
+  EXPECT_EQ(Replay("\tfalse\r\n"), "false");
+  EXPECT_EQ(Replay("\"hello\""), "\"hello\"");
+  EXPECT_EQ(Replay("-0"), "i0");
+  EXPECT_EQ(Replay("12345"), "i12345");
+  EXPECT_EQ(Replay("1.5"), "d1.500000");
+}
+
+TEST(JsonReaderTest, ClassifiesIntegers) {
+  JsonDocument document;
+  ASSERT_EQ(document.Parse("[9223372036854775807, -9223372036854775808, "
+                           "9223372036854775808, 18446744073709551615, "
+                           "18446744073709551616, -9223372036854775809, "
+                           "5000000000]"),
+            JsonParseStatus::kOk);
+  std::vector<JsonValue> values;
+  for (JsonValue value : document.GetRoot()) {
+    values.push_back(value);
+  }
+  ASSERT_EQ(values.size(), 7u);
+  EXPECT_EQ(values[0].GetInt64(), std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(values[1].GetInt64(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(values[2].GetType(), JsonType::kUint64);
+  EXPECT_EQ(values[2].GetUint64(), uint64_t{1} << 63);
+  EXPECT_EQ(values[3].GetUint64(), std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(values[4].GetType(), JsonType::kDouble);
+  EXPECT_EQ(values[4].GetDouble(), 18446744073709551616.0);
+  EXPECT_EQ(values[5].GetType(), JsonType::kDouble);
+  EXPECT_EQ(values[6].GetInt64(), 5000000000);
+}
+
+TEST(JsonReaderTest, ParsesDoublesWithCorrectRounding) {
+  JsonDocument document;
+  ASSERT_EQ(document.Parse("[3.1415926535897931, 0.30000000000000004, -0.0, "
+                           "1e-400, 2.2250738585072014E-308, 1E+2, "
+                           "9007199254740993.0, 0.000001e6, "
+                           "123456789012345678901234567890]"),
+            JsonParseStatus::kOk);
+  std::vector<double> values;
+  for (JsonValue value : document.GetRoot()) {
+    ASSERT_EQ(value.GetType(), JsonType::kDouble);
+    values.push_back(value.GetDouble());
+  }
+  ASSERT_EQ(values.size(), 9u);
+  EXPECT_EQ(values[0], M_PI);
+  EXPECT_EQ(values[1], 0.1 + 0.2);
+  EXPECT_EQ(values[2], 0.0);
+  EXPECT_TRUE(std::signbit(values[2]));
+  EXPECT_EQ(values[3], 0.0);
+  EXPECT_EQ(values[4], std::numeric_limits<double>::min());
+  EXPECT_EQ(values[5], 100.0);
+  EXPECT_EQ(values[6], 9007199254740992.0);
+  EXPECT_EQ(values[7], 1.0);
+  EXPECT_EQ(values[8], 123456789012345678901234567890.0);
+}
+
+TEST(JsonReaderTest, RejectsInvalidNumbers) {
+  for (const char* text :
+       {"00", "01", "--1", "+1", "0a", "0.", "0.a", "1e", "1e+", ".5", "-",
+        "1e400", "-1e400", "Infinity", "NaN"}) {
+    EXPECT_EQ(ParseStatus(text), JsonParseStatus::kInvalidJson) << text;
+  }
+}
+
+TEST(JsonReaderTest, ReadsStringsInPlace) {
+  const std::string text = "{\"key\":\"a value that is longer than a block\"}";
+  JsonDocument document;
+  ASSERT_EQ(document.Parse(text), JsonParseStatus::kOk);
+  std::optional<JsonValue> value = document.GetRoot().Find("key");
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(value->GetString(), "a value that is longer than a block");
+  EXPECT_EQ(value->GetString().data(), text.data() + 8);
+}
+
+TEST(JsonReaderTest, UnescapesStrings) {
+  JsonDocument document;
+  ASSERT_EQ(document.Parse("[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\", "
+                           "\"a long prefix before an escape\\u0041 and a "
+                           "long suffix after it\", \"\\u00e9\\u20ac\", "
+                           "\"\\ud83d\\ude00\", \"\\u0000\"]"),
+            JsonParseStatus::kOk);
+  std::vector<std::string_view> strings;
+  for (JsonValue value : document.GetRoot()) {
+    strings.push_back(value.GetString());
+  }
+  ASSERT_EQ(strings.size(), 5u);
+  EXPECT_EQ(strings[0], "\"\\/\b\f\n\r\t");
+  EXPECT_EQ(strings[1],
+            "a long prefix before an escapeA and a long suffix after it");
+  EXPECT_EQ(strings[2], "\xc3\xa9\xe2\x82\xac");
+  EXPECT_EQ(strings[3], "\xf0\x9f\x98\x80");
+  EXPECT_EQ(strings[4], std::string_view("\0", 1));
+}
+
+TEST(JsonReaderTest, RejectsInvalidStrings) {
+  for (const char* text :
+       {"\"", "\"\"\"", "\"\\\"", "\"\\z\"", "\"\\uxxxx\"", "\"\\u\"",
+        "\"\\uxx\"", "\"\\ud83d\"", "\"\\ude00\"", "\"\\ud83d\\u0041\"",
+        "\"Hello\x01World\"", "\"Hello\nWorld\"", "\"Hello\tWorld\"",
+        "\"a string that is longer than a block with a\ttab\""}) {
+    EXPECT_EQ(ParseStatus(text), JsonParseStatus::kInvalidJson) << text;
+  }
+}
+
+TEST(JsonReaderTest, ValidatesUtf8) {
+  EXPECT_EQ(ParseStatus("\"\xf0\x9f\x98\x80\""), JsonParseStatus::kOk);
+  for (const char* text :
+       {"\xff", "\"\xff\"", "\"\xc0\xaf\"", "\"\xed\xa0\x80\"",
+        "\"\xf4\x90\x80\x80\"", "\"\xe2\x82\"",
+        "[\"sixteen ASCII bytes\", \"then \x80\"]"}) {
+    EXPECT_EQ(ParseStatus(text), JsonParseStatus::kInvalidUtf8) << text;
+  }
+}
+
+TEST(JsonReaderTest, ParsesContainers) {
+  EXPECT_EQ(Replay("[]"), "[ ]0");
+  EXPECT_EQ(Replay("{}"), "{ }0");
+  EXPECT_EQ(Replay("[1, [true, {}], {\"a\": [null]}]"),
+            "[ i1 [ true { }0 ]2 { ka [ null ]1 }1 ]3");
+  EXPECT_EQ(Replay(" { \"x\" : 1 , \"y\" : \"z\" } "),
+            "{ kx i1 ky \"z\" }2");
+}
+
+TEST(JsonReaderTest, RejectsInvalidContainers) {
+  for (const char* text :
+       {"", " ", "[", "]", "[0,1,2,3 4]", "[0,1,2,3,4", "[0,1,2,3,4]]", "[1,]",
+        "{", "}", "{\"zero\":0 \"one\":1}", "{\"zero\" 0}", "{\"zero\":0,}",
+        "{0:1}", "{\"a\":1]", "[1}", "foo", "nul", "1 2"}) {
+    EXPECT_EQ(ParseStatus(text), JsonParseStatus::kInvalidJson) << text;
+  }
+}
+
+TEST(JsonReaderTest, FindsMembersAndIteratesOnDemand) {
+  JsonDocument document;
+  ASSERT_EQ(document.Parse("{\"method\":\"setLocale\",\"args\":[\"en\",\"US\","
+                           "\"\",\"\"],\"nested\":{\"method\":1}}"),
+            JsonParseStatus::kOk);
+  JsonValue root = document.GetRoot();
+  ASSERT_TRUE(root.IsObject());
+  EXPECT_EQ(root.Size(), 3u);
+  EXPECT_EQ(root.Find("method")->GetString(), "setLocale");
+  EXPECT_FALSE(root.Find("missing").has_value());
+
+  std::optional<JsonValue> args = root.Find("args");
+  ASSERT_TRUE(args.has_value() && args->IsArray());
+  EXPECT_EQ(args->Size(), 4u);
+  std::string joined;
+  for (JsonValue arg : *args) {
+    joined += std::string(arg.GetString()) + ";";
+  }
+  EXPECT_EQ(joined, "en;US;;;");
+
+  std::string keys;
+  for (auto it = root.begin(); it != root.end(); ++it) {
+    keys += std::string(it.key()) + ";";
+  }
+  EXPECT_EQ(keys, "method;args;nested;");
+}
+
+TEST(JsonReaderTest, ParsesDeeplyNestedArraysWithoutRecursion) {
+  const size_t depth = 1000000;
+  std::string text(depth, '[');
+  text.append(depth, ']');
+  JsonDocument document;
+  ASSERT_EQ(document.Parse(text), JsonParseStatus::kOk);
+  EXPECT_EQ(document.GetRoot().Size(), 1u);
+}
+
+TEST(JsonReaderTest, CanBeReused) {
+  JsonDocument document;
+  ASSERT_EQ(document.Parse("[\"\\n\"]"), JsonParseStatus::kOk);
+  ASSERT_EQ(document.Parse("{"), JsonParseStatus::kInvalidJson);
+  ASSERT_EQ(document.Parse("[\"\\t\"]"), JsonParseStatus::kOk);
+  EXPECT_EQ((*document.GetRoot().begin()).GetString(), "\t");
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -121,14 +121,27 @@ MallocMapping::MallocMapping() : data_(nullptr), size_(0) {}
 MallocMapping::MallocMapping(uint8_t* data, size_t size)
     : data_(data), size_(size) {}
 
+MallocMapping::MallocMapping(const uint8_t* data,
+                             size_t size,
+                             std::shared_ptr<const void> owner)
+    : data_(const_cast<uint8_t*>(data)),
+      size_(size),
+      owner_(std::move(owner)) {
+  FML_DCHECK(owner_);
+}
+
 MallocMapping::MallocMapping(fml::MallocMapping&& mapping)
-    : data_(mapping.data_), size_(mapping.size_) {
+    : data_(mapping.data_),
+      size_(mapping.size_),
+      owner_(std::move(mapping.owner_)) {
   mapping.data_ = nullptr;
   mapping.size_ = 0;
 }
 
 MallocMapping::~MallocMapping() {
-  free(data_);
+  if (!owner_) {
+    free(data_);
+  }
   data_ = nullptr;
 }
 
@@ -153,6 +166,15 @@ bool MallocMapping::IsDontNeedSafe() const {
 }
 
 uint8_t* MallocMapping::Release() {
+  if (owner_) {
+    uint8_t* copy = static_cast<uint8_t*>(malloc(size_));
+    FML_CHECK(copy != nullptr || size_ == 0);
+    if (size_ > 0) {
+      memcpy(copy, data_, size_);
+    }
+    owner_.reset();
+    data_ = copy;
+  }
   uint8_t* result = data_;
   data_ = nullptr;
   size_ = 0;
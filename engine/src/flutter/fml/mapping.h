@@ -151,6 +151,17 @@ class MallocMapping final : public Mapping {
   /// @param size The size of the mapping in bytes.
   MallocMapping(uint8_t* data, size_t size);
 
+  /// Creates a MallocMapping for a region of memory kept alive by `owner`
+  /// (without copying it). The mapping does not own the memory, so |Release|
+  /// returns a malloc'd copy of it instead.
+  /// @param data The starting address of the mapping.
+  /// @param size The size of the mapping in bytes.
+  /// @param owner Keeps the memory alive until the mapping is destroyed or
+  ///              released.
+  MallocMapping(const uint8_t* data,
+                size_t size,
+                std::shared_ptr<const void> owner);
+
   MallocMapping(fml::MallocMapping&& mapping);
 
   ~MallocMapping() override;
@@ -182,11 +193,15 @@ class MallocMapping final : public Mapping {
 
   /// Removes ownership of the data buffer.
   /// After this is called; the mapping will point to nullptr.
+  /// The result must be freed with `free()`. If the mapping was created with
+  /// an owner, it is a copy of the data.
   [[nodiscard]] uint8_t* Release();
 
  private:
   uint8_t* data_;
   size_t size_;
+  // Set if |data_| is not owned by the mapping.
+  std::shared_ptr<const void> owner_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MallocMapping);
 };
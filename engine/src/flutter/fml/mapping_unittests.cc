@@ -54,6 +54,25 @@ TEST(MallocMapping, Release) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(MallocMapping, SharesOwnedMemory) {
+  auto owner = std::make_shared<std::vector<uint8_t>>(10, 0xac);
+  std::weak_ptr<std::vector<uint8_t>> weak_owner = owner;
+  const uint8_t* data = owner->data() + 2;
+  MallocMapping mapping(data, 4, std::move(owner));
+  EXPECT_EQ(data, mapping.GetMapping());
+  EXPECT_EQ(4u, mapping.GetSize());
+
+  MallocMapping moved(std::move(mapping));
+  EXPECT_FALSE(weak_owner.expired());
+
+  uint8_t* released = moved.Release();
+  EXPECT_TRUE(weak_owner.expired());
+  ASSERT_NE(nullptr, released);
+  EXPECT_EQ(0xac, released[3]);
+  EXPECT_EQ(nullptr, moved.GetMapping());
+  free(released);
+}
+
 TEST(MallocMapping, IsDontNeedSafe) {
   size_t length = 10;
   MallocMapping mapping(reinterpret_cast<uint8_t*>(malloc(length)), length);
@@ -57,8 +57,8 @@ namespace fml {
 //     ...
 //   };
 //
-// For now, we only have thread-safe reference counting, since that's all we
-// need. It's easy enough to add thread-unsafe versions if necessary.
+// Objects that are only ever referenced on one thread can use |RefCounted|
+// instead (see below), which avoids atomic operations.
 template <typename T>
 class RefCountedThreadSafe : public internal::RefCountedThreadSafeBase {
  public:
@@ -121,11 +121,60 @@ class RefCountedThreadSafe : public internal::RefCountedThreadSafeBase {
   FML_DISALLOW_COPY_AND_ASSIGN(RefCountedThreadSafe);
 };
 
+// A variant of |RefCountedThreadSafe| for objects that are created,
+// referenced and released on a single thread. The reference count is a plain
+// integer, so adding and releasing references costs no atomic operations.
+// Debug builds check that every reference count change happens on the thread
+// that created the object.
+//
+// Only use this for objects that never have references taken or dropped on
+// another thread, including by tasks posted to other task runners and by
+// closures that may be copied or destroyed elsewhere.
+template <typename T>
+class RefCounted : public internal::RefCountedBase {
+ public:
+  // Adds a reference to this object.
+  // Inherited from the internal superclass:
+  //   void AddRef() const;
+
+  // Releases a reference to this object. This will destroy this object once the
+  // last reference is released.
+  void Release() const {
+    if (internal::RefCountedBase::Release()) {
+      delete static_cast<const T*>(this);
+    }
+  }
+
+  // See |RefCountedThreadSafe|.
+  // Inherited from the internal superclass:
+  //   bool HasOneRef();
+  //   void AssertHasOneRef();
+
+ protected:
+  // Constructor. As with |RefCountedThreadSafe|, the object is constructed
+  // with a reference count of 1, and then must be adopted.
+  RefCounted() {}
+
+  ~RefCounted() {}
+
+ private:
+#ifndef NDEBUG
+  template <typename U>
+  friend RefPtr<U> AdoptRef(U*);
+  void Adopt() { internal::RefCountedBase::Adopt(); }
+#endif
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RefCounted);
+};
+
 // If you subclass |RefCountedThreadSafe| and want to keep your destructor
 // private, use this. (See the example above |RefCountedThreadSafe|.)
 #define FML_FRIEND_REF_COUNTED_THREAD_SAFE(T) \
   friend class ::fml::RefCountedThreadSafe<T>
 
+// The same, for subclasses of |RefCounted|.
+#define FML_FRIEND_REF_COUNTED(T) friend class ::fml::RefCounted<T>
+
 // If you want to keep your constructor(s) private and still want to use
 // |MakeRefCounted<T>()|, use this. (See the example above
 // |RefCountedThreadSafe|.)
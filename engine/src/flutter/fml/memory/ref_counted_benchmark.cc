@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/ref_counted.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+class ThreadSafeObject : public RefCountedThreadSafe<ThreadSafeObject> {};
+
+class ThreadAffineObject : public RefCounted<ThreadAffineObject> {};
+
+}  // namespace
+
+// Copying and releasing a reference, as capturing a |RefPtr| in a closure
+// does.
+template <typename T>
+static void BM_RefPtrCopy(benchmark::State& state) {
+  RefPtr<T> object = MakeRefCounted<T>();
+  for (auto _ : state) {
+    RefPtr<T> copy = object;
+    benchmark::DoNotOptimize(copy.get());
+  }
+}
+BENCHMARK_TEMPLATE(BM_RefPtrCopy, ThreadSafeObject);
+BENCHMARK_TEMPLATE(BM_RefPtrCopy, ThreadAffineObject);
+
+template <typename T>
+static void BM_RefPtrCreate(benchmark::State& state) {
+  for (auto _ : state) {
+    RefPtr<T> object = MakeRefCounted<T>();
+    benchmark::DoNotOptimize(object.get());
+  }
+}
+BENCHMARK_TEMPLATE(BM_RefPtrCreate, ThreadSafeObject);
+BENCHMARK_TEMPLATE(BM_RefPtrCreate, ThreadAffineObject);
+
+}  // namespace benchmarking
+}  // namespace fml
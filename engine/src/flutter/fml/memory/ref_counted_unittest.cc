@@ -8,6 +8,8 @@
 
 #include "flutter/fml/memory/ref_counted.h"
 
+#include <thread>
+
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
 
@@ -639,6 +641,49 @@ TEST(RefCountedTest, DebugChecks) {
 }
 #endif
 
+class MyThreadAffineClass : public RefCounted<MyThreadAffineClass> {
+ public:
+  explicit MyThreadAffineClass(bool* was_destroyed)
+      : was_destroyed_(was_destroyed) {}
+
+  ~MyThreadAffineClass() { *was_destroyed_ = true; }
+
+ private:
+  bool* was_destroyed_;
+};
+
+TEST(RefCountedTest, ThreadAffine) {
+  bool was_destroyed = false;
+  RefPtr<MyThreadAffineClass> r1 =
+      MakeRefCounted<MyThreadAffineClass>(&was_destroyed);
+  EXPECT_TRUE(r1->HasOneRef());
+  {
+    RefPtr<MyThreadAffineClass> r2 = r1;
+    EXPECT_FALSE(r1->HasOneRef());
+    RefPtr<MyThreadAffineClass> r3 = std::move(r2);
+    EXPECT_FALSE(r2);
+    EXPECT_EQ(r1.get(), r3.get());
+  }
+  EXPECT_TRUE(r1->HasOneRef());
+  EXPECT_FALSE(was_destroyed);
+  r1 = nullptr;
+  EXPECT_TRUE(was_destroyed);
+}
+
+#ifndef NDEBUG
+TEST(RefCountedTest, ThreadAffineDebugChecks) {
+  bool was_destroyed = false;
+  RefPtr<MyThreadAffineClass> r =
+      MakeRefCounted<MyThreadAffineClass>(&was_destroyed);
+  EXPECT_DEATH_IF_SUPPORTED(
+      {
+        std::thread thread([&r]() { RefPtr<MyThreadAffineClass> copy = r; });
+        thread.join();
+      },
+      "IsCreationThreadCurrent");
+}
+#endif
+
 // TODO(vtl): Add (threaded) stress tests.
 
 }  // namespace
@@ -81,7 +81,7 @@ class WeakPtr {
 
   explicit operator bool() const {
     CheckThreadSafety();
-    return flag_ && flag_->is_valid();
+    return flag_.is_valid();
   }
 
   T* get() const {
@@ -102,7 +102,7 @@ class WeakPtr {
   }
 
  protected:
-  explicit WeakPtr(T* ptr, fml::RefPtr<fml::internal::WeakPtrFlag>&& flag)
+  explicit WeakPtr(T* ptr, fml::internal::WeakPtrFlagRef&& flag)
       : ptr_(ptr), flag_(std::move(flag)) {}
 
   void CheckThreadSafety() const {
@@ -116,11 +116,11 @@ class WeakPtr {
   friend class WeakPtrFactory<T>;
 
   explicit WeakPtr(T* ptr,
-                   fml::RefPtr<fml::internal::WeakPtrFlag>&& flag,
+                   fml::internal::WeakPtrFlagRef&& flag,
                    const DebugThreadChecker& checker)
       : ptr_(ptr), flag_(std::move(flag)), checker_(checker) {}
   T* ptr_;
-  fml::RefPtr<fml::internal::WeakPtrFlag> flag_;
+  fml::internal::WeakPtrFlagRef flag_;
   DebugThreadChecker checker_;
 
   // Copy/move construction/assignment supported.
@@ -170,7 +170,7 @@ class TaskRunnerAffineWeakPtr {
 
   explicit operator bool() const {
     CheckThreadSafety();
-    return flag_ && flag_->is_valid();
+    return flag_.is_valid();
   }
 
   T* get() const {
@@ -202,12 +202,12 @@ class TaskRunnerAffineWeakPtr {
 
   explicit TaskRunnerAffineWeakPtr(
       T* ptr,
-      fml::RefPtr<fml::internal::WeakPtrFlag>&& flag,
+      fml::internal::WeakPtrFlagRef&& flag,
       const DebugTaskRunnerChecker& checker)
       : ptr_(ptr), flag_(std::move(flag)), checker_(checker) {}
 
   T* ptr_;
-  fml::RefPtr<fml::internal::WeakPtrFlag> flag_;
+  fml::internal::WeakPtrFlagRef flag_;
   DebugTaskRunnerChecker checker_;
 };
 
@@ -257,26 +257,26 @@ template <typename T>
 class WeakPtrFactory {
  public:
   explicit WeakPtrFactory(T* ptr)
-      : ptr_(ptr), flag_(fml::MakeRefCounted<fml::internal::WeakPtrFlag>()) {
+      : ptr_(ptr), flag_(fml::internal::WeakPtrFlag::Acquire()) {
     FML_DCHECK(ptr_);
   }
 
   ~WeakPtrFactory() {
     CheckThreadSafety();
-    flag_->Invalidate();
+    flag_.get()->Invalidate();
   }
 
   // Gets a new weak pointer, which will be valid until this object is
   // destroyed.
   WeakPtr<T> GetWeakPtr() const {
-    return WeakPtr<T>(ptr_, flag_.Clone(), checker_);
+    return WeakPtr<T>(ptr_, fml::internal::WeakPtrFlagRef(flag_), checker_);
   }
 
  private:
   // Note: See weak_ptr_internal.h for an explanation of why we store the
   // pointer here, instead of in the "flag".
   T* const ptr_;
-  fml::RefPtr<fml::internal::WeakPtrFlag> flag_;
+  fml::internal::WeakPtrFlagRef flag_;
 
   void CheckThreadSafety() const {
     FML_DCHECK_CREATION_THREAD_IS_CURRENT(checker_.checker);
@@ -293,26 +293,27 @@ template <typename T>
 class TaskRunnerAffineWeakPtrFactory {
  public:
   explicit TaskRunnerAffineWeakPtrFactory(T* ptr)
-      : ptr_(ptr), flag_(fml::MakeRefCounted<fml::internal::WeakPtrFlag>()) {
+      : ptr_(ptr), flag_(fml::internal::WeakPtrFlag::Acquire()) {
     FML_DCHECK(ptr_);
   }
 
   ~TaskRunnerAffineWeakPtrFactory() {
     CheckThreadSafety();
-    flag_->Invalidate();
+    flag_.get()->Invalidate();
   }
 
   // Gets a new weak pointer, which will be valid until this object is
   // destroyed.
   TaskRunnerAffineWeakPtr<T> GetWeakPtr() const {
-    return TaskRunnerAffineWeakPtr<T>(ptr_, flag_.Clone(), checker_);
+    return TaskRunnerAffineWeakPtr<T>(
+        ptr_, fml::internal::WeakPtrFlagRef(flag_), checker_);
   }
 
  private:
   // Note: See weak_ptr_internal.h for an explanation of why we store the
   // pointer here, instead of in the "flag".
   T* const ptr_;
-  fml::RefPtr<fml::internal::WeakPtrFlag> flag_;
+  fml::internal::WeakPtrFlagRef flag_;
 
   void CheckThreadSafety() const {
     FML_DCHECK_TASK_RUNNER_IS_CURRENT(checker_.checker);
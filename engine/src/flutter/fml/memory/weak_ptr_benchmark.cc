@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/weak_ptr.h"
+
+#include <memory>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+struct Target {
+  int value = 0;
+};
+
+}  // namespace
+
+// Copying a weak pointer, as every task that captures one does.
+static void BM_WeakPtrCopy(benchmark::State& state) {
+  Target target;
+  WeakPtrFactory<Target> factory(&target);
+  WeakPtr<Target> weak = factory.GetWeakPtr();
+  for (auto _ : state) {
+    WeakPtr<Target> copy = weak;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_WeakPtrCopy);
+
+// Vending a weak pointer and checking it, as a posted task does when it runs.
+static void BM_WeakPtrGetAndDereference(benchmark::State& state) {
+  Target target;
+  WeakPtrFactory<Target> factory(&target);
+  for (auto _ : state) {
+    WeakPtr<Target> weak = factory.GetWeakPtr();
+    if (weak) {
+      benchmark::DoNotOptimize(weak->value);
+    }
+  }
+}
+BENCHMARK(BM_WeakPtrGetAndDereference);
+
+static void BM_TaskRunnerAffineWeakPtrCopy(benchmark::State& state) {
+  Target target;
+  TaskRunnerAffineWeakPtrFactory<Target> factory(&target);
+  TaskRunnerAffineWeakPtr<Target> weak = factory.GetWeakPtr();
+  for (auto _ : state) {
+    TaskRunnerAffineWeakPtr<Target> copy = weak;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_TaskRunnerAffineWeakPtrCopy);
+
+// Creating and destroying a factory, as objects that vend weak pointers do.
+static void BM_WeakPtrFactoryLifetime(benchmark::State& state) {
+  Target target;
+  for (auto _ : state) {
+    auto factory = std::make_unique<WeakPtrFactory<Target>>(&target);
+    benchmark::DoNotOptimize(factory.get());
+  }
+}
+BENCHMARK(BM_WeakPtrFactoryLifetime);
+
+// Several threads copying the same weak pointer, as when tasks capturing the
+// shell's weak pointers are posted from several threads at once.
+static void BM_WeakPtrCopyShared(benchmark::State& state) {
+  static Target target;
+  static WeakPtrFactory<Target>* factory = nullptr;
+  static WeakPtr<Target>* weak = nullptr;
+  if (state.thread_index() == 0) {
+    factory = new WeakPtrFactory<Target>(&target);
+    weak = new WeakPtr<Target>(factory->GetWeakPtr());
+  }
+  for (auto _ : state) {
+    WeakPtr<Target> copy = *weak;
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    delete weak;
+    delete factory;
+  }
+}
+BENCHMARK(BM_WeakPtrCopyShared)->ThreadRange(1, 4)->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
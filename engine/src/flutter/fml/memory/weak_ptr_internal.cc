@@ -4,22 +4,54 @@
 
 #include "flutter/fml/memory/weak_ptr_internal.h"
 
+#include <mutex>
+
 #include "flutter/fml/logging.h"
 
 namespace fml {
 namespace internal {
 
-WeakPtrFlag::WeakPtrFlag() : is_valid_(true) {}
+namespace {
+
+// Factories are created far less often than weak pointers are copied, so the
+// pool is a simple locked free list.
+struct WeakPtrFlagPool {
+  std::mutex mutex;
+  WeakPtrFlag* head = nullptr;
+};
+
+WeakPtrFlagPool& GetPool() {
+  static WeakPtrFlagPool* pool = new WeakPtrFlagPool();
+  return *pool;
+}
+
+}  // namespace
 
-WeakPtrFlag::~WeakPtrFlag() {
-  // Should be invalidated before destruction.
-  FML_DCHECK(!is_valid_);
+WeakPtrFlag* WeakPtrFlag::Acquire() {
+  WeakPtrFlagPool& pool = GetPool();
+  {
+    std::scoped_lock lock(pool.mutex);
+    if (pool.head) {
+      WeakPtrFlag* flag = pool.head;
+      pool.head = flag->next_;
+      flag->next_ = nullptr;
+      return flag;
+    }
+  }
+  return new WeakPtrFlag();
 }
 
 void WeakPtrFlag::Invalidate() {
-  // Invalidation should happen exactly once.
-  FML_DCHECK(is_valid_);
-  is_valid_ = false;
+  // Invalidation should happen exactly once per generation, which the owning
+  // factory guarantees. The generation is 64 bits, so it never wraps around to
+  // revalidate an old weak pointer.
+  generation_.fetch_add(1, std::memory_order_relaxed);
+
+  WeakPtrFlagPool& pool = GetPool();
+  std::scoped_lock lock(pool.mutex);
+  FML_DCHECK(next_ == nullptr);
+  next_ = pool.head;
+  pool.head = this;
 }
 
 }  // namespace internal
@@ -5,8 +5,11 @@
 #ifndef FLUTTER_FML_MEMORY_WEAK_PTR_INTERNAL_H_
 #define FLUTTER_FML_MEMORY_WEAK_PTR_INTERNAL_H_
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 #include "flutter/fml/macros.h"
-#include "flutter/fml/memory/ref_counted.h"
 
 namespace fml {
 namespace internal {
@@ -16,25 +19,84 @@ namespace internal {
 // there may also be |WeakPtr<U>|s to the same object, where |U| is a superclass
 // of |T|.
 //
-// This class in not thread-safe, though references may be released on any
-// thread (allowing weak pointers to be destroyed/reset/reassigned on any
-// thread).
-class WeakPtrFlag : public fml::RefCountedThreadSafe<WeakPtrFlag> {
+// Flags are not reference counted. They are never freed, but recycled through
+// a process-wide pool, and every use of a flag has a generation number. A
+// factory invalidates its weak pointers by advancing the generation before
+// returning the flag to the pool, so a weak pointer is valid only while the
+// generation it was vended with is current. Copying or destroying a weak
+// pointer therefore never touches the flag, and checking it is a single
+// relaxed load.
+class WeakPtrFlag {
  public:
-  WeakPtrFlag();
-
-  ~WeakPtrFlag();
+  // Takes a flag from the pool, allocating one if the pool is empty.
+  static WeakPtrFlag* Acquire();
 
-  bool is_valid() const { return is_valid_; }
+  uint64_t generation() const {
+    return generation_.load(std::memory_order_relaxed);
+  }
 
+  // Invalidates the current generation and returns this flag to the pool.
   void Invalidate();
 
  private:
-  bool is_valid_ = false;
+  WeakPtrFlag() = default;
+
+  ~WeakPtrFlag() = default;
+
+  std::atomic<uint64_t> generation_ = 0;
+  // The next flag in the pool, while this flag is in it.
+  WeakPtrFlag* next_ = nullptr;
 
   FML_DISALLOW_COPY_AND_ASSIGN(WeakPtrFlag);
 };
 
+// A reference to one generation of a |WeakPtrFlag|, held by weak pointers and
+// their factories. Moving a reference leaves the source null, as moving a
+// |RefPtr| would.
+//
+// This class is not thread-safe, though references may be copied, reset and
+// destroyed on any thread.
+class WeakPtrFlagRef {
+ public:
+  WeakPtrFlagRef() = default;
+
+  explicit WeakPtrFlagRef(WeakPtrFlag* flag)
+      : flag_(flag), generation_(flag->generation()) {}
+
+  WeakPtrFlagRef(const WeakPtrFlagRef& other) = default;
+
+  WeakPtrFlagRef(WeakPtrFlagRef&& other)
+      : flag_(other.flag_), generation_(other.generation_) {
+    other.flag_ = nullptr;
+  }
+
+  WeakPtrFlagRef& operator=(const WeakPtrFlagRef& other) = default;
+
+  WeakPtrFlagRef& operator=(WeakPtrFlagRef&& other) {
+    flag_ = other.flag_;
+    generation_ = other.generation_;
+    if (&other != this) {
+      other.flag_ = nullptr;
+    }
+    return *this;
+  }
+
+  WeakPtrFlagRef& operator=(std::nullptr_t) {
+    flag_ = nullptr;
+    return *this;
+  }
+
+  explicit operator bool() const { return flag_ != nullptr; }
+
+  WeakPtrFlag* get() const { return flag_; }
+
+  bool is_valid() const { return flag_ && flag_->generation() == generation_; }
+
+ private:
+  WeakPtrFlag* flag_ = nullptr;
+  uint64_t generation_ = 0;
+};
+
 }  // namespace internal
 }  // namespace fml
 
@@ -6,8 +6,10 @@
 
 #include "flutter/fml/memory/weak_ptr.h"
 
+#include <memory>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/raster_thread_merger.h"
@@ -119,6 +121,36 @@ TEST(WeakPtrTest, MultipleStaged) {
   EXPECT_EQ(nullptr, a.get());
 }
 
+TEST(WeakPtrTest, StaysInvalidWhenFlagIsReused) {
+  WeakPtr<int> a;
+  {
+    int data = 0;
+    WeakPtrFactory<int> factory(&data);
+    a = factory.GetWeakPtr();
+  }
+  EXPECT_EQ(nullptr, a.get());
+
+  // Factories recycle the flags of destroyed factories. Weak pointers vended
+  // by the destroyed factory must not become valid again.
+  std::vector<std::unique_ptr<WeakPtrFactory<int>>> factories;
+  int other = 0;
+  for (int i = 0; i < 16; i++) {
+    factories.push_back(std::make_unique<WeakPtrFactory<int>>(&other));
+    EXPECT_EQ(&other, factories.back()->GetWeakPtr().get());
+  }
+  EXPECT_EQ(nullptr, a.get());
+  EXPECT_FALSE(a);
+}
+
+TEST(WeakPtrTest, CanBeDestroyedOnAnotherThread) {
+  int data = 0;
+  WeakPtrFactory<int> factory(&data);
+  std::vector<WeakPtr<int>> ptrs(100, factory.GetWeakPtr());
+  std::thread thread([ptrs = std::move(ptrs)]() mutable { ptrs.clear(); });
+  thread.join();
+  EXPECT_EQ(&data, factory.GetWeakPtr().get());
+}
+
 struct Base {
   double member = 0.;
 };
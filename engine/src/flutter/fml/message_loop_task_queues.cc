@@ -134,7 +134,10 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   }
   fml::closure invocation = top.task.GetTask();
   const auto task_source_grade = top.task.GetTaskSourceGrade();
-  queue_entries_.at(top.task_queue_id)->task_source->PopTask(task_source_grade);
+  const auto& entry = queue_entries_.at(top.task_queue_id);
+  entry->task_wait_times.Record(
+      (from_time - top.task.GetTargetTime()).ToMicroseconds());
+  entry->task_source->PopTask(task_source_grade);
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
@@ -146,6 +149,16 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
   }
 }
 
+Histogram::Snapshot MessageLoopTaskQueues::GetTaskWaitTimes(
+    TaskQueueId queue_id) const {
+  std::lock_guard guard(queue_mutex_);
+  auto it = queue_entries_.find(queue_id);
+  if (it == queue_entries_.end()) {
+    return {};
+  }
+  return it->second->task_wait_times.GetSnapshot();
+}
+
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
   std::lock_guard guard(queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
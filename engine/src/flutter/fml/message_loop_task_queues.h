@@ -13,6 +13,7 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/histogram.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/task_queue_id.h"
@@ -45,6 +46,10 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// The time, in microseconds, that tasks registered on this TaskQueue were
+  /// ready to run before they started running.
+  Histogram task_wait_times;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -90,6 +95,12 @@ class MessageLoopTaskQueues {
 
   static TaskSourceGrade GetCurrentTaskSourceGrade();
 
+  /// Returns the time, in microseconds, that tasks registered on the queue
+  /// were ready to run before they started running. The snapshot is empty if
+  /// there is no such queue, e.g. because it was disposed or belongs to a
+  /// task runner that is not backed by a message loop.
+  Histogram::Snapshot GetTaskWaitTimes(TaskQueueId queue_id) const;
+
   // Observers methods.
 
   void AddTaskObserver(TaskQueueId queue_id,
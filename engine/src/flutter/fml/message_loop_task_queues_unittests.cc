@@ -60,6 +60,31 @@ TEST(MessageLoopTaskQueue, RegisterTwoTasksAndCount) {
   ASSERT_TRUE(task_queue->GetNumPendingTasks(queue_id) == 2);
 }
 
+TEST(MessageLoopTaskQueue, RecordsTaskWaitTimes) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const fml::TimePoint now = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(queue_id, [] {}, now);
+  task_queue->RegisterTask(queue_id, [] {},
+                           now + fml::TimeDelta::FromMilliseconds(1));
+
+  // Neither task is ready yet, so no wait is recorded.
+  ASSERT_FALSE(task_queue->GetNextTaskToRun(
+      queue_id, now - fml::TimeDelta::FromMicroseconds(1)));
+  EXPECT_EQ(task_queue->GetTaskWaitTimes(queue_id).count, 0u);
+
+  const fml::TimePoint later = now + fml::TimeDelta::FromMilliseconds(3);
+  ASSERT_TRUE(task_queue->GetNextTaskToRun(queue_id, later));
+  ASSERT_TRUE(task_queue->GetNextTaskToRun(queue_id, later));
+  Histogram::Snapshot wait_times = task_queue->GetTaskWaitTimes(queue_id);
+  EXPECT_EQ(wait_times.count, 2u);
+  EXPECT_EQ(wait_times.min, 2000);
+  EXPECT_EQ(wait_times.max, 3000);
+
+  task_queue->Dispose(queue_id);
+  EXPECT_EQ(task_queue->GetTaskWaitTimes(queue_id).count, 0u);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesAndCount) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -0,0 +1,278 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/cpu_affinity.h"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+// Sysfs lists never describe more CPUs than this, reject anything larger
+// rather than allocating for a corrupt range.
+constexpr size_t kMaxCpuListRange = 1 << 16;
+
+std::string_view Trim(std::string_view value) {
+  const size_t start = value.find_first_not_of(" \t\n");
+  if (start == std::string_view::npos) {
+    return {};
+  }
+  const size_t end = value.find_last_not_of(" \t\n");
+  return value.substr(start, end - start + 1);
+}
+
+bool ParseIndex(std::string_view token, size_t* value) {
+  auto result =
+      std::from_chars(token.data(), token.data() + token.size(), *value);
+  return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+std::string ReadFirstLine(const std::string& path) {
+  std::ifstream file(path.c_str());
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+}  // namespace
+
+std::vector<size_t> ParseCpuList(std::string_view list) {
+  std::vector<size_t> cpus;
+  list = Trim(list);
+  while (!list.empty()) {
+    const size_t comma = list.find(',');
+    std::string_view range = Trim(list.substr(0, comma));
+    list = comma == std::string_view::npos ? std::string_view()
+                                           : list.substr(comma + 1);
+
+    const size_t dash = range.find('-');
+    size_t first = 0;
+    size_t last = 0;
+    if (dash == std::string_view::npos) {
+      if (!ParseIndex(range, &first)) {
+        return {};
+      }
+      last = first;
+    } else if (!ParseIndex(range.substr(0, dash), &first) ||
+               !ParseIndex(range.substr(dash + 1), &last) || last < first ||
+               last - first > kMaxCpuListRange) {
+      return {};
+    }
+    for (size_t cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<LinuxCpuInfo> ReadLinuxCpuTopology(const std::string& sysfs_root) {
+  std::vector<LinuxCpuInfo> cpus;
+  const std::string cpu_root = sysfs_root + "/cpu";
+  for (size_t index : ParseCpuList(ReadFirstLine(cpu_root + "/online"))) {
+    const std::string cpu_dir = cpu_root + "/cpu" + std::to_string(index);
+    LinuxCpuInfo info = {
+        .index = index,
+        .speed =
+            ReadIntFromFile(cpu_dir + "/cpufreq/cpuinfo_max_freq").value_or(0),
+        .numa_node = std::nullopt,
+        .core = index,
+    };
+    auto siblings =
+        ParseCpuList(ReadFirstLine(cpu_dir + "/topology/thread_siblings_list"));
+    if (!siblings.empty()) {
+      info.core = *std::min_element(siblings.begin(), siblings.end());
+    }
+    cpus.push_back(info);
+  }
+
+  // Kernels built without CONFIG_NUMA don't have the node directory, in which
+  // case every CPU is left without a node.
+  const std::string node_root = sysfs_root + "/node";
+  for (size_t node : ParseCpuList(ReadFirstLine(node_root + "/online"))) {
+    const std::string cpulist =
+        node_root + "/node" + std::to_string(node) + "/cpulist";
+    for (size_t index : ParseCpuList(ReadFirstLine(cpulist))) {
+      for (auto& cpu : cpus) {
+        if (cpu.index == index) {
+          cpu.numa_node = node;
+        }
+      }
+    }
+  }
+  return cpus;
+}
+
+LinuxCpuAffinityTracker::LinuxCpuAffinityTracker(
+    const std::vector<LinuxCpuInfo>& cpus,
+    const std::vector<size_t>& allowed,
+    std::optional<size_t> home_node) {
+  std::vector<LinuxCpuInfo> domain;
+  std::set<size_t> nodes;
+  for (const auto& cpu : cpus) {
+    if (std::find(allowed.begin(), allowed.end(), cpu.index) == allowed.end()) {
+      continue;
+    }
+    domain.push_back(cpu);
+    if (cpu.numa_node.has_value()) {
+      nodes.insert(cpu.numa_node.value());
+    }
+  }
+
+  bool restricted_to_node = false;
+  if (nodes.size() > 1 && home_node.has_value()) {
+    std::vector<LinuxCpuInfo> local;
+    for (const auto& cpu : domain) {
+      if (cpu.numa_node == home_node) {
+        local.push_back(cpu);
+      }
+    }
+    if (!local.empty()) {
+      domain = std::move(local);
+      restricted_to_node = true;
+    }
+  }
+
+  std::vector<CpuIndexAndSpeed> speeds;
+  std::map<size_t, size_t> cores;
+  for (const auto& cpu : domain) {
+    cores[cpu.index] = cpu.core;
+    if (cpu.speed > 0) {
+      speeds.push_back({.index = cpu.index, .speed = cpu.speed});
+    }
+  }
+  // Classifying CPUs by speed is only meaningful if every speed is known.
+  if (speeds.size() != domain.size()) {
+    speeds.clear();
+  }
+
+  CPUSpeedTracker speed_tracker(speeds);
+  if (speed_tracker.IsValid()) {
+    has_speed_classes_ = true;
+    efficiency_ = speed_tracker.GetIndices(CpuAffinity::kEfficiency);
+    performance_ = speed_tracker.GetIndices(CpuAffinity::kPerformance);
+    not_performance_ = speed_tracker.GetIndices(CpuAffinity::kNotPerformance);
+    not_efficiency_ = speed_tracker.GetIndices(CpuAffinity::kNotEfficiency);
+
+    // Keep work requested away from the performance CPUs off their SMT
+    // siblings too, as those compete for the same execution units.
+    std::set<size_t> performance_cores;
+    for (size_t index : performance_) {
+      performance_cores.insert(cores[index]);
+    }
+    std::vector<size_t> spread;
+    for (size_t index : not_performance_) {
+      if (performance_cores.count(cores[index]) == 0) {
+        spread.push_back(index);
+      }
+    }
+    if (!spread.empty()) {
+      not_performance_ = std::move(spread);
+    }
+    valid_ = true;
+    return;
+  }
+
+  if (restricted_to_node) {
+    for (const auto& cpu : domain) {
+      efficiency_.push_back(cpu.index);
+    }
+    performance_ = efficiency_;
+    not_performance_ = efficiency_;
+    not_efficiency_ = efficiency_;
+    valid_ = true;
+  }
+}
+
+bool LinuxCpuAffinityTracker::IsValid() const {
+  return valid_;
+}
+
+std::optional<size_t> LinuxCpuAffinityTracker::EfficiencyCoreCount() const {
+  if (!has_speed_classes_) {
+    return std::nullopt;
+  }
+  return efficiency_.size();
+}
+
+const std::vector<size_t>& LinuxCpuAffinityTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+    case CpuAffinity::kNotEfficiency:
+      return not_efficiency_;
+  }
+}
+
+/// The tracker is initialized once, the first time the topology is needed. The
+/// NUMA node of the initializing thread becomes the home node of the engine.
+static std::once_flag gLinuxCpuTrackerFlag;
+static LinuxCpuAffinityTracker* gLinuxCpuTracker;
+
+static void InitLinuxCpuTracker() {
+  auto cpus = ReadLinuxCpuTopology("/sys/devices/system");
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  const bool has_mask = sched_getaffinity(0, sizeof(set), &set) == 0;
+  std::vector<size_t> allowed;
+  for (const auto& cpu : cpus) {
+    if (!has_mask ||
+        (cpu.index < CPU_SETSIZE && CPU_ISSET(cpu.index, &set))) {
+      allowed.push_back(cpu.index);
+    }
+  }
+
+  std::optional<size_t> home_node;
+  const int current_cpu = sched_getcpu();
+  for (const auto& cpu : cpus) {
+    if (current_cpu >= 0 && cpu.index == static_cast<size_t>(current_cpu)) {
+      home_node = cpu.numa_node;
+    }
+  }
+
+  gLinuxCpuTracker = new LinuxCpuAffinityTracker(cpus, allowed, home_node);
+}
+
+static const LinuxCpuAffinityTracker* GetLinuxCpuTracker() {
+  std::call_once(gLinuxCpuTrackerFlag, InitLinuxCpuTracker);
+  return gLinuxCpuTracker;
+}
+
+std::optional<size_t> LinuxEfficiencyCoreCount() {
+  return GetLinuxCpuTracker()->EfficiencyCoreCount();
+}
+
+bool LinuxRequestAffinity(CpuAffinity affinity) {
+  const LinuxCpuAffinityTracker* tracker = GetLinuxCpuTracker();
+  if (!tracker->IsValid()) {
+    return true;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto index : tracker->GetIndices(affinity)) {
+    if (index < CPU_SETSIZE) {
+      CPU_SET(index, &set);
+    }
+  }
+  FML_DCHECK(CPU_COUNT(&set) > 0);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+}  // namespace fml
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_CPU_AFFINITY_H_
+#define FLUTTER_FML_PLATFORM_LINUX_CPU_AFFINITY_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/cpu_affinity.h"
+
+namespace fml {
+
+/// @brief A logical CPU as described by sysfs.
+struct LinuxCpuInfo {
+  // The index of the logical CPU.
+  size_t index;
+  // The cpuinfo_max_freq of the CPU in kHz, or 0 if cpufreq is unavailable.
+  int64_t speed;
+  // The NUMA node of the CPU, if the kernel exposes NUMA topology.
+  std::optional<size_t> numa_node;
+  // The lowest index among the SMT siblings of the CPU. Logical CPUs with the
+  // same core share a physical core.
+  size_t core;
+};
+
+/// @brief Parses a sysfs CPU list such as "0-3,8,10-11".
+///
+/// @note  This is visible for testing.
+std::vector<size_t> ParseCpuList(std::string_view list);
+
+/// @brief Reads the topology of the online CPUs from a sysfs tree rooted at
+///        `sysfs_root`, normally "/sys/devices/system".
+///
+/// @note  This is visible for testing.
+std::vector<LinuxCpuInfo> ReadLinuxCpuTopology(const std::string& sysfs_root);
+
+/// @brief Computes the CPU indices for a requested CPU affinity from the
+///        topology of the machine.
+///
+///        Only the CPUs in `allowed` are considered. On machines with more
+///        than one NUMA node, the CPUs are further restricted to `home_node`
+///        so that the engine threads share the memory they allocate. Within
+///        that domain, CPUs are classified by speed as by |CPUSpeedTracker|,
+///        and CPUs that share a physical core with a performance CPU are kept
+///        out of |CpuAffinity::kNotPerformance|.
+///
+/// @note  This is visible for testing.
+class LinuxCpuAffinityTracker {
+ public:
+  LinuxCpuAffinityTracker(const std::vector<LinuxCpuInfo>& cpus,
+                          const std::vector<size_t>& allowed,
+                          std::optional<size_t> home_node);
+
+  /// @brief The tracker is valid if the CPUs have distinct speeds or if the
+  ///        CPUs were restricted to a NUMA node. Affinity requests are ignored
+  ///        otherwise.
+  bool IsValid() const;
+
+  /// @brief The count of the slowest CPUs, or std::nullopt if all CPUs of the
+  ///        domain have the same speed.
+  std::optional<size_t> EfficiencyCoreCount() const;
+
+  /// @brief Return the set of CPU indices for the requested CPU affinity.
+  ///
+  ///        If the tracker is valid, this will always return a non-empty set.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  bool has_speed_classes_ = false;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> performance_;
+  std::vector<size_t> not_performance_;
+  std::vector<size_t> not_efficiency_;
+};
+
+/// @brief Linux specific implementation of EfficiencyCoreCount.
+std::optional<size_t> LinuxEfficiencyCoreCount();
+
+/// @brief Linux specific implementation of RequestAffinity.
+bool LinuxRequestAffinity(CpuAffinity affinity);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_CPU_AFFINITY_H_
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/cpu_affinity.h"
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+void WriteFile(const fml::UniqueFD& root,
+               const std::vector<std::string>& directories,
+               const std::string& name,
+               const std::string& contents) {
+  auto directory =
+      fml::CreateDirectory(root, directories, fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(directory.is_valid());
+  ASSERT_TRUE(fml::WriteAtomically(directory, name.c_str(),
+                                   fml::DataMapping(contents + "\n")));
+}
+
+std::vector<size_t> AllIndices(const std::vector<LinuxCpuInfo>& cpus) {
+  std::vector<size_t> indices;
+  for (const auto& cpu : cpus) {
+    indices.push_back(cpu.index);
+  }
+  return indices;
+}
+}  // namespace
+
+TEST(LinuxCpuAffinity, ParsesCpuLists) {
+  EXPECT_EQ(ParseCpuList("0-3,8,10-11\n"),
+            (std::vector<size_t>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(ParseCpuList("5"), (std::vector<size_t>{5}));
+  EXPECT_TRUE(ParseCpuList("").empty());
+  EXPECT_TRUE(ParseCpuList("3-1").empty());
+  EXPECT_TRUE(ParseCpuList("0-x").empty());
+}
+
+TEST(LinuxCpuAffinity, ReadsTopologyFromSysfs) {
+  fml::ScopedTemporaryDirectory sysfs;
+  WriteFile(sysfs.fd(), {"cpu"}, "online", "0-2");
+  WriteFile(sysfs.fd(), {"cpu", "cpu0", "cpufreq"}, "cpuinfo_max_freq",
+            "1800000");
+  WriteFile(sysfs.fd(), {"cpu", "cpu0", "topology"}, "thread_siblings_list",
+            "0,2");
+  WriteFile(sysfs.fd(), {"cpu", "cpu2", "topology"}, "thread_siblings_list",
+            "0,2");
+  WriteFile(sysfs.fd(), {"node"}, "online", "0-1");
+  WriteFile(sysfs.fd(), {"node", "node0"}, "cpulist", "0");
+  WriteFile(sysfs.fd(), {"node", "node1"}, "cpulist", "1-2");
+
+  auto cpus = ReadLinuxCpuTopology(sysfs.path());
+  ASSERT_EQ(cpus.size(), 3u);
+  EXPECT_EQ(cpus[0].speed, 1800000);
+  EXPECT_EQ(cpus[0].numa_node, 0u);
+  EXPECT_EQ(cpus[0].core, 0u);
+  EXPECT_EQ(cpus[1].speed, 0);
+  EXPECT_EQ(cpus[1].numa_node, 1u);
+  EXPECT_EQ(cpus[1].core, 1u);
+  EXPECT_EQ(cpus[2].core, 0u);
+
+  EXPECT_TRUE(ReadLinuxCpuTopology(sysfs.path() + "/missing").empty());
+}
+
+TEST(LinuxCpuAffinity, KeepsWorkersOffPerformanceCores) {
+  // Two fast cores with SMT siblings of differing advertised speed, and two
+  // slow cores.
+  std::vector<LinuxCpuInfo> cpus = {
+      {.index = 0, .speed = 3000, .numa_node = std::nullopt, .core = 0},
+      {.index = 1, .speed = 2000, .numa_node = std::nullopt, .core = 0},
+      {.index = 2, .speed = 1000, .numa_node = std::nullopt, .core = 2},
+      {.index = 3, .speed = 1000, .numa_node = std::nullopt, .core = 3},
+  };
+  LinuxCpuAffinityTracker tracker(cpus, AllIndices(cpus), std::nullopt);
+
+  ASSERT_TRUE(tracker.IsValid());
+  EXPECT_EQ(tracker.EfficiencyCoreCount(), 2u);
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            (std::vector<size_t>{0}));
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            (std::vector<size_t>{2, 3}));
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kNotEfficiency),
+            (std::vector<size_t>{0, 1}));
+
+  // CPUs outside of the allowed set are never requested.
+  LinuxCpuAffinityTracker restricted(cpus, {1, 2, 3}, std::nullopt);
+  ASSERT_TRUE(restricted.IsValid());
+  EXPECT_EQ(restricted.GetIndices(CpuAffinity::kPerformance),
+            (std::vector<size_t>{1}));
+}
+
+TEST(LinuxCpuAffinity, RestrictsToHomeNumaNode) {
+  std::vector<LinuxCpuInfo> cpus = {
+      {.index = 0, .speed = 2000, .numa_node = 0, .core = 0},
+      {.index = 1, .speed = 2000, .numa_node = 0, .core = 1},
+      {.index = 2, .speed = 2000, .numa_node = 1, .core = 2},
+      {.index = 3, .speed = 2000, .numa_node = 1, .core = 3},
+  };
+  LinuxCpuAffinityTracker tracker(cpus, AllIndices(cpus), 1);
+
+  ASSERT_TRUE(tracker.IsValid());
+  EXPECT_FALSE(tracker.EfficiencyCoreCount().has_value());
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            (std::vector<size_t>{2, 3}));
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            (std::vector<size_t>{2, 3}));
+
+  // Without a home node, or on a single node, uniform CPUs are left alone.
+  EXPECT_FALSE(
+      LinuxCpuAffinityTracker(cpus, AllIndices(cpus), std::nullopt).IsValid());
+  EXPECT_FALSE(LinuxCpuAffinityTracker(cpus, {0, 1}, 0).IsValid());
+}
+
+TEST(LinuxCpuAffinity, IgnoresPartialSpeedData) {
+  std::vector<LinuxCpuInfo> cpus = {
+      {.index = 0, .speed = 3000, .numa_node = std::nullopt, .core = 0},
+      {.index = 1, .speed = 0, .numa_node = std::nullopt, .core = 1},
+      {.index = 2, .speed = 1000, .numa_node = std::nullopt, .core = 2},
+  };
+  LinuxCpuAffinityTracker tracker(cpus, AllIndices(cpus), std::nullopt);
+
+  EXPECT_FALSE(tracker.IsValid());
+  EXPECT_FALSE(tracker.EfficiencyCoreCount().has_value());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/futex.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <ctime>
+#include <thread>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+// Roughly a microsecond on current hardware, which covers a hand-off between
+// two running threads without burning a noticeable amount of CPU time when the
+// other side is descheduled.
+static constexpr size_t kSpinCount = 128;
+
+bool FutexWait(std::atomic<uint32_t>* word,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout) {
+  struct timespec relative_timeout = {};
+  if (timeout.has_value()) {
+    if (timeout->ToNanoseconds() <= 0) {
+      return false;
+    }
+    relative_timeout = timeout->ToTimespec();
+  }
+  long result = syscall(SYS_futex, reinterpret_cast<uint32_t*>(word),
+                        FUTEX_WAIT_PRIVATE, expected,
+                        timeout.has_value() ? &relative_timeout : nullptr,
+                        nullptr, 0);
+  if (result == 0) {
+    return true;
+  }
+  // EAGAIN means the word no longer held the expected value and EINTR is a
+  // spurious wakeup, both of which are handled by the caller's loop.
+  FML_DCHECK(errno == ETIMEDOUT || errno == EAGAIN || errno == EINTR);
+  return errno != ETIMEDOUT;
+}
+
+void FutexWake(std::atomic<uint32_t>* word, int count) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE,
+          count, nullptr, nullptr, 0);
+}
+
+size_t FutexSpinCount() {
+  static const size_t spin_count =
+      std::thread::hardware_concurrency() > 1 ? kSpinCount : 0;
+  return spin_count;
+}
+
+}  // namespace fml
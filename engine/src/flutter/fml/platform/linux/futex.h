@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_FUTEX_H_
+#define FLUTTER_FML_PLATFORM_LINUX_FUTEX_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "Futex words must be plain 32 bit integers.");
+
+/// Atomically checks that `*word` still holds `expected` and, if so, puts the
+/// calling thread to sleep until |FutexWake| is called on the same word or
+/// `timeout` elapses. Like all futex waits, this may also return spuriously,
+/// so callers must re-check their condition in a loop.
+///
+/// Returns false if the timeout elapsed and true otherwise.
+bool FutexWait(std::atomic<uint32_t>* word,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout = std::nullopt);
+
+/// Wakes at most `count` threads sleeping in |FutexWait| on `word`.
+///
+/// The word is only used as a key and is never dereferenced, so this may be
+/// called after the object owning it has been destroyed by a woken waiter.
+void FutexWake(std::atomic<uint32_t>* word, int count);
+
+/// The number of iterations of |SpinUntil|.
+size_t FutexSpinCount();
+
+/// Tells the CPU that the caller is in a spin loop.
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/// Busy-waits for `predicate` to become true for a short while before a caller
+/// parks in |FutexWait|. Hand-offs between running threads usually complete
+/// within this window, which avoids two system calls and a context switch.
+/// Returns false without spinning on single core machines.
+template <typename Predicate>
+bool SpinUntil(const Predicate& predicate) {
+  const size_t spin_count = FutexSpinCount();
+  for (size_t i = 0; i < spin_count; i++) {
+    if (predicate()) {
+      return true;
+    }
+    CpuRelax();
+  }
+  return false;
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_FUTEX_H_
@@ -4,23 +4,19 @@
 
 #include "flutter/fml/platform/win/wstring_conversion.h"
 
-#include <codecvt>
-#include <locale>
 #include <string>
 
-namespace fml {
+#include "flutter/fml/string_conversion.h"
 
-using WideStringConverter =
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t>;
+namespace fml {
 
 std::string WideStringToUtf8(const std::wstring_view str) {
-  WideStringConverter converter;
-  return converter.to_bytes(str.data());
+  return Utf16ToUtf8(std::u16string_view(
+      reinterpret_cast<const char16_t*>(str.data()), str.size()));
 }
 
 std::wstring Utf8ToWideString(const std::string_view str) {
-  WideStringConverter converter;
-  return converter.from_bytes(str.data());
+  return Utf16ToWideString(Utf8ToUtf16(str));
 }
 
 std::u16string WideStringToUtf16(const std::wstring_view str) {
@@ -4,24 +4,139 @@
 
 #include "flutter/fml/string_conversion.h"
 
-#include <codecvt>
-#include <locale>
+#include <cstdint>
 #include <sstream>
 #include <string>
 
 #include "flutter/fml/build_config.h"
 
-#if defined(FML_OS_WIN)
-// TODO(naifu): https://github.com/flutter/flutter/issues/98074
-// Eliminate this workaround for a link error on Windows when the underlying
-// bug is fixed.
-std::locale::id std::codecvt<char16_t, char, _Mbstatet>::id;
-#endif  // defined(FML_OS_WIN)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FML_STRING_CONVERSION_SSE2 1
+#elif defined(FML_ARCH_CPU_ARM64) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FML_STRING_CONVERSION_NEON 1
+#endif
 
 namespace fml {
 
-using Utf16StringConverter =
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>;
+namespace {
+
+// Replaces each sequence that isn't valid UTF-8 or UTF-16.
+constexpr char32_t kReplacementCharacter = 0xfffd;
+
+#if FML_STRING_CONVERSION_SSE2 || FML_STRING_CONVERSION_NEON
+// The number of code units converted at a time where vector instructions are
+// available. Most strings are mostly ASCII, which is converted without
+// decoding it.
+constexpr size_t kBlockSize = 16;
+#endif
+
+// Converts the ASCII characters at the start of |src| to UTF-16 at |dst|, a
+// block at a time, and returns the number converted.
+size_t WidenAscii(const uint8_t* src, size_t size, char16_t* dst) {
+  size_t converted = 0;
+#if FML_STRING_CONVERSION_SSE2
+  for (; size - converted >= kBlockSize; converted += kBlockSize) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + converted));
+    if (_mm_movemask_epi8(in) != 0) {
+      break;
+    }
+    __m128i* out = reinterpret_cast<__m128i*>(dst + converted);
+    _mm_storeu_si128(out, _mm_unpacklo_epi8(in, _mm_setzero_si128()));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(in, _mm_setzero_si128()));
+  }
+#elif FML_STRING_CONVERSION_NEON
+  for (; size - converted >= kBlockSize; converted += kBlockSize) {
+    const uint8x16_t in = vld1q_u8(src + converted);
+    if (vmaxvq_u8(in) >= 0x80) {
+      break;
+    }
+    uint16_t* out = reinterpret_cast<uint16_t*>(dst + converted);
+    vst1q_u16(out, vmovl_u8(vget_low_u8(in)));
+    vst1q_u16(out + 8, vmovl_u8(vget_high_u8(in)));
+  }
+#endif
+  return converted;
+}
+
+// Converts the ASCII characters at the start of |src| to UTF-8 at |dst|, a
+// block at a time, and returns the number converted.
+size_t NarrowAscii(const char16_t* src, size_t size, uint8_t* dst) {
+  size_t converted = 0;
+#if FML_STRING_CONVERSION_SSE2
+  for (; size - converted >= kBlockSize; converted += kBlockSize) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src + converted);
+    const __m128i low = _mm_loadu_si128(in);
+    const __m128i high = _mm_loadu_si128(in + 1);
+    const __m128i non_ascii =
+        _mm_and_si128(_mm_or_si128(low, high), _mm_set1_epi16(-0x80));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, _mm_setzero_si128())) !=
+        0xffff) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + converted),
+                     _mm_packus_epi16(low, high));
+  }
+#elif FML_STRING_CONVERSION_NEON
+  for (; size - converted >= kBlockSize; converted += kBlockSize) {
+    const uint16_t* in = reinterpret_cast<const uint16_t*>(src + converted);
+    const uint16x8_t low = vld1q_u16(in);
+    const uint16x8_t high = vld1q_u16(in + 8);
+    if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80) {
+      break;
+    }
+    vst1q_u8(dst + converted, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+  }
+#endif
+  return converted;
+}
+
+// Decodes the UTF-8 sequence at the start of |data|, whose first byte isn't
+// ASCII, into |code_point| and returns its length. If the sequence isn't
+// valid, decodes the replacement character instead and returns the length of
+// its longest valid prefix, or 1, so that each invalid sequence is replaced
+// once, as the Unicode standard recommends.
+size_t DecodeUtf8Sequence(const uint8_t* data,
+                          size_t size,
+                          char32_t* code_point) {
+  const uint8_t lead = data[0];
+  size_t length;
+  // The valid range of the second byte, which excludes overlong encodings,
+  // surrogates and code points above U+10FFFF.
+  uint8_t min = 0x80;
+  uint8_t max = 0xbf;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    length = 2;
+    *code_point = lead & 0x1f;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    length = 3;
+    *code_point = lead & 0x0f;
+    min = lead == 0xe0 ? 0xa0 : min;
+    max = lead == 0xed ? 0x9f : max;
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    length = 4;
+    *code_point = lead & 0x07;
+    min = lead == 0xf0 ? 0x90 : min;
+    max = lead == 0xf4 ? 0x8f : max;
+  } else {
+    *code_point = kReplacementCharacter;
+    return 1;
+  }
+  for (size_t i = 1; i < length; i++) {
+    if (i >= size || data[i] < min || data[i] > max) {
+      *code_point = kReplacementCharacter;
+      return i;
+    }
+    *code_point = *code_point << 6 | (data[i] & 0x3f);
+    min = 0x80;
+    max = 0xbf;
+  }
+  return length;
+}
+
+}  // namespace
 
 std::string Join(const std::vector<std::string>& vec, const char* delim) {
   std::stringstream res;
@@ -35,13 +150,78 @@ std::string Join(const std::vector<std::string>& vec, const char* delim) {
 }
 
 std::string Utf16ToUtf8(const std::u16string_view string) {
-  Utf16StringConverter converter;
-  return converter.to_bytes(string.data());
+  // Each code unit takes at most 3 bytes, as those of surrogate pairs take 2.
+  std::string result(string.size() * 3, '\0');
+  uint8_t* dst = reinterpret_cast<uint8_t*>(result.data());
+  size_t length = 0;
+  for (size_t i = 0; i < string.size();) {
+    const size_t ascii =
+        NarrowAscii(string.data() + i, string.size() - i, dst + length);
+    i += ascii;
+    length += ascii;
+    if (i == string.size()) {
+      break;
+    }
+    char32_t code_point = string[i++];
+    if (code_point >= 0xd800 && code_point <= 0xdfff) {
+      // Unpaired surrogates are replaced.
+      const char32_t trail = i < string.size() ? string[i] : 0;
+      if (code_point <= 0xdbff && trail >= 0xdc00 && trail <= 0xdfff) {
+        code_point = 0x10000 + ((code_point - 0xd800) << 10) + (trail - 0xdc00);
+        i++;
+      } else {
+        code_point = kReplacementCharacter;
+      }
+    }
+    if (code_point < 0x80) {
+      dst[length++] = code_point;
+    } else if (code_point < 0x800) {
+      dst[length++] = 0xc0 | (code_point >> 6);
+      dst[length++] = 0x80 | (code_point & 0x3f);
+    } else if (code_point < 0x10000) {
+      dst[length++] = 0xe0 | (code_point >> 12);
+      dst[length++] = 0x80 | ((code_point >> 6) & 0x3f);
+      dst[length++] = 0x80 | (code_point & 0x3f);
+    } else {
+      dst[length++] = 0xf0 | (code_point >> 18);
+      dst[length++] = 0x80 | ((code_point >> 12) & 0x3f);
+      dst[length++] = 0x80 | ((code_point >> 6) & 0x3f);
+      dst[length++] = 0x80 | (code_point & 0x3f);
+    }
+  }
+  result.resize(length);
+  return result;
 }
 
 std::u16string Utf8ToUtf16(const std::string_view string) {
-  Utf16StringConverter converter;
-  return converter.from_bytes(string.data());
+  // Each byte takes at most 1 code unit, as sequences that take 2 are 4
+  // bytes long.
+  std::u16string result(string.size(), u'\0');
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(string.data());
+  char16_t* dst = result.data();
+  size_t length = 0;
+  for (size_t i = 0; i < string.size();) {
+    const size_t ascii = WidenAscii(src + i, string.size() - i, dst + length);
+    i += ascii;
+    length += ascii;
+    if (i == string.size()) {
+      break;
+    }
+    if (src[i] < 0x80) {
+      dst[length++] = src[i++];
+      continue;
+    }
+    char32_t code_point;
+    i += DecodeUtf8Sequence(src + i, string.size() - i, &code_point);
+    if (code_point < 0x10000) {
+      dst[length++] = code_point;
+    } else {
+      dst[length++] = 0xd800 + ((code_point - 0x10000) >> 10);
+      dst[length++] = 0xdc00 + ((code_point - 0x10000) & 0x3ff);
+    }
+  }
+  result.resize(length);
+  return result;
 }
 
 std::string PathToUtf8(const std::filesystem::path& path) {
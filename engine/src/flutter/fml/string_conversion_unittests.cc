@@ -33,6 +33,47 @@ TEST(StringConversion, Utf16ToUtf8Unicode) {
   EXPECT_EQ(Utf16ToUtf8(u"\x2603"), "\xe2\x98\x83");
 }
 
+TEST(StringConversion, Utf8ToUtf16LongText) {
+  // Long enough to be converted in blocks where vector instructions are
+  // available, with characters outside ASCII in and between them.
+  std::string utf8;
+  std::u16string utf16;
+  for (int i = 0; i < 100; i++) {
+    utf8 += "abcdefghijklmnopqrstu\xe2\x98\x83\xf0\x9f\x98\x80";
+    utf16 += u"abcdefghijklmnopqrstu\x2603\xd83d\xde00";
+  }
+  EXPECT_EQ(Utf8ToUtf16(utf8), utf16);
+  EXPECT_EQ(Utf16ToUtf8(utf16), utf8);
+}
+
+TEST(StringConversion, Utf8ToUtf16EmbeddedNull) {
+  EXPECT_EQ(Utf8ToUtf16(std::string_view("a\0b", 3)),
+            std::u16string(u"a\0b", 3));
+  EXPECT_EQ(Utf16ToUtf8(std::u16string_view(u"a\0b", 3)),
+            std::string("a\0b", 3));
+}
+
+TEST(StringConversion, Utf8ToUtf16ReplacesInvalidSequences) {
+  // A lone continuation byte.
+  EXPECT_EQ(Utf8ToUtf16("a\x80z"), u"a\xfffdz");
+  // A truncated sequence, which is replaced once.
+  EXPECT_EQ(Utf8ToUtf16("a\xe2\x98z"), u"a\xfffdz");
+  EXPECT_EQ(Utf8ToUtf16("a\xe2\x98"), u"a\xfffd");
+  // An overlong encoding of '/'.
+  EXPECT_EQ(Utf8ToUtf16("\xc0\xaf"), u"\xfffd\xfffd");
+  // An encoded surrogate.
+  EXPECT_EQ(Utf8ToUtf16("\xed\xa0\x80"), u"\xfffd\xfffd\xfffd");
+  // Past U+10FFFF.
+  EXPECT_EQ(Utf8ToUtf16("\xf4\x90\x80\x80"), u"\xfffd\xfffd\xfffd\xfffd");
+}
+
+TEST(StringConversion, Utf16ToUtf8ReplacesUnpairedSurrogates) {
+  EXPECT_EQ(Utf16ToUtf8(u"a\xd83d"), "a\xef\xbf\xbd");
+  EXPECT_EQ(Utf16ToUtf8(u"a\xde00z"), "a\xef\xbf\xbdz");
+  EXPECT_EQ(Utf16ToUtf8(u"\xd83d\xd83d\xde00"),
+            "\xef\xbf\xbd\xf0\x9f\x98\x80");
+}
+
 TEST(StringConversion, PathToUtf8) {
   EXPECT_EQ(PathToUtf8(std::filesystem::path("abc")), "abc");
   EXPECT_EQ(PathToUtf8(std::filesystem::path(u"\x2603")), "\xe2\x98\x83");
@@ -108,6 +108,90 @@ class PlatformSemaphore {
 
 }  // namespace fml
 
+#elif defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <atomic>
+#include <climits>
+
+#include "flutter/fml/platform/linux/futex.h"
+
+namespace fml {
+
+// A semaphore that spins briefly and then parks on a futex. The count is kept
+// shifted left by one, and the low bit is set while waiters may be parked in
+// the kernel. |Signal()| clears it and wakes them all, waiters that lose the
+// race for the count set it again before parking.
+class PlatformSemaphore {
+ public:
+  explicit PlatformSemaphore(uint32_t count) : state_(count << 1) {
+    FML_DCHECK(count <= kMaxCount);
+  }
+
+  ~PlatformSemaphore() = default;
+
+  bool IsValid() const { return true; }
+
+  bool Wait() {
+    if (TryWait() || SpinUntil([this]() { return TryWait(); })) {
+      return true;
+    }
+
+    uint32_t current = state_.load(std::memory_order_relaxed);
+    while (true) {
+      if (current >= kCountIncrement) {
+        if (state_.compare_exchange_weak(current, current - kCountIncrement,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+          return true;
+        }
+        continue;
+      }
+      if ((current & kParkedBit) == 0) {
+        if (!state_.compare_exchange_weak(current, current | kParkedBit,
+                                          std::memory_order_relaxed)) {
+          continue;
+        }
+        current |= kParkedBit;
+      }
+      FutexWait(&state_, current);
+      current = state_.load(std::memory_order_relaxed);
+    }
+  }
+
+  bool TryWait() {
+    uint32_t current = state_.load(std::memory_order_relaxed);
+    while (current >= kCountIncrement) {
+      if (state_.compare_exchange_weak(current, current - kCountIncrement,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Signal() {
+    uint32_t current = state_.load(std::memory_order_relaxed);
+    while (!state_.compare_exchange_weak(
+        current, (current + kCountIncrement) & ~kParkedBit,
+        std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    if ((current & kParkedBit) != 0) {
+      FutexWake(&state_, INT_MAX);
+    }
+  }
+
+ private:
+  static constexpr uint32_t kParkedBit = 1;
+  static constexpr uint32_t kCountIncrement = 2;
+  static constexpr uint32_t kMaxCount = UINT32_MAX >> 1;
+
+  std::atomic<uint32_t> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformSemaphore);
+};
+
+}  // namespace fml
+
 #else
 #include <semaphore.h>
 #include "flutter/fml/eintr_wrapper.h"
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <chrono>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/thread.h"
@@ -42,3 +44,21 @@ TEST(SemaphoreTest, IndefiniteWait) {
   ASSERT_GE(delta.ToSecondsF(), wait_in_seconds);
   signaller.Join();
 }
+
+TEST(SemaphoreTest, WakesAllParkedWaiters) {
+  constexpr size_t kWaiterCount = 4;
+  fml::Semaphore sem(0);
+  std::vector<std::thread> waiters;
+  for (size_t i = 0; i < kWaiterCount; i++) {
+    waiters.emplace_back([&sem]() { ASSERT_TRUE(sem.Wait()); });
+  }
+  // Give the waiters a chance to block.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  for (size_t i = 0; i < kWaiterCount; i++) {
+    sem.Signal();
+  }
+  for (auto& waiter : waiters) {
+    waiter.join();
+  }
+  ASSERT_FALSE(sem.TryWait());
+}
@@ -5,14 +5,201 @@
 #include "flutter/fml/synchronization/waitable_event.h"
 
 #include <cerrno>
+#include <climits>
 #include <ctime>
+#include <optional>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include "flutter/fml/platform/linux/futex.h"
+#endif
+
 namespace fml {
 
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+// Both events spin briefly and then park in the kernel on a futex. Signaling
+// an event that nobody is parked on is a single atomic operation, and neither
+// |Signal()| touches the event after that operation (the futex address is only
+// used as a key), so it is safe for a waiter to destroy the event as soon as
+// its wait returns.
+
+namespace {
+
+// Values of |AutoResetWaitableEvent::state_|.
+constexpr uint32_t kUnsignaled = 0;
+constexpr uint32_t kSignaled = 1;
+constexpr uint32_t kParked = 2;
+
+// Bits of |ManualResetWaitableEvent::state_|.
+constexpr uint32_t kSignaledBit = 1;
+constexpr uint32_t kParkedBit = 2;
+constexpr uint32_t kSignalIdIncrement = 4;
+constexpr uint32_t kSignalIdMask = ~(kSignaledBit | kParkedBit);
+
+// Returns the point in time |timeout| from now, saturating rather than
+// overflowing for very long timeouts.
+TimePoint DeadlineAfter(TimeDelta timeout) {
+  const TimePoint now = TimePoint::Now();
+  if (timeout > TimePoint::Max() - now) {
+    return TimePoint::Max();
+  }
+  return now + timeout;
+}
+
+// Returns the time left until |deadline|, which is unbounded if there is no
+// deadline.
+std::optional<TimeDelta> TimeRemaining(std::optional<TimePoint> deadline) {
+  if (!deadline.has_value()) {
+    return std::nullopt;
+  }
+  return deadline.value() - TimePoint::Now();
+}
+
+// Consumes the signal of an auto-reset event. Returns false if |deadline|
+// passed first.
+bool AutoResetWait(std::atomic<uint32_t>& state,
+                   std::optional<TimePoint> deadline) {
+  auto try_consume = [&state]() {
+    uint32_t expected = kSignaled;
+    return state.load(std::memory_order_relaxed) == kSignaled &&
+           state.compare_exchange_strong(expected, kUnsignaled,
+                                         std::memory_order_acquire);
+  };
+  if (try_consume() || SpinUntil(try_consume)) {
+    return true;
+  }
+
+  // Once a thread has parked it consumes the signal by leaving the event in
+  // |kParked| rather than |kUnsignaled|, as other threads may still be parked.
+  // This costs at most one unnecessary wake on the next |Signal()|.
+  uint32_t current = state.load(std::memory_order_relaxed);
+  while (true) {
+    if (current == kSignaled) {
+      if (state.compare_exchange_weak(current, kParked,
+                                      std::memory_order_acquire,
+                                      std::memory_order_relaxed)) {
+        return true;
+      }
+      continue;
+    }
+    if (current == kUnsignaled) {
+      if (!state.compare_exchange_weak(current, kParked,
+                                       std::memory_order_relaxed)) {
+        continue;
+      }
+      current = kParked;
+    }
+
+    auto timeout = TimeRemaining(deadline);
+    if (timeout.has_value() && timeout.value() <= TimeDelta::Zero()) {
+      return false;
+    }
+    FutexWait(&state, kParked, timeout);
+    current = state.load(std::memory_order_relaxed);
+  }
+}
+
+// Waits for a manual-reset event to be signaled, or to have been signaled and
+// reset since the wait started. Returns false if |deadline| passed first.
+bool ManualResetWait(std::atomic<uint32_t>& state,
+                     std::optional<TimePoint> deadline) {
+  uint32_t current = state.load(std::memory_order_acquire);
+  const uint32_t signal_id = current & kSignalIdMask;
+  auto released = [signal_id](uint32_t value) {
+    return (value & kSignaledBit) != 0 || (value & kSignalIdMask) != signal_id;
+  };
+  if (released(current) ||
+      SpinUntil([&state, &released]() {
+        return released(state.load(std::memory_order_acquire));
+      })) {
+    return true;
+  }
+
+  current = state.load(std::memory_order_acquire);
+  while (true) {
+    if (released(current)) {
+      return true;
+    }
+    if ((current & kParkedBit) == 0) {
+      if (!state.compare_exchange_weak(current, current | kParkedBit,
+                                       std::memory_order_acquire)) {
+        continue;
+      }
+      current |= kParkedBit;
+    }
+
+    auto timeout = TimeRemaining(deadline);
+    if (timeout.has_value() && timeout.value() <= TimeDelta::Zero()) {
+      return false;
+    }
+    FutexWait(&state, current, timeout);
+    current = state.load(std::memory_order_acquire);
+  }
+}
+
+}  // namespace
+
+// AutoResetWaitableEvent ------------------------------------------------------
+
+void AutoResetWaitableEvent::Signal() {
+  if (state_.exchange(kSignaled, std::memory_order_release) == kParked) {
+    FutexWake(&state_, 1);
+  }
+}
+
+void AutoResetWaitableEvent::Reset() {
+  uint32_t expected = kSignaled;
+  state_.compare_exchange_strong(expected, kUnsignaled,
+                                 std::memory_order_relaxed);
+}
+
+void AutoResetWaitableEvent::Wait() {
+  AutoResetWait(state_, std::nullopt);
+}
+
+bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  return !AutoResetWait(state_, DeadlineAfter(timeout));
+}
+
+bool AutoResetWaitableEvent::IsSignaledForTest() {
+  return state_.load(std::memory_order_relaxed) == kSignaled;
+}
+
+// ManualResetWaitableEvent ----------------------------------------------------
+
+void ManualResetWaitableEvent::Signal() {
+  uint32_t current = state_.load(std::memory_order_relaxed);
+  while (!state_.compare_exchange_weak(
+      current, ((current | kSignaledBit) & ~kParkedBit) + kSignalIdIncrement,
+      std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  if ((current & kParkedBit) != 0) {
+    FutexWake(&state_, INT_MAX);
+  }
+}
+
+void ManualResetWaitableEvent::Reset() {
+  state_.fetch_and(~kSignaledBit, std::memory_order_relaxed);
+}
+
+void ManualResetWaitableEvent::Wait() {
+  ManualResetWait(state_, std::nullopt);
+}
+
+bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  return !ManualResetWait(state_, DeadlineAfter(timeout));
+}
+
+bool ManualResetWaitableEvent::IsSignaledForTest() {
+  return (state_.load(std::memory_order_relaxed) & kSignaledBit) != 0;
+}
+
+#else  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
 // Waits with a timeout on |condition()|. Returns true on timeout, or false if
 // |condition()| ever returns true. |condition()| should have no side effects
 // (and will always be called with |*mutex| held).
@@ -173,4 +360,6 @@ bool ManualResetWaitableEvent::IsSignaledForTest() {
   return signaled_;
 }
 
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
 }  // namespace fml
@@ -10,9 +10,12 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 #define FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 
@@ -38,8 +41,8 @@ class AutoResetWaitableEvent final {
   //   call to |Signal()|.
   // * A |Signal()|, followed by a |Reset()|, may cause *no* waiting thread to
   //   be unblocked.
-  // * We rely on pthreads's queueing for picking which waiting thread to
-  //   unblock, rather than enforcing FIFO ordering.
+  // * We rely on the kernel's (or pthreads's) queueing for picking which
+  //   waiting thread to unblock, rather than enforcing FIFO ordering.
   void Signal();
 
   // Put the event into the unsignaled state. Generally, this is not recommended
@@ -62,11 +65,17 @@ class AutoResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  // The futex word. One of |kUnsignaled|, |kSignaled| or |kParked|, the latter
+  // meaning unsignaled with threads that may be waiting in the kernel.
+  std::atomic<uint32_t> state_ = 0;
+#else
   std::condition_variable cv_;
   std::mutex mutex_;
 
   // True if this event is in the signaled state.
   bool signaled_ = false;
+#endif
 
   FML_DISALLOW_COPY_AND_ASSIGN(AutoResetWaitableEvent);
 };
@@ -104,6 +113,12 @@ class ManualResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  // The futex word. The low bit is set while the event is signaled and the
+  // next bit while threads may be waiting in the kernel. The remaining bits
+  // count signals, for the same reason as |signal_id_| below.
+  std::atomic<uint32_t> state_ = 0;
+#else
   std::condition_variable cv_;
   std::mutex mutex_;
 
@@ -118,6 +133,7 @@ class ManualResetWaitableEvent final {
   // |std::condition_variable::notify_all()|. A waiting thread knows it was
   // awoken if |signal_id_| is different from when it started waiting.
   unsigned signal_id_ = 0u;
+#endif
 
   FML_DISALLOW_COPY_AND_ASSIGN(ManualResetWaitableEvent);
 };
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/waitable_event.h"
+
+#include <atomic>
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/semaphore.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Measures the round trip latency of handing control back and forth between
+// two threads, as in a synchronous |RunNowOrPostTask| style hand-off.
+template <typename Event>
+static void PingPong(benchmark::State& state) {
+  Event ping;
+  Event pong;
+  std::atomic_bool done = false;
+  std::thread responder([&]() {
+    while (true) {
+      ping.Wait();
+      if (done) {
+        return;
+      }
+      pong.Signal();
+    }
+  });
+
+  while (state.KeepRunning()) {
+    ping.Signal();
+    pong.Wait();
+  }
+
+  done = true;
+  ping.Signal();
+  responder.join();
+}
+
+static void BM_AutoResetWaitableEventPingPong(
+    benchmark::State& state) {  // NOLINT
+  PingPong<AutoResetWaitableEvent>(state);
+}
+
+BENCHMARK(BM_AutoResetWaitableEventPingPong)->UseRealTime();
+
+namespace {
+// Adapts |ManualResetWaitableEvent| to auto-reset on wake up.
+class ManualResetPingPongEvent {
+ public:
+  void Signal() { event_.Signal(); }
+
+  void Wait() {
+    event_.Wait();
+    event_.Reset();
+  }
+
+ private:
+  ManualResetWaitableEvent event_;
+};
+
+// Adapts |Semaphore| to the event interface.
+class SemaphorePingPongEvent {
+ public:
+  void Signal() { semaphore_.Signal(); }
+
+  void Wait() {
+    bool result = semaphore_.Wait();
+    (void)result;
+  }
+
+ private:
+  Semaphore semaphore_{0};
+};
+}  // namespace
+
+static void BM_ManualResetWaitableEventPingPong(
+    benchmark::State& state) {  // NOLINT
+  PingPong<ManualResetPingPongEvent>(state);
+}
+
+BENCHMARK(BM_ManualResetWaitableEventPingPong)->UseRealTime();
+
+static void BM_SemaphorePingPong(benchmark::State& state) {  // NOLINT
+  PingPong<SemaphorePingPongEvent>(state);
+}
+
+BENCHMARK(BM_SemaphorePingPong)->UseRealTime();
+
+// Measures signaling an event that no thread waits on, the common case for
+// latches that are signaled before the other side gets to wait.
+static void BM_AutoResetWaitableEventSignalAndWait(
+    benchmark::State& state) {  // NOLINT
+  AutoResetWaitableEvent event;
+  while (state.KeepRunning()) {
+    event.Signal();
+    event.Wait();
+  }
+}
+
+BENCHMARK(BM_AutoResetWaitableEventSignalAndWait);
+
+}  // namespace benchmarking
+}  // namespace fml
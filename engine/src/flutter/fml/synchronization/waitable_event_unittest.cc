@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -186,6 +187,41 @@ TEST(ManualResetWaitableEventTest, SignalMultiple) {
   }
 }
 
+TEST(ManualResetWaitableEventTest, SignalThenResetReleasesWaiters) {
+  ManualResetWaitableEvent ev;
+  AutoResetWaitableEvent waiting;
+  std::thread thread([&]() {
+    waiting.Signal();
+    ev.Wait();
+  });
+  waiting.Wait();
+  // Give the thread a chance to block.
+  SleepFor(kEpsilonTimeout);
+  ev.Signal();
+  ev.Reset();
+  thread.join();
+  EXPECT_FALSE(ev.IsSignaledForTest());
+}
+
+// Waiters commonly destroy an event as soon as their wait returns, while the
+// signaling thread may still be inside |Signal()|.
+TEST(WaitableEventTest, EventsCanBeDestroyedOnceWaitReturns) {
+  for (size_t i = 0u; i < 1000u; i++) {
+    auto auto_reset = std::make_unique<AutoResetWaitableEvent>();
+    auto manual_reset = std::make_unique<ManualResetWaitableEvent>();
+    std::thread thread([auto_event = auto_reset.get(),
+                        manual_event = manual_reset.get()]() {
+      auto_event->Signal();
+      manual_event->Signal();
+    });
+    auto_reset->Wait();
+    auto_reset.reset();
+    manual_reset->Wait();
+    manual_reset.reset();
+    thread.join();
+  }
+}
+
 }  // namespace
 }  // namespace fml
 
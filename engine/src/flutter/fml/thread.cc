@@ -147,6 +147,9 @@ Thread::Thread(const ThreadConfigSetter& setter, const ThreadConfig& config)
   thread_ = std::make_unique<ThreadHandle>(
       [&latch, &runner, setter, config]() -> void {
         setter(config);
+        if (config.affinity.has_value()) {
+          fml::RequestAffinity(config.affinity.value());
+        }
         fml::MessageLoop::EnsureInitializedForCurrentThread();
         auto& loop = MessageLoop::GetCurrent();
         runner = loop.GetTaskRunner();
@@ -8,8 +8,10 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -29,10 +31,13 @@ class Thread {
     kDisplay,
   };
 
-  /// The ThreadConfig is the thread info include thread name, thread priority.
+  /// The ThreadConfig is the thread info include thread name, thread priority
+  /// and an optional CPU affinity hint.
   struct ThreadConfig {
-    ThreadConfig(const std::string& name, ThreadPriority priority)
-        : name(name), priority(priority) {}
+    ThreadConfig(const std::string& name,
+                 ThreadPriority priority,
+                 std::optional<CpuAffinity> affinity = std::nullopt)
+        : name(name), priority(priority), affinity(affinity) {}
 
     explicit ThreadConfig(const std::string& name)
         : ThreadConfig(name, ThreadPriority::kNormal) {}
@@ -41,6 +46,9 @@ class Thread {
 
     std::string name;
     ThreadPriority priority;
+    /// If set, the thread requests this affinity via |fml::RequestAffinity|
+    /// once the config setter has run.
+    std::optional<CpuAffinity> affinity;
   };
 
   using ThreadConfigSetter = std::function<void(const ThreadConfig&)>;
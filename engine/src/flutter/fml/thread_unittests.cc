@@ -16,6 +16,10 @@
 #else
 #endif
 
+#if defined(FML_OS_LINUX)
+#include <sched.h>
+#endif
+
 #if defined(FML_OS_WIN)
 #include "flutter/fml/platform/win/windows_shim.h"
 #endif
@@ -164,4 +168,26 @@ TEST(Thread, LinuxLongThreadNameTruncated) {
   });
   thread.Join();
 }
+
+TEST(Thread, LinuxAffinityHintStaysWithinAllowedCpus) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+
+  fml::Thread thread(fml::Thread::SetCurrentThreadName,
+                     fml::Thread::ThreadConfig(
+                         "affinity", fml::Thread::ThreadPriority::kNormal,
+                         fml::CpuAffinity::kNotPerformance));
+  bool done = false;
+  thread.GetTaskRunner()->PostTask([&]() {
+    cpu_set_t current;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(current), &current), 0);
+    cpu_set_t within;
+    CPU_AND(&within, &current, &allowed);
+    ASSERT_GT(CPU_COUNT(&current), 0);
+    ASSERT_TRUE(CPU_EQUAL(&within, &current));
+    done = true;
+  });
+  thread.Join();
+  ASSERT_TRUE(done);
+}
 #endif  // FML_OS_LINUX
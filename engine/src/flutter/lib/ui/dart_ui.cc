@@ -49,6 +49,7 @@ namespace flutter {
   V(PlatformConfigurationNativeApi::ComputePlatformResolvedLocale) \
   V(PlatformConfigurationNativeApi::SendPlatformMessage)           \
   V(PlatformConfigurationNativeApi::RespondToPlatformMessage)      \
+  V(PlatformConfigurationNativeApi::CreatePlatformMessageData)     \
   V(PlatformConfigurationNativeApi::GetRootIsolateToken)           \
   V(PlatformConfigurationNativeApi::RegisterBackgroundIsolate)     \
   V(PlatformConfigurationNativeApi::SendPortPlatformMessage)       \
@@ -48,6 +48,55 @@ void setLatencyPerformanceMode() {
   _finish();
 }
 
+@pragma('vm:entry-point')
+void persistentIsolateDataIsShared() {
+  final ByteData first = PlatformDispatcher.instance.getPersistentIsolateData()!;
+  final ByteData second = PlatformDispatcher.instance.getPersistentIsolateData()!;
+  bool didThrowOnModify = false;
+  try {
+    first.setUint8(0, 0);
+  } catch (e) {
+    didThrowOnModify = true;
+  }
+  _validatePersistentIsolateData(first, identical(first, second), didThrowOnModify);
+}
+
+@pragma('vm:external-name', 'ValidatePersistentIsolateData')
+external void _validatePersistentIsolateData(
+  ByteData data,
+  bool isSameObject,
+  bool didThrowOnModify,
+);
+
+@pragma('vm:entry-point')
+void sharedPlatformMessageData() {
+  final ByteData shared = PlatformDispatcher.instance.createPlatformMessageData(4096);
+  for (int i = 0; i < shared.lengthInBytes; i++) {
+    shared.setUint8(i, i & 0xff);
+  }
+  _validateSharedPlatformMessageData(
+    shared,
+    ByteData.sublistView(shared, 16, 2064),
+    ByteData(4096),
+  );
+}
+
+@pragma('vm:external-name', 'ValidateSharedPlatformMessageData')
+external void _validateSharedPlatformMessageData(ByteData shared, ByteData view, ByteData copied);
+
+@pragma('vm:entry-point')
+void incomingPlatformMessageDataIsWritable() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+        data!.setUint8(0, 1);
+        _validateIncomingPlatformMessageData(data);
+      };
+  _finish();
+}
+
+@pragma('vm:external-name', 'ValidateIncomingPlatformMessageData')
+external void _validateIncomingPlatformMessageData(ByteData data);
+
 @pragma('vm:entry-point')
 void platformMessagePortResponseTest() async {
   ReceivePort receivePort = ReceivePort();
@@ -63,6 +112,79 @@ void platformMessagePortResponseTest() async {
   }
 }
 
+@pragma('vm:entry-point')
+void platformMessagePortResponseConcurrentTest() async {
+  const int responseCount = 8;
+  final ReceivePort receivePort = ReceivePort();
+  _callPlatformMessageResponseDartPortConcurrently(receivePort.sendPort.nativePort);
+  final Set<int> identifiers = <int>{};
+  bool didPass = true;
+  await for (final dynamic message in receivePort) {
+    final List<dynamic> response = message as List<dynamic>;
+    didPass = didPass && response.length == 2;
+    final int identifier = response[0] as int;
+    final Uint8List bytes = response[1] as Uint8List;
+    identifiers.add(identifier);
+    didPass = didPass && bytes.length == 4096 && bytes[0] == identifier;
+    try {
+      bytes[0] = 0;
+      // Large responses should be read only.
+      didPass = false;
+    } on UnsupportedError {
+      // Expected.
+    }
+    if (identifiers.length == responseCount) {
+      break;
+    }
+  }
+  receivePort.close();
+  _finishCallResponse(didPass);
+}
+
+@pragma('vm:entry-point')
+void platformMessagePortResponseBatchedTest() async {
+  const int responseCount = 8;
+  final ReceivePort receivePort = ReceivePort();
+  _callPlatformMessageResponseDartPortBatched(receivePort.sendPort.nativePort);
+  final Set<int> identifiers = <int>{};
+  bool didPass = true;
+  await for (final dynamic message in receivePort) {
+    final List<dynamic> responses = message as List<dynamic>;
+    didPass = didPass && responses.length.isEven;
+    for (int i = 0; i < responses.length; i += 2) {
+      final int identifier = responses[i] as int;
+      final Uint8List? bytes = responses[i + 1] as Uint8List?;
+      identifiers.add(identifier);
+      if (identifier == 0) {
+        // The empty response.
+        didPass = didPass && bytes == null;
+      } else {
+        didPass = didPass && bytes!.length == 4096 && bytes[0] == identifier;
+      }
+    }
+    if (identifiers.length == responseCount) {
+      break;
+    }
+  }
+  receivePort.close();
+  _finishCallResponse(didPass);
+}
+
+@pragma('vm:entry-point')
+void platformMessagePortResponseBenchmark() {
+  final ReceivePort receivePort = ReceivePort();
+  receivePort.listen((dynamic message) {
+    // Batched responses arrive as several [identifier, data] pairs.
+    _portResponsesReceived((message as List<dynamic>).length ~/ 2);
+  });
+  _startPortResponseBenchmark(receivePort.sendPort.nativePort);
+}
+
+@pragma('vm:external-name', 'StartPortResponseBenchmark')
+external void _startPortResponseBenchmark(int port);
+@pragma('vm:external-name', 'PortResponsesReceived')
+external void _portResponsesReceived(int count);
+
 @pragma('vm:entry-point')
 void platformMessageResponseTest() {
   _callPlatformMessageResponseDart((ByteData? result) {
@@ -84,6 +206,10 @@ void platformMessageResponseTest() {
 
 @pragma('vm:external-name', 'CallPlatformMessageResponseDartPort')
 external void _callPlatformMessageResponseDartPort(int port);
+@pragma('vm:external-name', 'CallPlatformMessageResponseDartPortConcurrently')
+external void _callPlatformMessageResponseDartPortConcurrently(int port);
+@pragma('vm:external-name', 'CallPlatformMessageResponseDartPortBatched')
+external void _callPlatformMessageResponseDartPortBatched(int port);
 @pragma('vm:external-name', 'CallPlatformMessageResponseDart')
 external void _callPlatformMessageResponseDart(void Function(ByteData? result) callback);
 @pragma('vm:external-name', 'FinishCallResponse')
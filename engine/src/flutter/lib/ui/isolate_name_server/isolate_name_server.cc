@@ -6,20 +6,48 @@
 
 namespace flutter {
 
-IsolateNameServer::IsolateNameServer() {}
+namespace {
+std::atomic<uint64_t> gNextNameServerId = 1;
+}  // namespace
+
+IsolateNameServer::IsolateNameServer()
+    : id_(gNextNameServerId.fetch_add(1, std::memory_order_relaxed)),
+      port_mapping_(std::make_shared<const PortMapping>()) {}
 
 IsolateNameServer::~IsolateNameServer() = default;
 
-Dart_PortEx IsolateNameServer::LookupIsolatePortByName(
-    const std::string& name) {
-  std::scoped_lock lock(mutex_);
-  return LookupIsolatePortByNameUnprotected(name);
+const IsolateNameServer::PortMapping& IsolateNameServer::LoadSnapshot()
+    const {
+  struct CachedSnapshot {
+    uint64_t server_id = 0;
+    uint64_t version = 0;
+    std::shared_ptr<const PortMapping> port_mapping;
+  };
+  thread_local CachedSnapshot cached;
+
+  // The version is read before the snapshot. If a mutation races with this
+  // load, the cached snapshot is newer than its recorded version and is simply
+  // reloaded on the next lookup.
+  const uint64_t version = version_.load(std::memory_order_acquire);
+  if (cached.server_id != id_ || cached.version != version) {
+    cached.server_id = id_;
+    cached.version = version;
+    cached.port_mapping = std::atomic_load(&port_mapping_);
+  }
+  return *cached.port_mapping;
+}
+
+void IsolateNameServer::PublishLocked(
+    std::shared_ptr<const PortMapping> port_mapping) {
+  std::atomic_store(&port_mapping_, std::move(port_mapping));
+  version_.fetch_add(1, std::memory_order_release);
 }
 
-Dart_PortEx IsolateNameServer::LookupIsolatePortByNameUnprotected(
-    const std::string& name) {
-  auto port_iterator = port_mapping_.find(name);
-  if (port_iterator != port_mapping_.end()) {
+Dart_PortEx IsolateNameServer::LookupIsolatePortByName(
+    const std::string& name) const {
+  const PortMapping& port_mapping = LoadSnapshot();
+  auto port_iterator = port_mapping.find(name);
+  if (port_iterator != port_mapping.end()) {
     return port_iterator->second;
   }
   return {ILLEGAL_PORT, ILLEGAL_PORT};
@@ -28,21 +56,26 @@ Dart_PortEx IsolateNameServer::LookupIsolatePortByNameUnprotected(
 bool IsolateNameServer::RegisterIsolatePortWithName(Dart_PortEx port,
                                                     const std::string& name) {
   std::scoped_lock lock(mutex_);
-  if (LookupIsolatePortByNameUnprotected(name).port_id != ILLEGAL_PORT) {
+  const auto& current = *port_mapping_;
+  if (current.find(name) != current.end()) {
     // Name is already registered.
     return false;
   }
-  port_mapping_[name] = port;
+  auto updated = std::make_shared<PortMapping>(current);
+  updated->emplace(name, port);
+  PublishLocked(std::move(updated));
   return true;
 }
 
 bool IsolateNameServer::RemoveIsolateNameMapping(const std::string& name) {
   std::scoped_lock lock(mutex_);
-  auto port_iterator = port_mapping_.find(name);
-  if (port_iterator == port_mapping_.end()) {
+  const auto& current = *port_mapping_;
+  if (current.find(name) == current.end()) {
     return false;
   }
-  port_mapping_.erase(port_iterator);
+  auto updated = std::make_shared<PortMapping>(current);
+  updated->erase(name);
+  PublishLocked(std::move(updated));
   return true;
 }
 
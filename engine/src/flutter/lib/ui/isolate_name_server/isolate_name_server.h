@@ -5,15 +5,24 @@
 #ifndef FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_ISOLATE_NAME_SERVER_H_
 #define FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_ISOLATE_NAME_SERVER_H_
 
-#include <map>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "flutter/fml/macros.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
 namespace flutter {
 
+// Lookups are far more frequent than registrations (worker isolates look up
+// ports on every dispatch), so the name server publishes an immutable snapshot
+// of the mapping along with a version number. Each thread caches the last
+// snapshot it saw and only reloads it when the version changes, so steady
+// state lookups are a single atomic load and never write to shared memory.
+// Mutations are serialized, copy the snapshot and publish the modified copy.
 class IsolateNameServer {
  public:
   IsolateNameServer();
@@ -21,8 +30,9 @@ class IsolateNameServer {
   ~IsolateNameServer();
 
   // Looks up the Dart_Port associated with a given name. Returns ILLEGAL_PORT
-  // if the name does not exist.
-  Dart_PortEx LookupIsolatePortByName(const std::string& name);
+  // if the name does not exist. This is safe to call concurrently with any
+  // other method and does not take the mutation lock.
+  Dart_PortEx LookupIsolatePortByName(const std::string& name) const;
 
   // Registers a Dart_Port with a given name. Returns true if registration is
   // successful, false if the name entry already exists.
@@ -33,10 +43,23 @@ class IsolateNameServer {
   bool RemoveIsolateNameMapping(const std::string& name);
 
  private:
-  Dart_PortEx LookupIsolatePortByNameUnprotected(const std::string& name);
+  using PortMapping = std::unordered_map<std::string, Dart_PortEx>;
 
-  mutable std::mutex mutex_;
-  std::map<std::string, Dart_PortEx> port_mapping_;
+  // Returns the calling thread's cached snapshot, reloading it if stale. The
+  // reference is valid until the next call on the same thread.
+  const PortMapping& LoadSnapshot() const;
+
+  void PublishLocked(std::shared_ptr<const PortMapping> port_mapping);
+
+  // Distinguishes name servers in the per-thread snapshot cache. Unlike the
+  // address of the instance, this is never reused.
+  const uint64_t id_;
+  // Serializes mutations. Readers never take this lock.
+  std::mutex mutex_;
+  // Only ever accessed through std::atomic_load and std::atomic_store.
+  std::shared_ptr<const PortMapping> port_mapping_;
+  // Incremented after every change to |port_mapping_|.
+  std::atomic<uint64_t> version_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(IsolateNameServer);
 };
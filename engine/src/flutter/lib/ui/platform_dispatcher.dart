@@ -116,6 +116,9 @@ class PlatformDispatcher {
   ///
   /// The framework invokes [callback] in the same zone in which this method was
   /// called.
+  ///
+  /// Large payloads created with [createPlatformMessageData] are handed to
+  /// the engine without being copied; see [createPlatformMessageData].
   void sendPlatformMessage(String name, ByteData? data, PlatformMessageResponseCallback? callback) {
     final String? error = _sendPlatformMessage(
       name,
@@ -150,17 +153,45 @@ class PlatformDispatcher {
   /// of the channel communication will happen on. The [data] parameter is the
   /// payload of the message. The [identifier] parameter is a unique integer
   /// assigned to the message.
-  void sendPortPlatformMessage(String name, ByteData? data, int identifier, SendPort port) {
-    final String? error = _sendPortPlatformMessage(name, identifier, port.nativePort, data);
+  ///
+  /// The response is sent to [port] as `[identifier, data]`, where `data`
+  /// is a [Uint8List], or as `null` if the response is empty. Large payloads
+  /// are unmodifiable views of the engine's buffer rather than copies.
+  ///
+  /// If [batchResponses] is true, responses that complete at the same time
+  /// for the same port may arrive together as
+  /// `[identifier1, data1, identifier2, data2, ...]`, which takes fewer
+  /// messages when many requests are in flight. Empty responses are then
+  /// pairs whose `data` is `null`. All the messages that use a port should
+  /// pass the same value, so that its receiver can tell the formats apart.
+  void sendPortPlatformMessage(
+    String name,
+    ByteData? data,
+    int identifier,
+    SendPort port, {
+    bool batchResponses = false,
+  }) {
+    final String? error = _sendPortPlatformMessage(
+      name,
+      identifier,
+      port.nativePort,
+      data,
+      batchResponses,
+    );
     if (error != null) {
       throw Exception(error);
     }
   }
 
-  String? _sendPortPlatformMessage(String name, int identifier, int port, ByteData? data) =>
-      __sendPortPlatformMessage(name, identifier, port, data);
+  String? _sendPortPlatformMessage(
+    String name,
+    int identifier,
+    int port,
+    ByteData? data,
+    bool batchResponses,
+  ) => __sendPortPlatformMessage(name, identifier, port, data, batchResponses);
 
-  @Native<Handle Function(Handle, Handle, Handle, Handle)>(
+  @Native<Handle Function(Handle, Handle, Handle, Handle, Bool)>(
     symbol: 'PlatformConfigurationNativeApi::SendPortPlatformMessage',
   )
   external static String? __sendPortPlatformMessage(
@@ -168,8 +199,34 @@ class PlatformDispatcher {
     int identifier,
     int port,
     ByteData? data,
+    bool batchResponses,
   );
 
+  /// Creates a buffer of `length` zero bytes for the payload of a platform
+  /// message.
+  ///
+  /// When a buffer created by this method, or a view of part of it, is sent
+  /// with [sendPlatformMessage] or as the response to a platform message, the
+  /// engine shares the buffer rather than copying it, which makes sending
+  /// large payloads cheaper. Payloads received from the platform are not
+  /// shared, and are copied if they are sent back.
+  ///
+  /// The contents of the buffer must not be modified after it has been sent,
+  /// since the platform may read them at any time until it has handled the
+  /// message. Sending the buffer does not detach it, so this is not enforced:
+  /// modifying it afterwards can change the message the platform receives.
+  ///
+  /// This method can be called on any isolate.
+  ByteData createPlatformMessageData(int length) {
+    RangeError.checkNotNegative(length, 'length');
+    return __createPlatformMessageData(length);
+  }
+
+  @Native<Handle Function(Int64)>(
+    symbol: 'PlatformConfigurationNativeApi::CreatePlatformMessageData',
+  )
+  external static ByteData __createPlatformMessageData(int length);
+
   /// Registers the current isolate with the isolate identified with by the
   /// [token]. This is required if platform channels are to be used on a
   /// background isolate.
@@ -326,6 +383,9 @@ class PlatformDispatcher {
   ///
   /// For asynchronous communication between the embedder and isolate, a
   /// platform channel may be used.
+  ///
+  /// The returned [ByteData] is an unmodifiable view of the embedder's data
+  /// rather than a copy of it, and every call returns the same object.
   ByteData? getPersistentIsolateData() => _getPersistentIsolateData();
 
   @Native<Handle Function()>(symbol: 'PlatformConfigurationNativeApi::GetPersistentIsolateData')
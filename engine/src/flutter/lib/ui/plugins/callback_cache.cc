@@ -4,20 +4,21 @@
 
 #include "flutter/lib/ui/plugins/callback_cache.h"
 
+#include <cstring>
 #include <fstream>
 #include <iterator>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
 #include "rapidjson/document.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 using rapidjson::Document;
-using rapidjson::StringBuffer;
-using rapidjson::Writer;
 using tonic::ToDart;
 
 namespace flutter {
@@ -27,13 +28,199 @@ static const char* kRepresentationKey = "representation";
 static const char* kNameKey = "name";
 static const char* kClassNameKey = "class_name";
 static const char* kLibraryPathKey = "library_path";
-static const char* kCacheName = "flutter_callback_cache.json";
+static const char* kCacheName = "flutter_callback_cache.bin";
+static const char* kLegacyCacheName = "flutter_callback_cache.json";
 std::mutex DartCallbackCache::mutex_;
 std::string DartCallbackCache::cache_path_;
 std::map<int64_t, DartCallbackRepresentation> DartCallbackCache::cache_;
 
+// Log format (all integers in host byte order, the log never leaves the
+// device):
+//
+//   header: "FCBL" uint32 version
+//   record: uint32 payload_size
+//           uint32 payload_checksum (FNV-1a)
+//           payload: int64  handle
+//                    uint32 name_size, name
+//                    uint32 class_name_size, class_name
+//                    uint32 library_path_size, library_path
+//
+// A record that is truncated or fails its checksum (for instance because the
+// process died mid-write) ends the log. Everything before it is kept and the
+// log is compacted.
+static constexpr char kLogMagic[4] = {'F', 'C', 'B', 'L'};
+static constexpr uint32_t kLogVersion = 1;
+static constexpr size_t kLogHeaderSize = sizeof(kLogMagic) + sizeof(uint32_t);
+
+// State of the on disk log. Guarded by |DartCallbackCache::mutex_|.
+static std::string gLegacyCachePath;
+static std::string gPendingRecords;
+static bool gCompactionPending = false;
+static bool gWriteScheduled = false;
+static bool gWriterStarted = false;
+
+namespace {
+
+fml::RefPtr<fml::TaskRunner> GetWriterTaskRunner() {
+  // Leaked intentionally so that writes posted during static destruction do
+  // not race the teardown of the thread.
+  static fml::Thread* writer = new fml::Thread("io.flutter.callback_cache");
+  return writer->GetTaskRunner();
+}
+
+uint32_t Checksum(const char* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template <typename T>
+void AppendValue(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendString(std::string& out, const std::string& value) {
+  AppendValue<uint32_t>(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
+}
+
+void AppendHeader(std::string& out) {
+  out.append(kLogMagic, sizeof(kLogMagic));
+  AppendValue<uint32_t>(out, kLogVersion);
+}
+
+void AppendRecord(std::string& out,
+                  int64_t handle,
+                  const DartCallbackRepresentation& cb) {
+  const size_t record_start = out.size();
+  AppendValue<uint32_t>(out, 0);
+  AppendValue<uint32_t>(out, 0);
+  const size_t payload_start = out.size();
+  AppendValue<int64_t>(out, handle);
+  AppendString(out, cb.name);
+  AppendString(out, cb.class_name);
+  AppendString(out, cb.library_path);
+
+  const uint32_t payload_size = out.size() - payload_start;
+  const uint32_t checksum = Checksum(out.data() + payload_start, payload_size);
+  std::memcpy(out.data() + record_start, &payload_size, sizeof(payload_size));
+  std::memcpy(out.data() + record_start + sizeof(payload_size), &checksum,
+              sizeof(checksum));
+}
+
+class LogReader {
+ public:
+  LogReader(const uint8_t* data, size_t size)
+      : cursor_(reinterpret_cast<const char*>(data)), end_(cursor_ + size) {}
+
+  bool AtEnd() const { return cursor_ == end_; }
+
+  size_t Remaining() const { return end_ - cursor_; }
+
+  const char* cursor() const { return cursor_; }
+
+  template <typename T>
+  bool ReadValue(T* value) {
+    if (Remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(value, cursor_, sizeof(T));
+    cursor_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string* value) {
+    uint32_t size = 0;
+    if (!ReadValue(&size) || Remaining() < size) {
+      return false;
+    }
+    value->assign(cursor_, size);
+    cursor_ += size;
+    return true;
+  }
+
+  bool Skip(size_t size) {
+    if (Remaining() < size) {
+      return false;
+    }
+    cursor_ += size;
+    return true;
+  }
+
+ private:
+  const char* cursor_;
+  const char* end_;
+};
+
+bool HasLogHeader(const char* data, size_t size) {
+  uint32_t version = 0;
+  if (size < kLogHeaderSize ||
+      std::memcmp(data, kLogMagic, sizeof(kLogMagic)) != 0) {
+    return false;
+  }
+  std::memcpy(&version, data + sizeof(kLogMagic), sizeof(version));
+  return version == kLogVersion;
+}
+
+// Decodes the records of |mapping| into |cache|. Returns whether the entire log
+// was well formed.
+bool DecodeLog(const fml::Mapping& mapping,
+               size_t* record_count,
+               std::map<int64_t, DartCallbackRepresentation>* cache) {
+  LogReader reader(mapping.GetMapping(), mapping.GetSize());
+  if (!HasLogHeader(reader.cursor(), reader.Remaining())) {
+    return false;
+  }
+  reader.Skip(kLogHeaderSize);
+
+  while (!reader.AtEnd()) {
+    uint32_t payload_size = 0;
+    uint32_t checksum = 0;
+    if (!reader.ReadValue(&payload_size) || !reader.ReadValue(&checksum) ||
+        reader.Remaining() < payload_size ||
+        Checksum(reader.cursor(), payload_size) != checksum) {
+      return false;
+    }
+    LogReader payload(reinterpret_cast<const uint8_t*>(reader.cursor()),
+                      payload_size);
+    reader.Skip(payload_size);
+
+    int64_t handle = 0;
+    DartCallbackRepresentation cb;
+    if (!payload.ReadValue(&handle) || !payload.ReadString(&cb.name) ||
+        !payload.ReadString(&cb.class_name) ||
+        !payload.ReadString(&cb.library_path) || !payload.AtEnd()) {
+      return false;
+    }
+    (*cache)[handle] = std::move(cb);
+    (*record_count)++;
+  }
+  return true;
+}
+
+// Records can be appended to a log with a valid header and to missing or empty
+// files, in which case |needs_header| is set.
+bool CanAppendToLog(const std::string& path, bool* needs_header) {
+  std::ifstream input(path, std::ios::binary);
+  char header[kLogHeaderSize];
+  input.read(header, sizeof(header));
+  const size_t read = input.gcount();
+  *needs_header = read == 0;
+  return read == 0 || HasLogHeader(header, read);
+}
+
+}  // namespace
+
 void DartCallbackCache::SetCachePath(const std::string& path) {
+  // Records registered so far belong to the previous path.
+  FlushPendingWrites();
+
+  std::scoped_lock lock(mutex_);
   cache_path_ = fml::paths::JoinPaths({path, kCacheName});
+  gLegacyCachePath = fml::paths::JoinPaths({path, kLegacyCacheName});
 }
 
 Dart_Handle DartCallbackCache::GetCallback(int64_t handle) {
@@ -55,9 +242,11 @@ int64_t DartCallbackCache::GetCallbackHandle(const std::string& name,
   hash += hasher(class_name);
   hash += hasher(library_path);
 
-  if (cache_.find(hash) == cache_.end()) {
-    cache_[hash] = {name, class_name, library_path};
-    SaveCacheToDisk();
+  auto [iterator, inserted] =
+      cache_.try_emplace(hash, DartCallbackRepresentation{
+                                   name, class_name, library_path});
+  if (inserted) {
+    ScheduleWriteLocked(hash, iterator->second);
   }
   return hash;
 }
@@ -72,56 +261,133 @@ DartCallbackCache::GetCallbackInformation(int64_t handle) {
   return nullptr;
 }
 
-void DartCallbackCache::SaveCacheToDisk() {
-  // Cache JSON format
-  // [
-  //   {
-  //      "hash": 42,
-  //      "representation": {
-  //          "name": "...",
-  //          "class_name": "...",
-  //          "library_path": "..."
-  //      }
-  //   },
-  //   {
-  //   ...
-  //   }
-  // ]
-  StringBuffer s;
-  Writer<StringBuffer> writer(s);
-  writer.StartArray();
-  for (auto iterator = cache_.begin(); iterator != cache_.end(); ++iterator) {
-    int64_t hash = iterator->first;
-    DartCallbackRepresentation cb = iterator->second;
-    writer.StartObject();
-    writer.Key(kHandleKey);
-    writer.Int64(hash);
-    writer.Key(kRepresentationKey);
-    writer.StartObject();
-    writer.Key(kNameKey);
-    writer.String(cb.name.c_str());
-    writer.Key(kClassNameKey);
-    writer.String(cb.class_name.c_str());
-    writer.Key(kLibraryPathKey);
-    writer.String(cb.library_path.c_str());
-    writer.EndObject();
-    writer.EndObject();
-  }
-  writer.EndArray();
-
-  std::ofstream output(cache_path_);
-  output << s.GetString();
-  output.close();
+void DartCallbackCache::ScheduleWriteLocked(
+    int64_t handle,
+    const DartCallbackRepresentation& cb) {
+  if (cache_path_.empty()) {
+    return;
+  }
+  AppendRecord(gPendingRecords, handle, cb);
+  PostWriteLocked();
+}
+
+void DartCallbackCache::ScheduleCompactionLocked() {
+  if (cache_path_.empty()) {
+    return;
+  }
+  gCompactionPending = true;
+  PostWriteLocked();
+}
+
+void DartCallbackCache::PostWriteLocked() {
+  // Registrations arriving before the writer gets to run are batched into a
+  // single write.
+  if (!gWriteScheduled) {
+    gWriteScheduled = true;
+    gWriterStarted = true;
+    GetWriterTaskRunner()->PostTask(&DartCallbackCache::WritePendingRecords);
+  }
+}
+
+void DartCallbackCache::WritePendingRecords() {
+  TRACE_EVENT0("flutter", "DartCallbackCache::WritePendingRecords");
+  // At most two passes: an append may discover that the file on disk is not a
+  // log it can append to and fall back to a compaction.
+  for (int pass = 0; pass < 2; pass++) {
+    std::string path;
+    std::string contents;
+    bool truncate = false;
+    {
+      std::scoped_lock lock(mutex_);
+      gWriteScheduled = false;
+      path = cache_path_;
+      if (gCompactionPending) {
+        // The snapshot includes every pending record.
+        gCompactionPending = false;
+        gPendingRecords.clear();
+        AppendHeader(contents);
+        for (const auto& [handle, cb] : cache_) {
+          AppendRecord(contents, handle, cb);
+        }
+        truncate = true;
+      } else {
+        contents.swap(gPendingRecords);
+      }
+    }
+    if (path.empty() || contents.empty()) {
+      return;
+    }
+
+    if (!truncate) {
+      bool needs_header = false;
+      if (!CanAppendToLog(path, &needs_header)) {
+        std::scoped_lock lock(mutex_);
+        gCompactionPending = true;
+        continue;
+      }
+      if (needs_header) {
+        std::string header;
+        AppendHeader(header);
+        contents.insert(0, header);
+      }
+    }
+
+    // The log is rewritten in place rather than replaced so that attributes
+    // set on the file by the embedder (such as being excluded from backups)
+    // are preserved.
+    std::ofstream output(path, std::ios::binary | (truncate ? std::ios::trunc
+                                                            : std::ios::app));
+    output.write(contents.data(), contents.size());
+    if (!output) {
+      FML_LOG(ERROR) << "Could not write the callback cache to " << path;
+    }
+    return;
+  }
+}
+
+void DartCallbackCache::FlushPendingWrites() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (!gWriterStarted) {
+      return;
+    }
+  }
+  fml::AutoResetWaitableEvent latch;
+  GetWriterTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
+
+void DartCallbackCache::ResetForTesting() {
+  FlushPendingWrites();
+  std::scoped_lock lock(mutex_);
+  cache_.clear();
 }
 
 void DartCallbackCache::LoadCacheFromDisk() {
+  TRACE_EVENT0("flutter", "DartCallbackCache::LoadCacheFromDisk");
   std::scoped_lock lock(mutex_);
 
   // Don't reload the cache if it's already populated.
   if (!cache_.empty()) {
     return;
   }
-  std::ifstream input(cache_path_);
+
+  auto mapping = fml::FileMapping::CreateReadOnly(cache_path_);
+  if (!mapping || mapping->GetSize() == 0) {
+    LoadLegacyCacheLocked(gLegacyCachePath);
+    return;
+  }
+
+  size_t record_count = 0;
+  const bool intact = DecodeLog(*mapping, &record_count, &cache_);
+  if (!intact || record_count != cache_.size()) {
+    // Drop the corrupt tail or duplicate records.
+    ScheduleCompactionLocked();
+  }
+}
+
+void DartCallbackCache::LoadLegacyCacheLocked(const std::string& legacy_path) {
+  std::ifstream input(legacy_path);
   if (!input) {
     return;
   }
@@ -145,6 +411,11 @@ void DartCallbackCache::LoadCacheFromDisk() {
     cb.library_path = representation[kLibraryPathKey].GetString();
     cache_[hash] = cb;
   }
+
+  // Migrate the entries to the binary log.
+  if (!cache_.empty()) {
+    ScheduleCompactionLocked();
+  }
 }
 
 Dart_Handle DartCallbackCache::LookupDartClosure(
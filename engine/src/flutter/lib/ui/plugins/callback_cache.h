@@ -21,6 +21,13 @@ struct DartCallbackRepresentation {
   std::string library_path;
 };
 
+// The cache is persisted as an append-only binary log. Newly registered
+// callbacks are appended to the log by a background writer, so registration
+// never blocks on disk I/O. Records are only appended for handles that are not
+// in the cache yet, so they never go stale. The log is rewritten from scratch
+// (compacted) when it is found to contain duplicate or corrupt records on load,
+// or when it cannot be appended to. Caches written by earlier versions in JSON
+// are migrated on load.
 class DartCallbackCache {
  public:
   static void SetCachePath(const std::string& path);
@@ -37,12 +44,27 @@ class DartCallbackCache {
 
   static void LoadCacheFromDisk();
 
+  // Blocks until all callbacks registered so far have been written to disk.
+  static void FlushPendingWrites();
+
+  // Drops all in-memory entries. The log on disk is left untouched.
+  static void ResetForTesting();
+
  private:
   static Dart_Handle LookupDartClosure(const std::string& name,
                                        const std::string& class_name,
                                        const std::string& library_path);
 
-  static void SaveCacheToDisk();
+  static void LoadLegacyCacheLocked(const std::string& legacy_path);
+
+  static void ScheduleWriteLocked(int64_t handle,
+                                  const DartCallbackRepresentation& cb);
+
+  static void ScheduleCompactionLocked();
+
+  static void PostWriteLocked();
+
+  static void WritePendingRecords();
 
   static std::mutex mutex_;
   static std::string cache_path_;
@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/plugins/callback_cache.h"
+
+#include <fstream>
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+class CallbackCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    DartCallbackCache::SetCachePath(temp_dir_.path());
+    DartCallbackCache::ResetForTesting();
+  }
+
+  void TearDown() override { DartCallbackCache::ResetForTesting(); }
+
+  size_t GetLogSize() {
+    DartCallbackCache::FlushPendingWrites();
+    auto mapping =
+        fml::FileMapping::CreateReadOnly(DartCallbackCache::GetCachePath());
+    return mapping ? mapping->GetSize() : 0;
+  }
+
+  fml::ScopedTemporaryDirectory temp_dir_;
+};
+}  // namespace
+
+TEST_F(CallbackCacheTest, RestoresRegisteredCallbacks) {
+  const int64_t first =
+      DartCallbackCache::GetCallbackHandle("first", "", "package:a/a.dart");
+  const int64_t second =
+      DartCallbackCache::GetCallbackHandle("second", "Klass", "");
+  // Registering an existing callback does not append to the log.
+  const size_t log_size = GetLogSize();
+  EXPECT_GT(log_size, 0u);
+  EXPECT_EQ(DartCallbackCache::GetCallbackHandle("first", "",
+                                                 "package:a/a.dart"),
+            first);
+  EXPECT_EQ(GetLogSize(), log_size);
+
+  DartCallbackCache::ResetForTesting();
+  ASSERT_EQ(DartCallbackCache::GetCallbackInformation(first), nullptr);
+  DartCallbackCache::LoadCacheFromDisk();
+
+  auto info = DartCallbackCache::GetCallbackInformation(first);
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->name, "first");
+  EXPECT_EQ(info->class_name, "");
+  EXPECT_EQ(info->library_path, "package:a/a.dart");
+  info = DartCallbackCache::GetCallbackInformation(second);
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->name, "second");
+  EXPECT_EQ(info->class_name, "Klass");
+}
+
+TEST_F(CallbackCacheTest, KeepsRecordsBeforeTornWrite) {
+  const int64_t handle = DartCallbackCache::GetCallbackHandle("cb", "", "");
+  const size_t log_size = GetLogSize();
+  {
+    std::ofstream log(DartCallbackCache::GetCachePath(),
+                      std::ios::binary | std::ios::app);
+    log << "torn";
+  }
+  ASSERT_EQ(GetLogSize(), log_size + 4);
+
+  DartCallbackCache::ResetForTesting();
+  DartCallbackCache::LoadCacheFromDisk();
+  EXPECT_NE(DartCallbackCache::GetCallbackInformation(handle), nullptr);
+  // The log is compacted to drop the torn record.
+  EXPECT_EQ(GetLogSize(), log_size);
+}
+
+TEST_F(CallbackCacheTest, CompactsDuplicateRecords) {
+  const int64_t handle = DartCallbackCache::GetCallbackHandle("cb", "", "");
+  const size_t log_size = GetLogSize();
+  {
+    // Appends a second copy of the only record, which follows the 8 byte
+    // header.
+    auto mapping =
+        fml::FileMapping::CreateReadOnly(DartCallbackCache::GetCachePath());
+    ASSERT_NE(mapping, nullptr);
+    const std::string record(
+        reinterpret_cast<const char*>(mapping->GetMapping()) + 8,
+        mapping->GetSize() - 8);
+    std::ofstream log(DartCallbackCache::GetCachePath(),
+                      std::ios::binary | std::ios::app);
+    log << record;
+  }
+  ASSERT_GT(GetLogSize(), log_size);
+
+  DartCallbackCache::ResetForTesting();
+  DartCallbackCache::LoadCacheFromDisk();
+  EXPECT_NE(DartCallbackCache::GetCallbackInformation(handle), nullptr);
+  EXPECT_EQ(GetLogSize(), log_size);
+}
+
+TEST_F(CallbackCacheTest, CompactsLogsItCannotAppendTo) {
+  {
+    std::ofstream log(DartCallbackCache::GetCachePath(), std::ios::binary);
+    log << "not a callback cache log";
+  }
+  const int64_t handle = DartCallbackCache::GetCallbackHandle("cb", "", "");
+  ASSERT_GT(GetLogSize(), 0u);
+
+  // The file was replaced by a log holding only the new record.
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(DartCallbackCache::GetCachePath());
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        4),
+            "FCBL");
+  DartCallbackCache::ResetForTesting();
+  DartCallbackCache::LoadCacheFromDisk();
+  EXPECT_NE(DartCallbackCache::GetCallbackInformation(handle), nullptr);
+}
+
+TEST_F(CallbackCacheTest, MigratesLegacyJsonCache) {
+  {
+    std::ofstream legacy(fml::paths::JoinPaths(
+        {temp_dir_.path(), "flutter_callback_cache.json"}));
+    legacy << R"([{"handle":42,"representation":{"name":"legacy",)"
+           << R"("class_name":"","library_path":"lib.dart"}}])";
+  }
+  DartCallbackCache::LoadCacheFromDisk();
+  auto info = DartCallbackCache::GetCallbackInformation(42);
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->name, "legacy");
+  EXPECT_EQ(info->library_path, "lib.dart");
+  EXPECT_GT(GetLogSize(), 0u);
+
+  // The binary log takes precedence from now on.
+  DartCallbackCache::ResetForTesting();
+  ASSERT_TRUE(fml::UnlinkFile(fml::paths::JoinPaths(
+                                  {temp_dir_.path(),
+                                   "flutter_callback_cache.json"})
+                                  .c_str()));
+  DartCallbackCache::LoadCacheFromDisk();
+  EXPECT_NE(DartCallbackCache::GetCallbackInformation(42), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,13 +4,22 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/file.h"
+#include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
+#include "flutter/lib/ui/plugins/callback_cache.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
+#include "flutter/lib/ui/window/platform_message_response_dart_port.h"
+#include "flutter/lib/ui/window/platform_message_response_table.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/tonic/converter/dart_converter.h"
 
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <mutex>
 
 namespace flutter {
 
@@ -66,4 +75,257 @@ static void BM_PlatformMessageResponseDartComplete(benchmark::State& state) {
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+// The number of responses completed per iteration of the response throughput
+// benchmarks.
+static constexpr int kResponsesPerIteration = 16;
+
+static std::unique_ptr<fml::Mapping> CreateResponse(size_t size) {
+  return std::make_unique<fml::MallocMapping>(
+      static_cast<uint8_t*>(calloc(size, 1)), size);
+}
+
+// Replies to messages sent from the root isolate, which are delivered by
+// invoking a closure on the UI thread. The first argument is the size of each
+// response.
+static void BM_PlatformMessageResponseDartThroughput(benchmark::State& state) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::kPlatform | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+  const size_t size = state.range(0);
+
+  std::vector<fml::RefPtr<PlatformMessageResponseDart>> responses;
+  for (auto _ : state) {
+    state.PauseTiming();
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle closure = Dart_GetField(
+          Dart_RootLibrary(), Dart_NewStringFromCString("messageCallback"));
+      for (int i = 0; i < kResponsesPerIteration; i++) {
+        responses.push_back(fml::MakeRefCounted<PlatformMessageResponseDart>(
+            tonic::DartPersistentValue(isolate->get(), closure),
+            thread_host.ui_thread->GetTaskRunner(), ""));
+      }
+      return true;
+    });
+    FML_CHECK(successful);
+    state.ResumeTiming();
+
+    for (auto& response : responses) {
+      response->Complete(CreateResponse(size));
+    }
+    std::promise<bool> completed;
+    task_runners.GetUITaskRunner()->PostTask(
+        [&completed] { completed.set_value(true); });
+    completed.get_future().wait();
+
+    state.PauseTiming();
+    responses.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kResponsesPerIteration);
+  state.SetBytesProcessed(state.iterations() * kResponsesPerIteration * size);
+}
+
+BENCHMARK(BM_PlatformMessageResponseDartThroughput)
+    ->ArgName("size")
+    ->Arg(64)
+    ->Arg(4 << 10)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// Replies to messages sent over a port, as background isolates do, which are
+// delivered as Dart_CObjects to a ReceivePort. The fixture stands in for the
+// background isolate; the delivery path is the same for any isolate. The
+// first argument is the size of each response, and the second whether the
+// receiver opted into batching.
+static void BM_PlatformMessageResponseDartPortThroughput(
+    benchmark::State& state) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::kPlatform | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner());
+  Fixture fixture;
+
+  std::mutex mutex;
+  std::condition_variable received_condition;
+  Dart_Port port = ILLEGAL_PORT;
+  int64_t received = 0;
+  fixture.AddNativeCallback(
+      "StartPortResponseBenchmark",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        std::scoped_lock lock(mutex);
+        port = tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        received_condition.notify_all();
+      })));
+  fixture.AddNativeCallback(
+      "PortResponsesReceived",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        std::scoped_lock lock(mutex);
+        received += tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        received_condition.notify_all();
+      })));
+
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate = testing::RunDartCodeInIsolate(
+      vm_ref, settings, task_runners, "platformMessagePortResponseBenchmark",
+      {}, testing::GetDefaultKernelFilePath(), {});
+  {
+    std::unique_lock lock(mutex);
+    received_condition.wait(lock, [&] { return port != ILLEGAL_PORT; });
+  }
+  const size_t size = state.range(0);
+  const bool batch_responses = state.range(1) != 0;
+
+  int64_t expected = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kResponsesPerIteration; i++) {
+      auto response = fml::MakeRefCounted<PlatformMessageResponseDartPort>(
+          port, expected++, "", batch_responses);
+      response->Complete(CreateResponse(size));
+    }
+    std::unique_lock lock(mutex);
+    received_condition.wait(lock, [&] { return received == expected; });
+  }
+  state.SetItemsProcessed(state.iterations() * kResponsesPerIteration);
+  state.SetBytesProcessed(state.iterations() * kResponsesPerIteration * size);
+}
+
+BENCHMARK(BM_PlatformMessageResponseDartPortThroughput)
+    ->ArgNames({"size", "batched"})
+    ->ArgsProduct({{64, 4 << 10, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+namespace {
+class NoopResponse : public PlatformMessageResponse {
+ public:
+  void Complete(std::unique_ptr<fml::Mapping> data) override {}
+  void CompleteEmpty() override {}
+};
+}  // namespace
+
+// Stores and takes the responses to platform messages dispatched to the
+// framework while the given number of other responses are in flight, as
+// PlatformConfiguration does for every message that expects a response.
+static void BM_PlatformMessageResponseTable(benchmark::State& state) {
+  const int64_t in_flight = state.range(0);
+  auto response = fml::MakeRefCounted<NoopResponse>();
+  PlatformMessageResponseTable table;
+  std::deque<int> ids;
+  for (int64_t i = 0; i < in_flight; i++) {
+    ids.push_back(table.Add(response));
+  }
+  for (auto _ : state) {
+    // The framework responds to the oldest message first.
+    ids.push_back(table.Add(response));
+    benchmark::DoNotOptimize(table.Take(ids.front()));
+    ids.pop_front();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PlatformMessageResponseTable)
+    ->ArgName("in_flight")
+    ->Arg(0)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16);
+
+// Each benchmark thread stands in for an isolate looking up a port by name,
+// as worker isolates do on every job dispatch.
+static void BM_IsolateNameServerLookup(benchmark::State& state) {
+  static IsolateNameServer* name_server = nullptr;
+  static constexpr int kRegisteredNames = 64;
+  if (state.thread_index() == 0) {
+    name_server = new IsolateNameServer();
+    for (int i = 0; i < kRegisteredNames; i++) {
+      name_server->RegisterIsolatePortWithName(
+          {static_cast<Dart_Port>(i + 1), static_cast<Dart_Port>(i + 1)},
+          "worker_port_" + std::to_string(i));
+    }
+  }
+
+  const std::string name =
+      "worker_port_" + std::to_string(state.thread_index() % kRegisteredNames);
+  const bool mutate = state.range(0) != 0 && state.thread_index() == 0;
+  int64_t iteration = 0;
+  for (auto _ : state) {
+    if (mutate && (++iteration % 64) == 0) {
+      // Simulate isolates coming and going while others look up ports.
+      name_server->RegisterIsolatePortWithName({1, 1}, "transient");
+      name_server->RemoveIsolateNameMapping("transient");
+    }
+    benchmark::DoNotOptimize(name_server->LookupIsolatePortByName(name));
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    delete name_server;
+    name_server = nullptr;
+  }
+}
+
+BENCHMARK(BM_IsolateNameServerLookup)
+    ->ArgName("mutating")
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+static constexpr int kCallbackCacheHandleCount = 10000;
+
+static void RegisterCallbackHandles() {
+  for (int i = 0; i < kCallbackCacheHandleCount; i++) {
+    DartCallbackCache::GetCallbackHandle("callback" + std::to_string(i),
+                                         "BackgroundTasks",
+                                         "package:app/background.dart");
+  }
+}
+
+// Registers the callbacks of an app with many background tasks, including
+// persisting them.
+static void BM_DartCallbackCacheRegister(benchmark::State& state) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  DartCallbackCache::SetCachePath(temp_dir.path());
+  for (auto _ : state) {
+    state.PauseTiming();
+    DartCallbackCache::ResetForTesting();
+    fml::UnlinkFile(DartCallbackCache::GetCachePath().c_str());
+    state.ResumeTiming();
+
+    RegisterCallbackHandles();
+    DartCallbackCache::FlushPendingWrites();
+  }
+  DartCallbackCache::ResetForTesting();
+  state.SetItemsProcessed(state.iterations() * kCallbackCacheHandleCount);
+}
+
+BENCHMARK(BM_DartCallbackCacheRegister)->Unit(benchmark::kMillisecond);
+
+static void BM_DartCallbackCacheRestore(benchmark::State& state) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  DartCallbackCache::SetCachePath(temp_dir.path());
+  DartCallbackCache::ResetForTesting();
+  RegisterCallbackHandles();
+  DartCallbackCache::FlushPendingWrites();
+  for (auto _ : state) {
+    state.PauseTiming();
+    DartCallbackCache::ResetForTesting();
+    state.ResumeTiming();
+
+    DartCallbackCache::LoadCacheFromDisk();
+  }
+  DartCallbackCache::ResetForTesting();
+  state.SetItemsProcessed(state.iterations() * kCallbackCacheHandleCount);
+}
+
+BENCHMARK(BM_DartCallbackCacheRestore)->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/channel_registry.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/common/engine_metrics.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// Every interned channel is counted separately by the engine metrics.
+static_assert(ChannelRegistry::kMaxChannels <= EngineMetrics::kMaxChannels);
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  // Keys point into the strings owned by |names|.
+  std::unordered_map<std::string_view, ChannelId> ids;
+  // Indexed by id. Entries are published once and never change, so they are
+  // read without taking the lock.
+  std::array<std::atomic<const std::string*>, ChannelRegistry::kMaxChannels>
+      names = {};
+  ChannelId next_id = ChannelRegistry::kUninternedChannel + 1;
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+}  // namespace
+
+ChannelId ChannelRegistry::Intern(std::string_view name) {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  auto found = registry.ids.find(name);
+  if (found != registry.ids.end()) {
+    return found->second;
+  }
+  if (registry.next_id >= kMaxChannels) {
+    return kUninternedChannel;
+  }
+  const ChannelId id = registry.next_id++;
+  const std::string* interned = new std::string(name);
+  registry.names[id].store(interned, std::memory_order_release);
+  registry.ids.emplace(*interned, id);
+  return id;
+}
+
+ChannelId ChannelRegistry::InternCached(std::string_view name) {
+  // Keys point to the interned names, which are never freed. Names that
+  // could not be interned are not cached.
+  thread_local std::unordered_map<std::string_view, ChannelId> cache;
+  auto found = cache.find(name);
+  if (found != cache.end()) {
+    return found->second;
+  }
+  const ChannelId id = Intern(name);
+  if (id != kUninternedChannel) {
+    cache.emplace(GetName(id), id);
+  }
+  return id;
+}
+
+bool ChannelRegistry::IsIdOf(ChannelId id, std::string_view name) {
+  if (id == kUninternedChannel || id >= kMaxChannels) {
+    return false;
+  }
+  const std::string* interned =
+      GetRegistry().names[id].load(std::memory_order_acquire);
+  return interned && *interned == name;
+}
+
+const std::string& ChannelRegistry::GetName(ChannelId id) {
+  static const std::string* empty = new std::string();
+  FML_DCHECK(id < kMaxChannels);
+  if (id == kUninternedChannel) {
+    return *empty;
+  }
+  const std::string* name =
+      GetRegistry().names[id].load(std::memory_order_acquire);
+  FML_DCHECK(name);
+  return *name;
+}
+
+}  // namespace flutter
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_CHANNEL_REGISTRY_H_
+#define FLUTTER_LIB_UI_WINDOW_CHANNEL_REGISTRY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace flutter {
+
+/// An interned platform channel name.
+///
+/// Ids are small, dense integers that stay the same for the lifetime of the
+/// process, so they can be compared instead of names and used to index
+/// per-channel tables.
+using ChannelId = uint32_t;
+
+/// The process-wide table of interned platform channel names.
+///
+/// Apps use a small, fixed set of channels, so names are never removed. To
+/// bound the memory used by apps that create channel names dynamically, at
+/// most |kMaxChannels| names are interned; messages on any further channels
+/// carry |kUninternedChannel| and their own copy of the name.
+///
+/// All methods are thread-safe.
+class ChannelRegistry {
+ public:
+  /// The id of channels whose names could not be interned.
+  static constexpr ChannelId kUninternedChannel = 0;
+
+  static constexpr size_t kMaxChannels = 4096;
+
+  /// Returns the id of the channel named `name`, interning the name if
+  /// needed, or |kUninternedChannel| if the registry is full.
+  static ChannelId Intern(std::string_view name);
+
+  /// Same as |Intern|, but looks `name` up in a cache local to the calling
+  /// thread first, so that sending repeatedly on a channel takes no lock.
+  static ChannelId InternCached(std::string_view name);
+
+  /// Returns whether `id` is the interned id of `name`, without taking a
+  /// lock. Used to check ids supplied by embedders.
+  static bool IsIdOf(ChannelId id, std::string_view name);
+
+  /// Returns the interned name of `id`, which lives for the lifetime of the
+  /// process. Returns an empty string for |kUninternedChannel|.
+  static const std::string& GetName(ChannelId id);
+
+  ChannelRegistry() = delete;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_CHANNEL_REGISTRY_H_
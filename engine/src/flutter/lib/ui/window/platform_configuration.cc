@@ -4,12 +4,15 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstdlib>
 #include <cstring>
 
+#include "flutter/common/engine_metrics.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/lib/ui/window/platform_message_response_dart_port.h"
+#include "flutter/lib/ui/window/shared_byte_data.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/dart_byte_data.h"
@@ -17,8 +20,31 @@
 namespace flutter {
 namespace {
 
-Dart_Handle ToByteData(const fml::Mapping& buffer) {
-  return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
+void FreeFinalizer(void* isolate_callback_data, void* peer) {
+  free(peer);
+}
+
+// Large payloads are handed to Dart without a copy. The engine gives up the
+// buffer, so Dart may write to it just as it can to smaller payloads, which
+// are copied into the Dart heap. Neither is shared with the engine when it is
+// sent back.
+Dart_Handle ToByteData(fml::MallocMapping buffer) {
+  const size_t size = buffer.GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    return tonic::DartByteData::Create(buffer.GetMapping(), size);
+  }
+  uint8_t* data = buffer.Release();
+  Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, size, data, size, FreeFinalizer);
+  if (Dart_IsError(handle)) {
+    free(data);
+  }
+  return handle;
+}
+
+// Releases the persistent isolate data mapping held by a ByteData.
+void PersistentIsolateDataFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<std::shared_ptr<const fml::Mapping>*>(peer);
 }
 
 }  // namespace
@@ -100,8 +126,11 @@ void PlatformConfiguration::DispatchPlatformMessage(
     return;
   }
   tonic::DartState::Scope scope(dart_state);
+  EngineMetrics::GetInstance().RecordChannelMessage(
+      message->channel_id(), EngineMetrics::Direction::kToFramework,
+      message->data().GetSize());
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      message->hasData() ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -111,43 +140,88 @@ void PlatformConfiguration::DispatchPlatformMessage(
 
   int response_id = 0;
   if (auto response = message->response()) {
-    response_id = next_response_id_++;
-    pending_responses_[response_id] = response;
+    response_id = pending_responses_.Add(response);
   }
 
   tonic::CheckAndHandleError(
       tonic::DartInvoke(dispatch_platform_message_.Get(),
-                        {tonic::ToDart(message->channel()), data_handle,
+                        {GetChannelName(*message), data_handle,
                          tonic::ToDart(response_id)}));
 }
 
+Dart_Handle PlatformConfiguration::GetChannelName(
+    const PlatformMessage& message) {
+  const ChannelId id = message.channel_id();
+  if (id == ChannelRegistry::kUninternedChannel) {
+    return tonic::ToDart(message.channel());
+  }
+  if (id >= channel_names_.size()) {
+    channel_names_.resize(id + 1);
+  }
+  tonic::DartPersistentValue& name = channel_names_[id];
+  if (name.is_empty()) {
+    name.Set(tonic::DartState::Current(), tonic::ToDart(message.channel()));
+  }
+  return name.Get();
+}
+
+Dart_Handle PlatformConfiguration::GetPersistentIsolateData() {
+  if (!persistent_isolate_data_.is_empty()) {
+    return persistent_isolate_data_.Get();
+  }
+  std::shared_ptr<const fml::Mapping> mapping =
+      client_->GetPersistentIsolateData();
+  if (!mapping) {
+    return Dart_Null();
+  }
+  // The ByteData keeps the mapping alive rather than owning a copy of it.
+  // The mapping is shared with the engine and any other isolates using it, so
+  // it is not reported as an external allocation of this isolate.
+  auto* peer = new std::shared_ptr<const fml::Mapping>(mapping);
+  Dart_Handle data = Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
+      /*type=*/Dart_TypedData_kByteData,
+      /*data=*/mapping->GetMapping(),
+      /*length=*/mapping->GetSize(),
+      /*peer=*/peer,
+      /*external_allocation_size=*/0,
+      /*callback=*/PersistentIsolateDataFinalizer);
+  if (Dart_IsError(data)) {
+    delete peer;
+    return data;
+  }
+  persistent_isolate_data_.Set(tonic::DartState::Current(), data);
+  return data;
+}
+
 void PlatformConfiguration::CompletePlatformMessageEmptyResponse(
     int response_id) {
   if (!response_id) {
     return;
   }
-  auto it = pending_responses_.find(response_id);
-  if (it == pending_responses_.end()) {
+  auto response = pending_responses_.Take(response_id);
+  if (!response) {
     return;
   }
-  auto response = std::move(it->second);
-  pending_responses_.erase(it);
+  EngineMetrics::GetInstance().RecordPlatformMessageRoundTrip(
+      EngineMetrics::Direction::kToFramework,
+      fml::TimePoint::Now() - response->creation_time());
   response->CompleteEmpty();
 }
 
 void PlatformConfiguration::CompletePlatformMessageResponse(
     int response_id,
-    std::vector<uint8_t> data) {
+    fml::MallocMapping data) {
   if (!response_id) {
     return;
   }
-  auto it = pending_responses_.find(response_id);
-  if (it == pending_responses_.end()) {
+  auto response = pending_responses_.Take(response_id);
+  if (!response) {
     return;
   }
-  auto response = std::move(it->second);
-  pending_responses_.erase(it);
-  response->Complete(std::make_unique<fml::DataMapping>(std::move(data)));
+  EngineMetrics::GetInstance().RecordPlatformMessageRoundTrip(
+      EngineMetrics::Direction::kToFramework,
+      fml::TimePoint::Now() - response->creation_time());
+  response->Complete(std::make_unique<fml::MallocMapping>(std::move(data)));
 }
 
 namespace {
@@ -156,16 +230,21 @@ Dart_Handle HandlePlatformMessage(
     const std::string& name,
     Dart_Handle data_handle,
     const fml::RefPtr<PlatformMessageResponse>& response) {
+  // Isolates send on the same few channels over and over, so their names
+  // are interned once per thread rather than under the registry's lock.
+  const ChannelId channel_id = ChannelRegistry::InternCached(name);
+  std::unique_ptr<PlatformMessage> message;
   if (Dart_IsNull(data_handle)) {
-    return dart_state->HandlePlatformMessage(
-        std::make_unique<PlatformMessage>(name, response));
+    message = std::make_unique<PlatformMessage>(channel_id, name, response);
   } else {
     tonic::DartByteData data(data_handle);
-    const uint8_t* buffer = static_cast<const uint8_t*>(data.data());
-    return dart_state->HandlePlatformMessage(std::make_unique<PlatformMessage>(
-        name, fml::MallocMapping::Copy(buffer, data.length_in_bytes()),
-        response));
+    message = std::make_unique<PlatformMessage>(
+        channel_id, name, SharedByteData::ToMapping(data), response);
   }
+  EngineMetrics::GetInstance().RecordChannelMessage(
+      message->channel_id(), EngineMetrics::Direction::kFromFramework,
+      message->data().GetSize());
+  return dart_state->HandlePlatformMessage(std::move(message));
 }
 }  // namespace
 
@@ -195,7 +274,8 @@ Dart_Handle PlatformConfigurationNativeApi::SendPortPlatformMessage(
     const std::string& name,
     Dart_Handle identifier,
     Dart_Handle send_port,
-    Dart_Handle data_handle) {
+    Dart_Handle data_handle,
+    bool batch_responses) {
   // This can be executed on any isolate.
   UIDartState* dart_state = UIDartState::Current();
 
@@ -207,7 +287,7 @@ Dart_Handle PlatformConfigurationNativeApi::SendPortPlatformMessage(
   fml::RefPtr<PlatformMessageResponse> response =
       fml::MakeRefCounted<PlatformMessageResponseDartPort>(
           c_send_port, tonic::DartConverter<int64_t>::FromDart(identifier),
-          name);
+          name, batch_responses);
 
   return HandlePlatformMessage(dart_state, name, data_handle, response);
 }
@@ -220,16 +300,20 @@ void PlatformConfigurationNativeApi::RespondToPlatformMessage(
         ->platform_configuration()
         ->CompletePlatformMessageEmptyResponse(response_id);
   } else {
-    // TODO(engine): Avoid this copy.
-    const uint8_t* buffer = static_cast<const uint8_t*>(data.data());
     UIDartState::Current()
         ->platform_configuration()
-        ->CompletePlatformMessageResponse(
-            response_id,
-            std::vector<uint8_t>(buffer, buffer + data.length_in_bytes()));
+        ->CompletePlatformMessageResponse(response_id,
+                                          SharedByteData::ToMapping(data));
   }
 }
 
+Dart_Handle PlatformConfigurationNativeApi::CreatePlatformMessageData(
+    int64_t length) {
+  // This can be executed on any isolate.
+  FML_DCHECK(length >= 0);
+  return SharedByteData::Create(static_cast<size_t>(length));
+}
+
 void PlatformConfigurationNativeApi::SetIsolateDebugName(
     const std::string& name) {
   UIDartState::ThrowIfUIOperationsProhibited();
@@ -252,17 +336,9 @@ int PlatformConfigurationNativeApi::RequestDartPerformanceMode(int mode) {
 Dart_Handle PlatformConfigurationNativeApi::GetPersistentIsolateData() {
   UIDartState::ThrowIfUIOperationsProhibited();
 
-  auto persistent_isolate_data = UIDartState::Current()
-                                     ->platform_configuration()
-                                     ->client()
-                                     ->GetPersistentIsolateData();
-
-  if (!persistent_isolate_data) {
-    return Dart_Null();
-  }
-
-  return tonic::DartByteData::Create(persistent_isolate_data->GetMapping(),
-                                     persistent_isolate_data->GetSize());
+  return UIDartState::Current()
+      ->platform_configuration()
+      ->GetPersistentIsolateData();
 }
 
 Dart_Handle PlatformConfigurationNativeApi::ComputePlatformResolvedLocale(
@@ -8,11 +8,11 @@
 #include <functional>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
+#include "flutter/lib/ui/window/platform_message_response_table.h"
 #include "fml/macros.h"
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/typed_data/dart_byte_data.h"
@@ -250,7 +250,7 @@ class PlatformConfiguration final {
   /// @param[in] data        The data to send back in the response.
   ///
   void CompletePlatformMessageResponse(int response_id,
-                                       std::vector<uint8_t> data);
+                                       fml::MallocMapping data);
 
   //----------------------------------------------------------------------------
   /// @brief      Responds to a previous platform message to the engine from the
@@ -261,11 +261,26 @@ class PlatformConfiguration final {
   ///
   void CompletePlatformMessageEmptyResponse(int response_id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the client's persistent isolate data as an
+  ///             unmodifiable ByteData backed by the client's mapping, or
+  ///             null if there is none.
+  ///
+  ///             The ByteData is created on the first call and the same
+  ///             object is returned afterwards, so the data is never copied.
+  ///             Only the root isolate has a platform configuration, so there
+  ///             is one such object per isolate group.
+  ///
+  Dart_Handle GetPersistentIsolateData();
+
   Dart_Handle on_error() { return on_error_.Get(); }
 
  private:
   FML_FRIEND_TEST(testing::PlatformConfigurationTest, BeginFrameMonotonic);
 
+  // Returns the name of the channel of `message` as a Dart string.
+  Dart_Handle GetChannelName(const PlatformMessage& message);
+
   PlatformConfigurationClient* client_;
   tonic::DartPersistentValue on_error_;
   tonic::DartPersistentValue set_engine_id_;
@@ -273,10 +288,13 @@ class PlatformConfiguration final {
   tonic::DartPersistentValue dispatch_platform_message_;
   tonic::DartPersistentValue invoke_hot_restart_listeners_;
 
-  // ID starts at 1 because an ID of 0 indicates that no response is expected.
-  int next_response_id_ = 1;
-  std::unordered_map<int, fml::RefPtr<PlatformMessageResponse>>
-      pending_responses_;
+  // The Dart strings for the names of interned channels, indexed by channel
+  // id, so that a new string is not allocated for every message.
+  std::vector<tonic::DartPersistentValue> channel_names_;
+
+  tonic::DartPersistentValue persistent_isolate_data_;
+
+  PlatformMessageResponseTable pending_responses_;
 };
 
 //----------------------------------------------------------------------------
@@ -319,11 +337,14 @@ class PlatformConfigurationNativeApi {
   static Dart_Handle SendPortPlatformMessage(const std::string& name,
                                              Dart_Handle identifier,
                                              Dart_Handle send_port,
-                                             Dart_Handle data_handle);
+                                             Dart_Handle data_handle,
+                                             bool batch_responses);
 
   static void RespondToPlatformMessage(int response_id,
                                        const tonic::DartByteData& data);
 
+  static Dart_Handle CreatePlatformMessageData(int64_t length);
+
   static void SendChannelUpdate(const std::string& name, bool listening);
 
   //--------------------------------------------------------------------------
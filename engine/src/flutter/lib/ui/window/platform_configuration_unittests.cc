@@ -6,12 +6,16 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/lib/ui/window/shared_byte_data.h"
 #include "flutter/shell/common/shell_test.h"
 #include "googletest/googletest/include/gtest/gtest.h"
 #include "third_party/dart/runtime/include/dart_api.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 namespace flutter {
 namespace testing {
@@ -197,5 +201,141 @@ TEST_F(PlatformConfigurationTest, SetDartPerformanceMode) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(PlatformConfigurationTest, SharesPlatformMessageDataCreatedByEngine) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  auto validate = [message_latch](Dart_NativeArguments args) {
+    tonic::DartByteData shared(Dart_GetNativeArgument(args, 0));
+    tonic::DartByteData view(Dart_GetNativeArgument(args, 1));
+    tonic::DartByteData copied(Dart_GetNativeArgument(args, 2));
+
+    fml::MallocMapping shared_mapping = SharedByteData::ToMapping(shared);
+    EXPECT_EQ(shared_mapping.GetMapping(), shared.data());
+    EXPECT_EQ(shared_mapping.GetSize(), 4096u);
+
+    fml::MallocMapping view_mapping = SharedByteData::ToMapping(view);
+    EXPECT_EQ(view_mapping.GetMapping(),
+              static_cast<const uint8_t*>(shared.data()) + 16);
+    EXPECT_EQ(view_mapping.GetSize(), 2048u);
+    EXPECT_EQ(view_mapping.GetMapping()[0], 16);
+
+    fml::MallocMapping copied_mapping = SharedByteData::ToMapping(copied);
+    EXPECT_NE(copied_mapping.GetMapping(), copied.data());
+    EXPECT_EQ(copied_mapping.GetSize(), 4096u);
+
+    // Releasing shared data hands out a copy the caller can free.
+    uint8_t* released = view_mapping.Release();
+    EXPECT_NE(released, static_cast<const uint8_t*>(shared.data()) + 16);
+    EXPECT_EQ(released[1], 17);
+    free(released);
+
+    message_latch->Signal();
+  };
+  AddNativeCallback("ValidateSharedPlatformMessageData",
+                    CREATE_NATIVE_ENTRY(validate));
+
+  Settings settings = CreateSettingsForFixture();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread()        // ui
+  );
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("sharedPlatformMessageData");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
+TEST_F(PlatformConfigurationTest, IncomingPlatformMessageDataIsWritable) {
+  fml::AutoResetWaitableEvent ready_latch;
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  auto finish = [&ready_latch](Dart_NativeArguments args) {
+    ready_latch.Signal();
+  };
+  auto validate = [message_latch](Dart_NativeArguments args) {
+    tonic::DartByteData data(Dart_GetNativeArgument(args, 0));
+    EXPECT_EQ(data.length_in_bytes(), 4096u);
+    // The handler's write succeeded, and sending the data back copies it.
+    fml::MallocMapping mapping = SharedByteData::ToMapping(data);
+    EXPECT_NE(mapping.GetMapping(), data.data());
+    EXPECT_EQ(mapping.GetMapping()[0], 1);
+    EXPECT_EQ(mapping.GetMapping()[1], 'x');
+    message_latch->Signal();
+  };
+  AddNativeCallback("Finish", CREATE_NATIVE_ENTRY(finish));
+  AddNativeCallback("ValidateIncomingPlatformMessageData",
+                    CREATE_NATIVE_ENTRY(validate));
+
+  Settings settings = CreateSettingsForFixture();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread()        // ui
+  );
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("incomingPlatformMessageDataIsWritable");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+  ready_latch.Wait();
+
+  std::vector<uint8_t> data(4096, 'x');
+  SendEnginePlatformMessage(
+      shell.get(), std::make_unique<PlatformMessage>(
+                       "test/channel",
+                       fml::MallocMapping::Copy(data.data(), data.size()),
+                       nullptr));
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
+TEST_F(PlatformConfigurationTest, PersistentIsolateDataIsNotCopied) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  auto persistent_isolate_data = std::make_shared<fml::DataMapping>(
+      std::vector<uint8_t>(4096, 'x'));
+  auto validate = [message_latch,
+                   persistent_isolate_data](Dart_NativeArguments args) {
+    tonic::DartByteData data(Dart_GetNativeArgument(args, 0));
+    EXPECT_EQ(data.data(), persistent_isolate_data->GetMapping());
+    EXPECT_EQ(data.length_in_bytes(), persistent_isolate_data->GetSize());
+    EXPECT_TRUE(tonic::DartConverter<bool>::FromDart(
+        Dart_GetNativeArgument(args, 1)));
+    EXPECT_TRUE(tonic::DartConverter<bool>::FromDart(
+        Dart_GetNativeArgument(args, 2)));
+    message_latch->Signal();
+  };
+  AddNativeCallback("ValidatePersistentIsolateData",
+                    CREATE_NATIVE_ENTRY(validate));
+
+  Settings settings = CreateSettingsForFixture();
+  settings.persistent_isolate_data = persistent_isolate_data;
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread()        // ui
+  );
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("persistentIsolateDataIsShared");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,24 +4,224 @@
 
 #include "flutter/lib/ui/window/platform_message.h"
 
+#include <mutex>
+#include <new>
 #include <utility>
+#include <vector>
+
+#include "flutter/fml/logging.h"
 
 namespace flutter {
 
+namespace {
+
+// A pool of blocks the size of a |PlatformMessage|.
+//
+// Messages are usually created on one thread and destroyed on another, so
+// each thread keeps a small cache of free blocks and exchanges whole batches
+// of them with a shared list, as thread-caching allocators do. Taking or
+// returning a block only takes the lock once per |kBatchSize| messages.
+class MessagePool {
+ public:
+  static constexpr size_t kBatchSize = 32;
+  // The most blocks kept in a thread's cache.
+  static constexpr size_t kCacheCapacity = 2 * kBatchSize;
+  // The most batches kept in the shared list. Blocks beyond that are freed.
+  static constexpr size_t kMaxSharedBatches = 32;
+
+  static void* Allocate() {
+    ThreadCache& cache = GetThreadCache();
+    if (!cache.head && !cache.is_destroyed) {
+      cache.head = GetShared().TakeBatch();
+      cache.count = cache.head ? kBatchSize : 0;
+    }
+    if (!cache.head) {
+      return ::operator new(sizeof(PlatformMessage));
+    }
+    FreeBlock* block = cache.head;
+    cache.head = block->next;
+    cache.count--;
+    return block;
+  }
+
+  static void Free(void* pointer) {
+    ThreadCache& cache = GetThreadCache();
+    if (cache.is_destroyed) {
+      ::operator delete(pointer);
+      return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = cache.head;
+    cache.head = block;
+    cache.count++;
+    if (cache.count == kCacheCapacity) {
+      // Hand the most recently freed batch to other threads.
+      FreeBlock* batch = cache.head;
+      FreeBlock* last = batch;
+      for (size_t i = 1; i < kBatchSize; i++) {
+        last = last->next;
+      }
+      cache.head = last->next;
+      cache.count -= kBatchSize;
+      last->next = nullptr;
+      GetShared().ReturnBatch(batch);
+    }
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  static_assert(sizeof(PlatformMessage) >= sizeof(FreeBlock));
+
+  class SharedList {
+   public:
+    // Returns a list of |kBatchSize| blocks, or null.
+    FreeBlock* TakeBatch() {
+      std::scoped_lock lock(mutex_);
+      if (batches_.empty()) {
+        return nullptr;
+      }
+      FreeBlock* batch = batches_.back();
+      batches_.pop_back();
+      return batch;
+    }
+
+    // Takes a null terminated list of |kBatchSize| blocks.
+    void ReturnBatch(FreeBlock* batch) {
+      {
+        std::scoped_lock lock(mutex_);
+        if (batches_.size() < kMaxSharedBatches) {
+          batches_.push_back(batch);
+          return;
+        }
+      }
+      FreeList(batch);
+    }
+
+   private:
+    std::mutex mutex_;
+    std::vector<FreeBlock*> batches_;
+  };
+
+  // Trivially destructible, so that it remains usable while other thread
+  // locals, such as a message loop holding pending messages, are destroyed.
+  struct ThreadCache {
+    FreeBlock* head;
+    size_t count;
+    bool is_registered;
+    // Set once the cache has been released at thread exit, after which
+    // blocks go straight back to the system.
+    bool is_destroyed;
+  };
+
+  // Releases the calling thread's cache when the thread exits.
+  struct ThreadCacheReleaser {
+    ~ThreadCacheReleaser() {
+      ThreadCache& cache = thread_cache_;
+      FreeList(cache.head);
+      cache.head = nullptr;
+      cache.count = 0;
+      cache.is_destroyed = true;
+    }
+  };
+
+  static void FreeList(FreeBlock* block) {
+    while (block) {
+      FreeBlock* next = block->next;
+      ::operator delete(block);
+      block = next;
+    }
+  }
+
+  static SharedList& GetShared() {
+    static SharedList* shared = new SharedList();
+    return *shared;
+  }
+
+  static ThreadCache& GetThreadCache() {
+    if (!thread_cache_.is_registered) {
+      thread_cache_.is_registered = true;
+      thread_local ThreadCacheReleaser releaser;
+    }
+    return thread_cache_;
+  }
+
+  static thread_local ThreadCache thread_cache_;
+};
+
+thread_local MessagePool::ThreadCache MessagePool::thread_cache_ = {};
+
+}  // namespace
+
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::MallocMapping data,
                                  fml::RefPtr<PlatformMessageResponse> response)
-    : channel_(std::move(channel)),
+    : channel_id_(ChannelRegistry::Intern(channel)),
       data_(std::move(data)),
       has_data_(true),
-      response_(std::move(response)) {}
+      response_(std::move(response)) {
+  SetChannel(std::move(channel));
+}
+
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::RefPtr<PlatformMessageResponse> response)
-    : channel_(std::move(channel)),
+    : channel_id_(ChannelRegistry::Intern(channel)),
       data_(),
       has_data_(false),
-      response_(std::move(response)) {}
+      response_(std::move(response)) {
+  SetChannel(std::move(channel));
+}
+
+PlatformMessage::PlatformMessage(ChannelId channel_id,
+                                 std::string_view channel,
+                                 fml::MallocMapping data,
+                                 fml::RefPtr<PlatformMessageResponse> response)
+    : channel_id_(channel_id),
+      data_(std::move(data)),
+      has_data_(true),
+      response_(std::move(response)) {
+  FML_DCHECK(channel_id_ == ChannelRegistry::kUninternedChannel ||
+             ChannelRegistry::GetName(channel_id_) == channel);
+  SetChannel(channel_id_ == ChannelRegistry::kUninternedChannel
+                 ? std::string(channel)
+                 : std::string());
+}
+
+PlatformMessage::PlatformMessage(ChannelId channel_id,
+                                 std::string_view channel,
+                                 fml::RefPtr<PlatformMessageResponse> response)
+    : channel_id_(channel_id),
+      data_(),
+      has_data_(false),
+      response_(std::move(response)) {
+  FML_DCHECK(channel_id_ == ChannelRegistry::kUninternedChannel ||
+             ChannelRegistry::GetName(channel_id_) == channel);
+  SetChannel(channel_id_ == ChannelRegistry::kUninternedChannel
+                 ? std::string(channel)
+                 : std::string());
+}
 
 PlatformMessage::~PlatformMessage() = default;
 
+void PlatformMessage::SetChannel(std::string channel) {
+  if (channel_id_ == ChannelRegistry::kUninternedChannel) {
+    uninterned_channel_ = std::move(channel);
+    channel_ = &uninterned_channel_;
+  } else {
+    channel_ = &ChannelRegistry::GetName(channel_id_);
+  }
+}
+
+void* PlatformMessage::operator new(size_t size) {
+  FML_DCHECK(size == sizeof(PlatformMessage));
+  return MessagePool::Allocate();
+}
+
+void PlatformMessage::operator delete(void* pointer) {
+  if (pointer) {
+    MessagePool::Free(pointer);
+  }
+}
+
 }  // namespace flutter
@@ -6,10 +6,13 @@
 #define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/lib/ui/window/channel_registry.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
 
 namespace flutter {
@@ -21,9 +24,28 @@ class PlatformMessage {
                   fml::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string channel,
                   fml::RefPtr<PlatformMessageResponse> response);
+  /// Creates a message on a channel that the caller interned ahead of time,
+  /// so that sending a message does not intern its channel name. `channel`
+  /// is only copied if `channel_id` is |ChannelRegistry::kUninternedChannel|.
+  PlatformMessage(ChannelId channel_id,
+                  std::string_view channel,
+                  fml::MallocMapping data,
+                  fml::RefPtr<PlatformMessageResponse> response);
+  PlatformMessage(ChannelId channel_id,
+                  std::string_view channel,
+                  fml::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
-  const std::string& channel() const { return channel_; }
+  /// Messages are allocated from a pool of recycled blocks, since one is
+  /// created for every message sent in either direction.
+  static void* operator new(size_t size);
+  static void operator delete(void* pointer);
+
+  const std::string& channel() const { return *channel_; }
+
+  /// The interned id of |channel|, or |ChannelRegistry::kUninternedChannel|.
+  ChannelId channel_id() const { return channel_id_; }
+
   const fml::MallocMapping& data() const { return data_; }
   bool hasData() { return has_data_; }
 
@@ -34,10 +56,19 @@ class PlatformMessage {
   fml::MallocMapping releaseData() { return std::move(data_); }
 
  private:
-  std::string channel_;
+  // Points |channel_| to the interned name, or to `channel` if it could not
+  // be interned.
+  void SetChannel(std::string channel);
+
+  ChannelId channel_id_;
+  // Points to the interned name, or to |uninterned_channel_|.
+  const std::string* channel_;
+  std::string uninterned_channel_;
   fml::MallocMapping data_;
   bool has_data_;
   fml::RefPtr<PlatformMessageResponse> response_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessage);
 };
 
 }  // namespace flutter
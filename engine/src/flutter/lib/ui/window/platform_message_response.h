@@ -10,6 +10,7 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace flutter {
 
@@ -24,11 +25,16 @@ class PlatformMessageResponse
 
   bool is_complete() const { return is_complete_; }
 
+  /// When this response was created, which is just before the message it
+  /// belongs to is sent.
+  fml::TimePoint creation_time() const { return creation_time_; }
+
  protected:
   PlatformMessageResponse();
   virtual ~PlatformMessageResponse();
 
   bool is_complete_ = false;
+  const fml::TimePoint creation_time_ = fml::TimePoint::Now();
 };
 
 }  // namespace flutter
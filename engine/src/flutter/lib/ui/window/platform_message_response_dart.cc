@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/common/engine_metrics.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
@@ -68,6 +69,9 @@ PlatformMessageResponseDart::~PlatformMessageResponseDart() {
 }
 
 void PlatformMessageResponseDart::Complete(std::unique_ptr<fml::Mapping> data) {
+  EngineMetrics::GetInstance().RecordPlatformMessageRoundTrip(
+      EngineMetrics::Direction::kFromFramework,
+      fml::TimePoint::Now() - creation_time_);
   PostCompletion(
       std::move(callback_), ui_task_runner_, &is_complete_, channel_,
       [data = std::move(data)]() mutable {
@@ -100,6 +104,9 @@ void PlatformMessageResponseDart::Complete(std::unique_ptr<fml::Mapping> data) {
 }
 
 void PlatformMessageResponseDart::CompleteEmpty() {
+  EngineMetrics::GetInstance().RecordPlatformMessageRoundTrip(
+      EngineMetrics::Direction::kFromFramework,
+      fml::TimePoint::Now() - creation_time_);
   PostCompletion(std::move(callback_), ui_task_runner_, &is_complete_, channel_,
                  [] { return Dart_Null(); });
 }
@@ -4,9 +4,13 @@
 
 #include "flutter/lib/ui/window/platform_message_response_dart_port.h"
 
+#include <algorithm>
 #include <array>
+#include <mutex>
 #include <utility>
+#include <vector>
 
+#include "flutter/common/engine_metrics.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
@@ -18,27 +22,195 @@
 
 namespace flutter {
 
+namespace {
+
+void MappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::Mapping*>(peer);
+}
+
+// Sets |object| to the payload of a response, or to null for an empty
+// response.
+//
+// Large responses are handed to the receiving isolate without a copy. Returns
+// true if so, in which case the VM owns |data| once |object| has been posted,
+// and deletes it when the typed data is collected.
+bool SetResponseData(const fml::Mapping* data, Dart_CObject* object) {
+  if (data == nullptr) {
+    object->type = Dart_CObject_kNull;
+    return false;
+  }
+  const size_t size = data->GetSize();
+  if (size > tonic::DartByteData::kExternalSizeThreshold) {
+    object->type = Dart_CObject_kUnmodifiableExternalTypedData;
+    object->value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    object->value.as_external_typed_data.length = size;
+    object->value.as_external_typed_data.data =
+        const_cast<uint8_t*>(data->GetMapping());
+    object->value.as_external_typed_data.peer =
+        const_cast<fml::Mapping*>(data);
+    object->value.as_external_typed_data.callback = MappingFinalizer;
+    return true;
+  }
+  object->type = Dart_CObject_kTypedData;
+  object->value.as_typed_data.type = Dart_TypedData_kUint8;
+  object->value.as_typed_data.length = size;
+  object->value.as_typed_data.values = data->GetMapping();
+  return false;
+}
+
+struct PortResponse {
+  Dart_Port port;
+  int64_t identifier;
+  // Null for an empty response.
+  std::unique_ptr<fml::Mapping> data;
+};
+
+// Posts the responses of receivers that opted into batching, combining the
+// responses completed concurrently into one message per port.
+//
+// The first thread to complete a response posts it immediately. Responses
+// completed on other threads while it does so are queued, and posted by that
+// same thread once it is done, so no response waits for a timer and ports
+// that are replied to from many threads at once receive fewer, larger
+// messages.
+class PortResponsePoster {
+ public:
+  static PortResponsePoster& GetInstance() {
+    static PortResponsePoster* instance = new PortResponsePoster();
+    return *instance;
+  }
+
+  void Post(PortResponse response) {
+    std::vector<PortResponse> batch;
+    {
+      std::scoped_lock lock(mutex_);
+      pending_.push_back(std::move(response));
+      if (is_posting_) {
+        return;
+      }
+      is_posting_ = true;
+      batch.swap(pending_);
+    }
+    while (true) {
+      PostBatch(batch);
+      batch.clear();
+      std::scoped_lock lock(mutex_);
+      if (pending_.empty()) {
+        is_posting_ = false;
+        // Hand the storage back so the next batch does not allocate.
+        if (pending_.capacity() < batch.capacity()) {
+          pending_.swap(batch);
+        }
+        return;
+      }
+      batch.swap(pending_);
+    }
+  }
+
+ private:
+  PortResponsePoster() = default;
+
+  // Only called by the thread that set |is_posting_|.
+  void PostBatch(std::vector<PortResponse>& batch) {
+    TRACE_EVENT1("flutter", "PlatformMessageResponseDartPort::PostBatch",
+                 "count", std::to_string(batch.size()).c_str());
+    // Keep the responses to each port in the order they were completed.
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const PortResponse& a, const PortResponse& b) {
+                       return a.port < b.port;
+                     });
+    auto start = batch.begin();
+    while (start != batch.end()) {
+      auto end = std::find_if(start, batch.end(),
+                              [port = start->port](const PortResponse& r) {
+                                return r.port != port;
+                              });
+      PostResponses(start, end);
+      start = end;
+    }
+  }
+
+  // Posts |[identifier, data, identifier, data, ...]| for the responses in
+  // [begin, end), which are all to the same port.
+  void PostResponses(std::vector<PortResponse>::iterator begin,
+                     std::vector<PortResponse>::iterator end) {
+    const size_t count = end - begin;
+    objects_.resize(count * 2);
+    values_.resize(count * 2);
+    is_external_.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      Dart_CObject& identifier = objects_[i * 2];
+      identifier.type = Dart_CObject_kInt64;
+      identifier.value.as_int64 = begin[i].identifier;
+      is_external_[i] =
+          SetResponseData(begin[i].data.get(), &objects_[i * 2 + 1]);
+      values_[i * 2] = &objects_[i * 2];
+      values_[i * 2 + 1] = &objects_[i * 2 + 1];
+    }
+
+    Dart_CObject message = {
+        .type = Dart_CObject_kArray,
+    };
+    message.value.as_array.length = values_.size();
+    message.value.as_array.values = values_.data();
+
+    bool did_send = Dart_PostCObject(begin->port, &message);
+    FML_CHECK(did_send);
+
+    for (size_t i = 0; i < count; i++) {
+      if (is_external_[i]) {
+        // The VM now owns the mapping.
+        begin[i].data.release();
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  bool is_posting_ = false;
+  std::vector<PortResponse> pending_;
+  // Scratch space for building messages, reused across batches.
+  std::vector<Dart_CObject> objects_;
+  std::vector<Dart_CObject*> values_;
+  std::vector<bool> is_external_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PortResponsePoster);
+};
+
+}  // namespace
+
 PlatformMessageResponseDartPort::PlatformMessageResponseDartPort(
     Dart_Port send_port,
     int64_t identifier,
-    const std::string& channel)
-    : send_port_(send_port), identifier_(identifier), channel_(channel) {
+    const std::string& channel,
+    bool batch_responses)
+    : send_port_(send_port),
+      identifier_(identifier),
+      channel_(channel),
+      batch_responses_(batch_responses) {
   FML_DCHECK(send_port != ILLEGAL_PORT);
 }
 
 void PlatformMessageResponseDartPort::Complete(
     std::unique_ptr<fml::Mapping> data) {
   is_complete_ = true;
+  EngineMetrics::GetInstance().RecordPlatformMessageRoundTrip(
+      EngineMetrics::Direction::kFromFramework,
+      fml::TimePoint::Now() - creation_time_);
+  if (batch_responses_) {
+    PortResponsePoster::GetInstance().Post({
+        .port = send_port_,
+        .identifier = identifier_,
+        .data = std::move(data),
+    });
+    return;
+  }
+
   Dart_CObject response_identifier = {
       .type = Dart_CObject_kInt64,
   };
   response_identifier.value.as_int64 = identifier_;
-  Dart_CObject response_data = {
-      .type = Dart_CObject_kTypedData,
-  };
-  response_data.value.as_typed_data.type = Dart_TypedData_kUint8;
-  response_data.value.as_typed_data.length = data->GetSize();
-  response_data.value.as_typed_data.values = data->GetMapping();
+  Dart_CObject response_data = {};
+  const bool is_external = SetResponseData(data.get(), &response_data);
 
   std::array<Dart_CObject*, 2> response_values = {&response_identifier,
                                                   &response_data};
@@ -51,10 +223,28 @@ void PlatformMessageResponseDartPort::Complete(
 
   bool did_send = Dart_PostCObject(send_port_, &response);
   FML_CHECK(did_send);
+  if (is_external) {
+    // The VM now owns the mapping.
+    data.release();
+  }
 }
 
 void PlatformMessageResponseDartPort::CompleteEmpty() {
   is_complete_ = true;
+  EngineMetrics::GetInstance().RecordPlatformMessageRoundTrip(
+      EngineMetrics::Direction::kFromFramework,
+      fml::TimePoint::Now() - creation_time_);
+  if (batch_responses_) {
+    // Goes through the same queue as the other responses so that it keeps
+    // its place among them.
+    PortResponsePoster::GetInstance().Post({
+        .port = send_port_,
+        .identifier = identifier_,
+        .data = nullptr,
+    });
+    return;
+  }
+
   Dart_CObject response = {
       .type = Dart_CObject_kNull,
   };
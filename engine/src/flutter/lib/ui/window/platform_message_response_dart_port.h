@@ -12,6 +12,16 @@
 namespace flutter {
 
 /// A \ref PlatformMessageResponse that will respond over a Dart port.
+///
+/// The port receives `[identifier, data]` for each response, or null for an
+/// empty response. Payloads larger than
+/// `tonic::DartByteData::kExternalSizeThreshold` are unmodifiable and backed
+/// by the response mapping rather than copied into the receiving isolate.
+///
+/// If `batch_responses` is true, the receiver has opted into batching:
+/// responses completed concurrently for the same port are posted together as
+/// `[identifier1, data1, identifier2, data2, ...]`, and an empty response is
+/// a pair whose data is null.
 class PlatformMessageResponseDartPort : public PlatformMessageResponse {
   FML_FRIEND_MAKE_REF_COUNTED(PlatformMessageResponseDartPort);
 
@@ -23,11 +33,13 @@ class PlatformMessageResponseDartPort : public PlatformMessageResponse {
  protected:
   explicit PlatformMessageResponseDartPort(Dart_Port send_port,
                                            int64_t identifier,
-                                           const std::string& channel);
+                                           const std::string& channel,
+                                           bool batch_responses = false);
 
   Dart_Port send_port_;
   int64_t identifier_;
   const std::string channel_;
+  const bool batch_responses_;
 };
 
 }  // namespace flutter
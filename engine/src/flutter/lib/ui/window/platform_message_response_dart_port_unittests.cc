@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -67,5 +71,137 @@ TEST_F(ShellTest, PlatformMessageResponseDartPort) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, PlatformMessageResponseDartPortConcurrentLargeResponses) {
+  bool did_pass = false;
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread()        // ui
+  );
+
+  // Completes responses above the external typed data threshold from
+  // several threads at once. Each arrives as its own [identifier, data].
+  auto nativeCallPlatformMessageResponseDartPortConcurrently =
+      [](Dart_NativeArguments args) {
+        Dart_Port port = tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < 8; i++) {
+          threads.emplace_back([port, i]() {
+            auto response =
+                fml::MakeRefCounted<PlatformMessageResponseDartPort>(port, i,
+                                                                     "foobar");
+            uint8_t* data = static_cast<uint8_t*>(malloc(4096));
+            memset(data, static_cast<int>(i), 4096);
+            response->Complete(
+                std::make_unique<fml::MallocMapping>(data, 4096));
+          });
+        }
+        for (std::thread& thread : threads) {
+          thread.join();
+        }
+      };
+
+  AddNativeCallback(
+      "CallPlatformMessageResponseDartPortConcurrently",
+      CREATE_NATIVE_ENTRY(
+          nativeCallPlatformMessageResponseDartPortConcurrently));
+
+  auto nativeFinishCallResponse = [message_latch,
+                                   &did_pass](Dart_NativeArguments args) {
+    did_pass =
+        tonic::DartConverter<bool>::FromDart(Dart_GetNativeArgument(args, 0));
+    message_latch->Signal();
+  };
+
+  AddNativeCallback("FinishCallResponse",
+                    CREATE_NATIVE_ENTRY(nativeFinishCallResponse));
+
+  Settings settings = CreateSettingsForFixture();
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("platformMessagePortResponseConcurrentTest");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+
+  ASSERT_TRUE(did_pass);
+  DestroyShell(std::move(shell), task_runners);
+}
+
+TEST_F(ShellTest, PlatformMessageResponseDartPortBatchesResponses) {
+  bool did_pass = false;
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread()        // ui
+  );
+
+  // Completes responses for a receiver that opted into batching from several
+  // threads at once. They may arrive together, and the empty response is a
+  // pair with null data.
+  auto nativeCallPlatformMessageResponseDartPortBatched =
+      [](Dart_NativeArguments args) {
+        Dart_Port port = tonic::DartConverter<int64_t>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < 8; i++) {
+          threads.emplace_back([port, i]() {
+            auto response =
+                fml::MakeRefCounted<PlatformMessageResponseDartPort>(
+                    port, i, "foobar", /*batch_responses=*/true);
+            if (i == 0) {
+              response->CompleteEmpty();
+              return;
+            }
+            uint8_t* data = static_cast<uint8_t*>(malloc(4096));
+            memset(data, static_cast<int>(i), 4096);
+            response->Complete(
+                std::make_unique<fml::MallocMapping>(data, 4096));
+          });
+        }
+        for (std::thread& thread : threads) {
+          thread.join();
+        }
+      };
+
+  AddNativeCallback(
+      "CallPlatformMessageResponseDartPortBatched",
+      CREATE_NATIVE_ENTRY(nativeCallPlatformMessageResponseDartPortBatched));
+
+  auto nativeFinishCallResponse = [message_latch,
+                                   &did_pass](Dart_NativeArguments args) {
+    did_pass =
+        tonic::DartConverter<bool>::FromDart(Dart_GetNativeArgument(args, 0));
+    message_latch->Signal();
+  };
+
+  AddNativeCallback("FinishCallResponse",
+                    CREATE_NATIVE_ENTRY(nativeFinishCallResponse));
+
+  Settings settings = CreateSettingsForFixture();
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("platformMessagePortResponseBatchedTest");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+
+  ASSERT_TRUE(did_pass);
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_response_table.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+PlatformMessageResponseTable::PlatformMessageResponseTable() = default;
+
+PlatformMessageResponseTable::~PlatformMessageResponseTable() = default;
+
+int PlatformMessageResponseTable::Add(
+    fml::RefPtr<PlatformMessageResponse> response) {
+  FML_DCHECK(response);
+  uint32_t index = first_free_;
+  if (index == kNoSlot) {
+    FML_CHECK(slots_.size() < kMaxSlots)
+        << "Too many platform message responses are pending.";
+    index = slots_.size();
+    slots_.emplace_back();
+  } else {
+    first_free_ = slots_[index].next_free;
+  }
+  Slot& slot = slots_[index];
+  slot.response = std::move(response);
+  size_++;
+  return static_cast<int>((slot.generation << kSlotBits) | index);
+}
+
+fml::RefPtr<PlatformMessageResponse> PlatformMessageResponseTable::Take(
+    int response_id) {
+  if (response_id <= 0) {
+    return nullptr;
+  }
+  const uint32_t id = static_cast<uint32_t>(response_id);
+  const uint32_t index = id & (kMaxSlots - 1);
+  if (index >= slots_.size()) {
+    return nullptr;
+  }
+  Slot& slot = slots_[index];
+  if (!slot.response || slot.generation != id >> kSlotBits) {
+    return nullptr;
+  }
+  fml::RefPtr<PlatformMessageResponse> response = std::move(slot.response);
+  slot.generation = slot.generation == kMaxGeneration ? 1 : slot.generation + 1;
+  slot.next_free = first_free_;
+  first_free_ = index;
+  size_--;
+  return response;
+}
+
+}  // namespace flutter
@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RESPONSE_TABLE_H_
+#define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RESPONSE_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/lib/ui/window/platform_message_response.h"
+
+namespace flutter {
+
+/// The responses to platform messages that were dispatched to the framework
+/// and have not been responded to yet, by response id.
+///
+/// Responses are kept in a dense vector of slots whose free slots form a
+/// list, so adding and taking responses takes constant time and does not
+/// allocate once the table has grown to the number of responses in flight.
+///
+/// A response id encodes the index of the slot and the generation of the
+/// slot, which is incremented every time the slot is freed. Ids are never 0,
+/// which means that no response is expected, and an id that has already
+/// been taken is not found again even if its slot has been reused, unless
+/// the slot has since been reused |kMaxGeneration| times.
+///
+/// Not thread-safe.
+class PlatformMessageResponseTable {
+ public:
+  static constexpr int kSlotBits = 20;
+  static constexpr uint32_t kMaxSlots = uint32_t{1} << kSlotBits;
+  // Generations are non-zero and leave the sign bit of the id clear.
+  static constexpr uint32_t kMaxGeneration =
+      (uint32_t{1} << (31 - kSlotBits)) - 1;
+
+  PlatformMessageResponseTable();
+
+  ~PlatformMessageResponseTable();
+
+  /// Stores `response` and returns its id.
+  ///
+  /// At most |kMaxSlots| responses may be stored at once.
+  int Add(fml::RefPtr<PlatformMessageResponse> response);
+
+  /// Removes and returns the response with the id `response_id`, or returns
+  /// null if there is no such response.
+  fml::RefPtr<PlatformMessageResponse> Take(int response_id);
+
+  /// The number of responses stored.
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  struct Slot {
+    fml::RefPtr<PlatformMessageResponse> response;
+    uint32_t generation = 1;
+    // The next free slot, if this slot is free.
+    uint32_t next_free = kNoSlot;
+  };
+
+  std::vector<Slot> slots_;
+  uint32_t first_free_ = kNoSlot;
+  size_t size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessageResponseTable);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RESPONSE_TABLE_H_
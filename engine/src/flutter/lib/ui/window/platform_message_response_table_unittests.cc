@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_response_table.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+class TestResponse : public PlatformMessageResponse {
+ public:
+  void Complete(std::unique_ptr<fml::Mapping> data) override {}
+  void CompleteEmpty() override {}
+};
+}  // namespace
+
+TEST(PlatformMessageResponseTableTest, TakesResponsesById) {
+  PlatformMessageResponseTable table;
+  auto a = fml::MakeRefCounted<TestResponse>();
+  auto b = fml::MakeRefCounted<TestResponse>();
+  const int a_id = table.Add(a);
+  const int b_id = table.Add(b);
+  EXPECT_GT(a_id, 0);
+  EXPECT_GT(b_id, 0);
+  EXPECT_NE(a_id, b_id);
+  EXPECT_EQ(table.size(), 2u);
+
+  EXPECT_EQ(table.Take(b_id).get(), b.get());
+  EXPECT_EQ(table.Take(a_id).get(), a.get());
+  EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(PlatformMessageResponseTableTest, IgnoresUnknownAndStaleIds) {
+  PlatformMessageResponseTable table;
+  EXPECT_FALSE(table.Take(0));
+  EXPECT_FALSE(table.Take(-1));
+  EXPECT_FALSE(table.Take(12345));
+
+  const int stale_id = table.Add(fml::MakeRefCounted<TestResponse>());
+  ASSERT_TRUE(table.Take(stale_id));
+  EXPECT_FALSE(table.Take(stale_id));
+
+  // The slot is reused with a new generation.
+  auto response = fml::MakeRefCounted<TestResponse>();
+  const int id = table.Add(response);
+  EXPECT_NE(id, stale_id);
+  EXPECT_FALSE(table.Take(stale_id));
+  EXPECT_EQ(table.size(), 1u);
+  EXPECT_EQ(table.Take(id).get(), response.get());
+}
+
+TEST(PlatformMessageResponseTableTest, ReusesFreedSlots) {
+  PlatformMessageResponseTable table;
+  std::vector<int> ids;
+  for (int i = 0; i < 1000; i++) {
+    ids.push_back(table.Add(fml::MakeRefCounted<TestResponse>()));
+  }
+  for (int id : ids) {
+    ASSERT_TRUE(table.Take(id));
+  }
+  // Freed slots are reused before the table grows, so the slot indices in the
+  // low bits of the ids stay below the number of responses that were in
+  // flight at once. Generations wrap around without producing invalid ids.
+  for (uint32_t i = 0; i < 2 * PlatformMessageResponseTable::kMaxGeneration;
+       i++) {
+    const int id = table.Add(fml::MakeRefCounted<TestResponse>());
+    EXPECT_GT(id, 0);
+    EXPECT_LT(static_cast<uint32_t>(id) %
+                  PlatformMessageResponseTable::kMaxSlots,
+              1000u);
+    ASSERT_TRUE(table.Take(id));
+  }
+  EXPECT_EQ(table.size(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(PlatformMessageTest, InternsChannelNames) {
+  PlatformMessage a("flutter/lifecycle", nullptr);
+  PlatformMessage b(std::string("flutter/lifecycle"),
+                    fml::MallocMapping::Copy("x", 1), nullptr);
+  PlatformMessage c("flutter/navigation", nullptr);
+
+  EXPECT_NE(a.channel_id(), ChannelRegistry::kUninternedChannel);
+  EXPECT_EQ(a.channel_id(), b.channel_id());
+  EXPECT_NE(a.channel_id(), c.channel_id());
+  EXPECT_EQ(a.channel(), "flutter/lifecycle");
+  // Both messages refer to the same interned name.
+  EXPECT_EQ(&a.channel(), &b.channel());
+  EXPECT_EQ(&ChannelRegistry::GetName(a.channel_id()), &a.channel());
+  EXPECT_EQ(ChannelRegistry::Intern("flutter/navigation"), c.channel_id());
+}
+
+TEST(PlatformMessageTest, TakesChannelsInternedAheadOfTime) {
+  const ChannelId id = ChannelRegistry::InternCached("flutter/textinput");
+  EXPECT_EQ(id, ChannelRegistry::Intern("flutter/textinput"));
+  EXPECT_EQ(ChannelRegistry::InternCached("flutter/textinput"), id);
+  EXPECT_TRUE(ChannelRegistry::IsIdOf(id, "flutter/textinput"));
+  EXPECT_FALSE(ChannelRegistry::IsIdOf(id, "flutter/keyevent"));
+  EXPECT_FALSE(ChannelRegistry::IsIdOf(ChannelRegistry::kUninternedChannel,
+                                       ""));
+
+  PlatformMessage a(id, "flutter/textinput", nullptr);
+  EXPECT_EQ(a.channel_id(), id);
+  EXPECT_EQ(&a.channel(), &ChannelRegistry::GetName(id));
+
+  // Messages on channels that could not be interned keep their own name.
+  PlatformMessage b(ChannelRegistry::kUninternedChannel, "dynamic/1",
+                    fml::MallocMapping::Copy("x", 1), nullptr);
+  EXPECT_EQ(b.channel_id(), ChannelRegistry::kUninternedChannel);
+  EXPECT_EQ(b.channel(), "dynamic/1");
+  EXPECT_TRUE(b.hasData());
+}
+
+TEST(PlatformMessageTest, CanBeDestroyedOnAnotherThread) {
+  std::vector<std::unique_ptr<PlatformMessage>> messages;
+  for (int i = 0; i < 1000; i++) {
+    messages.push_back(std::make_unique<PlatformMessage>(
+        "flutter/keyevent", fml::MallocMapping::Copy("{}", 2), nullptr));
+  }
+  std::thread thread([messages = std::move(messages)]() mutable {
+    for (const auto& message : messages) {
+      EXPECT_EQ(message->channel(), "flutter/keyevent");
+      EXPECT_EQ(message->data().GetSize(), 2u);
+    }
+    messages.clear();
+  });
+  thread.join();
+
+  // Blocks freed on the other thread are reused here.
+  for (int i = 0; i < 1000; i++) {
+    auto message = std::make_unique<PlatformMessage>("flutter/keyevent",
+                                                     nullptr);
+    EXPECT_FALSE(message->hasData());
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/shared_byte_data.h"
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+class Buffer;
+
+// The buffers that may back live ByteData objects, by start address.
+struct Registry {
+  std::mutex mutex;
+  std::map<const uint8_t*, std::weak_ptr<Buffer>> buffers;
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+// A malloc'd buffer backing a ByteData object created by SharedByteData.
+class Buffer {
+ public:
+  Buffer(uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  ~Buffer() {
+    {
+      Registry& registry = GetRegistry();
+      std::scoped_lock lock(registry.mutex);
+      registry.buffers.erase(data_);
+    }
+    // Only free the memory once it can no longer be found, so that another
+    // buffer allocated at the same address cannot be mistaken for this one.
+    free(data_);
+  }
+
+  uint8_t* data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+ private:
+  uint8_t* data_;
+  size_t size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Buffer);
+};
+
+void BufferFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<std::shared_ptr<Buffer>*>(peer);
+}
+
+Dart_Handle WrapBuffer(uint8_t* data, size_t size) {
+  auto buffer = std::make_shared<Buffer>(data, size);
+  {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    registry.buffers[data] = buffer;
+  }
+  // The Dart object keeps a reference to the buffer until it is collected.
+  auto* peer = new std::shared_ptr<Buffer>(std::move(buffer));
+  Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, size, peer, size, BufferFinalizer);
+  if (Dart_IsError(handle)) {
+    delete peer;
+  }
+  return handle;
+}
+
+// Returns the buffer holding the `size` bytes at `data`, if any.
+std::shared_ptr<Buffer> FindBuffer(const uint8_t* data, size_t size) {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  auto it = registry.buffers.upper_bound(data);
+  if (it == registry.buffers.begin()) {
+    return nullptr;
+  }
+  --it;
+  // The caller holds a handle to a ByteData backed by the buffer, so the
+  // buffer can only have expired if this is a different, dying buffer.
+  std::shared_ptr<Buffer> buffer = it->second.lock();
+  if (!buffer || data + size > buffer->data() + buffer->size()) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+}  // namespace
+
+Dart_Handle SharedByteData::Create(size_t length) {
+  if (length == 0) {
+    return Dart_NewTypedData(Dart_TypedData_kByteData, 0);
+  }
+  uint8_t* data = static_cast<uint8_t*>(calloc(length, 1));
+  FML_CHECK(data);
+  return WrapBuffer(data, length);
+}
+
+fml::MallocMapping SharedByteData::ToMapping(const tonic::DartByteData& data) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data.data());
+  const size_t size = data.length_in_bytes();
+  // Below this size a copy is as cheap as looking up the buffer.
+  if (size >= tonic::DartByteData::kExternalSizeThreshold) {
+    if (std::shared_ptr<Buffer> buffer = FindBuffer(bytes, size)) {
+      return fml::MallocMapping(bytes, size, std::move(buffer));
+    }
+  }
+  return fml::MallocMapping::Copy(bytes, size);
+}
+
+}  // namespace flutter
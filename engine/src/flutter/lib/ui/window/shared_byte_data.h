@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_SHARED_BYTE_DATA_H_
+#define FLUTTER_LIB_UI_WINDOW_SHARED_BYTE_DATA_H_
+
+#include <cstddef>
+
+#include "flutter/fml/mapping.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
+
+namespace flutter {
+
+/// Platform message payloads that are shared between Dart and the engine
+/// rather than copied each time they cross between the two.
+///
+/// The ByteData objects created here are external typed data backed by
+/// buffers the engine keeps track of. When such an object, or a view of part
+/// of it, is passed back to the engine, |ToMapping| returns a mapping that
+/// shares the buffer instead of a copy of it. The buffer is freed once the
+/// Dart object has been collected and every mapping sharing it has been
+/// destroyed.
+///
+/// Only buffers Dart creates with |Create| are shared. They stay writable from
+/// Dart after they have been sent: the ByteData is not detached, since the
+/// Dart API offers no way to detach external typed data. As the engine may
+/// read a buffer on another thread after Dart has sent it, Dart code must not
+/// modify a buffer after sending it. This is a contract that is documented on
+/// `PlatformDispatcher.createPlatformMessageData` and not enforced.
+///
+/// All methods are thread-safe, and those taking or returning handles must be
+/// called in a Dart scope.
+class SharedByteData {
+ public:
+  /// Returns a new ByteData of `length` zero bytes.
+  static Dart_Handle Create(size_t length);
+
+  /// Returns the contents of `data`, which must hold acquired data.
+  ///
+  /// If the contents lie within a ByteData created by |Create|, the result
+  /// shares them. Otherwise, it is a copy.
+  static fml::MallocMapping ToMapping(const tonic::DartByteData& data);
+
+  SharedByteData() = delete;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_SHARED_BYTE_DATA_H_
@@ -27,7 +27,15 @@ abstract class PlatformDispatcher {
 
   void sendPlatformMessage(String name, ByteData? data, PlatformMessageResponseCallback? callback);
 
-  void sendPortPlatformMessage(String name, ByteData? data, int identifier, Object port);
+  void sendPortPlatformMessage(
+    String name,
+    ByteData? data,
+    int identifier,
+    Object port, {
+    bool batchResponses = false,
+  });
+
+  ByteData createPlatformMessageData(int length);
 
   void registerBackgroundIsolate(RootIsolateToken token);
 
@@ -70,10 +70,22 @@ class EnginePlatformDispatcher extends ui.PlatformDispatcher {
   }
 
   @override
-  void sendPortPlatformMessage(String name, ByteData? data, int identifier, Object port) {
+  void sendPortPlatformMessage(
+    String name,
+    ByteData? data,
+    int identifier,
+    Object port, {
+    bool batchResponses = false,
+  }) {
     throw Exception("Isolates aren't supported in web.");
   }
 
+  @override
+  ByteData createPlatformMessageData(int length) {
+    RangeError.checkNotNegative(length, 'length');
+    return ByteData(length);
+  }
+
   @override
   void registerBackgroundIsolate(ui.RootIsolateToken token) {
     throw Exception("Isolates aren't supported in web.");
@@ -109,6 +109,9 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     return {};
   }
 
+  // Let the configuration fetch its snapshots while the isolate is created.
+  isolate_configuration->BeginLoading(context.concurrent_task_runner);
+
   isolate_flags.SetNullSafetyEnabled(
       isolate_configuration->IsNullSafetyEnabled(*isolate_snapshot));
   isolate_flags.SetIsDontNeedSafe(isolate_snapshot->IsDontNeedSafe());
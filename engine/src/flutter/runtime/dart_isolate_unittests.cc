@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -76,6 +78,78 @@ TEST_F(DartIsolateTest, RootIsolateCreationAndShutdown) {
   ASSERT_TRUE(root_isolate->Shutdown());
 }
 
+TEST_F(DartIsolateTest, RootIsolateCreationFromKernelList) {
+  if (DartVM::IsRunningPrecompiledCode()) {
+    FML_LOG(INFO) << "Kernel lists are only used in JIT mode";
+    return;
+  }
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  ASSERT_TRUE(vm_ref);
+  auto vm_data = vm_ref.GetVMData();
+  ASSERT_TRUE(vm_data);
+  TaskRunners task_runners(GetCurrentTestName(),    //
+                           GetCurrentTaskRunner(),  //
+                           GetCurrentTaskRunner()   //
+  );
+
+  fml::ScopedTemporaryDirectory kernel_list_dir;
+  ASSERT_TRUE(fml::WriteAtomically(kernel_list_dir.fd(), "not_a_kernel",
+                                   fml::DataMapping("garbage")));
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead),
+      false));
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::Duplicate(kernel_list_dir.fd().get()), false));
+
+  auto launch = [&](const std::string& kernel_list_asset) {
+    Settings kernel_list_settings = settings;
+    kernel_list_settings.application_kernels = nullptr;
+    kernel_list_settings.application_kernel_list_asset = kernel_list_asset;
+    auto isolate_configuration = IsolateConfiguration::InferFromSettings(
+        kernel_list_settings, asset_manager);
+    FML_CHECK(isolate_configuration);
+
+    UIDartState::Context context(task_runners);
+    context.advisory_script_uri = "main.dart";
+    context.advisory_script_entrypoint = "main";
+    context.concurrent_task_runner = vm_ref->GetConcurrentWorkerTaskRunner();
+    auto weak_isolate = DartIsolate::CreateRunningRootIsolate(
+        vm_data->GetSettings(),              // settings
+        vm_data->GetIsolateSnapshot(),       // isolate snapshot
+        nullptr,                             // platform configuration
+        DartIsolate::Flags{},                // flags
+        nullptr,                             // root_isolate_create_callback
+        settings.isolate_create_callback,    // isolate create callback
+        settings.isolate_shutdown_callback,  // isolate shutdown callback
+        "main",                              // dart entrypoint
+        std::nullopt,                        // dart entrypoint library
+        {},                                  // dart entrypoint arguments
+        std::move(isolate_configuration),    // isolate configuration
+        context                              // engine context
+    );
+    return weak_isolate.lock();
+  };
+
+  {
+    // A piece that is not a kernel is rejected before it reaches the VM.
+    ASSERT_TRUE(fml::WriteAtomically(kernel_list_dir.fd(), "invalid_kernels",
+                                     fml::DataMapping("not_a_kernel")));
+    ASSERT_FALSE(launch("invalid_kernels"));
+  }
+
+  {
+    ASSERT_TRUE(fml::WriteAtomically(kernel_list_dir.fd(), "valid_kernels",
+                                     fml::DataMapping("kernel_blob.bin")));
+    auto root_isolate = launch("valid_kernels");
+    ASSERT_TRUE(root_isolate);
+    ASSERT_EQ(root_isolate->GetPhase(), DartIsolate::Phase::Running);
+    ASSERT_TRUE(root_isolate->Shutdown());
+  }
+}
+
 TEST_F(DartIsolateTest, IsolateShutdownCallbackIsInIsolateScope) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   auto settings = CreateSettingsForFixture();
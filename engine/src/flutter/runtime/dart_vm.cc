@@ -10,6 +10,7 @@
 #include <sstream>
 #include <vector>
 
+#include "flutter/assets/compressed_asset_bundle.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/logging.h"
@@ -274,7 +275,10 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
                          std::thread::hardware_concurrency()) /
                          2,
                      kMinCount,
-                     kMaxCount))),
+                     kMaxCount),
+          settings_.enable_cpu_affinity
+              ? std::optional(fml::CpuAffinity::kNotPerformance)
+              : std::nullopt)),
       vm_data_(vm_data),
       isolate_name_server_(std::move(isolate_name_server)),
       service_protocol_(std::make_shared<ServiceProtocol>()) {
@@ -498,9 +502,14 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   // Update thread names now that the Dart VM is initialized.
   concurrent_message_loop_->PostTaskToAllWorkers(
       [] { Dart_SetThreadName("FlutterConcurrentMessageLoopWorker"); });
+
+  CompressedAssetBundle::SetWorkerTaskRunner(
+      concurrent_message_loop_->GetTaskRunner());
 }
 
 DartVM::~DartVM() {
+  CompressedAssetBundle::SetWorkerTaskRunner(nullptr);
+
   if (Dart_CurrentIsolate() != nullptr) {
     Dart_ExitIsolate();
   }
@@ -4,6 +4,8 @@
 
 #include "flutter/runtime/dart_vm.h"
 
+#include <thread>
+
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/testing/fixture_test.h"
@@ -37,6 +39,28 @@ TEST_F(DartVMTest, SimpleIsolateNameServer) {
   ASSERT_TRUE(ns->RemoveIsolateNameMapping("foobar"));
 }
 
+TEST_F(DartVMTest, IsolateNameServerLookupsObserveMutations) {
+  IsolateNameServer ns;
+  IsolateNameServer other_ns;
+  ASSERT_TRUE(ns.RegisterIsolatePortWithName({1, 1}, "foo"));
+  ASSERT_TRUE(other_ns.RegisterIsolatePortWithName({2, 2}, "foo"));
+
+  // Lookups on the same thread must not be served from the snapshot of
+  // another name server.
+  ASSERT_EQ(ns.LookupIsolatePortByName("foo").port_id, 1);
+  ASSERT_EQ(other_ns.LookupIsolatePortByName("foo").port_id, 2);
+  ASSERT_EQ(ns.LookupIsolatePortByName("foo").port_id, 1);
+
+  // Mutations on another thread are visible to a thread that has already
+  // cached a snapshot.
+  std::thread([&ns]() {
+    ASSERT_TRUE(ns.RemoveIsolateNameMapping("foo"));
+    ASSERT_TRUE(ns.RegisterIsolatePortWithName({3, 3}, "bar"));
+  }).join();
+  ASSERT_EQ(ns.LookupIsolatePortByName("foo").port_id, ILLEGAL_PORT);
+  ASSERT_EQ(ns.LookupIsolatePortByName("bar").port_id, 3);
+}
+
 TEST_F(DartVMTest, OldGenHeapSize) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   auto settings = CreateSettingsForFixture();
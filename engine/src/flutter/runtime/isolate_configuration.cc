@@ -5,6 +5,7 @@
 #include "flutter/runtime/isolate_configuration.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
 
 namespace flutter {
@@ -23,6 +24,9 @@ bool IsolateConfiguration::PrepareIsolate(DartIsolate& isolate) {
   return DoPrepareIsolate(isolate);
 }
 
+void IsolateConfiguration::BeginLoading(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_worker) {}
+
 class AppSnapshotIsolateConfiguration final : public IsolateConfiguration {
  public:
   AppSnapshotIsolateConfiguration() = default;
@@ -69,41 +73,109 @@ class KernelIsolateConfiguration : public IsolateConfiguration {
   FML_DISALLOW_COPY_AND_ASSIGN(KernelIsolateConfiguration);
 };
 
+// Fetches a kernel piece named in a kernel list and checks that it looks like
+// a kernel before handing it to the isolate. Safe to call on any thread.
+static std::unique_ptr<const fml::Mapping> FetchKernelPiece(
+    const AssetManager& asset_manager,
+    const std::string& path) {
+  TRACE_EVENT1("flutter", "FetchKernelPiece", "path", path.c_str());
+  std::unique_ptr<fml::Mapping> piece = asset_manager.GetAsMapping(path);
+  if (!piece || piece->GetSize() == 0) {
+    FML_LOG(ERROR) << "Failed to load kernel piece: " << path;
+    return nullptr;
+  }
+  if (!Dart_IsKernel(piece->GetMapping(), piece->GetSize())) {
+    FML_LOG(ERROR) << "Kernel piece is not a valid kernel: " << path;
+    return nullptr;
+  }
+  return piece;
+}
+
 class KernelListIsolateConfiguration final : public IsolateConfiguration {
  public:
+  // The pieces have already been requested by the embedder.
   explicit KernelListIsolateConfiguration(
       std::vector<std::future<std::unique_ptr<const fml::Mapping>>>
           kernel_pieces)
-      : kernel_piece_futures_(std::move(kernel_pieces)) {
+      : kernel_piece_futures_(std::move(kernel_pieces)),
+        loading_started_(true) {
     if (kernel_piece_futures_.empty()) {
       FML_LOG(ERROR) << "Attempted to create kernel list configuration without "
                         "any kernel blobs.";
     }
   }
 
+  // The pieces are named by a kernel list asset and are fetched from the asset
+  // manager once loading begins.
+  KernelListIsolateConfiguration(
+      std::vector<std::string> kernel_piece_paths,
+      std::shared_ptr<AssetManager> asset_manager,
+      fml::RefPtr<fml::TaskRunner> io_worker)
+      : kernel_piece_paths_(std::move(kernel_piece_paths)),
+        asset_manager_(std::move(asset_manager)),
+        io_worker_(std::move(io_worker)) {
+    if (kernel_piece_paths_.empty()) {
+      FML_LOG(ERROR) << "Attempted to create kernel list configuration without "
+                        "any kernel blobs.";
+    }
+  }
+
+  // |IsolateConfiguration|
+  void BeginLoading(const std::shared_ptr<fml::ConcurrentTaskRunner>&
+                        concurrent_worker) override {
+    if (loading_started_) {
+      return;
+    }
+    loading_started_ = true;
+
+    // All pieces are requested up front so that they are fetched in parallel.
+    // The isolate then consumes them in order as each one becomes available.
+    for (const auto& path : kernel_piece_paths_) {
+      std::promise<std::unique_ptr<const fml::Mapping>> fetch_promise;
+      kernel_piece_futures_.push_back(fetch_promise.get_future());
+      auto fetch_task = fml::MakeCopyable(
+          [asset_manager = asset_manager_, path,
+           fetch_promise = std::move(fetch_promise)]() mutable {
+            fetch_promise.set_value(FetchKernelPiece(*asset_manager, path));
+          });
+      if (concurrent_worker) {
+        concurrent_worker->PostTask(fetch_task);
+      } else if (io_worker_) {
+        io_worker_->PostTask(fetch_task);
+      } else {
+        fetch_task();
+      }
+    }
+  }
+
   // |IsolateConfiguration|
   bool DoPrepareIsolate(DartIsolate& isolate) override {
     if (DartVM::IsRunningPrecompiledCode()) {
       return false;
     }
 
-    ResolveKernelPiecesIfNecessary();
+    BeginLoading(nullptr);
 
-    if (resolved_kernel_pieces_.empty()) {
+    if (kernel_piece_futures_.empty()) {
       FML_DLOG(ERROR) << "No kernel pieces provided to prepare this isolate.";
       return false;
     }
 
-    for (size_t i = 0; i < resolved_kernel_pieces_.size(); i++) {
-      if (!resolved_kernel_pieces_[i]) {
-        FML_DLOG(ERROR) << "This kernel list isolate configuration was already "
-                           "used to prepare an isolate.";
+    // Only the loading of the libraries into the isolate is serialized. Later
+    // pieces continue to be fetched while earlier ones are being loaded.
+    for (size_t i = 0; i < kernel_piece_futures_.size(); i++) {
+      std::unique_ptr<const fml::Mapping> piece = TakeKernelPiece(i);
+      if (!piece) {
+        FML_DLOG(ERROR) << "Kernel piece " << i
+                        << " could not be resolved or this kernel list "
+                           "isolate configuration was already used to prepare "
+                           "an isolate.";
         return false;
       }
-      const bool last_piece = i + 1 == resolved_kernel_pieces_.size();
-      if (!isolate.PrepareForRunningFromKernel(
-              std::move(resolved_kernel_pieces_[i]), /*child_isolate=*/false,
-              last_piece)) {
+      const bool last_piece = i + 1 == kernel_piece_futures_.size();
+      if (!isolate.PrepareForRunningFromKernel(std::move(piece),
+                                               /*child_isolate=*/false,
+                                               last_piece)) {
         return false;
       }
     }
@@ -113,34 +185,37 @@ class KernelListIsolateConfiguration final : public IsolateConfiguration {
 
   // |IsolateConfiguration|
   bool IsNullSafetyEnabled(const DartSnapshot& snapshot) override {
-    ResolveKernelPiecesIfNecessary();
-    const auto kernel = resolved_kernel_pieces_.empty()
-                            ? nullptr
-                            : resolved_kernel_pieces_.front().get();
-    return snapshot.IsNullSafetyEnabled(kernel);
+    BeginLoading(nullptr);
+    if (kernel_piece_futures_.empty()) {
+      return snapshot.IsNullSafetyEnabled(nullptr);
+    }
+    // Only the first piece is needed. The rest keep loading in the meantime.
+    if (kernel_piece_futures_.front().valid()) {
+      first_kernel_piece_ = kernel_piece_futures_.front().get();
+    }
+    return snapshot.IsNullSafetyEnabled(first_kernel_piece_.get());
   }
 
-  // This must be call as late as possible before accessing any of the kernel
-  // pieces. This will delay blocking on the futures for as long as possible. So
-  // far, only Fuchsia depends on this optimization and only on the non-AOT
-  // configs.
-  void ResolveKernelPiecesIfNecessary() {
-    if (resolved_kernel_pieces_.size() == kernel_piece_futures_.size()) {
-      return;
+ private:
+  std::unique_ptr<const fml::Mapping> TakeKernelPiece(size_t index) {
+    if (index == 0 && first_kernel_piece_) {
+      return std::move(first_kernel_piece_);
     }
-
-    resolved_kernel_pieces_.clear();
-    for (auto& piece : kernel_piece_futures_) {
-      // The get() call will xfer the unique pointer out and leave an empty
-      // future in the original vector.
-      resolved_kernel_pieces_.emplace_back(piece.get());
+    auto& future = kernel_piece_futures_[index];
+    if (!future.valid()) {
+      return nullptr;
     }
+    return future.get();
   }
 
- private:
+  const std::vector<std::string> kernel_piece_paths_;
+  const std::shared_ptr<AssetManager> asset_manager_;
+  const fml::RefPtr<fml::TaskRunner> io_worker_;
   std::vector<std::future<std::unique_ptr<const fml::Mapping>>>
       kernel_piece_futures_;
-  std::vector<std::unique_ptr<const fml::Mapping>> resolved_kernel_pieces_;
+  // Resolved early to answer |IsNullSafetyEnabled|.
+  std::unique_ptr<const fml::Mapping> first_kernel_piece_;
+  bool loading_started_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(KernelListIsolateConfiguration);
 };
@@ -172,34 +247,6 @@ static std::vector<std::string> ParseKernelListPaths(
   return kernel_pieces_paths;
 }
 
-static std::vector<std::future<std::unique_ptr<const fml::Mapping>>>
-PrepareKernelMappings(const std::vector<std::string>& kernel_pieces_paths,
-                      const std::shared_ptr<AssetManager>& asset_manager,
-                      const fml::RefPtr<fml::TaskRunner>& io_worker) {
-  FML_DCHECK(asset_manager);
-  std::vector<std::future<std::unique_ptr<const fml::Mapping>>> fetch_futures;
-
-  for (const auto& kernel_pieces_path : kernel_pieces_paths) {
-    std::promise<std::unique_ptr<const fml::Mapping>> fetch_promise;
-    fetch_futures.push_back(fetch_promise.get_future());
-    auto fetch_task =
-        fml::MakeCopyable([asset_manager, kernel_pieces_path,
-                           fetch_promise = std::move(fetch_promise)]() mutable {
-          fetch_promise.set_value(
-              asset_manager->GetAsMapping(kernel_pieces_path));
-        });
-    // Fulfill the promise on the worker if one is available or the current
-    // thread if one is not.
-    if (io_worker) {
-      io_worker->PostTask(fetch_task);
-    } else {
-      fetch_task();
-    }
-  }
-
-  return fetch_futures;
-}
-
 std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
     const Settings& settings,
     const std::shared_ptr<AssetManager>& asset_manager,
@@ -241,13 +288,8 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
   }
 
   // Running from kernel divided into several pieces (for sharing). Requires
-  // asset manager and io worker.
-
-  if (!io_worker) {
-    FML_DLOG(ERROR) << "No IO worker specified to load kernel pieces.";
-    return nullptr;
-  }
-
+  // asset manager. The pieces themselves are fetched once the isolate is
+  // launched.
   {
     std::unique_ptr<fml::Mapping> kernel_list =
         asset_manager->GetAsMapping(settings.application_kernel_list_asset);
@@ -257,9 +299,8 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
       return nullptr;
     }
     auto kernel_pieces_paths = ParseKernelListPaths(std::move(kernel_list));
-    auto kernel_mappings =
-        PrepareKernelMappings(kernel_pieces_paths, asset_manager, io_worker);
-    return CreateForKernelList(std::move(kernel_mappings));
+    return std::make_unique<KernelListIsolateConfiguration>(
+        std::move(kernel_pieces_paths), asset_manager, io_worker);
   }
 
   return nullptr;
@@ -11,6 +11,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/runtime/dart_isolate.h"
@@ -52,11 +53,15 @@ class IsolateConfiguration {
   ///             snapshot resolution is attempted with predefined symbols
   ///             present in the currently loaded process. In JIT mode, Dart
   ///             kernel file resolution is attempted in the assets directory.
-  ///             If an IO worker is specified, snapshot resolution may be
-  ///             attempted on the serial worker task runner. The worker task
-  ///             runner thread must remain valid and running till after the
-  ///             shell associated with the engine used to launch the isolate
-  ///             for which this run configuration is used is collected.
+  ///             Kernel pieces named by a kernel list asset are fetched and
+  ///             validated concurrently on the VM's worker pool when the
+  ///             isolate is launched (see `BeginLoading`). If no worker pool
+  ///             is available and an IO worker is specified, snapshot
+  ///             resolution is attempted on the serial worker task runner
+  ///             instead. The worker task runner thread must remain valid and
+  ///             running till after the shell associated with the engine used
+  ///             to launch the isolate for which this run configuration is
+  ///             used is collected.
   ///
   /// @param[in]  settings       The settings
   /// @param[in]  asset_manager  The optional asset manager. This is used when
@@ -171,6 +176,23 @@ class IsolateConfiguration {
   ///
   [[nodiscard]] bool PrepareIsolate(DartIsolate& isolate);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gives the configuration a chance to start resolving the
+  ///             snapshots it needs before the isolate is created. This is
+  ///             invoked before `IsNullSafetyEnabled` and `PrepareIsolate`.
+  ///             Configurations that resolve their snapshots lazily use this to
+  ///             fetch them concurrently while the isolate is being set up.
+  ///             Calling this more than once has no additional effect.
+  ///
+  /// @param[in]  concurrent_worker  The worker pool on which snapshots may be
+  ///                                resolved. May be `nullptr`, in which case
+  ///                                snapshots are resolved on the IO worker
+  ///                                the configuration was created with or,
+  ///                                failing that, on demand.
+  ///
+  virtual void BeginLoading(
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_worker);
+
   virtual bool IsNullSafetyEnabled(const DartSnapshot& snapshot) = 0;
 
  protected:
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/base64.h"
+
+#include <random>
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace flutter {
+
+namespace {
+
+std::string MakeBytes(size_t size) {
+  std::mt19937 random(size);
+  std::string bytes(size, '\0');
+  for (char& byte : bytes) {
+    byte = static_cast<char>(random());
+  }
+  return bytes;
+}
+
+}  // namespace
+
+// The first argument is the size of the decoded data in bytes.
+static void BM_Base64Encode(benchmark::State& state) {
+  const std::string bytes = MakeBytes(state.range(0));
+  std::string text(Base64::EncodedSize(bytes.size()), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Base64::Encode(bytes.data(), bytes.size(), text.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_Base64Encode)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+// Measures the decoded size, then decodes, as callers that don't know the
+// size of the data do.
+static void BM_Base64Decode(benchmark::State& state) {
+  const std::string bytes = MakeBytes(state.range(0));
+  std::string text(Base64::EncodedSize(bytes.size()), '\0');
+  Base64::Encode(bytes.data(), bytes.size(), text.data());
+  std::string decoded(bytes.size(), '\0');
+  for (auto _ : state) {
+    size_t length = 0;
+    benchmark::DoNotOptimize(
+        Base64::Decode(text.data(), text.size(), nullptr, &length));
+    benchmark::DoNotOptimize(
+        Base64::Decode(text.data(), text.size(), decoded.data(), &length));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Base64Decode)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+}  // namespace flutter
@@ -7,6 +7,7 @@
 #include "fml/logging.h"
 #include "gtest/gtest.h"
 
+#include <cctype>
 #include <string>
 
 namespace flutter {
@@ -118,5 +119,55 @@ TEST(Base64, DecodeBytes) {
   test("AyQ/aoiF", pi, sizeof(pi));
 }
 
+TEST(Base64, EncodeDecodeLongBytes) {
+  // Long enough to be encoded and decoded in blocks where vector
+  // instructions are available, with a remainder of every length.
+  for (size_t size = 0; size < 200; size++) {
+    std::string bytes(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+      bytes[i] = static_cast<char>(i * 37 + size);
+    }
+    std::string text(Base64::EncodedSize(size), '\0');
+    ASSERT_EQ(Base64::Encode(bytes.data(), size, text.data()), text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+      const char c = text[i];
+      ASSERT_TRUE(isalnum(c) || c == '+' || c == '/' || c == '=') << size;
+    }
+
+    size_t length = 0;
+    ASSERT_EQ(Base64::Decode(text.data(), text.size(), nullptr, &length),
+              Base64::Error::kNone);
+    ASSERT_EQ(length, size);
+    std::string decoded(length, '\0');
+    ASSERT_EQ(Base64::Decode(text.data(), text.size(), decoded.data(), &length),
+              Base64::Error::kNone);
+    ASSERT_EQ(decoded, bytes);
+  }
+}
+
+TEST(Base64, DecodeLongStringsWithErrors) {
+  const std::string text(128, 'Q');
+  for (size_t i = 0; i < text.size(); i++) {
+    char buffer[256];
+    size_t len = 0;
+    std::string bad_char = text;
+    bad_char[i] = '!';
+    EXPECT_EQ(Base64::Decode(bad_char.data(), bad_char.size(), buffer, &len),
+              Base64::Error::kBadChar)
+        << i;
+
+    // Whitespace anywhere but at the end is ignored.
+    if (i == text.size() - 1) {
+      continue;
+    }
+    std::string space = text;
+    space[i] = ' ';
+    ASSERT_EQ(Base64::Decode(space.data(), space.size(), buffer, &len),
+              Base64::Error::kNone)
+        << i;
+    EXPECT_EQ(len, (text.size() - 1) / 4 * 3 + 2) << i;
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
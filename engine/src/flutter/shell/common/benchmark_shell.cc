@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/benchmark_shell.h"
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+namespace {
+
+// Signals a latch when the response to a message arrives.
+class LatchResponse : public PlatformMessageResponse {
+ public:
+  explicit LatchResponse(fml::AutoResetWaitableEvent* latch) : latch_(latch) {}
+
+  // |PlatformMessageResponse|
+  void Complete(std::unique_ptr<fml::Mapping> data) override {
+    is_complete_ = true;
+    latch_->Signal();
+  }
+
+  // |PlatformMessageResponse|
+  void CompleteEmpty() override {
+    is_complete_ = true;
+    latch_->Signal();
+  }
+
+ private:
+  fml::AutoResetWaitableEvent* latch_;
+};
+
+}  // namespace
+
+Settings CreateFixtureSettings(testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {
+    return fml::TaskQueueId::Invalid();
+  };
+  settings.task_observer_remove = [](fml::TaskQueueId, intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = []() {
+      auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                           fml::FilePermission::kRead);
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+BenchmarkShell::BenchmarkShell(
+    const std::string& entrypoint,
+    std::vector<std::string> entrypoint_args,
+    std::shared_ptr<const fml::Mapping> persistent_isolate_data)
+    : settings_(CreateFixtureSettings(aot_symbols_)),
+      thread_host_(ThreadHost::ThreadHostConfig(
+          "io.flutter.bench.",
+          ThreadHost::Type::kPlatform | ThreadHost::Type::kUi)),
+      task_runners_("test",
+                    thread_host_.platform_thread->GetTaskRunner(),
+                    thread_host_.ui_thread->GetTaskRunner()) {
+  settings_.persistent_isolate_data = std::move(persistent_isolate_data);
+  shell_ = Shell::Create(
+      flutter::PlatformData(), task_runners_, settings_, [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      });
+  FML_CHECK(shell_);
+
+  fml::AutoResetWaitableEvent latch;
+  Engine::RunStatus status = Engine::RunStatus::Failure;
+  auto configuration = RunConfiguration::InferFromSettings(settings_);
+  configuration.SetEntrypoint(entrypoint);
+  configuration.SetEntrypointArgs(std::move(entrypoint_args));
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(),
+      fml::MakeCopyable(
+          [&, configuration = std::move(configuration)]() mutable {
+            shell_->RunEngine(std::move(configuration),
+                              [&](Engine::RunStatus result) {
+                                status = result;
+                                latch.Signal();
+                              });
+          }));
+  latch.Wait();
+  FML_CHECK(status == Engine::RunStatus::Success);
+}
+
+BenchmarkShell::~BenchmarkShell() {
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runners_.GetPlatformTaskRunner(),
+                                    [&]() {
+                                      shell_.reset();
+                                      latch.Signal();
+                                    });
+  latch.Wait();
+}
+
+void BenchmarkShell::SendMessage(const std::string& channel,
+                                 const std::string& payload) {
+  fml::AutoResetWaitableEvent latch;
+  task_runners_.GetPlatformTaskRunner()->PostTask([&]() {
+    auto data = fml::MallocMapping::Copy(payload.data(), payload.size());
+    shell_->GetPlatformView()->DispatchPlatformMessage(
+        std::make_unique<PlatformMessage>(
+            channel, std::move(data),
+            fml::MakeRefCounted<LatchResponse>(&latch)));
+  });
+  latch.Wait();
+}
+
+}  // namespace flutter
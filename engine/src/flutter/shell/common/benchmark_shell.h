@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_BENCHMARK_SHELL_H_
+#define FLUTTER_SHELL_COMMON_BENCHMARK_SHELL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/shell/common/shell.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/testing/elf_loader.h"
+
+namespace flutter {
+
+// Returns the settings for running the shell test fixtures. |aot_symbols|
+// must outlive any shell using the settings.
+Settings CreateFixtureSettings(testing::ELFAOTSymbols& aot_symbols);
+
+// A shell running a fixture entrypoint, for benchmarks that exchange platform
+// messages with Dart.
+class BenchmarkShell {
+ public:
+  explicit BenchmarkShell(
+      const std::string& entrypoint,
+      std::vector<std::string> entrypoint_args = {},
+      std::shared_ptr<const fml::Mapping> persistent_isolate_data = nullptr);
+
+  ~BenchmarkShell();
+
+  // Dispatches a message from the platform thread and waits for its
+  // response.
+  void SendMessage(const std::string& channel, const std::string& payload);
+
+ private:
+  testing::ELFAOTSymbols aot_symbols_;
+  Settings settings_;
+  ThreadHost thread_host_;
+  TaskRunners task_runners_;
+  std::unique_ptr<Shell> shell_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BenchmarkShell);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_BENCHMARK_SHELL_H_
@@ -4,16 +4,19 @@
 
 #include "flutter/shell/common/engine.h"
 
+#include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "flutter/assets/native_assets.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/json_reader.h"
 #include "flutter/fml/trace_event.h"
-#include "rapidjson/document.h"
 
 namespace flutter {
 
@@ -21,10 +24,109 @@ static constexpr char kAssetChannel[] = "flutter/assets";
 static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
 
+// Bounds for the mappings retained for the asset channel. Mappings are
+// usually file backed, so the byte budget mostly limits address space. File
+// mappings larger than the budget are retained without counting against it.
+static constexpr size_t kAssetChannelCacheMaxEntries = 32;
+static constexpr size_t kAssetChannelCacheMaxBytes = 64 * 1024 * 1024;
+
 namespace {
 fml::MallocMapping MakeMapping(const std::string& str) {
   return fml::MallocMapping::Copy(str.c_str(), str.length());
 }
+
+// Whether |message| is on the channel |name|, comparing interned ids rather
+// than names whenever possible.
+template <const char* name>
+bool IsOnChannel(const PlatformMessage& message) {
+  static const ChannelId id = ChannelRegistry::Intern(name);
+  if (id == ChannelRegistry::kUninternedChannel) {
+    return message.channel() == name;
+  }
+  return message.channel_id() == id;
+}
+
+struct AssetRequest {
+  std::string asset_name;
+  size_t offset = 0;
+  // Zero means to the end of the asset.
+  size_t length = 0;
+};
+
+std::optional<AssetRequest> ParseAssetRequest(const fml::Mapping& data) {
+  const char* begin = reinterpret_cast<const char*>(data.GetMapping());
+  const char* end = begin + data.GetSize();
+  const char* separator = std::find(begin, end, '\0');
+
+  AssetRequest request;
+  request.asset_name.assign(begin, separator);
+  if (separator == end) {
+    return request;
+  }
+
+  const char* range = separator + 1;
+  auto [offset_end, offset_error] =
+      std::from_chars(range, end, request.offset);
+  if (offset_error != std::errc() || offset_end == end ||
+      *offset_end != ':') {
+    return std::nullopt;
+  }
+  auto [length_end, length_error] =
+      std::from_chars(offset_end + 1, end, request.length);
+  if (length_error != std::errc() || length_end != end) {
+    return std::nullopt;
+  }
+  return request;
+}
+
+void ServeAssetRequest(const AssetRequest& request,
+                       const std::shared_ptr<AssetManager>& asset_manager,
+                       const std::shared_ptr<AssetMappingCache>& cache,
+                       const fml::RefPtr<PlatformMessageResponse>& response) {
+  TRACE_EVENT1("flutter", "Engine::ServeAssetRequest", "asset",
+               request.asset_name.c_str());
+  std::shared_ptr<const fml::Mapping> mapping = cache->Get(request.asset_name);
+  const bool is_range = request.offset != 0 || request.length != 0;
+  if (!mapping && is_range) {
+    // Only the range is read, so that compressed assets are decompressed
+    // chunk by chunk as they are streamed. Nothing is retained, so resolvers
+    // that do not read ranges themselves resolve the whole asset again for
+    // each chunk. For directory bundles that is a file mapping, which the
+    // FileMappingCache shares between chunks for files up to its size limit
+    // and maps again for larger ones.
+    std::unique_ptr<fml::Mapping> range = asset_manager->GetAsMappingRange(
+        request.asset_name, request.offset, request.length);
+    if (range && range->GetSize() > 0) {
+      response->Complete(std::move(range));
+    } else {
+      response->CompleteEmpty();
+    }
+    return;
+  }
+  if (!mapping) {
+    mapping = asset_manager->GetAsMapping(request.asset_name);
+    if (!mapping) {
+      response->CompleteEmpty();
+      return;
+    }
+    cache->Put(request.asset_name, mapping);
+  }
+
+  const size_t size = mapping->GetSize();
+  if (request.offset == 0 &&
+      (request.length == 0 || request.length >= size)) {
+    response->Complete(AssetMappingCache::Slice(std::move(mapping), 0, size));
+    return;
+  }
+  if (request.offset >= size) {
+    response->CompleteEmpty();
+    return;
+  }
+  const size_t length =
+      request.length == 0 ? size - request.offset : request.length;
+  response->Complete(
+      AssetMappingCache::Slice(std::move(mapping), request.offset, length));
+}
 }  // namespace
 
 Engine::Engine(Delegate& delegate,
@@ -59,6 +161,7 @@ Engine::Engine(Delegate& delegate,
           settings_.advisory_script_entrypoint,  // advisory script entrypoint
           vm.GetConcurrentWorkerTaskRunner(),    // concurrent task runner
       });
+  concurrent_task_runner_ = vm.GetConcurrentWorkerTaskRunner();
 }
 
 std::unique_ptr<Engine> Engine::Spawn(Delegate& delegate,
@@ -77,6 +180,8 @@ std::unique_ptr<Engine> Engine::Spawn(Delegate& delegate,
       /*isolate_shutdown_callback=*/settings.isolate_shutdown_callback,
       /*persistent_isolate_data=*/settings.persistent_isolate_data);
   result->asset_manager_ = asset_manager_;
+  result->asset_channel_cache_ = asset_channel_cache_;
+  result->concurrent_task_runner_ = concurrent_task_runner_;
   return result;
 }
 
@@ -98,6 +203,8 @@ bool Engine::UpdateAssetManager(
   }
 
   asset_manager_ = new_asset_manager;
+  asset_channel_cache_ = std::make_shared<AssetMappingCache>(
+      kAssetChannelCacheMaxEntries, kAssetChannelCacheMaxBytes);
 
   if (!asset_manager_) {
     return false;
@@ -231,57 +338,62 @@ tonic::DartErrorHandleType Engine::GetUIIsolateLastError() {
 }
 
 void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
-  std::string channel = message->channel();
-  if (channel == kLocalizationChannel) {
+  if (IsOnChannel<kLocalizationChannel>(*message)) {
     if (HandleLocalizationPlatformMessage(message.get())) {
       return;
     }
   }
 
+  // The names of interned channels outlive the message, so only those of
+  // uninterned channels are copied for the warning below.
+  const std::string* channel = &message->channel();
+  std::string uninterned_channel;
+  if (message->channel_id() == ChannelRegistry::kUninternedChannel) {
+    uninterned_channel = *channel;
+    channel = &uninterned_channel;
+  }
   if (runtime_controller_->IsRootIsolateRunning() &&
       runtime_controller_->DispatchPlatformMessage(std::move(message))) {
     return;
   }
 
-  FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
+  FML_DLOG(WARNING) << "Dropping platform message on channel: " << *channel;
 }
 
 bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
 
-  rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
-                 data.GetSize());
-  if (document.HasParseError() || !document.IsObject()) {
+  // Only the method and the locale strings are needed, so read them straight
+  // out of the message instead of building a DOM on the UI thread.
+  fml::JsonDocument document;
+  if (document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                     data.GetSize()) != fml::JsonParseStatus::kOk ||
+      !document.GetRoot().IsObject()) {
     return false;
   }
-  auto root = document.GetObject();
-  auto method = root.FindMember("method");
-  if (method == root.MemberEnd()) {
+  fml::JsonValue root = document.GetRoot();
+  std::optional<fml::JsonValue> method = root.Find("method");
+  if (!method.has_value()) {
     return false;
   }
   const size_t strings_per_locale = 4;
-  if (method->value == "setLocale") {
+  if (method->IsString() && method->GetString() == "setLocale") {
     // Decode and pass the list of locale data onwards to dart.
-    auto args = root.FindMember("args");
-    if (args == root.MemberEnd() || !args->value.IsArray()) {
+    std::optional<fml::JsonValue> args = root.Find("args");
+    if (!args.has_value() || !args->IsArray()) {
       return false;
     }
 
-    if (args->value.Size() % strings_per_locale != 0) {
+    if (args->Size() % strings_per_locale != 0) {
       return false;
     }
     std::vector<std::string> locale_data;
-    for (size_t locale_index = 0; locale_index < args->value.Size();
-         locale_index += strings_per_locale) {
-      if (!args->value[locale_index].IsString() ||
-          !args->value[locale_index + 1].IsString()) {
+    locale_data.reserve(args->Size());
+    for (fml::JsonValue arg : *args) {
+      if (!arg.IsString()) {
         return false;
       }
-      locale_data.push_back(args->value[locale_index].GetString());
-      locale_data.push_back(args->value[locale_index + 1].GetString());
-      locale_data.push_back(args->value[locale_index + 2].GetString());
-      locale_data.push_back(args->value[locale_index + 3].GetString());
+      locale_data.emplace_back(arg.GetString());
     }
 
     return runtime_controller_->SetLocales(locale_data);
@@ -290,7 +402,7 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 }
 
 void Engine::HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) {
-  if (message->channel() == kAssetChannel) {
+  if (IsOnChannel<kAssetChannel>(*message)) {
     HandleAssetPlatformMessage(std::move(message));
   } else {
     delegate_.OnEngineHandlePlatformMessage(std::move(message));
@@ -317,20 +429,23 @@ void Engine::HandleAssetPlatformMessage(
   if (!response) {
     return;
   }
-  const auto& data = message->data();
-  std::string asset_name(reinterpret_cast<const char*>(data.GetMapping()),
-                         data.GetSize());
-
-  if (asset_manager_) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset_name);
-    if (asset_mapping) {
-      response->Complete(std::move(asset_mapping));
-      return;
-    }
+  auto request = ParseAssetRequest(message->data());
+  if (!asset_manager_ || !asset_channel_cache_ || !request.has_value()) {
+    response->CompleteEmpty();
+    return;
   }
 
-  response->CompleteEmpty();
+  auto serve = [request = std::move(request.value()),
+                asset_manager = asset_manager_, cache = asset_channel_cache_,
+                response = std::move(response)]() {
+    ServeAssetRequest(request, asset_manager, cache, response);
+  };
+
+  if (concurrent_task_runner_) {
+    concurrent_task_runner_->PostTask(std::move(serve));
+  } else {
+    serve();
+  }
 }
 
 const std::string& Engine::GetLastEntrypoint() const {
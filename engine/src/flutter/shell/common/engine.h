@@ -9,6 +9,7 @@
 #include <string>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/assets/asset_mapping_cache.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
@@ -670,6 +671,25 @@ class Engine final : public RuntimeDelegate {
 
   bool HandleLocalizationPlatformMessage(PlatformMessage* message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Serves a request on the `flutter/assets` channel.
+  ///
+  ///             The request payload is the UTF-8 encoded asset name,
+  ///             optionally followed by a NUL character and a byte range in
+  ///             the form `<offset>:<length>` (both decimal). A length of zero
+  ///             means "to the end of the asset". Ranges past the end of the
+  ///             asset are clamped. Range requests let large assets be read in
+  ///             chunks instead of being copied into the Dart heap whole.
+  ///
+  ///             Assets are resolved on the concurrent worker task runner and
+  ///             the response is completed from there. Recently served
+  ///             mappings are retained in |asset_channel_cache_| so repeated
+  ///             requests do not hit the asset resolvers again. Range requests
+  ///             for assets that are not retained read only the range, so
+  ///             compressed assets are decompressed as they are streamed, but
+  ///             resolvers that cannot read ranges resolve the whole asset for
+  ///             each of them.
+  ///
   void HandleAssetPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
@@ -685,8 +705,12 @@ class Engine final : public RuntimeDelegate {
   std::vector<std::string> last_entry_point_args_;
   std::optional<int64_t> last_engine_id_;
   std::shared_ptr<AssetManager> asset_manager_;
+  // Replaced (not cleared) whenever |asset_manager_| changes so that in-flight
+  // asset requests for the previous asset manager cannot repopulate it.
+  std::shared_ptr<AssetMappingCache> asset_channel_cache_;
   std::shared_ptr<NativeAssetsManager> native_assets_manager_;
   TaskRunners task_runners_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::TaskRunnerAffineWeakPtrFactory<Engine>
       weak_factory_;  // Must be the last member.
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
@@ -5,6 +5,10 @@
 #include "flutter/shell/common/engine.h"
 
 #include <cstring>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
@@ -55,6 +59,83 @@ class FontManifestAssetResolver : public AssetResolver {
   }
 };
 
+// Serves "asset" with the contents "0123456789".
+class RangeAssetResolver : public AssetResolver {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  AssetResolver::AssetResolverType GetType() const override {
+    return AssetResolver::AssetResolverType::kDirectoryAssetBundle;
+  }
+
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    if (asset_name != "asset") {
+      return nullptr;
+    }
+    std::scoped_lock lock(mutex_);
+    resolved_on_ = std::this_thread::get_id();
+    return std::make_unique<fml::DataMapping>("0123456789");
+  }
+
+  // The thread on which "asset" was last resolved.
+  std::thread::id GetResolvedOn() const {
+    std::scoped_lock lock(mutex_);
+    return resolved_on_;
+  }
+
+  bool operator==(const AssetResolver& other) const override {
+    return this == &other;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  mutable std::thread::id resolved_on_;
+};
+
+// Records the data an asset request was completed with.
+class AssetResponse : public PlatformMessageResponse {
+ public:
+  void Complete(std::unique_ptr<fml::Mapping> data) override {
+    data_ = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                        data->GetSize());
+    latch_.Signal();
+  }
+
+  void CompleteEmpty() override {
+    data_ = std::nullopt;
+    latch_.Signal();
+  }
+
+  // Waits for the response, and returns its data or nullopt if it was empty.
+  std::optional<std::string> Wait() {
+    latch_.Wait();
+    return data_;
+  }
+
+ private:
+  fml::AutoResetWaitableEvent latch_;
+  std::optional<std::string> data_;
+};
+
+// Returns the payload of a request for the `range` ("<offset>:<length>") of
+// `name`.
+std::string MakeAssetRangeRequest(const std::string& name,
+                                  const std::string& range) {
+  return name + std::string(1, '\0') + range;
+}
+
+std::optional<std::string> RequestAsset(Engine& engine,
+                                        const std::string& request) {
+  auto response = fml::MakeRefCounted<AssetResponse>();
+  engine.HandlePlatformMessage(std::make_unique<PlatformMessage>(
+      "flutter/assets",
+      fml::MallocMapping::Copy(request.data(), request.size()), response));
+  return response->Wait();
+}
+
 class MockDelegate : public Engine::Delegate {
  public:
   MOCK_METHOD(void,
@@ -336,4 +417,85 @@ TEST_F(EngineTest, UpdateAssetManagerWithEqualManagers) {
   });
 }
 
+TEST_F(EngineTest, ServesAssetRangeRequests) {
+  PostUITaskSync([this] {
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*runtime_controller=*/std::move(runtime_controller_));
+    auto asset_manager = std::make_shared<AssetManager>();
+    asset_manager->PushBack(std::make_unique<RangeAssetResolver>());
+    engine->UpdateAssetManager(asset_manager);
+
+    auto check_ranges = [&engine]() {
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", "2:3")),
+                "234");
+      // A length of zero reads to the end of the asset.
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", "7:0")),
+                "789");
+      // Ranges are clamped to the asset.
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", "8:10")),
+                "89");
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", "10:1")),
+                std::nullopt);
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", "20:0")),
+                std::nullopt);
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("missing", "0:1")),
+                std::nullopt);
+      // Malformed ranges are rejected.
+      for (const char* range : {"", "2", "2:", ":3", "x:1", "2:3x", "-1:2",
+                                "2:-3", "2;3", "99999999999999999999:1"}) {
+        EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", range)),
+                  std::nullopt)
+            << range;
+      }
+      // This is the same as requesting the whole asset.
+      EXPECT_EQ(RequestAsset(*engine, MakeAssetRangeRequest("asset", "0:0")),
+                "0123456789");
+    };
+
+    // Ranges of assets that were not requested whole are read from the
+    // resolvers, and then sliced from the retained mapping.
+    check_ranges();
+    check_ranges();
+    EXPECT_EQ(RequestAsset(*engine, "asset"), "0123456789");
+    EXPECT_EQ(RequestAsset(*engine, "missing"), std::nullopt);
+  });
+}
+
+TEST_F(EngineTest, ServesAssetRequestsOffTheUIThread) {
+  auto vm_ref = DartVMRef::Create(settings_);
+  std::unique_ptr<Engine> engine;
+  PostUITaskSync([&] {
+    engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*vm=*/*vm_ref,
+        /*isolate_snapshot=*/vm_ref->GetVMData()->GetIsolateSnapshot(),
+        /*task_runners=*/task_runners_,
+        /*platform_data=*/PlatformData(),
+        /*settings=*/settings_);
+  });
+  auto asset_manager = std::make_shared<AssetManager>();
+  auto resolver = std::make_unique<RangeAssetResolver>();
+  const RangeAssetResolver* resolver_ptr = resolver.get();
+  asset_manager->PushBack(std::move(resolver));
+
+  auto response = fml::MakeRefCounted<AssetResponse>();
+  std::thread::id ui_thread_id;
+  PostUITaskSync([&] {
+    ui_thread_id = std::this_thread::get_id();
+    engine->UpdateAssetManager(asset_manager);
+    const std::string request = MakeAssetRangeRequest("asset", "4:2");
+    engine->HandlePlatformMessage(std::make_unique<PlatformMessage>(
+        "flutter/assets",
+        fml::MallocMapping::Copy(request.data(), request.size()), response));
+  });
+  EXPECT_EQ(response->Wait(), "45");
+  EXPECT_NE(resolver_ptr->GetResolvedOn(), std::thread::id());
+  EXPECT_NE(resolver_ptr->GetResolvedOn(), ui_thread_id);
+
+  PostUITaskSync([&] { engine.reset(); });
+}
+
 }  // namespace flutter
@@ -18,6 +18,37 @@ void expect(Object? a, Object? b) {
 
 void main() {}
 
+// Sends `args[2]` messages of `args[0]` bytes to the platform for each message
+// received on bench/send. `args[1]` is 'shared' to create the payload with
+// createPlatformMessageData.
+@pragma('vm:entry-point')
+void platformMessageSendBenchmark(List<String> args) {
+  final int size = int.parse(args[0]);
+  final ByteData payload = args[1] == 'shared'
+      ? PlatformDispatcher.instance.createPlatformMessageData(size)
+      : ByteData(size);
+  final int count = int.parse(args[2]);
+  channelBuffers.setListener('bench/send', (
+    ByteData? data,
+    PlatformMessageResponseCallback callback,
+  ) {
+    for (int i = 0; i < count; i++) {
+      PlatformDispatcher.instance.sendPlatformMessage('bench/sink', payload, null);
+    }
+    callback(null);
+  });
+}
+
+@pragma('vm:entry-point')
+void platformMessageEchoBenchmark() {
+  channelBuffers.setListener('bench/echo', (
+    ByteData? data,
+    PlatformMessageResponseCallback callback,
+  ) {
+    callback(data);
+  });
+}
+
 @pragma('vm:entry-point')
 void mainNotifyNative() {
   notifyNative();
@@ -114,6 +145,22 @@ void canAccessIsolateLaunchData() {
   );
 }
 
+// Reads the persistent isolate data `args[0]` times and keeps the results
+// alive until the isolate is shut down.
+@pragma('vm:entry-point')
+void persistentIsolateDataBenchmark(List<String> args) {
+  final int count = int.parse(args[0]);
+  final List<ByteData?> reads = <ByteData?>[
+    for (int i = 0; i < count; i++) PlatformDispatcher.instance.getPersistentIsolateData(),
+  ];
+  channelBuffers.setListener('bench/ready', (
+    ByteData? data,
+    PlatformMessageResponseCallback callback,
+  ) {
+    callback(ByteData(reads.length));
+  });
+}
+
 @pragma('vm:entry-point')
 void performanceModeImpactsNotifyIdle() {
   notifyNativeBool(false);
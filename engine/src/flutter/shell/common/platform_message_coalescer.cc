@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/platform_message_coalescer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+PlatformMessageCoalescer::PlatformMessageCoalescer() = default;
+
+PlatformMessageCoalescer::~PlatformMessageCoalescer() = default;
+
+void PlatformMessageCoalescer::Channel::Push(
+    std::unique_ptr<PlatformMessage> message,
+    std::unique_ptr<PlatformMessage>* evicted) {
+  FML_DCHECK(!ring.empty());
+  const size_t capacity = ring.size();
+  if (count == capacity) {
+    *evicted = std::move(ring[head]);
+    head = (head + 1) % capacity;
+    count--;
+    dropped++;
+  }
+  ring[(head + count) % capacity] = std::move(message);
+  count++;
+}
+
+std::unique_ptr<PlatformMessage> PlatformMessageCoalescer::Channel::Pop() {
+  FML_DCHECK(count > 0);
+  auto message = std::move(ring[head]);
+  head = (head + 1) % ring.size();
+  count--;
+  return message;
+}
+
+std::vector<std::unique_ptr<PlatformMessage>>
+PlatformMessageCoalescer::SetCapacity(const std::string& channel,
+                                      size_t capacity) {
+  std::vector<std::unique_ptr<PlatformMessage>> evicted;
+  std::scoped_lock lock(mutex_);
+  auto found = channels_.find(channel);
+  if (found == channels_.end()) {
+    if (capacity == 0) {
+      return evicted;
+    }
+    found = channels_.emplace(channel, Channel{}).first;
+  }
+  Channel& state = found->second;
+  const size_t old_capacity = state.capacity;
+  if (old_capacity == capacity) {
+    return evicted;
+  }
+
+  // Unwind the ring oldest first. When shrinking, the oldest messages are
+  // the ones that no longer fit. When the policy is removed entirely, pending
+  // messages are kept for the outstanding drain since it was posted before any
+  // message that will now be dispatched directly.
+  std::vector<std::unique_ptr<PlatformMessage>> pending;
+  pending.reserve(state.count);
+  while (state.count > 0) {
+    pending.push_back(state.Pop());
+  }
+  const size_t keep = capacity == 0 ? pending.size()
+                                    : std::min(capacity, pending.size());
+  const size_t evict = pending.size() - keep;
+  for (size_t i = 0; i < evict; i++) {
+    evicted.push_back(std::move(pending[i]));
+  }
+  state.dropped += evict;
+
+  state.capacity = capacity;
+  state.ring.clear();
+  state.ring.resize(std::max(capacity, keep));
+  state.head = 0;
+  for (size_t i = evict; i < pending.size(); i++) {
+    state.ring[state.count++] = std::move(pending[i]);
+  }
+
+  if (old_capacity == 0 && capacity != 0) {
+    active_channels_++;
+  } else if (old_capacity != 0 && capacity == 0) {
+    active_channels_--;
+  }
+  return evicted;
+}
+
+PlatformMessageCoalescer::EnqueueResult PlatformMessageCoalescer::Enqueue(
+    std::unique_ptr<PlatformMessage>& message,
+    std::unique_ptr<PlatformMessage>* evicted) {
+  FML_DCHECK(message);
+  FML_DCHECK(evicted);
+  if (!HasCoalescedChannels()) {
+    return EnqueueResult::kNotCoalesced;
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto found = channels_.find(message->channel());
+  if (found == channels_.end() || found->second.capacity == 0) {
+    return EnqueueResult::kNotCoalesced;
+  }
+  Channel& state = found->second;
+  state.Push(std::move(message), evicted);
+  if (state.drain_scheduled) {
+    return EnqueueResult::kCoalesced;
+  }
+  state.drain_scheduled = true;
+  return EnqueueResult::kScheduleDrain;
+}
+
+std::vector<std::unique_ptr<PlatformMessage>> PlatformMessageCoalescer::Drain(
+    const std::string& channel) {
+  std::vector<std::unique_ptr<PlatformMessage>> messages;
+  std::scoped_lock lock(mutex_);
+  auto found = channels_.find(channel);
+  if (found == channels_.end()) {
+    return messages;
+  }
+  Channel& state = found->second;
+  messages.reserve(state.count);
+  while (state.count > 0) {
+    messages.push_back(state.Pop());
+  }
+  state.delivered += messages.size();
+  state.drain_scheduled = false;
+  return messages;
+}
+
+std::optional<PlatformMessageCoalescer::Stats>
+PlatformMessageCoalescer::GetStats(const std::string& channel) const {
+  std::scoped_lock lock(mutex_);
+  auto found = channels_.find(channel);
+  if (found == channels_.end()) {
+    return std::nullopt;
+  }
+  const Channel& state = found->second;
+  return Stats{
+      .capacity = state.capacity,
+      .pending = state.count,
+      .delivered = state.delivered,
+      .dropped = state.dropped,
+  };
+}
+
+}  // namespace flutter
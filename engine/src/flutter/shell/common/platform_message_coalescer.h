@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PLATFORM_MESSAGE_COALESCER_H_
+#define FLUTTER_SHELL_COMMON_PLATFORM_MESSAGE_COALESCER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/platform_message.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Buffers platform messages sent from the platform to the
+///             framework on channels that opted into coalescing.
+///
+///             Each coalesced channel owns a fixed capacity ring buffer. While
+///             a delivery to the UI thread is outstanding, further messages on
+///             that channel are appended to the ring instead of each posting a
+///             task of its own. When the ring is full, the oldest message is
+///             evicted (and its response completed empty), so a capacity of
+///             one gives "latest value wins" semantics. This is intended for
+///             high frequency level-triggered channels (sensor readings, for
+///             example) where stale values are useless once the UI thread gets
+///             around to handling them.
+///
+///             Channels without a policy are not affected and take no lock on
+///             the hot path as long as no channel in the shell is coalesced.
+///
+///             This class is thread safe.
+///
+class PlatformMessageCoalescer {
+ public:
+  /// Per channel counters.
+  struct Stats {
+    /// The capacity of the ring buffer for the channel.
+    size_t capacity = 0;
+    /// The number of messages currently buffered.
+    size_t pending = 0;
+    /// The number of messages handed to the UI thread for dispatch.
+    uint64_t delivered = 0;
+    /// The number of messages evicted before they could be dispatched.
+    uint64_t dropped = 0;
+  };
+
+  enum class EnqueueResult {
+    /// The channel is not coalesced. The message was not consumed and must be
+    /// dispatched by the caller.
+    kNotCoalesced,
+    /// The message was buffered and no drain is outstanding for the channel.
+    /// The caller must arrange for |Drain| to be called on the UI thread.
+    kScheduleDrain,
+    /// The message was buffered and will be picked up by an outstanding
+    /// drain.
+    kCoalesced,
+  };
+
+  PlatformMessageCoalescer();
+
+  ~PlatformMessageCoalescer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the ring buffer capacity for a channel.
+  ///
+  /// @param[in]  channel   The channel name.
+  /// @param[in]  capacity  The number of messages retained while a drain is
+  ///                       outstanding. Zero removes the policy and restores
+  ///                       regular one-task-per-message delivery.
+  ///
+  /// @return     The messages evicted because they no longer fit. Their
+  ///             responses have not been completed. Callers should do so
+  ///             outside any locks of their own.
+  ///
+  [[nodiscard]] std::vector<std::unique_ptr<PlatformMessage>> SetCapacity(
+      const std::string& channel,
+      size_t capacity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether any channel currently has a coalescing policy. Does
+  ///             not take a lock.
+  ///
+  bool HasCoalescedChannels() const {
+    return active_channels_.load(std::memory_order_relaxed) > 0;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Offers a message to the coalescer.
+  ///
+  /// @param      message  The message. Ownership is taken unless the result is
+  ///                      |EnqueueResult::kNotCoalesced|.
+  /// @param[out] evicted  Set to the message that was evicted to make room,
+  ///                      if any. Its response has not been completed.
+  ///
+  /// @return     What the caller needs to do next.
+  ///
+  EnqueueResult Enqueue(std::unique_ptr<PlatformMessage>& message,
+                        std::unique_ptr<PlatformMessage>* evicted);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes all messages buffered for the channel, oldest first, and
+  ///             marks the channel as having no outstanding drain.
+  ///
+  std::vector<std::unique_ptr<PlatformMessage>> Drain(
+      const std::string& channel);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the counters for a channel, or std::nullopt if the
+  ///             channel has never been coalesced.
+  ///
+  std::optional<Stats> GetStats(const std::string& channel) const;
+
+ private:
+  struct Channel {
+    size_t capacity = 0;
+    // Sized to |capacity|. Only larger while a backlog from before the policy
+    // was removed is waiting for its drain.
+    std::vector<std::unique_ptr<PlatformMessage>> ring;
+    size_t head = 0;
+    size_t count = 0;
+    bool drain_scheduled = false;
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;
+
+    void Push(std::unique_ptr<PlatformMessage> message,
+              std::unique_ptr<PlatformMessage>* evicted);
+    std::unique_ptr<PlatformMessage> Pop();
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Channel> channels_;
+  // The number of channels with a non-zero capacity. Lets uncoalesced traffic
+  // skip the mutex entirely in the common case where nothing is coalesced.
+  std::atomic<size_t> active_channels_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessageCoalescer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PLATFORM_MESSAGE_COALESCER_H_
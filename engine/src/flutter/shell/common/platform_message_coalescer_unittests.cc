@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/platform_message_coalescer.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+class MockResponse : public PlatformMessageResponse {
+ public:
+  MOCK_METHOD(void, Complete, (std::unique_ptr<fml::Mapping> data), (override));
+  MOCK_METHOD(void, CompleteEmpty, (), (override));
+};
+
+std::unique_ptr<PlatformMessage> MakeMessage(const std::string& channel,
+                                             uint8_t value) {
+  return std::make_unique<PlatformMessage>(
+      channel, fml::MallocMapping::Copy(&value, sizeof(value)),
+      fml::MakeRefCounted<MockResponse>());
+}
+
+uint8_t ValueOf(const std::unique_ptr<PlatformMessage>& message) {
+  return message->data().GetMapping()[0];
+}
+}  // namespace
+
+TEST(PlatformMessageCoalescerTest, UncoalescedChannelsAreNotConsumed) {
+  PlatformMessageCoalescer coalescer;
+  EXPECT_FALSE(coalescer.HasCoalescedChannels());
+
+  auto message = MakeMessage("sensor", 1);
+  std::unique_ptr<PlatformMessage> evicted;
+  EXPECT_EQ(coalescer.Enqueue(message, &evicted),
+            PlatformMessageCoalescer::EnqueueResult::kNotCoalesced);
+  EXPECT_TRUE(message);
+  EXPECT_FALSE(evicted);
+  EXPECT_FALSE(coalescer.GetStats("sensor").has_value());
+
+  EXPECT_TRUE(coalescer.SetCapacity("sensor", 1).empty());
+  auto other = MakeMessage("other", 1);
+  EXPECT_EQ(coalescer.Enqueue(other, &evicted),
+            PlatformMessageCoalescer::EnqueueResult::kNotCoalesced);
+  EXPECT_TRUE(other);
+}
+
+TEST(PlatformMessageCoalescerTest, LatestValueWins) {
+  PlatformMessageCoalescer coalescer;
+  EXPECT_TRUE(coalescer.SetCapacity("sensor", 1).empty());
+  EXPECT_TRUE(coalescer.HasCoalescedChannels());
+
+  std::unique_ptr<PlatformMessage> evicted;
+  auto first = MakeMessage("sensor", 1);
+  EXPECT_EQ(coalescer.Enqueue(first, &evicted),
+            PlatformMessageCoalescer::EnqueueResult::kScheduleDrain);
+  EXPECT_FALSE(evicted);
+
+  for (uint8_t i = 2; i <= 4; i++) {
+    auto message = MakeMessage("sensor", i);
+    EXPECT_EQ(coalescer.Enqueue(message, &evicted),
+              PlatformMessageCoalescer::EnqueueResult::kCoalesced);
+    ASSERT_TRUE(evicted);
+    EXPECT_EQ(ValueOf(evicted), i - 1);
+    evicted.reset();
+  }
+
+  auto drained = coalescer.Drain("sensor");
+  ASSERT_EQ(drained.size(), 1u);
+  EXPECT_EQ(ValueOf(drained[0]), 4);
+
+  auto stats = coalescer.GetStats("sensor");
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->capacity, 1u);
+  EXPECT_EQ(stats->pending, 0u);
+  EXPECT_EQ(stats->delivered, 1u);
+  EXPECT_EQ(stats->dropped, 3u);
+
+  // Once drained, the next message schedules a new drain.
+  auto next = MakeMessage("sensor", 5);
+  EXPECT_EQ(coalescer.Enqueue(next, &evicted),
+            PlatformMessageCoalescer::EnqueueResult::kScheduleDrain);
+}
+
+TEST(PlatformMessageCoalescerTest, RingKeepsMostRecentInOrder) {
+  PlatformMessageCoalescer coalescer;
+  EXPECT_TRUE(coalescer.SetCapacity("sensor", 3).empty());
+
+  std::unique_ptr<PlatformMessage> evicted;
+  for (uint8_t i = 1; i <= 5; i++) {
+    auto message = MakeMessage("sensor", i);
+    coalescer.Enqueue(message, &evicted);
+  }
+
+  auto drained = coalescer.Drain("sensor");
+  ASSERT_EQ(drained.size(), 3u);
+  EXPECT_EQ(ValueOf(drained[0]), 3);
+  EXPECT_EQ(ValueOf(drained[1]), 4);
+  EXPECT_EQ(ValueOf(drained[2]), 5);
+  EXPECT_EQ(coalescer.GetStats("sensor")->dropped, 2u);
+}
+
+TEST(PlatformMessageCoalescerTest, ShrinkingEvictsOldest) {
+  PlatformMessageCoalescer coalescer;
+  EXPECT_TRUE(coalescer.SetCapacity("sensor", 4).empty());
+
+  std::unique_ptr<PlatformMessage> evicted;
+  for (uint8_t i = 1; i <= 4; i++) {
+    auto message = MakeMessage("sensor", i);
+    coalescer.Enqueue(message, &evicted);
+  }
+
+  auto shrunk = coalescer.SetCapacity("sensor", 2);
+  ASSERT_EQ(shrunk.size(), 2u);
+  EXPECT_EQ(ValueOf(shrunk[0]), 1);
+  EXPECT_EQ(ValueOf(shrunk[1]), 2);
+
+  auto drained = coalescer.Drain("sensor");
+  ASSERT_EQ(drained.size(), 2u);
+  EXPECT_EQ(ValueOf(drained[0]), 3);
+  EXPECT_EQ(ValueOf(drained[1]), 4);
+}
+
+TEST(PlatformMessageCoalescerTest, DisablingKeepsBacklogForOutstandingDrain) {
+  PlatformMessageCoalescer coalescer;
+  EXPECT_TRUE(coalescer.SetCapacity("sensor", 2).empty());
+
+  std::unique_ptr<PlatformMessage> evicted;
+  for (uint8_t i = 1; i <= 2; i++) {
+    auto message = MakeMessage("sensor", i);
+    coalescer.Enqueue(message, &evicted);
+  }
+
+  EXPECT_TRUE(coalescer.SetCapacity("sensor", 0).empty());
+  EXPECT_FALSE(coalescer.HasCoalescedChannels());
+
+  auto direct = MakeMessage("sensor", 3);
+  EXPECT_EQ(coalescer.Enqueue(direct, &evicted),
+            PlatformMessageCoalescer::EnqueueResult::kNotCoalesced);
+
+  auto drained = coalescer.Drain("sensor");
+  ASSERT_EQ(drained.size(), 2u);
+  EXPECT_EQ(ValueOf(drained[0]), 1);
+  EXPECT_EQ(ValueOf(drained[1]), 2);
+  EXPECT_EQ(coalescer.GetStats("sensor")->capacity, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
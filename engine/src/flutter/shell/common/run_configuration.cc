@@ -7,7 +7,10 @@
 #include <sstream>
 #include <utility>
 
+#include "flutter/assets/compressed_asset_bundle.h"
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/file_mapping_cache.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/isolate_configuration.h"
@@ -20,15 +23,28 @@ RunConfiguration RunConfiguration::InferFromSettings(
     IsolateLaunchType launch_type) {
   auto asset_manager = std::make_shared<AssetManager>();
 
+  // Assets packed by the asset_packer tool are found before the files of
+  // the directory, which remain for the assets that are not packed. Packed
+  // assets may be compressed.
+  auto push_directory = [&asset_manager](fml::UniqueFD directory) {
+    if (directory.is_valid() &&
+        fml::FileExists(directory, PackedAssetBundle::kFileName)) {
+      asset_manager->PushBack(std::make_unique<CompressedAssetBundle>(
+          std::make_unique<PackedAssetBundle>(
+              FileMappingCache::GetInstance().GetMapping(
+                  directory, PackedAssetBundle::kFileName),
+              true)));
+    }
+    asset_manager->PushBack(
+        std::make_unique<DirectoryAssetBundle>(std::move(directory), true));
+  };
+
   if (fml::UniqueFD::traits_type::IsValid(settings.assets_dir)) {
-    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-        fml::Duplicate(settings.assets_dir), true));
+    push_directory(fml::Duplicate(settings.assets_dir));
   }
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+  push_directory(fml::OpenDirectory(settings.assets_path.c_str(), false,
+                                    fml::FilePermission::kRead));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker, launch_type),
@@ -12,16 +12,20 @@
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/file_mapping_cache.h"
+#include "flutter/common/engine_metrics.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/window/channel_registry.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/switches.h"
@@ -282,6 +286,10 @@ Shell::Shell(DartVMRef vm,
       {task_runners_.GetUITaskRunner(),
        std::bind(&Shell::OnServiceProtocolGetPipelineUsage, this,
                  std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetEngineMetricsExtensionName] =
+      {task_runners_.GetUITaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetEngineMetrics, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -556,6 +564,11 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   }
 #endif  // FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
 
+  if (message_coalescer_->HasCoalescedChannels() &&
+      EnqueueCoalescedPlatformMessage(message)) {
+    return;
+  }
+
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   fml::TaskRunner::RunNowAndFlushMessages(
@@ -568,6 +581,57 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
           }));
 }
 
+bool Shell::EnqueueCoalescedPlatformMessage(
+    std::unique_ptr<PlatformMessage>& message) {
+  std::string channel = message->channel();
+  std::unique_ptr<PlatformMessage> evicted;
+  auto result = message_coalescer_->Enqueue(message, &evicted);
+  if (evicted && evicted->response()) {
+    evicted->response()->CompleteEmpty();
+  }
+
+  switch (result) {
+    case PlatformMessageCoalescer::EnqueueResult::kNotCoalesced:
+      return false;
+    case PlatformMessageCoalescer::EnqueueResult::kCoalesced:
+      return true;
+    case PlatformMessageCoalescer::EnqueueResult::kScheduleDrain:
+      break;
+  }
+
+  fml::TaskRunner::RunNowAndFlushMessages(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, coalescer = message_coalescer_,
+       channel = std::move(channel)]() {
+        auto messages = coalescer->Drain(channel);
+        if (!engine) {
+          return;
+        }
+        for (auto& pending : messages) {
+          engine->DispatchPlatformMessage(std::move(pending));
+        }
+      });
+  return true;
+}
+
+void Shell::SetPlatformMessageCoalescing(const std::string& channel,
+                                         size_t capacity) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  auto evicted = message_coalescer_->SetCapacity(channel, capacity);
+  for (const auto& message : evicted) {
+    if (message->response()) {
+      message->response()->CompleteEmpty();
+    }
+  }
+}
+
+std::optional<PlatformMessageCoalescer::Stats>
+Shell::GetPlatformMessageCoalescingStats(const std::string& channel) const {
+  return message_coalescer_->GetStats(channel);
+}
+
 // |PlatformView::Delegate|
 const Settings& Shell::OnPlatformViewGetSettings() const {
   return settings_;
@@ -1097,6 +1161,100 @@ bool Shell::OnServiceProtocolGetPipelineUsage(
   return true;
 }
 
+namespace {
+
+rapidjson::Value LatencyToJson(const fml::Histogram::Snapshot& latency,
+                               rapidjson::MemoryPoolAllocator<>& allocator) {
+  rapidjson::Value json(rapidjson::kObjectType);
+  json.AddMember<uint64_t>("count", latency.count, allocator);
+  json.AddMember<int64_t>("min", latency.min, allocator);
+  json.AddMember<int64_t>("max", latency.max, allocator);
+  json.AddMember("mean", latency.Mean(), allocator);
+  json.AddMember<int64_t>("p50", latency.ValueAtPercentile(50), allocator);
+  json.AddMember<int64_t>("p90", latency.ValueAtPercentile(90), allocator);
+  json.AddMember<int64_t>("p99", latency.ValueAtPercentile(99), allocator);
+  return json;
+}
+
+}  // namespace
+
+bool Shell::OnServiceProtocolGetEngineMetrics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  const EngineMetrics& metrics = EngineMetrics::GetInstance();
+  auto& allocator = response->GetAllocator();
+
+  response->SetObject();
+  response->AddMember("type", "EngineMetrics", allocator);
+
+  rapidjson::Value channels(rapidjson::kArrayType);
+  for (const auto& counts : metrics.GetChannelCounts()) {
+    const std::string& name = ChannelRegistry::GetName(counts.channel_id);
+    rapidjson::Value channel(rapidjson::kObjectType);
+    channel.AddMember("name",
+                      rapidjson::Value(name.data(), name.size(), allocator),
+                      allocator);
+    channel.AddMember<uint64_t>("messagesToFramework",
+                                counts.messages_to_framework, allocator);
+    channel.AddMember<uint64_t>("bytesToFramework", counts.bytes_to_framework,
+                                allocator);
+    channel.AddMember<uint64_t>("messagesFromFramework",
+                                counts.messages_from_framework, allocator);
+    channel.AddMember<uint64_t>("bytesFromFramework",
+                                counts.bytes_from_framework, allocator);
+    channels.PushBack(channel, allocator);
+  }
+  response->AddMember("channels", channels, allocator);
+
+  response->AddMember(
+      "platformMessageRoundTripToFramework",
+      LatencyToJson(metrics.GetPlatformMessageRoundTrips(
+                        EngineMetrics::Direction::kToFramework),
+                    allocator),
+      allocator);
+  response->AddMember(
+      "platformMessageRoundTripFromFramework",
+      LatencyToJson(metrics.GetPlatformMessageRoundTrips(
+                        EngineMetrics::Direction::kFromFramework),
+                    allocator),
+      allocator);
+  response->AddMember("assetLoad",
+                      LatencyToJson(metrics.GetAssetLoads(), allocator),
+                      allocator);
+
+  const FileMappingCache::Stats mapping_stats =
+      FileMappingCache::GetInstance().GetStats();
+  rapidjson::Value mapping_cache(rapidjson::kObjectType);
+  mapping_cache.AddMember<uint64_t>("hits", mapping_stats.hits, allocator);
+  mapping_cache.AddMember<uint64_t>("misses", mapping_stats.misses, allocator);
+  mapping_cache.AddMember<uint64_t>("evictions", mapping_stats.evictions,
+                                    allocator);
+  mapping_cache.AddMember<uint64_t>("entries", mapping_stats.entry_count,
+                                    allocator);
+  mapping_cache.AddMember<uint64_t>("mappedBytes", mapping_stats.mapped_bytes,
+                                    allocator);
+  response->AddMember("assetMappingCache", mapping_cache, allocator);
+
+  auto* task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const fml::TaskQueueId platform_queue_id =
+      task_runners_.GetPlatformTaskRunner()->GetTaskQueueId();
+  const fml::TaskQueueId ui_queue_id =
+      task_runners_.GetUITaskRunner()->GetTaskQueueId();
+  rapidjson::Value task_queue_waits(rapidjson::kObjectType);
+  task_queue_waits.AddMember(
+      "platform",
+      LatencyToJson(task_queues->GetTaskWaitTimes(platform_queue_id),
+                    allocator),
+      allocator);
+  task_queue_waits.AddMember(
+      "ui",
+      LatencyToJson(task_queues->GetTaskWaitTimes(ui_queue_id), allocator),
+      allocator);
+  response->AddMember("taskQueueWait", task_queue_waits, allocator);
+  return true;
+}
+
 void Shell::SendFontChangeNotification() {
   // After system fonts are reloaded, we send a system channel message
   // to notify flutter framework.
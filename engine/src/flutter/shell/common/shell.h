@@ -22,6 +22,7 @@
 #include "flutter/runtime/platform_data.h"
 #include "flutter/runtime/service_protocol.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/platform_message_coalescer.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/geometry/geometry.h"
 
@@ -258,6 +259,32 @@ class Shell final : public Engine::Delegate,
   ///
   bool EngineHasPendingMicrotasks() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Configures native coalescing of platform messages sent to the
+  ///             framework on the given channel. While a delivery for the
+  ///             channel is waiting on the UI task runner, at most `capacity`
+  ///             of the most recent messages are retained. Older messages are
+  ///             dropped before they reach Dart and their responses completed
+  ///             empty.
+  ///
+  /// @param[in]  channel   The name of the channel.
+  /// @param[in]  capacity  The number of messages to retain. A capacity of one
+  ///                       gives "latest value wins" semantics. Zero disables
+  ///                       coalescing for the channel (the default).
+  ///
+  void SetPlatformMessageCoalescing(const std::string& channel,
+                                    size_t capacity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the coalescing counters for a channel. This call has no
+  ///             threading restrictions.
+  ///
+  /// @return     The counters, or std::nullopt if coalescing was never enabled
+  ///             for the channel.
+  ///
+  std::optional<PlatformMessageCoalescer::Stats>
+  GetPlatformMessageCoalescingStats(const std::string& channel) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get a pointer to the Dart VM used by this running shell
   ///             instance.
@@ -327,6 +354,10 @@ class Shell final : public Engine::Delegate,
   std::unique_ptr<Engine> engine_;  // on UI task runner
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
+  // Shared with the drain tasks posted to the UI task runner, which may outlive
+  // the shell.
+  std::shared_ptr<PlatformMessageCoalescer> message_coalescer_ =
+      std::make_shared<PlatformMessageCoalescer>();
 
   fml::TaskRunnerAffineWeakPtr<Engine>
       weak_engine_;  // to be shared across threads
@@ -376,6 +407,12 @@ class Shell final : public Engine::Delegate,
   void OnPlatformViewDispatchPlatformMessage(
       std::unique_ptr<PlatformMessage> message) override;
 
+  // Hands the message to |message_coalescer_| and schedules a drain on the UI
+  // task runner if necessary. Returns false, leaving the message untouched, if
+  // the channel of the message is not coalesced.
+  bool EnqueueCoalescedPlatformMessage(
+      std::unique_ptr<PlatformMessage>& message);
+
   // |PlatformView::Delegate|
   const Settings& OnPlatformViewGetSettings() const override;
 
@@ -491,6 +528,14 @@ class Shell final : public Engine::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Returns the process-wide |EngineMetrics| and the time tasks waited in
+  // the queues of this shell's task runners. Latencies are in microseconds.
+  bool OnServiceProtocolGetEngineMetrics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
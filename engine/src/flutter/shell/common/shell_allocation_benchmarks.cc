@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// These benchmarks replace the global operator new to count allocations, so
+// they are built into their own executable to leave the allocator of the
+// other shell benchmarks untouched.
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+#include "flutter/shell/common/benchmark_shell.h"
+
+namespace {
+
+// Set while a |ScopedAllocationCounter| is in scope.
+std::atomic<bool> gCountAllocations = false;
+std::atomic<size_t> gAllocationCount = 0;
+
+}  // namespace
+
+// Forwards to malloc, and only counts allocations while a
+// |ScopedAllocationCounter| is in scope.
+void* operator new(size_t size) {
+  if (gCountAllocations.load(std::memory_order_relaxed)) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* pointer = malloc(size > 0 ? size : 1);
+  FML_CHECK(pointer);
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+  free(pointer);
+}
+
+namespace flutter {
+
+namespace {
+
+// Counts the calls to the global operator new on every thread while in
+// scope.
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter() {
+    FML_CHECK(!gCountAllocations.exchange(true));
+    gAllocationCount = 0;
+  }
+
+  ~ScopedAllocationCounter() { gCountAllocations = false; }
+
+  size_t GetCount() const {
+    return gAllocationCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedAllocationCounter);
+};
+
+}  // namespace
+
+// Sends a message from the platform thread to a Dart listener that echoes it
+// back, and waits for the reply, as a plugin call does. Reports the number of
+// C++ heap allocations made per message, including the task the benchmark
+// posts to the platform thread to send each message. Allocations made by the
+// Dart VM and malloc'd payloads are not counted.
+static void BM_ShellPlatformMessageRoundTrip(benchmark::State& state) {
+  BenchmarkShell shell("platformMessageEchoBenchmark");
+  const std::string payload(state.range(0), 'x');
+  size_t allocations = 0;
+  {
+    ScopedAllocationCounter counter;
+    for (auto _ : state) {
+      shell.SendMessage("bench/echo", payload);
+    }
+    allocations = counter.GetCount();
+  }
+  state.counters["allocations_per_message"] = benchmark::Counter(
+      allocations, benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ShellPlatformMessageRoundTrip)
+    ->ArgName("size")
+    ->Arg(16)
+    ->Arg(1024)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -4,47 +4,39 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/benchmark_shell.h"
+#include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
+#if FML_OS_LINUX || FML_OS_ANDROID
+#include <unistd.h>
+#endif
+
 namespace flutter {
 
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
-  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
-                                       fml::FilePermission::kRead);
   std::unique_ptr<Shell> shell;
   std::unique_ptr<ThreadHost> thread_host;
   testing::ELFAOTSymbols aot_symbols;
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {
-      return fml::TaskQueueId::Invalid();
-    };
-    settings.task_observer_remove = [](fml::TaskQueueId, intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
+    Settings settings = CreateFixtureSettings(aot_symbols);
 
     thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
         "io.flutter.bench.",
@@ -118,4 +110,168 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures the time to launch the root isolate of a JIT app whose kernel is
+// split into several pieces named by a kernel list asset.
+static void BM_ShellRunFromKernelList(benchmark::State& state) {
+  if (DartVM::IsRunningPrecompiledCode()) {
+    state.SkipWithError("Kernel lists are only used in JIT mode.");
+    return;
+  }
+
+  auto kernel = fml::FileMapping::CreateReadOnly(
+      fml::OpenDirectory(testing::GetFixturesPath(), false,
+                         fml::FilePermission::kRead),
+      "kernel_blob.bin");
+  FML_CHECK(kernel);
+
+  // Each piece is a separate file so that fetching them is not served from a
+  // single mapping. The VM skips libraries that are already loaded, so the
+  // pieces after the first mostly measure fetching and validation.
+  fml::ScopedTemporaryDirectory assets_dir;
+  std::string kernel_list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    const std::string piece = "piece_" + std::to_string(i) + ".dill";
+    FML_CHECK(fml::WriteAtomically(assets_dir.fd(), piece.c_str(), *kernel));
+    kernel_list += piece + "\n";
+  }
+  FML_CHECK(fml::WriteAtomically(assets_dir.fd(), "kernel_list",
+                                 fml::DataMapping(kernel_list)));
+
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {
+    return fml::TaskQueueId::Invalid();
+  };
+  settings.task_observer_remove = [](fml::TaskQueueId, intptr_t) {};
+  settings.assets_path = assets_dir.path();
+  settings.application_kernel_list_asset = "kernel_list";
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<ThreadHost> thread_host;
+    std::unique_ptr<Shell> shell;
+    {
+      benchmarking::ScopedPauseTiming pause(state, true);
+      thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+          "io.flutter.bench.",
+          ThreadHost::Type::kPlatform | ThreadHost::Type::kUi));
+      TaskRunners task_runners("test",
+                               thread_host->platform_thread->GetTaskRunner(),
+                               thread_host->ui_thread->GetTaskRunner());
+      shell = Shell::Create(
+          flutter::PlatformData(), task_runners, settings, [](Shell& shell) {
+            return std::make_unique<PlatformView>(shell,
+                                                  shell.GetTaskRunners());
+          });
+      FML_CHECK(shell);
+    }
+
+    fml::AutoResetWaitableEvent latch;
+    Engine::RunStatus status = Engine::RunStatus::Failure;
+    auto configuration = RunConfiguration::InferFromSettings(settings);
+    fml::TaskRunner::RunNowOrPostTask(
+        thread_host->platform_thread->GetTaskRunner(),
+        fml::MakeCopyable(
+            [&, configuration = std::move(configuration)]() mutable {
+              shell->RunEngine(std::move(configuration),
+                               [&](Engine::RunStatus result) {
+                                 status = result;
+                                 latch.Signal();
+                               });
+            }));
+    latch.Wait();
+    FML_CHECK(status == Engine::RunStatus::Success);
+
+    {
+      benchmarking::ScopedPauseTiming pause(state, true);
+      fml::TaskRunner::RunNowOrPostTask(
+          thread_host->platform_thread->GetTaskRunner(), [&]() {
+            shell.reset();
+            latch.Signal();
+          });
+      latch.Wait();
+      thread_host.reset();
+    }
+  }
+}
+
+BENCHMARK(BM_ShellRunFromKernelList)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+
+// The resident set size of the process, or 0 where it is not known.
+static size_t GetResidentBytes() {
+#if FML_OS_LINUX || FML_OS_ANDROID
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return resident_pages * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+// Starts the first argument's number of engines, whose root isolates each
+// read the persistent isolate data the second argument's number of times and
+// keep the results alive, as apps passing large configurations to every
+// engine do. Reports the growth of the resident set size per engine, which
+// includes the engine's own overhead as well as any copies of the data.
+static void BM_ShellPersistentIsolateDataMemory(benchmark::State& state) {
+  const int engine_count = state.range(0);
+  const int reads_per_isolate = state.range(1);
+  static constexpr size_t kDataSize = 16 << 20;
+  auto data = std::make_shared<fml::DataMapping>(
+      std::vector<uint8_t>(kDataSize, 'x'));
+
+  double resident_bytes = 0;
+  for (auto _ : state) {
+    const size_t resident_before = GetResidentBytes();
+    std::vector<std::unique_ptr<BenchmarkShell>> shells;
+    for (int i = 0; i < engine_count; i++) {
+      shells.push_back(std::make_unique<BenchmarkShell>(
+          "persistentIsolateDataBenchmark",
+          std::vector<std::string>{std::to_string(reads_per_isolate)}, data));
+      // Waits for the entrypoint to have read the data.
+      shells.back()->SendMessage("bench/ready", "");
+    }
+    resident_bytes += static_cast<double>(GetResidentBytes()) -
+                      static_cast<double>(resident_before);
+  }
+  state.counters["resident_bytes_per_engine"] = benchmark::Counter(
+      resident_bytes / engine_count,
+      benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_ShellPersistentIsolateDataMemory)
+    ->ArgNames({"engines", "reads"})
+    ->ArgsProduct({{1, 4, 8}, {1, 8}})
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+// The number of messages Dart sends for each request from the benchmark.
+static constexpr int kMessagesPerIteration = 16;
+
+// Sends messages from Dart to the platform, as plugins pushing large payloads
+// do. The first argument is the size of each message, and the second whether
+// the payload is created with PlatformDispatcher.createPlatformMessageData,
+// which the engine shares rather than copies.
+static void BM_ShellPlatformMessageSendThroughput(benchmark::State& state) {
+  const size_t size = state.range(0);
+  const bool shared = state.range(1) != 0;
+  BenchmarkShell shell("platformMessageSendBenchmark",
+                       {std::to_string(size), shared ? "shared" : "copied",
+                        std::to_string(kMessagesPerIteration)});
+  for (auto _ : state) {
+    shell.SendMessage("bench/send", "");
+  }
+  state.SetItemsProcessed(state.iterations() * kMessagesPerIteration);
+  state.SetBytesProcessed(state.iterations() * kMessagesPerIteration * size);
+}
+
+BENCHMARK(BM_ShellPlatformMessageSendThroughput)
+    ->ArgNames({"size", "shared"})
+    ->ArgsProduct({{4 << 10, 256 << 10, 4 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
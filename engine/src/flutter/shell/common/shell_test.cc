@@ -105,6 +105,9 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetEngineMetrics:
+            shell->OnServiceProtocolGetEngineMetrics(params, response);
+            break;
         }
         finished.set_value(true);
       });
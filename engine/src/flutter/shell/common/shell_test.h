@@ -64,6 +64,7 @@ class ShellTest : public FixtureTest {
     kEstimateRasterCacheMemory,
     kSetAssetBundlePath,
     kRunInView,
+    kGetEngineMetrics,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
@@ -8,6 +8,7 @@
 #include <ctime>
 #include <future>
 #include <memory>
+#include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -18,11 +19,13 @@
 
 #include "assets/asset_resolver.h"
 #include "assets/directory_asset_bundle.h"
+#include "flutter/common/engine_metrics.h"
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/window/channel_registry.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell_test.h"
@@ -616,6 +619,38 @@ TEST_F(ShellTest, OnServiceProtocolSetAssetBundlePathWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetEngineMetricsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  const ChannelId channel_id = ChannelRegistry::Intern("test/engine_metrics");
+  EngineMetrics::GetInstance().RecordChannelMessage(
+      channel_id, EngineMetrics::Direction::kFromFramework, 5);
+
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetEngineMetrics,
+                    shell->GetTaskRunners().GetUITaskRunner(), {}, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  const rapidjson::Value* channel = nullptr;
+  for (const auto& value : document["channels"].GetArray()) {
+    if (std::string_view(value["name"].GetString()) == "test/engine_metrics") {
+      channel = &value;
+    }
+  }
+  ASSERT_NE(channel, nullptr);
+  EXPECT_EQ((*channel)["messagesFromFramework"].GetUint64(), 1u);
+  EXPECT_EQ((*channel)["bytesFromFramework"].GetUint64(), 5u);
+  EXPECT_EQ((*channel)["messagesToFramework"].GetUint64(), 0u);
+  EXPECT_TRUE(document["assetLoad"].HasMember("p99"));
+  EXPECT_TRUE(document["assetMappingCache"].HasMember("hits"));
+  EXPECT_TRUE(document["assetMappingCache"].HasMember("mappedBytes"));
+  EXPECT_TRUE(document["taskQueueWait"]["platform"].HasMember("count"));
+  EXPECT_GT(document["taskQueueWait"]["ui"]["count"].GetUint64(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, EngineRootIsolateLaunchesDontTakeVMDataSettings) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   // Make sure the shell launch does not kick off the creation of the VM
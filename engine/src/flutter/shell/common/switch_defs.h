@@ -203,6 +203,12 @@ DEF_SWITCH(EnableSerialGC,
            "GC tasks on threads can cause them to contend with the UI thread "
            "which could potentially lead to jank. This option turns off all "
            "concurrent GC activities")
+DEF_SWITCH(EnableCpuAffinity,
+           "enable-cpu-affinity",
+           "Requests that the UI thread runs on the performance cores of the "
+           "device and that the concurrent worker threads run on the other "
+           "cores. This has no effect on devices where all cores have the "
+           "same speed and share a NUMA node.")
 DEF_SWITCH(DisallowInsecureConnections,
            "disallow-insecure-connections",
            "By default, dart:io allows all socket connections. If this switch "
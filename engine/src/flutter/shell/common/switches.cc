@@ -305,6 +305,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
   settings.enable_serial_gc =
       command_line.HasOption(FlagForSwitch(Switch::EnableSerialGC));
 
+  settings.enable_cpu_affinity =
+      command_line.HasOption(FlagForSwitch(Switch::EnableCpuAffinity));
+
   std::string trace_allowlist;
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceAllowlist),
                               &trace_allowlist);
@@ -533,15 +533,16 @@ void PlatformViewAndroidJNIImpl::FlutterViewHandlePlatformMessage(
       fml::jni::StringToJavaString(env, message->channel());
 
   if (message->hasData()) {
-    fml::jni::ScopedJavaLocalRef<jobject> message_array(
-        env, env->NewDirectByteBuffer(
-                 const_cast<uint8_t*>(message->data().GetMapping()),
-                 message->data().GetSize()));
-    // Message data is deleted in CleanupMessageData.
+    // Message data is deleted in CleanupMessageData. Release it before
+    // wrapping it, since releasing data shared with Dart makes a copy.
     fml::MallocMapping mapping = message->releaseData();
+    const size_t size = mapping.GetSize();
+    uint8_t* data = mapping.Release();
+    fml::jni::ScopedJavaLocalRef<jobject> message_array(
+        env, env->NewDirectByteBuffer(data, size));
     env->CallVoidMethod(java_object.obj(), g_handle_platform_message_method,
                         java_channel.obj(), message_array.obj(), responseId,
-                        reinterpret_cast<jlong>(mapping.Release()));
+                        reinterpret_cast<jlong>(data));
   } else {
     env->CallVoidMethod(java_object.obj(), g_handle_platform_message_method,
                         java_channel.obj(), nullptr, responseId, nullptr);
@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_METHOD_CALL_ROUTER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_METHOD_CALL_ROUTER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "method_call.h"
+#include "method_channel.h"
+#include "method_result.h"
+
+namespace flutter {
+
+class EncodableValue;
+
+// Routes method calls to the handlers registered for their method names.
+//
+// A router is a MethodCallHandler, so it can be passed to
+// MethodChannel::SetMethodCallHandler in place of a handler that compares the
+// method name of each call with every name it handles:
+//
+//   MethodCallRouter<> router;
+//   router.AddHandler("getBatteryLevel", ...);
+//   router.AddHandler("setBrightness", ...);
+//   channel.SetMethodCallHandler(router);
+//
+// Method names are hashed when their handlers are added, and handlers are
+// kept in a hash table, so routing a call hashes its method name once and
+// compares it with only the names that have the same hash, however many
+// handlers there are.
+template <typename T = EncodableValue>
+class MethodCallRouter {
+ public:
+  MethodCallRouter() = default;
+
+  // Adds |handler| for calls of the method named |method|, replacing any
+  // handler added for it before.
+  void AddHandler(const std::string& method, MethodCallHandler<T> handler) {
+    const uint64_t hash = Hash(method);
+    if (const Entry* entry = Find(method, hash)) {
+      entries_[entry - entries_.data()].handler = std::move(handler);
+      return;
+    }
+    entries_.push_back({hash, method, std::move(handler)});
+    if (entries_.size() * 2 > slots_.size()) {
+      Rehash(slots_.empty() ? 16 : slots_.size() * 2);
+    } else {
+      Insert(entries_.size() - 1);
+    }
+  }
+
+  // Sets the handler for calls of methods that have no handler. By default,
+  // such calls are answered with NotImplemented.
+  void SetFallbackHandler(MethodCallHandler<T> handler) {
+    fallback_handler_ = std::move(handler);
+  }
+
+  // Passes |call| and |result| to the handler for the method called.
+  void operator()(const MethodCall<T>& call,
+                  std::unique_ptr<MethodResult<T>> result) const {
+    const std::string& method = call.method_name();
+    if (const Entry* entry = Find(method, Hash(method))) {
+      entry->handler(call, std::move(result));
+    } else if (fallback_handler_) {
+      fallback_handler_(call, std::move(result));
+    } else {
+      result->NotImplemented();
+    }
+  }
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    std::string method;
+    MethodCallHandler<T> handler;
+  };
+
+  // FNV-1a.
+  static uint64_t Hash(std::string_view method) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (char c : method) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    return hash;
+  }
+
+  // Returns the entry for |method|, whose hash is |hash|, or null.
+  const Entry* Find(std::string_view method, uint64_t hash) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = hash & mask; slots_[slot] != 0;
+         slot = (slot + 1) & mask) {
+      const Entry& entry = entries_[slots_[slot] - 1];
+      if (entry.hash == hash && entry.method == method) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  // Adds the entry at |index| to |slots_|, which has a free slot.
+  void Insert(size_t index) {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = entries_[index].hash & mask;
+    while (slots_[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = static_cast<uint32_t>(index + 1);
+  }
+
+  void Rehash(size_t slot_count) {
+    slots_.assign(slot_count, 0);
+    for (size_t i = 0; i < entries_.size(); i++) {
+      Insert(i);
+    }
+  }
+
+  std::vector<Entry> entries_;
+  // An open-addressed table of the indices of |entries_| plus one, or 0 for
+  // free slots. Its size is a power of two, at least twice that of
+  // |entries_|.
+  std::vector<uint32_t> slots_;
+  MethodCallHandler<T> fallback_handler_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_METHOD_CALL_ROUTER_H_
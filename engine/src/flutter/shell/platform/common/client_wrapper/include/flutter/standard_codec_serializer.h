@@ -64,11 +64,6 @@ class StandardCodecSerializer {
   // EncodableValue.
   template <typename T>
   EncodableValue ReadVector(ByteStreamReader* stream) const;
-
-  // Writes |vector| to |stream| as a fixed-type list. |T| must correspond to
-  // one of the supported list value types of EncodableValue.
-  template <typename T>
-  void WriteVector(const std::vector<T> vector, ByteStreamWriter* stream) const;
 };
 
 }  // namespace flutter
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/encodable_value.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/method_call_router.h"
+
+namespace flutter {
+
+namespace {
+
+// A result that ignores what it is given, so that routing is all that is
+// measured.
+class NullResult : public MethodResult<> {
+ protected:
+  void SuccessInternal(const EncodableValue* result) override {}
+  void ErrorInternal(const std::string& error_code,
+                     const std::string& error_message,
+                     const EncodableValue* error_details) override {}
+  void NotImplementedInternal() override {}
+};
+
+std::vector<std::string> GetMethodNames(int count) {
+  std::vector<std::string> names;
+  for (int i = 0; i < count; i++) {
+    names.push_back("TextInput.setEditingState" + std::to_string(i));
+  }
+  return names;
+}
+
+}  // namespace
+
+// Routes calls round robin to the first argument's number of methods with a
+// MethodCallRouter.
+static void BM_RouteMethodCall(benchmark::State& state) {
+  const std::vector<std::string> names = GetMethodNames(state.range(0));
+  int64_t handled = 0;
+  MethodCallRouter<> router;
+  for (const std::string& name : names) {
+    router.AddHandler(name, [&handled](const auto& call, auto result) {
+      handled++;
+    });
+  }
+  std::vector<std::unique_ptr<MethodCall<>>> calls;
+  for (const std::string& name : names) {
+    calls.push_back(std::make_unique<MethodCall<>>(name, nullptr));
+  }
+
+  size_t next = 0;
+  for (auto _ : state) {
+    router(*calls[next], std::make_unique<NullResult>());
+    next = next + 1 == calls.size() ? 0 : next + 1;
+  }
+  benchmark::DoNotOptimize(handled);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Routes the same calls with a handler that compares the method name with
+// each name it handles in turn, as handlers written without a router do.
+static void BM_RouteMethodCallByComparison(benchmark::State& state) {
+  const std::vector<std::string> names = GetMethodNames(state.range(0));
+  int64_t handled = 0;
+  auto handler = [&handled, &names](const MethodCall<>& call,
+                                    std::unique_ptr<MethodResult<>> result) {
+    for (const std::string& name : names) {
+      if (call.method_name() == name) {
+        handled++;
+        return;
+      }
+    }
+    result->NotImplemented();
+  };
+  std::vector<std::unique_ptr<MethodCall<>>> calls;
+  for (const std::string& name : names) {
+    calls.push_back(std::make_unique<MethodCall<>>(name, nullptr));
+  }
+
+  size_t next = 0;
+  for (auto _ : state) {
+    handler(*calls[next], std::make_unique<NullResult>());
+    next = next + 1 == calls.size() ? 0 : next + 1;
+  }
+  benchmark::DoNotOptimize(handled);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RouteMethodCall)->Arg(4)->Arg(32)->Arg(256);
+BENCHMARK(BM_RouteMethodCallByComparison)->Arg(4)->Arg(32)->Arg(256);
+
+}  // namespace flutter
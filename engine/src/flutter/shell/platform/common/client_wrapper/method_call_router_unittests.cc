@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/method_call_router.h"
+
+#include <memory>
+#include <string>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/encodable_value.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/method_result_functions.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+// Routes a call of |method| through |router| and returns whether it was
+// answered with NotImplemented.
+bool RouteCall(const MethodCallRouter<>& router, const std::string& method) {
+  bool not_implemented = false;
+  router(MethodCall<>(method, nullptr),
+         std::make_unique<MethodResultFunctions<>>(
+             nullptr, nullptr,
+             [&not_implemented]() { not_implemented = true; }));
+  return !not_implemented;
+}
+
+}  // namespace
+
+TEST(MethodCallRouterTest, RoutesCallsByMethodName) {
+  MethodCallRouter<> router;
+  std::string last_method;
+  for (int i = 0; i < 200; i++) {
+    router.AddHandler("method" + std::to_string(i),
+                      [&last_method](const auto& call, auto result) {
+                        last_method = call.method_name();
+                        result->Success();
+                      });
+  }
+  for (int i = 0; i < 200; i++) {
+    const std::string method = "method" + std::to_string(i);
+    EXPECT_TRUE(RouteCall(router, method));
+    EXPECT_EQ(last_method, method);
+  }
+  EXPECT_FALSE(RouteCall(router, "method200"));
+  EXPECT_FALSE(RouteCall(router, ""));
+}
+
+TEST(MethodCallRouterTest, ReplacesHandlers) {
+  MethodCallRouter<> router;
+  int calls[2] = {0, 0};
+  router.AddHandler("hello", [&calls](const auto& call, auto result) {
+    calls[0]++;
+    result->Success();
+  });
+  router.AddHandler("hello", [&calls](const auto& call, auto result) {
+    calls[1]++;
+    result->Success();
+  });
+  EXPECT_TRUE(RouteCall(router, "hello"));
+  EXPECT_EQ(calls[0], 0);
+  EXPECT_EQ(calls[1], 1);
+}
+
+TEST(MethodCallRouterTest, RoutesUnknownMethodsToFallbackHandler) {
+  MethodCallRouter<> router;
+  EXPECT_FALSE(RouteCall(router, "hello"));
+
+  std::string fallback_method;
+  router.SetFallbackHandler([&fallback_method](const auto& call, auto result) {
+    fallback_method = call.method_name();
+    result->Success();
+  });
+  EXPECT_TRUE(RouteCall(router, "hello"));
+  EXPECT_EQ(fallback_method, "hello");
+}
+
+}  // namespace flutter
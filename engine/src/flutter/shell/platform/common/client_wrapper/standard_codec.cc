@@ -18,6 +18,7 @@
 #include "include/flutter/standard_codec_serializer.h"
 #include "include/flutter/standard_message_codec.h"
 #include "include/flutter/standard_method_codec.h"
+#include "standard_codec_core.h"
 
 namespace flutter {
 
@@ -25,24 +26,8 @@ namespace flutter {
 
 namespace {
 
-// The order/values here must match the constants in message_codecs.dart.
-enum class EncodedType {
-  kNull = 0,
-  kTrue,
-  kFalse,
-  kInt32,
-  kInt64,
-  kLargeInt,  // No longer used. If encountered, treat as kString.
-  kFloat64,
-  kString,
-  kUInt8List,
-  kInt32List,
-  kInt64List,
-  kFloat64List,
-  kList,
-  kMap,
-  kFloat32List,
-};
+// The type discrimination bytes are shared with the codec core.
+using EncodedType = StandardCodecType;
 
 // Returns the encoded type that should be written when serializing |value|.
 EncodedType EncodedTypeForValue(const EncodableValue& value) {
@@ -78,26 +63,64 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
-}  // namespace
+// Adapts a ByteStreamWriter to the writer interface used by
+// WriteStandardValue. It is also the buffer of the StandardCodecWriter that
+// encodes its sizes and scalars; alignment is left to the stream, which knows
+// its own write position.
+class StandardCodecStreamWriter {
+ public:
+  // |stream| must remain valid for the lifetime of this object.
+  explicit StandardCodecStreamWriter(ByteStreamWriter* stream)
+      : stream_(stream) {}
 
-StandardCodecSerializer::StandardCodecSerializer() = default;
+  void AppendByte(uint8_t byte) { stream_->WriteByte(byte); }
 
-StandardCodecSerializer::~StandardCodecSerializer() = default;
+  void Append(const uint8_t* bytes, size_t length) {
+    stream_->WriteBytes(bytes, length);
+  }
 
-const StandardCodecSerializer& StandardCodecSerializer::GetInstance() {
-  static StandardCodecSerializer sInstance;
-  return sInstance;
-};
+  void WriteType(EncodedType type) { AppendByte(static_cast<uint8_t>(type)); }
 
-EncodableValue StandardCodecSerializer::ReadValue(
-    ByteStreamReader* stream) const {
-  uint8_t type = stream->ReadByte();
-  return ReadValueOfType(type, stream);
-}
+  template <typename T>
+  void WriteScalar(T value) {
+    StandardCodecWriter<StandardCodecStreamWriter>(this).WriteScalar(value);
+  }
 
-void StandardCodecSerializer::WriteValue(const EncodableValue& value,
-                                         ByteStreamWriter* stream) const {
-  stream->WriteByte(static_cast<uint8_t>(EncodedTypeForValue(value)));
+  void WriteSize(uint32_t size) {
+    StandardCodecWriter<StandardCodecStreamWriter>(this).WriteSize(size);
+  }
+
+  void WriteAlignment(size_t alignment) {
+    stream_->WriteAlignment(static_cast<uint8_t>(alignment));
+  }
+
+  void WriteBytes(const void* bytes, size_t length) {
+    StandardCodecWriter<StandardCodecStreamWriter>(this).WriteBytes(bytes,
+                                                                    length);
+  }
+
+  template <typename T>
+  void WriteList(const T* elements, size_t count) {
+    WriteSize(static_cast<uint32_t>(count));
+    if (alignof(T) > 1) {
+      WriteAlignment(alignof(T));
+    }
+    WriteBytes(elements, count * sizeof(T));
+  }
+
+ private:
+  ByteStreamWriter* stream_;
+};
+
+// Writes the encoding of |value| to |writer|, which is either a
+// StandardCodecWriter or a StandardCodecStreamWriter. The items of lists and
+// maps are written with |write_item|, so that the serializer can pass them to
+// an overridden WriteValue.
+template <typename Writer, typename WriteItem>
+void WriteStandardValue(const EncodableValue& value,
+                        Writer* writer,
+                        const WriteItem& write_item) {
+  writer->WriteType(EncodedTypeForValue(value));
   // TODO(cbracken): Consider replacing this with std::visit.
   switch (value.index()) {
     case 0:
@@ -105,51 +128,55 @@ void StandardCodecSerializer::WriteValue(const EncodableValue& value,
       // Null and bool are encoded directly in the type.
       break;
     case 2:
-      stream->WriteInt32(std::get<int32_t>(value));
+      writer->WriteScalar(std::get<int32_t>(value));
       break;
     case 3:
-      stream->WriteInt64(std::get<int64_t>(value));
+      writer->WriteScalar(std::get<int64_t>(value));
       break;
     case 4:
-      stream->WriteAlignment(8);
-      stream->WriteDouble(std::get<double>(value));
+      writer->WriteAlignment(8);
+      writer->WriteScalar(std::get<double>(value));
       break;
     case 5: {
       const auto& string_value = std::get<std::string>(value);
-      size_t size = string_value.size();
-      WriteSize(size, stream);
-      if (size > 0) {
-        stream->WriteBytes(
-            reinterpret_cast<const uint8_t*>(string_value.data()), size);
-      }
+      writer->WriteSize(static_cast<uint32_t>(string_value.size()));
+      writer->WriteBytes(string_value.data(), string_value.size());
       break;
     }
-    case 6:
-      WriteVector(std::get<std::vector<uint8_t>>(value), stream);
+    case 6: {
+      const auto& list = std::get<std::vector<uint8_t>>(value);
+      writer->WriteList(list.data(), list.size());
       break;
-    case 7:
-      WriteVector(std::get<std::vector<int32_t>>(value), stream);
+    }
+    case 7: {
+      const auto& list = std::get<std::vector<int32_t>>(value);
+      writer->WriteList(list.data(), list.size());
       break;
-    case 8:
-      WriteVector(std::get<std::vector<int64_t>>(value), stream);
+    }
+    case 8: {
+      const auto& list = std::get<std::vector<int64_t>>(value);
+      writer->WriteList(list.data(), list.size());
       break;
-    case 9:
-      WriteVector(std::get<std::vector<double>>(value), stream);
+    }
+    case 9: {
+      const auto& list = std::get<std::vector<double>>(value);
+      writer->WriteList(list.data(), list.size());
       break;
+    }
     case 10: {
       const auto& list = std::get<EncodableList>(value);
-      WriteSize(list.size(), stream);
+      writer->WriteSize(static_cast<uint32_t>(list.size()));
       for (const auto& item : list) {
-        WriteValue(item, stream);
+        write_item(item);
       }
       break;
     }
     case 11: {
       const auto& map = std::get<EncodableMap>(value);
-      WriteSize(map.size(), stream);
+      writer->WriteSize(static_cast<uint32_t>(map.size()));
       for (const auto& pair : map) {
-        WriteValue(pair.first, stream);
-        WriteValue(pair.second, stream);
+        write_item(pair.first);
+        write_item(pair.second);
       }
       break;
     }
@@ -159,12 +186,39 @@ void StandardCodecSerializer::WriteValue(const EncodableValue& value,
           << "Custom types require codec extensions." << std::endl;
       break;
     case 13: {
-      WriteVector(std::get<std::vector<float>>(value), stream);
+      const auto& list = std::get<std::vector<float>>(value);
+      writer->WriteList(list.data(), list.size());
       break;
     }
   }
 }
 
+}  // namespace
+
+StandardCodecSerializer::StandardCodecSerializer() = default;
+
+StandardCodecSerializer::~StandardCodecSerializer() = default;
+
+const StandardCodecSerializer& StandardCodecSerializer::GetInstance() {
+  static StandardCodecSerializer sInstance;
+  return sInstance;
+};
+
+EncodableValue StandardCodecSerializer::ReadValue(
+    ByteStreamReader* stream) const {
+  uint8_t type = stream->ReadByte();
+  return ReadValueOfType(type, stream);
+}
+
+void StandardCodecSerializer::WriteValue(const EncodableValue& value,
+                                         ByteStreamWriter* stream) const {
+  StandardCodecStreamWriter writer(stream);
+  WriteStandardValue(value, &writer,
+                     [this, stream](const EncodableValue& item) {
+                       WriteValue(item, stream);
+                     });
+}
+
 EncodableValue StandardCodecSerializer::ReadValueOfType(
     uint8_t type,
     ByteStreamReader* stream) const {
@@ -243,17 +297,7 @@ size_t StandardCodecSerializer::ReadSize(ByteStreamReader* stream) const {
 
 void StandardCodecSerializer::WriteSize(size_t size,
                                         ByteStreamWriter* stream) const {
-  if (size < 254) {
-    stream->WriteByte(static_cast<uint8_t>(size));
-  } else if (size <= 0xffff) {
-    stream->WriteByte(254);
-    uint16_t value = static_cast<uint16_t>(size);
-    stream->WriteBytes(reinterpret_cast<uint8_t*>(&value), 2);
-  } else {
-    stream->WriteByte(255);
-    uint32_t value = static_cast<uint32_t>(size);
-    stream->WriteBytes(reinterpret_cast<uint8_t*>(&value), 4);
-  }
+  StandardCodecStreamWriter(stream).WriteSize(static_cast<uint32_t>(size));
 }
 
 template <typename T>
@@ -271,22 +315,138 @@ EncodableValue StandardCodecSerializer::ReadVector(
   return EncodableValue(vector);
 }
 
+// ===== Codec core fast path =====
+
+namespace {
+
+using StandardCodecVectorWriter =
+    StandardCodecWriter<StandardCodecVectorBuffer>;
+
+// Returns true if |serializer| is the shared instance without extensions.
+//
+// Values of such a serializer are encoded and decoded directly with the codec
+// core, rather than byte by byte through the virtual stream interfaces that
+// extensions override.
+bool IsStandardSerializer(const StandardCodecSerializer* serializer) {
+  return serializer == &StandardCodecSerializer::GetInstance();
+}
+
+// Writes the encoding of |value| to |writer| with the codec core.
+void EncodeStandardValue(const EncodableValue& value,
+                         StandardCodecVectorWriter* writer) {
+  WriteStandardValue(value, writer, [writer](const EncodableValue& item) {
+    EncodeStandardValue(item, writer);
+  });
+}
+
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
-                                          ByteStreamWriter* stream) const {
-  size_t count = vector.size();
-  WriteSize(count, stream);
-  if (count == 0) {
-    return;
+EncodableValue DecodeStandardList(StandardCodecReader* reader) {
+  uint32_t count = 0;
+  const uint8_t* elements = nullptr;
+  reader->ReadList<T>(&count, &elements);
+  std::vector<T> list(count);
+  StandardCodecReader::CopyList(elements, count, list.data());
+  return EncodableValue(std::move(list));
+}
+
+// Reads the next value from |reader|, which must have been checked with
+// ValidateStandardCodecValue. Like StandardCodecSerializer::ReadValue, this
+// recurses once per level of nesting.
+EncodableValue DecodeStandardValue(StandardCodecReader* reader) {
+  uint8_t type = 0;
+  reader->ReadByte(&type);
+  switch (static_cast<EncodedType>(type)) {
+    case EncodedType::kNull:
+      return EncodableValue();
+    case EncodedType::kTrue:
+      return EncodableValue(true);
+    case EncodedType::kFalse:
+      return EncodableValue(false);
+    case EncodedType::kInt32: {
+      int32_t value = 0;
+      reader->ReadScalar(&value);
+      return EncodableValue(value);
+    }
+    case EncodedType::kInt64: {
+      int64_t value = 0;
+      reader->ReadScalar(&value);
+      return EncodableValue(value);
+    }
+    case EncodedType::kFloat64: {
+      double value = 0;
+      reader->ReadAlignment(8);
+      reader->ReadScalar(&value);
+      return EncodableValue(value);
+    }
+    case EncodedType::kLargeInt:
+    case EncodedType::kString: {
+      uint32_t size = 0;
+      const uint8_t* bytes = nullptr;
+      reader->ReadList<uint8_t>(&size, &bytes);
+      return EncodableValue(
+          std::string(reinterpret_cast<const char*>(bytes), size));
+    }
+    case EncodedType::kUInt8List:
+      return DecodeStandardList<uint8_t>(reader);
+    case EncodedType::kInt32List:
+      return DecodeStandardList<int32_t>(reader);
+    case EncodedType::kInt64List:
+      return DecodeStandardList<int64_t>(reader);
+    case EncodedType::kFloat64List:
+      return DecodeStandardList<double>(reader);
+    case EncodedType::kList: {
+      uint32_t length = 0;
+      reader->ReadSize(&length);
+      EncodableList list_value;
+      list_value.reserve(length);
+      for (size_t i = 0; i < length; ++i) {
+        list_value.push_back(DecodeStandardValue(reader));
+      }
+      return EncodableValue(std::move(list_value));
+    }
+    case EncodedType::kMap: {
+      uint32_t length = 0;
+      reader->ReadSize(&length);
+      EncodableMap map_value;
+      for (size_t i = 0; i < length; ++i) {
+        EncodableValue key = DecodeStandardValue(reader);
+        EncodableValue value = DecodeStandardValue(reader);
+        map_value.emplace(std::move(key), std::move(value));
+      }
+      return EncodableValue(std::move(map_value));
+    }
+    case EncodedType::kFloat32List:
+      return DecodeStandardList<float>(reader);
   }
-  uint8_t type_size = static_cast<uint8_t>(sizeof(T));
-  if (type_size > 1) {
-    stream->WriteAlignment(type_size);
+  return EncodableValue();
+}
+
+// Decodes |count| consecutive values from the start of |message| into
+// |values|.
+//
+// The values are validated in one pass before any of them is built. Returns
+// false without decoding anything if they are malformed or contain types that
+// are not built into the codec, in which case the caller should fall back to
+// the serializer so that errors are reported as before.
+bool DecodeStandardValues(const uint8_t* message,
+                          size_t message_size,
+                          EncodableValue* values,
+                          size_t count) {
+  StandardCodecReader validator(message, message_size);
+  for (size_t i = 0; i < count; ++i) {
+    if (ValidateStandardCodecValue(&validator) != StandardCodecStatus::kOk) {
+      return false;
+    }
+  }
+  StandardCodecReader reader(message, message_size);
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = DecodeStandardValue(&reader);
   }
-  stream->WriteBytes(reinterpret_cast<const uint8_t*>(vector.data()),
-                     count * type_size);
+  return true;
 }
 
+}  // namespace
+
 // ===== standard_message_codec.h =====
 
 // static
@@ -322,6 +482,12 @@ std::unique_ptr<EncodableValue> StandardMessageCodec::DecodeMessageInternal(
   if (!binary_message) {
     return std::make_unique<EncodableValue>();
   }
+  if (IsStandardSerializer(serializer_)) {
+    auto value = std::make_unique<EncodableValue>();
+    if (DecodeStandardValues(binary_message, message_size, value.get(), 1)) {
+      return value;
+    }
+  }
   ByteBufferStreamReader stream(binary_message, message_size);
   return std::make_unique<EncodableValue>(serializer_->ReadValue(&stream));
 }
@@ -330,6 +496,12 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  if (IsStandardSerializer(serializer_)) {
+    StandardCodecVectorBuffer buffer(encoded.get());
+    StandardCodecVectorWriter writer(&buffer);
+    EncodeStandardValue(message, &writer);
+    return encoded;
+  }
   ByteBufferStreamWriter stream(encoded.get());
   serializer_->WriteValue(message, &stream);
   return encoded;
@@ -367,6 +539,19 @@ StandardMethodCodec::~StandardMethodCodec() = default;
 std::unique_ptr<MethodCall<EncodableValue>>
 StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
                                               size_t message_size) const {
+  if (IsStandardSerializer(serializer_)) {
+    EncodableValue values[2];
+    if (DecodeStandardValues(message, message_size, values, 2)) {
+      const auto* method_name = std::get_if<std::string>(&values[0]);
+      if (!method_name) {
+        std::cerr << "Invalid method call; method name is not a string."
+                  << std::endl;
+        return nullptr;
+      }
+      return std::make_unique<MethodCall<EncodableValue>>(
+          *method_name, std::make_unique<EncodableValue>(std::move(values[1])));
+    }
+  }
   ByteBufferStreamReader stream(message, message_size);
   EncodableValue method_name_value = serializer_->ReadValue(&stream);
   const auto* method_name = std::get_if<std::string>(&method_name_value);
@@ -385,6 +570,17 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  if (IsStandardSerializer(serializer_)) {
+    StandardCodecVectorBuffer buffer(encoded.get());
+    StandardCodecVectorWriter writer(&buffer);
+    EncodeStandardValue(EncodableValue(method_call.method_name()), &writer);
+    if (method_call.arguments()) {
+      EncodeStandardValue(*method_call.arguments(), &writer);
+    } else {
+      EncodeStandardValue(EncodableValue(), &writer);
+    }
+    return encoded;
+  }
   ByteBufferStreamWriter stream(encoded.get());
   serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
   if (method_call.arguments()) {
@@ -399,6 +595,17 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  if (IsStandardSerializer(serializer_)) {
+    StandardCodecVectorBuffer buffer(encoded.get());
+    StandardCodecVectorWriter writer(&buffer);
+    writer.WriteByte(0);
+    if (result) {
+      EncodeStandardValue(*result, &writer);
+    } else {
+      EncodeStandardValue(EncodableValue(), &writer);
+    }
+    return encoded;
+  }
   ByteBufferStreamWriter stream(encoded.get());
   stream.WriteByte(0);
   if (result) {
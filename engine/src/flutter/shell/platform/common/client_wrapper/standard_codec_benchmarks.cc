@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A serializer that extends nothing, which makes the codec go through the
+// byte stream interfaces rather than the codec core. This is how every
+// message was encoded before the core existed, and how messages are still
+// encoded by codecs with extensions.
+class StreamSerializer : public StandardCodecSerializer {
+ public:
+  StreamSerializer() = default;
+
+  static const StreamSerializer& GetInstance() {
+    static StreamSerializer sInstance;
+    return sInstance;
+  }
+};
+
+enum class CodecPath {
+  kCore,
+  kStream,
+};
+
+const StandardMessageCodec& GetCodec(const benchmark::State& state) {
+  if (static_cast<CodecPath>(state.range(0)) == CodecPath::kCore) {
+    return StandardMessageCodec::GetInstance();
+  }
+  return StandardMessageCodec::GetInstance(&StreamSerializer::GetInstance());
+}
+
+EncodableValue MakeFloat64List(size_t count) {
+  std::vector<double> list(count);
+  for (size_t i = 0; i < count; i++) {
+    list[i] = i * 0.5;
+  }
+  return EncodableValue(std::move(list));
+}
+
+// A structure resembling a batch of method call arguments.
+EncodableValue MakeMap(size_t count) {
+  EncodableList list;
+  for (size_t i = 0; i < count; i++) {
+    list.emplace_back(EncodableMap{
+        {EncodableValue("id"), EncodableValue(static_cast<int32_t>(i))},
+        {EncodableValue("timestamp"),
+         EncodableValue(static_cast<int64_t>(i) << 33)},
+        {EncodableValue("x"), EncodableValue(i * 1.5)},
+        {EncodableValue("label"), EncodableValue("item " + std::to_string(i))},
+        {EncodableValue("enabled"), EncodableValue(i % 2 == 0)},
+    });
+  }
+  return EncodableValue(std::move(list));
+}
+
+void RunEncode(benchmark::State& state, const EncodableValue& value) {
+  const StandardMessageCodec& codec = GetCodec(state);
+  size_t size = 0;
+  for (auto _ : state) {
+    auto encoded = codec.EncodeMessage(value);
+    size = encoded->size();
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+
+void RunDecode(benchmark::State& state, const EncodableValue& value) {
+  const StandardMessageCodec& codec = GetCodec(state);
+  auto encoded = codec.EncodeMessage(value);
+  for (auto _ : state) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+}  // namespace
+
+static void BM_StandardCodecEncodeFloat64List(benchmark::State& state) {
+  RunEncode(state, MakeFloat64List(state.range(1)));
+}
+
+static void BM_StandardCodecDecodeFloat64List(benchmark::State& state) {
+  RunDecode(state, MakeFloat64List(state.range(1)));
+}
+
+static void BM_StandardCodecEncodeMaps(benchmark::State& state) {
+  RunEncode(state, MakeMap(state.range(1)));
+}
+
+static void BM_StandardCodecDecodeMaps(benchmark::State& state) {
+  RunDecode(state, MakeMap(state.range(1)));
+}
+
+// The first argument selects the codec path, the second the element count.
+BENCHMARK(BM_StandardCodecEncodeFloat64List)
+    ->ArgsProduct({{static_cast<int64_t>(CodecPath::kCore),
+                    static_cast<int64_t>(CodecPath::kStream)},
+                   {16, 4096, 1 << 20}});
+BENCHMARK(BM_StandardCodecDecodeFloat64List)
+    ->ArgsProduct({{static_cast<int64_t>(CodecPath::kCore),
+                    static_cast<int64_t>(CodecPath::kStream)},
+                   {16, 4096, 1 << 20}});
+BENCHMARK(BM_StandardCodecEncodeMaps)
+    ->ArgsProduct({{static_cast<int64_t>(CodecPath::kCore),
+                    static_cast<int64_t>(CodecPath::kStream)},
+                   {1, 64}});
+BENCHMARK(BM_StandardCodecDecodeMaps)
+    ->ArgsProduct({{static_cast<int64_t>(CodecPath::kCore),
+                    static_cast<int64_t>(CodecPath::kStream)},
+                   {1, 64}});
+
+}  // namespace flutter
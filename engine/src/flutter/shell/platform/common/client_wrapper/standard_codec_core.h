@@ -0,0 +1,347 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_STANDARD_CODEC_CORE_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_STANDARD_CODEC_CORE_H_
+
+// The wire format primitives of the standard message codec, shared by the C++
+// client wrapper and the Linux shell. See lib/src/services/message_codecs.dart
+// in the Flutter framework for a description of the encoding.
+//
+// Both ends of a channel run in the same process, so the encoding uses host
+// byte order and typed lists never need to be byte swapped. They are moved with
+// a single bounds check and a single memcpy, which the compiler lowers to wide
+// vector loads and stores.
+//
+// This header has no dependencies outside of the C++ standard library so that
+// it can be published with the client wrapper.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace flutter {
+
+// The order/values here must match the constants in message_codecs.dart.
+enum class StandardCodecType : uint8_t {
+  kNull = 0,
+  kTrue,
+  kFalse,
+  kInt32,
+  kInt64,
+  kLargeInt,  // No longer used. If encountered, treat as kString.
+  kFloat64,
+  kString,
+  kUInt8List,
+  kInt32List,
+  kInt64List,
+  kFloat64List,
+  kList,
+  kMap,
+  kFloat32List,
+};
+
+// The result of validating an encoded value with ValidateStandardCodecValue.
+enum class StandardCodecStatus {
+  kOk,
+  // The value is truncated.
+  kOutOfData,
+  // The value contains a type that is not built into the standard codec, which
+  // may be handled by a codec extension.
+  kUnsupportedType,
+};
+
+// Reads standard codec primitives from a byte array.
+//
+// Every read is bounds checked. A failed read returns false and leaves the
+// read position unchanged.
+class StandardCodecReader {
+ public:
+  // Creates a reader reading |size| bytes from |data|, starting at |offset|.
+  // |data| must remain valid for the lifetime of this object.
+  StandardCodecReader(const uint8_t* data, size_t size, size_t offset = 0)
+      : data_(data), size_(size), offset_(offset) {}
+
+  // The current read position, relative to the start of the data.
+  size_t offset() const { return offset_; }
+
+  // The number of bytes left to read.
+  size_t remaining() const { return offset_ < size_ ? size_ - offset_ : 0; }
+
+  bool ReadByte(uint8_t* value) {
+    if (remaining() < 1) {
+      return false;
+    }
+    *value = data_[offset_++];
+    return true;
+  }
+
+  // Reads a scalar of type |T|. The data does not need to be aligned.
+  template <typename T>
+  bool ReadScalar(T* value) {
+    static_assert(std::is_arithmetic_v<T>);
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  // Reads the variable-length size encoding.
+  bool ReadSize(uint32_t* value) {
+    const size_t start = offset_;
+    uint8_t byte = 0;
+    if (!ReadByte(&byte)) {
+      return false;
+    }
+    bool read = true;
+    if (byte < 254) {
+      *value = byte;
+    } else if (byte == 254) {
+      uint16_t value16 = 0;
+      read = ReadScalar(&value16);
+      *value = value16;
+    } else {
+      read = ReadScalar(value);
+    }
+    if (!read) {
+      offset_ = start;
+    }
+    return read;
+  }
+
+  // Advances the read position to the next multiple of |alignment| relative
+  // to the start of the data, unless it is already aligned.
+  bool ReadAlignment(size_t alignment) {
+    const size_t mod = offset_ % alignment;
+    if (mod == 0) {
+      return true;
+    }
+    if (remaining() < alignment - mod) {
+      return false;
+    }
+    offset_ += alignment - mod;
+    return true;
+  }
+
+  // Sets |bytes| to the next |length| bytes of the data without copying them.
+  bool ReadBytes(size_t length, const uint8_t** bytes) {
+    if (remaining() < length) {
+      return false;
+    }
+    *bytes = data_ + offset_;
+    offset_ += length;
+    return true;
+  }
+
+  // Reads the header of a typed list of |T|, i.e. its size and padding, and
+  // sets |elements| to the start of its |count| elements without copying
+  // them. The elements are aligned relative to the start of the data, but
+  // |elements| is only aligned if the data itself is; use CopyList to read
+  // them.
+  template <typename T>
+  bool ReadList(uint32_t* count, const uint8_t** elements) {
+    static_assert(std::is_arithmetic_v<T>);
+    const size_t start = offset_;
+    if (!ReadSize(count) || !ReadAlignment(alignof(T)) ||
+        remaining() / sizeof(T) < *count) {
+      offset_ = start;
+      return false;
+    }
+    *elements = data_ + offset_;
+    offset_ += static_cast<size_t>(*count) * sizeof(T);
+    return true;
+  }
+
+  // Copies |count| elements of a typed list returned by ReadList to |output|.
+  template <typename T>
+  static void CopyList(const uint8_t* elements, size_t count, T* output) {
+    if (count > 0) {
+      std::memcpy(output, elements, count * sizeof(T));
+    }
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_;
+};
+
+// Adapts a std::vector<uint8_t> for use with StandardCodecWriter.
+class StandardCodecVectorBuffer {
+ public:
+  // |bytes| must remain valid for the lifetime of this object.
+  explicit StandardCodecVectorBuffer(std::vector<uint8_t>* bytes)
+      : bytes_(bytes) {}
+
+  size_t size() const { return bytes_->size(); }
+
+  void AppendByte(uint8_t byte) { bytes_->push_back(byte); }
+
+  void Append(const uint8_t* bytes, size_t length) {
+    bytes_->insert(bytes_->end(), bytes, bytes + length);
+  }
+
+ private:
+  std::vector<uint8_t>* bytes_;
+};
+
+// Writes standard codec primitives to the end of a byte buffer.
+//
+// |Buffer| must provide |size_t size() const|, returning the current size of
+// the buffer, |void AppendByte(uint8_t byte)| and
+// |void Append(const uint8_t* bytes, size_t length)|. The
+// elements of a typed list are appended with a single call, so that the buffer
+// grows at most once for a list of any length.
+template <typename Buffer>
+class StandardCodecWriter {
+ public:
+  // |buffer| must remain valid for the lifetime of this object.
+  explicit StandardCodecWriter(Buffer* buffer) : buffer_(buffer) {}
+
+  void WriteByte(uint8_t value) { buffer_->AppendByte(value); }
+
+  void WriteType(StandardCodecType type) {
+    WriteByte(static_cast<uint8_t>(type));
+  }
+
+  template <typename T>
+  void WriteScalar(T value) {
+    static_assert(std::is_arithmetic_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  // Writes the variable-length size encoding of |size|.
+  void WriteSize(uint32_t size) {
+    uint8_t bytes[1 + sizeof(uint32_t)] = {};
+    if (size < 254) {
+      buffer_->AppendByte(static_cast<uint8_t>(size));
+    } else if (size <= 0xffff) {
+      const uint16_t value = static_cast<uint16_t>(size);
+      bytes[0] = 254;
+      std::memcpy(bytes + 1, &value, sizeof(value));
+      buffer_->Append(bytes, 1 + sizeof(value));
+    } else {
+      bytes[0] = 255;
+      std::memcpy(bytes + 1, &size, sizeof(size));
+      buffer_->Append(bytes, 1 + sizeof(size));
+    }
+  }
+
+  // Writes zeros until the next multiple of |alignment| relative to the start
+  // of the buffer, unless the write position is already aligned. |alignment|
+  // must be at most 8.
+  void WriteAlignment(size_t alignment) {
+    static constexpr uint8_t kZeros[8] = {};
+    const size_t mod = buffer_->size() % alignment;
+    if (mod != 0) {
+      buffer_->Append(kZeros, alignment - mod);
+    }
+  }
+
+  void WriteBytes(const void* bytes, size_t length) {
+    if (length > 0) {
+      buffer_->Append(static_cast<const uint8_t*>(bytes), length);
+    }
+  }
+
+  // Writes the size, padding and elements of a typed list of |count|
+  // elements. As in the framework, the padding is written even if the list is
+  // empty, since readers always skip it.
+  template <typename T>
+  void WriteList(const T* elements, size_t count) {
+    static_assert(std::is_arithmetic_v<T>);
+    WriteSize(static_cast<uint32_t>(count));
+    WriteAlignment(alignof(T));
+    WriteBytes(elements, count * sizeof(T));
+  }
+
+ private:
+  Buffer* buffer_;
+};
+
+// Checks that |reader| holds one complete value made of the types built into
+// the standard codec, and advances |reader| past it.
+//
+// The whole structure is checked in a single pass without allocating, so a
+// decoder can reject a malformed message before building any part of it.
+// Nesting is tracked with a count of the values still to be read rather than
+// recursion, so validating a deeply nested message cannot overflow the stack.
+// This does not extend to decoders, which recurse once per level of nesting.
+inline StandardCodecStatus ValidateStandardCodecValue(
+    StandardCodecReader* reader) {
+  // Every container adds at most 2^33 pending values and consumes at least 2
+  // bytes, so this cannot overflow.
+  uint64_t pending = 1;
+  while (pending > 0) {
+    pending--;
+    uint8_t type = 0;
+    if (!reader->ReadByte(&type)) {
+      return StandardCodecStatus::kOutOfData;
+    }
+    uint32_t count = 0;
+    const uint8_t* bytes = nullptr;
+    bool read = true;
+    switch (static_cast<StandardCodecType>(type)) {
+      case StandardCodecType::kNull:
+      case StandardCodecType::kTrue:
+      case StandardCodecType::kFalse:
+        break;
+      case StandardCodecType::kInt32:
+        read = reader->ReadBytes(sizeof(int32_t), &bytes);
+        break;
+      case StandardCodecType::kInt64:
+        read = reader->ReadBytes(sizeof(int64_t), &bytes);
+        break;
+      case StandardCodecType::kFloat64:
+        read = reader->ReadAlignment(alignof(double)) &&
+               reader->ReadBytes(sizeof(double), &bytes);
+        break;
+      case StandardCodecType::kLargeInt:
+      case StandardCodecType::kString:
+      case StandardCodecType::kUInt8List:
+        read = reader->ReadList<uint8_t>(&count, &bytes);
+        break;
+      case StandardCodecType::kInt32List:
+        read = reader->ReadList<int32_t>(&count, &bytes);
+        break;
+      case StandardCodecType::kInt64List:
+        read = reader->ReadList<int64_t>(&count, &bytes);
+        break;
+      case StandardCodecType::kFloat32List:
+        read = reader->ReadList<float>(&count, &bytes);
+        break;
+      case StandardCodecType::kFloat64List:
+        read = reader->ReadList<double>(&count, &bytes);
+        break;
+      case StandardCodecType::kList:
+      case StandardCodecType::kMap: {
+        read = reader->ReadSize(&count);
+        const uint64_t children =
+            type == static_cast<uint8_t>(StandardCodecType::kMap)
+                ? uint64_t{count} * 2
+                : uint64_t{count};
+        pending += children;
+        // Each value takes at least one byte.
+        if (read && pending > reader->remaining()) {
+          return StandardCodecStatus::kOutOfData;
+        }
+        break;
+      }
+      default:
+        return StandardCodecStatus::kUnsupportedType;
+    }
+    if (!read) {
+      return StandardCodecStatus::kOutOfData;
+    }
+  }
+  return StandardCodecStatus::kOk;
+}
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_STANDARD_CODEC_CORE_H_
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/standard_codec_core.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+using VectorWriter = StandardCodecWriter<StandardCodecVectorBuffer>;
+
+StandardCodecStatus Validate(const std::vector<uint8_t>& bytes,
+                             size_t* end = nullptr) {
+  StandardCodecReader reader(bytes.data(), bytes.size());
+  StandardCodecStatus status = ValidateStandardCodecValue(&reader);
+  if (end) {
+    *end = reader.offset();
+  }
+  return status;
+}
+
+}  // namespace
+
+TEST(StandardCodecCore, WritesSizes) {
+  std::vector<uint8_t> bytes;
+  StandardCodecVectorBuffer buffer(&bytes);
+  VectorWriter writer(&buffer);
+  writer.WriteSize(253);
+  writer.WriteSize(254);
+  writer.WriteSize(0x10000);
+  EXPECT_EQ(bytes, (std::vector<uint8_t>{0xfd, 0xfe, 0xfe, 0x00, 0xff, 0x00,
+                                         0x00, 0x01, 0x00}));
+
+  StandardCodecReader reader(bytes.data(), bytes.size());
+  uint32_t size = 0;
+  ASSERT_TRUE(reader.ReadSize(&size));
+  EXPECT_EQ(size, 253u);
+  ASSERT_TRUE(reader.ReadSize(&size));
+  EXPECT_EQ(size, 254u);
+  ASSERT_TRUE(reader.ReadSize(&size));
+  EXPECT_EQ(size, 0x10000u);
+  EXPECT_FALSE(reader.ReadSize(&size));
+}
+
+TEST(StandardCodecCore, RoundTripsAlignedLists) {
+  std::vector<uint8_t> bytes;
+  StandardCodecVectorBuffer buffer(&bytes);
+  VectorWriter writer(&buffer);
+  const std::vector<double> doubles = {1.5, -2.25, 1e300};
+  writer.WriteType(StandardCodecType::kFloat64List);
+  writer.WriteList(doubles.data(), doubles.size());
+  // Type and size, padded to 8 bytes, then the elements.
+  ASSERT_EQ(bytes.size(), 8u + 3 * sizeof(double));
+  EXPECT_EQ(bytes[1], 3u);
+  for (size_t i = 2; i < 8; i++) {
+    EXPECT_EQ(bytes[i], 0u);
+  }
+
+  StandardCodecReader reader(bytes.data(), bytes.size());
+  uint8_t type = 0;
+  ASSERT_TRUE(reader.ReadByte(&type));
+  uint32_t count = 0;
+  const uint8_t* elements = nullptr;
+  ASSERT_TRUE(reader.ReadList<double>(&count, &elements));
+  ASSERT_EQ(count, 3u);
+  std::vector<double> decoded(count);
+  StandardCodecReader::CopyList(elements, count, decoded.data());
+  EXPECT_EQ(decoded, doubles);
+  EXPECT_EQ(reader.remaining(), 0u);
+}
+
+TEST(StandardCodecCore, RejectsTruncatedLists) {
+  // An int32 list of two elements with only one present.
+  const std::vector<uint8_t> bytes = {0x09, 0x02, 0x00, 0x00,
+                                      0x01, 0x00, 0x00, 0x00};
+  StandardCodecReader reader(bytes.data(), bytes.size(), 1);
+  uint32_t count = 0;
+  const uint8_t* elements = nullptr;
+  EXPECT_FALSE(reader.ReadList<int32_t>(&count, &elements));
+  // A failed read does not move the reader.
+  EXPECT_EQ(reader.offset(), 1u);
+  EXPECT_EQ(Validate(bytes), StandardCodecStatus::kOutOfData);
+}
+
+TEST(StandardCodecCore, ValidatesNestedValues) {
+  // {"a": [1, 2.5], null: "bc"}, followed by one more byte.
+  const std::vector<uint8_t> bytes = {
+      0x0d, 0x02,                                            // map
+      0x07, 0x01, 0x61,                                      // "a"
+      0x0c, 0x02,                                            // list
+      0x03, 0x01, 0x00, 0x00, 0x00,                          // 1
+      0x06, 0x00, 0x00, 0x00,                                // 2.5, aligned
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x40,
+      0x00,                                                  // null
+      0x07, 0x02, 0x62, 0x63,                                // "bc"
+      0x00,                                                  // trailing
+  };
+  size_t end = 0;
+  EXPECT_EQ(Validate(bytes, &end), StandardCodecStatus::kOk);
+  EXPECT_EQ(end, bytes.size() - 1);
+
+  for (size_t size = 0; size < bytes.size() - 1; size++) {
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + size);
+    EXPECT_EQ(Validate(truncated), StandardCodecStatus::kOutOfData) << size;
+  }
+}
+
+TEST(StandardCodecCore, ValidationStopsAtUnsupportedTypes) {
+  EXPECT_EQ(Validate({0x0c, 0x02, 0x00, 0x80}),
+            StandardCodecStatus::kUnsupportedType);
+  // A huge declared container is rejected without walking it.
+  EXPECT_EQ(Validate({0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00}),
+            StandardCodecStatus::kOutOfData);
+}
+
+TEST(StandardCodecCore, ValidatesDeeplyNestedListsWithoutRecursion) {
+  std::vector<uint8_t> bytes;
+  for (size_t i = 0; i < 1000000; i++) {
+    bytes.push_back(0x0c);
+    bytes.push_back(0x01);
+  }
+  bytes.push_back(0x00);
+  EXPECT_EQ(Validate(bytes), StandardCodecStatus::kOk);
+}
+
+}  // namespace flutter
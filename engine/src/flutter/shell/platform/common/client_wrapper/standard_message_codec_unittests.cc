@@ -203,6 +203,13 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeInt32Array) {
   CheckEncodeDecode(value, bytes);
 }
 
+TEST(StandardMessageCodec, CanEncodeAndDecodeEmptyInt32Array) {
+  // The alignment padding is written even though there are no elements.
+  std::vector<uint8_t> bytes = {0x09, 0x00, 0x00, 0x00};
+  EncodableValue value(std::vector<int32_t>{});
+  CheckEncodeDecode(value, bytes);
+}
+
 TEST(StandardMessageCodec, CanEncodeAndDecodeInt64Array) {
   std::vector<uint8_t> bytes = {0x0a, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                                 0xef, 0xcd, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12,
@@ -227,6 +234,17 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeFloat64Array) {
   CheckEncodeDecode(value, bytes);
 }
 
+TEST(StandardMessageCodec, DecodesUnsupportedTypesThroughSerializer) {
+  // A list holding a custom type, which the shared serializer can't decode.
+  std::vector<uint8_t> bytes = {0x0c, 0x02, 0x01, 0x80};
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto decoded = codec.DecodeMessage(bytes);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(*decoded,
+            EncodableValue(EncodableList{EncodableValue(true),
+                                         EncodableValue()}));
+}
+
 TEST(StandardMessageCodec, CanEncodeAndDecodeSimpleCustomType) {
   std::vector<uint8_t> bytes = {0x80, 0x09, 0x00, 0x00, 0x00,
                                 0x10, 0x00, 0x00, 0x00};
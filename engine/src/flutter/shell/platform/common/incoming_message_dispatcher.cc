@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 
+#include "flutter/shell/platform/embedder/embedder_struct_macros.h"
+
 namespace flutter {
 
 IncomingMessageDispatcher::IncomingMessageDispatcher(
@@ -17,25 +19,22 @@ void IncomingMessageDispatcher::HandleMessage(
     const FlutterDesktopMessage& message,
     const std::function<void(void)>& input_block_cb,
     const std::function<void(void)>& input_unblock_cb) {
-  std::string channel(message.channel);
-
-  auto callback_iterator = callbacks_.find(channel);
+  const Route* found_route = FindRoute(message);
   // Find the handler for the channel; if there isn't one, report the failure.
-  if (callback_iterator == callbacks_.end()) {
+  if (found_route == nullptr || found_route->callback == nullptr) {
     FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
                                         nullptr, 0);
     return;
   }
-  auto& callback_info = callback_iterator->second;
-  const FlutterDesktopMessageCallback& message_callback = callback_info.first;
+  // Copied, as the handler may add routes.
+  const Route route = *found_route;
 
   // Process the call, handling input blocking if requested.
-  bool block_input = input_blocking_channels_.count(channel) > 0;
-  if (block_input) {
+  if (route.block_input) {
     input_block_cb();
   }
-  message_callback(messenger_, &message, callback_info.second);
-  if (block_input) {
+  route.callback(messenger_, &message, route.user_data);
+  if (route.block_input) {
     input_unblock_cb();
   }
 }
@@ -45,15 +44,56 @@ void IncomingMessageDispatcher::SetMessageCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data) {
   if (!callback) {
-    callbacks_.erase(channel);
+    auto found = route_indices_.find(channel);
+    if (found != route_indices_.end()) {
+      routes_[found->second].callback = nullptr;
+      routes_[found->second].user_data = nullptr;
+    }
     return;
   }
-  callbacks_[channel] = std::make_pair(callback, user_data);
+  Route& route = GetOrAddRoute(channel);
+  route.callback = callback;
+  route.user_data = user_data;
 }
 
 void IncomingMessageDispatcher::EnableInputBlockingForChannel(
     const std::string& channel) {
-  input_blocking_channels_.insert(channel);
+  GetOrAddRoute(channel).block_input = true;
+}
+
+IncomingMessageDispatcher::Route& IncomingMessageDispatcher::GetOrAddRoute(
+    const std::string& channel) {
+  auto [found, added] = route_indices_.try_emplace(channel, routes_.size());
+  if (added) {
+    routes_.emplace_back();
+  }
+  return routes_[found->second];
+}
+
+const IncomingMessageDispatcher::Route* IncomingMessageDispatcher::FindRoute(
+    const FlutterDesktopMessage& message) {
+  const FlutterDesktopMessage* message_pointer = &message;
+  const uint32_t channel_id = SAFE_ACCESS(message_pointer, channel_id, 0);
+  if (channel_id != 0 && channel_id < route_indices_by_channel_id_.size()) {
+    const uint32_t route_index = route_indices_by_channel_id_[channel_id];
+    if (route_index != 0) {
+      return &routes_[route_index - 1];
+    }
+  }
+
+  auto found = route_indices_.find(std::string_view(message.channel));
+  if (found == route_indices_.end()) {
+    return nullptr;
+  }
+  if (channel_id != 0) {
+    // Ids are small and dense, as the engine assigns them in order.
+    if (channel_id >= route_indices_by_channel_id_.size()) {
+      route_indices_by_channel_id_.resize(channel_id + 1, 0);
+    }
+    route_indices_by_channel_id_[channel_id] =
+        static_cast<uint32_t>(found->second + 1);
+  }
+  return &routes_[found->second];
 }
 
 }  // namespace flutter
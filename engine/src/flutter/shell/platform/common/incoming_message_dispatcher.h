@@ -5,11 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_COMMON_INCOMING_MESSAGE_DISPATCHER_H_
 #define FLUTTER_SHELL_PLATFORM_COMMON_INCOMING_MESSAGE_DISPATCHER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <map>
-#include <set>
 #include <string>
-#include <utility>
+#include <vector>
 
 #include "flutter/shell/platform/common/public/flutter_messenger.h"
 
@@ -59,18 +60,39 @@ class IncomingMessageDispatcher {
   void EnableInputBlockingForChannel(const std::string& channel);
 
  private:
+  // The handler and settings of a channel.
+  struct Route {
+    FlutterDesktopMessageCallback callback = nullptr;
+    void* user_data = nullptr;
+    // Whether input blocking should be enabled during the call to the
+    // channel's handler.
+    bool block_input = false;
+  };
+
+  // Returns the route for the channel named |channel|, adding it if needed.
+  Route& GetOrAddRoute(const std::string& channel);
+
+  // Returns the route of the channel |message| was sent on, or null.
+  //
+  // Messages carry an id that the engine has assigned to their channel. The
+  // first message on a channel finds the route by name and binds the id to
+  // it, so that later messages find it by indexing a vector with their id
+  // rather than by looking up the channel name.
+  const Route* FindRoute(const FlutterDesktopMessage& message);
+
   // Handle for interacting with the C messaging API.
   FlutterDesktopMessengerRef messenger_;
 
-  // A map from channel names to the FlutterDesktopMessageCallback that should
-  // be called for incoming messages on that channel, along with the void* user
-  // data to pass to it.
-  std::map<std::string, std::pair<FlutterDesktopMessageCallback, void*>>
-      callbacks_;
+  // The routes of all channels with a handler or with input blocking
+  // enabled. Routes are never removed, so indices into this stay valid.
+  std::vector<Route> routes_;
+
+  // A map from channel names to the index of their route in |routes_|.
+  std::map<std::string, size_t, std::less<>> route_indices_;
 
-  // Channel names for which input blocking should be enabled during the call to
-  // that channel's handler.
-  std::set<std::string> input_blocking_channels_;
+  // The index of the route of the channel with each engine-assigned channel
+  // id plus one, or 0 if no message has been received on that channel yet.
+  std::vector<uint32_t> route_indices_by_channel_id_;
 };
 
 }  // namespace flutter
@@ -88,4 +88,42 @@ TEST(IncomingMessageDispatcher, BlockInputTrue) {
   EXPECT_EQ(did_call[2], 2);
 }
 
+TEST(IncomingMessageDispatcher, RoutesByChannelId) {
+  FlutterDesktopMessengerRef messenger = nullptr;
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(messenger);
+  int calls = 0;
+  dispatcher->SetMessageCallback(
+      "hello",
+      [](FlutterDesktopMessengerRef messenger,
+         const FlutterDesktopMessage* message,
+         void* user_data) { (*reinterpret_cast<int*>(user_data))++; },
+      &calls);
+  FlutterDesktopMessage message = {
+      .struct_size = sizeof(FlutterDesktopMessage),
+      .channel = "hello",
+      .message = nullptr,
+      .message_size = 0,
+      .response_handle = nullptr,
+      .channel_id = 7,
+  };
+  dispatcher->HandleMessage(message);
+  EXPECT_EQ(calls, 1);
+
+  // Once bound, the id alone identifies the channel.
+  message.channel = "unused";
+  dispatcher->HandleMessage(message);
+  EXPECT_EQ(calls, 2);
+
+  // Messages of older engines have no channel id.
+  message.channel = "hello";
+  message.struct_size = offsetof(FlutterDesktopMessage, channel_id);
+  dispatcher->HandleMessage(message);
+  EXPECT_EQ(calls, 3);
+
+  dispatcher->SetMessageCallback("hello", nullptr, nullptr);
+  message.struct_size = sizeof(FlutterDesktopMessage);
+  dispatcher->HandleMessage(message);
+  EXPECT_EQ(calls, 3);
+}
+
 }  // namespace flutter
@@ -37,8 +37,11 @@ std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
     const size_t message_size) const {
   auto raw_message = reinterpret_cast<const char*>(binary_message);
   auto json_message = std::make_unique<rapidjson::Document>();
+  // Callers get a DOM either way, so rapidjson builds it directly rather than
+  // from the shared reader's tape, which would only add a pass.
   rapidjson::ParseResult result =
-      json_message->Parse(raw_message, message_size);
+      json_message->Parse<rapidjson::kParseValidateEncodingFlag>(raw_message,
+                                                                 message_size);
   if (result.IsError()) {
     std::cerr << "Unable to parse JSON message:" << std::endl
               << rapidjson::GetParseError_En(result.Code()) << std::endl;
@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -44,4 +45,31 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that decoded values keep the types rapidjson would give them.
+TEST(JsonMessageCodec, DecodesNumbersAndEscapedStrings) {
+  const std::string message =
+      R"({"int":5000000000,"uint":18446744073709551615,"double":-0.5,)"
+      R"("string":"a\"b\u00e9"})";
+  auto decoded = JsonMessageCodec::GetInstance().DecodeMessage(
+      reinterpret_cast<const uint8_t*>(message.data()), message.size());
+  ASSERT_TRUE(decoded);
+  ASSERT_TRUE(decoded->IsObject());
+  EXPECT_TRUE((*decoded)["int"].IsInt64());
+  EXPECT_EQ((*decoded)["int"].GetInt64(), 5000000000);
+  EXPECT_TRUE((*decoded)["uint"].IsUint64());
+  EXPECT_FALSE((*decoded)["uint"].IsInt64());
+  EXPECT_EQ((*decoded)["double"].GetDouble(), -0.5);
+  EXPECT_EQ(std::string((*decoded)["string"].GetString(),
+                        (*decoded)["string"].GetStringLength()),
+            "a\"b\xc3\xa9");
+}
+
+TEST(JsonMessageCodec, RejectsInvalidMessages) {
+  for (const std::string message : {"", "{", "[1,]", "\"\xff\""}) {
+    EXPECT_FALSE(JsonMessageCodec::GetInstance().DecodeMessage(
+        reinterpret_cast<const uint8_t*>(message.data()), message.size()))
+        << message;
+  }
+}
+
 }  // namespace flutter
@@ -40,6 +40,9 @@ typedef struct {
   // The response handle. If non-null, the receiver of this message must call
   // FlutterDesktopSendMessageResponse exactly once with this handle.
   const FlutterDesktopMessageResponseHandle* response_handle;
+  // An id that identifies |channel| for the lifetime of the process, or 0 if
+  // the channel has none.
+  uint32_t channel_id;
 } FlutterDesktopMessage;
 
 // Function pointer type for message handler callback registration.
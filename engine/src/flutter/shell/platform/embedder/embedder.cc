@@ -9,13 +9,13 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/thread.h"
-#include "third_party/dart/runtime/bin/elf_loader.h"
 #include "third_party/dart/runtime/include/dart_native_api.h"
 
 #if !defined(FLUTTER_NO_EXPORT)
@@ -34,15 +34,19 @@ extern const intptr_t kPlatformStrongDillSize;
 #endif  // FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
 }
 
+#include "flutter/common/engine_metrics.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/window/channel_registry.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_aot_elf.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
@@ -79,18 +83,12 @@ struct _FlutterPlatformMessageResponseHandle {
   std::unique_ptr<flutter::PlatformMessage> message;
 };
 
-struct LoadedElfDeleter {
-  void operator()(Dart_LoadedElf* elf) {
-    if (elf) {
-      ::Dart_UnloadELF(elf);
-    }
-  }
+struct _FlutterPlatformMessageData {
+  std::unique_ptr<fml::Mapping> mapping;
 };
 
-using UniqueLoadedElf = std::unique_ptr<Dart_LoadedElf, LoadedElfDeleter>;
-
 struct _FlutterEngineAOTData {
-  UniqueLoadedElf loaded_elf = nullptr;
+  std::shared_ptr<const flutter::EmbedderAOTElf> elf;
   const uint8_t* vm_snapshot_data = nullptr;
   const uint8_t* vm_snapshot_instrs = nullptr;
   const uint8_t* vm_isolate_data = nullptr;
@@ -110,36 +108,28 @@ FlutterEngineResult FlutterEngineCreateAOTData(
   }
 
   switch (source->type) {
-    case kFlutterEngineAOTDataSourceTypeElfPath: {
+    case kFlutterEngineAOTDataSourceTypeElfPath:
+    case kFlutterEngineAOTDataSourceTypeElfPathWarmPageCache: {
       if (!source->elf_path || !fml::IsFile(source->elf_path)) {
         return LOG_EMBEDDER_ERROR(kInvalidArguments,
                                   "Invalid ELF path specified.");
       }
 
-      auto aot_data = std::make_unique<_FlutterEngineAOTData>();
       const char* error = nullptr;
-
-#if OS_FUCHSIA
-      // TODO(gw280): https://github.com/flutter/flutter/issues/50285
-      // Dart doesn't implement Dart_LoadELF on Fuchsia
-      Dart_LoadedElf* loaded_elf = nullptr;
-#else
-      Dart_LoadedElf* loaded_elf = Dart_LoadELF(
-          source->elf_path,               // file path
-          0,                              // file offset
-          &error,                         // error (out)
-          &aot_data->vm_snapshot_data,    // vm snapshot data (out)
-          &aot_data->vm_snapshot_instrs,  // vm snapshot instr (out)
-          &aot_data->vm_isolate_data,     // vm isolate data (out)
-          &aot_data->vm_isolate_instrs    // vm isolate instr (out)
-      );
-#endif
-
-      if (loaded_elf == nullptr) {
+      auto elf = flutter::EmbedderAOTElf::Load(
+          source->elf_path,
+          source->type == kFlutterEngineAOTDataSourceTypeElfPathWarmPageCache,
+          &error);
+      if (elf == nullptr) {
         return LOG_EMBEDDER_ERROR(kInvalidArguments, error);
       }
 
-      aot_data->loaded_elf.reset(loaded_elf);
+      auto aot_data = std::make_unique<_FlutterEngineAOTData>();
+      aot_data->vm_snapshot_data = elf->vm_snapshot_data();
+      aot_data->vm_snapshot_instrs = elf->vm_snapshot_instrs();
+      aot_data->vm_isolate_data = elf->vm_isolate_data();
+      aot_data->vm_isolate_instrs = elf->vm_isolate_instrs();
+      aot_data->elf = std::move(elf);
 
       *data_out = aot_data.release();
       return kSuccess;
@@ -364,6 +354,9 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   settings.assets_path = args->assets_path;
   settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
   settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+  if (SAFE_ACCESS(args, enable_cpu_affinity, false)) {
+    settings.enable_cpu_affinity = true;
+  }
 
   if (!flutter::DartVM::IsRunningPrecompiledCode()) {
     // Verify the assets path contains Dart 2 kernel assets.
@@ -422,6 +415,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
               message->data().GetMapping(),    // message
               message->data().GetSize(),       // message_size
               handle,                          // response_handle
+              message->channel_id(),           // channel_id
           };
           handle->message = std::move(message);
           return ptr(&incoming_message, user_data);
@@ -535,7 +529,10 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   };
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          custom_task_runners, thread_config_callback);
+          custom_task_runners, thread_config_callback,
+          settings.enable_cpu_affinity
+              ? std::optional(fml::CpuAffinity::kPerformance)
+              : std::nullopt);
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -682,9 +679,22 @@ FlutterEngineResult FlutterEngineShutdown(FLUTTER_API_SYMBOL(FlutterEngine)
   return kSuccess;
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
+// Sends a platform message. The payload is copied unless `release_callback`
+// is set, in which case the engine references the payload until it invokes
+// the callback. The callback is invoked exactly once, including on failure.
+static FlutterEngineResult InternalSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  std::shared_ptr<const void> payload_owner;
+  if (release_callback != nullptr) {
+    payload_owner = std::shared_ptr<const void>(
+        nullptr, [release_callback, release_user_data](const void*) {
+          release_callback(release_user_data);
+        });
+  }
+
   if (engine == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
   }
@@ -715,14 +725,20 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     response = response_handle->message->response();
   }
 
+  const std::string_view channel = flutter_message->channel;
+  const flutter::ChannelId channel_id =
+      flutter::ChannelRegistry::InternCached(channel);
   std::unique_ptr<flutter::PlatformMessage> message;
   if (message_size == 0) {
-    message = std::make_unique<flutter::PlatformMessage>(
-        flutter_message->channel, response);
+    message = std::make_unique<flutter::PlatformMessage>(channel_id, channel,
+                                                         response);
   } else {
     message = std::make_unique<flutter::PlatformMessage>(
-        flutter_message->channel,
-        fml::MallocMapping::Copy(message_data, message_size), response);
+        channel_id, channel,
+        payload_owner ? fml::MallocMapping(message_data, message_size,
+                                           std::move(payload_owner))
+                      : fml::MallocMapping::Copy(message_data, message_size),
+        response);
   }
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
@@ -733,6 +749,27 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return InternalSendPlatformMessage(engine, flutter_message, nullptr,
+                                     nullptr);
+}
+
+// Note: This can execute on any thread.
+FlutterEngineResult FlutterEngineSendPlatformMessageWithRelease(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid release callback argument.");
+  }
+  return InternalSendPlatformMessage(engine, flutter_message,
+                                     release_callback, release_user_data);
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -810,6 +847,240 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterPlatformMessageAcquireData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    FlutterPlatformMessageData** data_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (handle == nullptr || data_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid response handle or data argument.");
+  }
+
+  // The data is moved out of the message, so a second call on the same
+  // handle finds none.
+  if (!handle->message || !handle->message->hasData() ||
+      handle->message->data().GetMapping() == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The platform message has no data to acquire, or it was already "
+        "acquired.");
+  }
+
+  // The message buffer is moved, not reallocated, so pointers previously
+  // handed to the embedder remain valid.
+  *data_out = new FlutterPlatformMessageData{
+      std::make_unique<fml::MallocMapping>(handle->message->releaseData())};
+  return kSuccess;
+}
+
+// Note: This can execute on any thread.
+FlutterEngineResult FlutterPlatformMessageReleaseData(
+    FlutterPlatformMessageData* data) {
+  if (data == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid data argument.");
+  }
+  delete data;
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterPlatformMessageCreateResponseHandleWithOwnedData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterOwnedDataCallback data_callback,
+    void* user_data,
+    FlutterPlatformMessageResponseHandle** response_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (data_callback == nullptr || response_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments, "Data callback or the response handle was invalid.");
+  }
+
+  flutter::EmbedderPlatformMessageResponse::OwnedDataCallback
+      response_callback = [user_data,
+                           data_callback](std::unique_ptr<fml::Mapping> data) {
+        auto owner = new FlutterPlatformMessageData{std::move(data)};
+        data_callback(owner->mapping->GetMapping(), owner->mapping->GetSize(),
+                      owner, user_data);
+      };
+
+  auto platform_task_runner = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                                  ->GetTaskRunners()
+                                  .GetPlatformTaskRunner();
+
+  auto handle = new FlutterPlatformMessageResponseHandle();
+
+  handle->message = std::make_unique<flutter::PlatformMessage>(
+      "",  // See |FlutterPlatformMessageCreateResponseHandle|.
+      fml::MakeRefCounted<flutter::EmbedderPlatformMessageResponse>(
+          std::move(platform_task_runner), response_callback));
+  *response_out = handle;
+  return kSuccess;
+}
+
+// Note: This can execute on any thread.
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseWithRelease(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  auto mapping = std::make_unique<fml::NonOwnedMapping>(
+      data, data_length,
+      [release_callback, release_user_data](const uint8_t*, size_t) {
+        if (release_callback) {
+          release_callback(release_user_data);
+        }
+      });
+
+  if (data_length != 0 && data == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Data size was non zero but the pointer to the data was null.");
+  }
+
+  if (handle == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid response handle.");
+  }
+
+  auto response = handle->message->response();
+
+  if (response) {
+    if (data_length == 0) {
+      response->CompleteEmpty();
+    } else {
+      response->Complete(std::move(mapping));
+    }
+  }
+
+  delete handle;
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSetPlatformMessageCoalescing(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    const char* channel,
+    size_t capacity) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid channel argument.");
+  }
+
+  engine->GetShell().SetPlatformMessageCoalescing(channel, capacity);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetPlatformMessageCoalescingStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    const char* channel,
+    FlutterPlatformMessageCoalescingStats* stats_out) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (channel == nullptr || stats_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid channel or stats argument.");
+  }
+
+  auto stats = engine->GetShell().GetPlatformMessageCoalescingStats(channel);
+  if (!stats.has_value()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Coalescing was never enabled for the channel.");
+  }
+
+  if (STRUCT_HAS_MEMBER(stats_out, capacity)) {
+    stats_out->capacity = stats->capacity;
+  }
+  if (STRUCT_HAS_MEMBER(stats_out, pending_count)) {
+    stats_out->pending_count = stats->pending;
+  }
+  if (STRUCT_HAS_MEMBER(stats_out, delivered_count)) {
+    stats_out->delivered_count = stats->delivered;
+  }
+  if (STRUCT_HAS_MEMBER(stats_out, dropped_count)) {
+    stats_out->dropped_count = stats->dropped;
+  }
+  return kSuccess;
+}
+
+static FlutterEngineLatencyStats ToLatencyStats(
+    const fml::Histogram::Snapshot& latency) {
+  return {
+      .struct_size = sizeof(FlutterEngineLatencyStats),
+      .count = latency.count,
+      .min = latency.min,
+      .max = latency.max,
+      .mean = latency.Mean(),
+      .p50 = latency.ValueAtPercentile(50),
+      .p90 = latency.ValueAtPercentile(90),
+      .p99 = latency.ValueAtPercentile(99),
+  };
+}
+
+FlutterEngineResult FlutterEngineGetMetrics(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterEngineMetricsCallback callback,
+    void* user_data) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid callback.");
+  }
+
+  const flutter::EngineMetrics& metrics =
+      flutter::EngineMetrics::GetInstance();
+  std::vector<FlutterEngineChannelMetrics> channels;
+  for (const auto& counts : metrics.GetChannelCounts()) {
+    channels.push_back({
+        .struct_size = sizeof(FlutterEngineChannelMetrics),
+        .channel =
+            flutter::ChannelRegistry::GetName(counts.channel_id).c_str(),
+        .messages_to_framework = counts.messages_to_framework,
+        .bytes_to_framework = counts.bytes_to_framework,
+        .messages_from_framework = counts.messages_from_framework,
+        .bytes_from_framework = counts.bytes_from_framework,
+    });
+  }
+
+  const flutter::TaskRunners& task_runners =
+      engine->GetShell().GetTaskRunners();
+  auto* task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const FlutterEngineMetrics engine_metrics = {
+      .struct_size = sizeof(FlutterEngineMetrics),
+      .channels = channels.data(),
+      .channels_count = channels.size(),
+      .platform_message_round_trip_to_framework =
+          ToLatencyStats(metrics.GetPlatformMessageRoundTrips(
+              flutter::EngineMetrics::Direction::kToFramework)),
+      .platform_message_round_trip_from_framework =
+          ToLatencyStats(metrics.GetPlatformMessageRoundTrips(
+              flutter::EngineMetrics::Direction::kFromFramework)),
+      .asset_load = ToLatencyStats(metrics.GetAssetLoads()),
+      .platform_task_queue_wait = ToLatencyStats(task_queues->GetTaskWaitTimes(
+          task_runners.GetPlatformTaskRunner()->GetTaskQueueId())),
+      .ui_task_queue_wait = ToLatencyStats(task_queues->GetTaskWaitTimes(
+          task_runners.GetUITaskRunner()->GetTaskQueueId())),
+  };
+  callback(&engine_metrics, user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult __FlutterEngineFlushPendingTasksNow() {
   fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
   return kSuccess;
@@ -1153,6 +1424,19 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyLowMemoryWarning, FlutterEngineNotifyLowMemoryWarning);
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
+  SET_PROC(SetPlatformMessageCoalescing,
+           FlutterEngineSetPlatformMessageCoalescing);
+  SET_PROC(GetPlatformMessageCoalescingStats,
+           FlutterEngineGetPlatformMessageCoalescingStats);
+  SET_PROC(PlatformMessageAcquireData, FlutterPlatformMessageAcquireData);
+  SET_PROC(PlatformMessageReleaseData, FlutterPlatformMessageReleaseData);
+  SET_PROC(PlatformMessageCreateResponseHandleWithOwnedData,
+           FlutterPlatformMessageCreateResponseHandleWithOwnedData);
+  SET_PROC(SendPlatformMessageResponseWithRelease,
+           FlutterEngineSendPlatformMessageResponseWithRelease);
+  SET_PROC(GetMetrics, FlutterEngineGetMetrics);
+  SET_PROC(SendPlatformMessageWithRelease,
+           FlutterEngineSendPlatformMessageWithRelease);
 #undef SET_PROC
 
   return kSuccess;
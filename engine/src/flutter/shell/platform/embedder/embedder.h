@@ -110,6 +110,11 @@ typedef struct {
   /// `FlutterEngineSendPlatformMessageResponse` will cause a memory leak. It is
   /// not safe to send multiple responses on a single response object.
   const FlutterPlatformMessageResponseHandle* response_handle;
+  /// A small integer that identifies `channel` for the lifetime of the
+  /// process, or 0 if the engine has not assigned the channel one. Embedders
+  /// may use it to route messages to their handlers without looking up the
+  /// channel name. Only set on messages sent by the engine.
+  uint32_t channel_id;
 } FlutterPlatformMessage;
 
 typedef void (*FlutterPlatformMessageCallback)(
@@ -120,6 +125,23 @@ typedef void (*FlutterDataCallback)(const uint8_t* /* data */,
                                     size_t /* size */,
                                     void* /* user data */);
 
+/// An engine owned buffer backing the contents of a platform message or a
+/// platform message response. Ownership of the buffer is transferred to the
+/// embedder by `FlutterPlatformMessageAcquireData` or a
+/// `FlutterOwnedDataCallback` and must be returned via
+/// `FlutterPlatformMessageReleaseData`.
+struct _FlutterPlatformMessageData;
+typedef struct _FlutterPlatformMessageData FlutterPlatformMessageData;
+
+/// A variant of `FlutterDataCallback` that hands ownership of the response
+/// buffer to the embedder. `data` remains valid until `owner` is released via
+/// `FlutterPlatformMessageReleaseData`.
+typedef void (*FlutterOwnedDataCallback)(
+    const uint8_t* /* data */,
+    size_t /* size */,
+    FlutterPlatformMessageData* /* owner */,
+    void* /* user data */);
+
 /// An update to whether a message channel has a listener set or not.
 typedef struct {
   /// The size of the struct. Must be sizeof(FlutterChannelUpdate).
@@ -134,6 +156,83 @@ typedef void (*FlutterChannelUpdateCallback)(
     const FlutterChannelUpdate* /* channel update */,
     void* /* user data */);
 
+/// Counters for a channel configured via
+/// `FlutterEngineSetPlatformMessageCoalescing`.
+typedef struct {
+  /// The size of this struct. Must be
+  /// sizeof(FlutterPlatformMessageCoalescingStats).
+  size_t struct_size;
+  /// The number of messages retained for the channel while a delivery to the
+  /// framework is outstanding. Zero if coalescing has been disabled.
+  size_t capacity;
+  /// The number of messages currently waiting to be delivered.
+  size_t pending_count;
+  /// The number of messages handed to the framework.
+  uint64_t delivered_count;
+  /// The number of messages dropped by the engine before they could be
+  /// delivered to the framework.
+  uint64_t dropped_count;
+} FlutterPlatformMessageCoalescingStats;
+
+/// A summary of the latencies recorded for an operation, in microseconds.
+/// Percentiles are upper bounds accurate to within 1/16th of the value.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineLatencyStats).
+  size_t struct_size;
+  /// The number of latencies recorded. All other fields are zero if none
+  /// were.
+  uint64_t count;
+  int64_t min;
+  int64_t max;
+  double mean;
+  int64_t p50;
+  int64_t p90;
+  int64_t p99;
+} FlutterEngineLatencyStats;
+
+/// The number of platform messages sent on a channel, and the number of bytes
+/// of data they carried, in each direction.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineChannelMetrics).
+  size_t struct_size;
+  /// The null terminated name of the channel. Empty for the messages on
+  /// channels that were not counted separately because the process used too
+  /// many distinct channel names.
+  const char* channel;
+  uint64_t messages_to_framework;
+  uint64_t bytes_to_framework;
+  uint64_t messages_from_framework;
+  uint64_t bytes_from_framework;
+} FlutterEngineChannelMetrics;
+
+/// The metrics reported by `FlutterEngineGetMetrics`. Apart from the task
+/// queue waits, the metrics are shared by all engines in the process.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineMetrics).
+  size_t struct_size;
+  /// The channels on which messages were sent.
+  const FlutterEngineChannelMetrics* channels;
+  size_t channels_count;
+  /// The time from sending a platform message to the framework to its
+  /// response.
+  FlutterEngineLatencyStats platform_message_round_trip_to_framework;
+  /// The time from the framework sending a platform message to its response.
+  FlutterEngineLatencyStats platform_message_round_trip_from_framework;
+  /// The time taken to load assets.
+  FlutterEngineLatencyStats asset_load;
+  /// The time tasks on the platform and UI task runners of this engine were
+  /// ready to run before they started running. Empty for task runners
+  /// provided by the embedder.
+  FlutterEngineLatencyStats platform_task_queue_wait;
+  FlutterEngineLatencyStats ui_task_queue_wait;
+} FlutterEngineMetrics;
+
+/// The callback made by `FlutterEngineGetMetrics`. `metrics` and everything
+/// it points to are only valid for the duration of the call.
+typedef void (*FlutterEngineMetricsCallback)(
+    const FlutterEngineMetrics* /* metrics */,
+    void* /* user_data */);
+
 typedef struct _FlutterTaskRunner* FlutterTaskRunner;
 
 typedef struct {
@@ -332,7 +431,16 @@ typedef void (*FlutterNativeThreadCallback)(FlutterNativeThreadType type,
 
 /// AOT data source type.
 typedef enum {
-  kFlutterEngineAOTDataSourceTypeElfPath
+  kFlutterEngineAOTDataSourceTypeElfPath,
+  /// Like `kFlutterEngineAOTDataSourceTypeElfPath`, except that every page of
+  /// the ELF library file is read into the operating system's page cache when
+  /// it is loaded, and a mapping of the file is kept for as long as the AOT
+  /// data is alive so that its pages are less likely to be evicted. This
+  /// avoids page faults that wait for the disk when engines are launched, at
+  /// the cost of keeping the whole file resident. The snapshots mapped by the
+  /// ELF loader are not pre-faulted themselves, so their first use still
+  /// takes page faults, which are served from the page cache.
+  kFlutterEngineAOTDataSourceTypeElfPathWarmPageCache,
 } FlutterEngineAOTDataSourceType;
 
 /// This struct specifies one of the various locations the engine can look for
@@ -573,6 +681,14 @@ typedef struct {
   /// `PlatformDispatcher.instance.engineId`. Can be used in native code to
   /// retrieve the engine instance that is running the Dart code.
   int64_t engine_id;
+
+  /// Whether the engine should request CPU affinities for the threads it
+  /// manages. If true, the engine managed UI thread requests the fastest cores
+  /// and the Dart VM worker threads request the remaining ones. Requests are
+  /// honored on Android and Linux, on devices whose cores differ in speed or
+  /// span several NUMA nodes. Since the Dart VM is shared, the value of the
+  /// first engine launched in the process applies to its worker threads.
+  bool enable_cpu_affinity;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -585,6 +701,12 @@ typedef struct {
 ///             all FlutterEngine instances launched using this data have been
 ///             terminated.
 ///
+///             Loaded ELF files are shared by all the AOT data created from
+///             them in the process, so creating AOT data for each of several
+///             engines running the same application does not load it again.
+///             A file that was modified or replaced since it was loaded is
+///             loaded anew.
+///
 /// @param[in]  source    The source of the AOT data.
 /// @param[out] data_out  The AOT data on success. Unchanged on failure.
 ///
@@ -723,6 +845,29 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message like
+///             `FlutterEngineSendPlatformMessage`, but without copying its
+///             payload. The engine references `message->message` until it
+///             invokes `release_callback`, which may happen on any thread.
+///             The release callback is invoked exactly once, including when
+///             this call fails.
+///
+/// @param[in]  engine            A running engine instance.
+/// @param[in]  message           The message to send.
+/// @param[in]  release_callback  The callback invoked once the engine no
+///                               longer references the message payload.
+/// @param[in]  release_user_data The user data passed to the release callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageWithRelease(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* release_user_data);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -796,6 +941,170 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
     const uint8_t* data,
     size_t data_length);
 
+//------------------------------------------------------------------------------
+/// @brief      Takes ownership of the buffer backing a platform message
+///             received from the engine so that the embedder can keep
+///             referencing `FlutterPlatformMessage::message` without copying
+///             it. The buffer stays valid after the response has been sent
+///             and is only collected once the returned owner is released via
+///             `FlutterPlatformMessageReleaseData`.
+///
+///             This must be called before a response is sent on the handle.
+///             Messages without a payload have no buffer to acquire.
+///
+///             The call consumes the message data: the buffer is moved out of
+///             the message, so a second call on the same handle fails with
+///             `kInvalidArguments`.
+///
+/// @param[in]  engine    A running engine instance.
+/// @param[in]  handle    The response handle of the received platform
+///                       message.
+/// @param[out] data_out  The owner of the message buffer.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterPlatformMessageAcquireData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    FlutterPlatformMessageData** data_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Releases a buffer acquired via
+///             `FlutterPlatformMessageAcquireData` or handed to a
+///             `FlutterOwnedDataCallback`. This call has no threading
+///             restrictions and may be made after the engine has been shut
+///             down.
+///
+/// @param[in]  data  The owner of the buffer to release.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterPlatformMessageReleaseData(
+    FlutterPlatformMessageData* data);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a platform message response handle like
+///             `FlutterPlatformMessageCreateResponseHandle`, except that the
+///             buffer containing the response is handed to the callback
+///             instead of being collected once the callback returns.
+///
+/// @see        FlutterPlatformMessageCreateResponseHandle()
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  data_callback  The callback invoked by the engine when the
+///                            Flutter application send a response on the
+///                            handle. The callback must release the owner it
+///                            is passed via
+///                            `FlutterPlatformMessageReleaseData`.
+/// @param[in]  user_data      The user data associated with the data callback.
+/// @param[out] response_out   The response handle created when this call is
+///                            successful.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterPlatformMessageCreateResponseHandleWithOwnedData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterOwnedDataCallback data_callback,
+    void* user_data,
+    FlutterPlatformMessageResponseHandle** response_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Send a response from the native side to a platform message from
+///             the Dart Flutter application without copying the response data.
+///             The engine references `data` until it invokes
+///             `release_callback`, which may happen on any thread. The
+///             release callback is invoked exactly once, including when this
+///             call fails.
+///
+/// @param[in]  engine            The running engine instance.
+/// @param[in]  handle            The platform message response handle.
+/// @param[in]  data              The data to associate with the platform
+///                               message response.
+/// @param[in]  data_length       The length of the platform message response
+///                               data.
+/// @param[in]  release_callback  The callback invoked once the engine no
+///                               longer references `data`.
+/// @param[in]  release_user_data The user data passed to the release callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseWithRelease(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Configures coalescing of platform messages sent by the embedder
+///             to the framework on the given channel. Messages on a coalesced
+///             channel that arrive while an earlier delivery is still waiting
+///             for the UI thread are held in a ring buffer of `capacity`
+///             messages instead of each being posted to the UI thread. When
+///             the ring buffer is full, the oldest message is dropped and its
+///             response handle (if any) is completed with an empty response.
+///
+///             A capacity of 1 gives "latest value wins" semantics, which is
+///             suitable for high frequency level-triggered channels such as
+///             sensor readings. A capacity of 0 disables coalescing for the
+///             channel, which is the default for all channels.
+///
+///             This call must be made on the platform thread.
+///
+/// @param[in]  engine    A running engine instance.
+/// @param[in]  channel   The null terminated name of the channel.
+/// @param[in]  capacity  The number of messages to retain.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetPlatformMessageCoalescing(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    size_t capacity);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the counters for a channel configured via
+///             `FlutterEngineSetPlatformMessageCoalescing`. This call has no
+///             threading restrictions.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  channel    The null terminated name of the channel.
+/// @param[out] stats_out  The counters. The caller must set `struct_size`.
+///
+/// @return     kInvalidArguments if coalescing was never enabled for the
+///             channel.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetPlatformMessageCoalescingStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCoalescingStats* stats_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the counters and latencies the engine records about
+///             platform messages, asset loads and its task queues. The same
+///             metrics are available to tools through the
+///             `_flutter.getEngineMetrics` service extension. This call has
+///             no threading restrictions.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   Called with the metrics before this call returns.
+/// @param[in]  user_data  A baton passed to the callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetMetrics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMetricsCallback callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief      This API is only meant to be used by platforms that need to
 ///             flush tasks on a message loop not controlled by the Flutter
@@ -1049,6 +1358,44 @@ typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageResponseFnPtr)(
     const FlutterPlatformMessageResponseHandle* handle,
     const uint8_t* data,
     size_t data_length);
+typedef FlutterEngineResult (*FlutterEnginePlatformMessageAcquireDataFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    FlutterPlatformMessageData** data_out);
+typedef FlutterEngineResult (*FlutterEnginePlatformMessageReleaseDataFnPtr)(
+    FlutterPlatformMessageData* data);
+typedef FlutterEngineResult (
+    *FlutterEnginePlatformMessageCreateResponseHandleWithOwnedDataFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterOwnedDataCallback data_callback,
+    void* user_data,
+    FlutterPlatformMessageResponseHandle** response_out);
+typedef FlutterEngineResult (
+    *FlutterEngineSendPlatformMessageResponseWithReleaseFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data);
+typedef FlutterEngineResult (*FlutterEngineSetPlatformMessageCoalescingFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    size_t capacity);
+typedef FlutterEngineResult (
+    *FlutterEngineGetPlatformMessageCoalescingStatsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageCoalescingStats* stats_out);
+typedef FlutterEngineResult (*FlutterEngineGetMetricsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMetricsCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageWithReleaseFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* release_user_data);
 typedef void (*FlutterEngineTraceEventDurationBeginFnPtr)(const char* name);
 typedef void (*FlutterEngineTraceEventDurationEndFnPtr)(const char* name);
 typedef void (*FlutterEngineTraceEventInstantFnPtr)(const char* name);
@@ -1101,6 +1448,18 @@ typedef struct {
   FlutterEngineNotifyLowMemoryWarningFnPtr NotifyLowMemoryWarning;
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
+  FlutterEngineSetPlatformMessageCoalescingFnPtr SetPlatformMessageCoalescing;
+  FlutterEngineGetPlatformMessageCoalescingStatsFnPtr
+      GetPlatformMessageCoalescingStats;
+  FlutterEnginePlatformMessageAcquireDataFnPtr PlatformMessageAcquireData;
+  FlutterEnginePlatformMessageReleaseDataFnPtr PlatformMessageReleaseData;
+  FlutterEnginePlatformMessageCreateResponseHandleWithOwnedDataFnPtr
+      PlatformMessageCreateResponseHandleWithOwnedData;
+  FlutterEngineSendPlatformMessageResponseWithReleaseFnPtr
+      SendPlatformMessageResponseWithRelease;
+  FlutterEngineGetMetricsFnPtr GetMetrics;
+  FlutterEngineSendPlatformMessageWithReleaseFnPtr
+      SendPlatformMessageWithRelease;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
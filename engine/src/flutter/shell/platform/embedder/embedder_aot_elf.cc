@@ -0,0 +1,182 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_aot_elf.h"
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/trace_event.h"
+
+#if FML_OS_WIN
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // FML_OS_WIN
+
+namespace flutter {
+
+struct EmbedderAOTElf::Key {
+  std::string path;
+  uint64_t device = 0;
+  uint64_t inode = 0;
+  uint64_t size = 0;
+  int64_t modification_time = 0;
+
+  bool operator<(const Key& other) const {
+    return std::tie(path, device, inode, size, modification_time) <
+           std::tie(other.path, other.device, other.inode, other.size,
+                    other.modification_time);
+  }
+};
+
+namespace {
+
+struct Cache {
+  std::mutex mutex;
+  std::map<EmbedderAOTElf::Key, std::weak_ptr<EmbedderAOTElf>> elfs;
+};
+
+Cache& GetCache() {
+  static Cache* cache = new Cache();
+  return *cache;
+}
+
+std::optional<EmbedderAOTElf::Key> GetKey(const std::string& path) {
+  std::error_code error;
+  const std::filesystem::path canonical_path =
+      std::filesystem::canonical(path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  EmbedderAOTElf::Key key;
+  key.path = canonical_path.string();
+  key.size = std::filesystem::file_size(canonical_path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  const auto modification_time =
+      std::filesystem::last_write_time(canonical_path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  key.modification_time = modification_time.time_since_epoch().count();
+#if !FML_OS_WIN
+  // Also tell apart files that replaced one another at the same path.
+  struct stat file_stat = {};
+  if (::stat(key.path.c_str(), &file_stat) != 0) {
+    return std::nullopt;
+  }
+  key.device = file_stat.st_dev;
+  key.inode = file_stat.st_ino;
+#endif  // !FML_OS_WIN
+  return key;
+}
+
+size_t GetPageSize() {
+#if FML_OS_WIN
+  SYSTEM_INFO system_info = {};
+  ::GetSystemInfo(&system_info);
+  return system_info.dwPageSize;
+#else
+  return ::sysconf(_SC_PAGESIZE);
+#endif  // FML_OS_WIN
+}
+
+// Reads every page of the file at `path` into the page cache and returns a
+// mapping of it.
+//
+// This is a separate mapping from the segments mapped by the Dart ELF loader,
+// whose extents Dart does not expose. Those are not pre-faulted, but their
+// faults no longer wait for the disk.
+std::unique_ptr<fml::FileMapping> WarmPageCache(const std::string& path) {
+  TRACE_EVENT0("flutter", "EmbedderAOTElf::WarmPageCache");
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping || !mapping->IsValid()) {
+    return nullptr;
+  }
+  const size_t page_size = GetPageSize();
+  const volatile uint8_t* bytes = mapping->GetMapping();
+  uint8_t sum = 0;
+  for (size_t offset = 0; offset < mapping->GetSize(); offset += page_size) {
+    sum += bytes[offset];
+  }
+  (void)sum;
+  return mapping;
+}
+
+}  // namespace
+
+EmbedderAOTElf::EmbedderAOTElf() = default;
+
+EmbedderAOTElf::~EmbedderAOTElf() {
+  if (key_) {
+    Cache& cache = GetCache();
+    std::scoped_lock lock(cache.mutex);
+    auto it = cache.elfs.find(*key_);
+    // The file may have been loaded again since this ELF was last used.
+    if (it != cache.elfs.end() && it->second.expired()) {
+      cache.elfs.erase(it);
+    }
+  }
+  if (loaded_elf_) {
+    ::Dart_UnloadELF(loaded_elf_);
+  }
+}
+
+std::shared_ptr<const EmbedderAOTElf> EmbedderAOTElf::Load(
+    const std::string& path,
+    bool warm_page_cache,
+    const char** error) {
+  TRACE_EVENT0("flutter", "EmbedderAOTElf::Load");
+  std::optional<Key> key = GetKey(path);
+  if (!key.has_value()) {
+    *error = "Could not read the ELF file.";
+    return nullptr;
+  }
+
+  // The lock is held while loading so that engines launched concurrently
+  // wait for one another rather than loading the same file twice.
+  Cache& cache = GetCache();
+  std::scoped_lock lock(cache.mutex);
+  std::shared_ptr<EmbedderAOTElf> elf;
+  auto it = cache.elfs.find(*key);
+  if (it != cache.elfs.end()) {
+    elf = it->second.lock();
+  }
+  if (!elf) {
+    elf = std::shared_ptr<EmbedderAOTElf>(new EmbedderAOTElf());
+#if OS_FUCHSIA
+    // TODO(gw280): https://github.com/flutter/flutter/issues/50285
+    // Dart doesn't implement Dart_LoadELF on Fuchsia
+    elf->loaded_elf_ = nullptr;
+#else
+    elf->loaded_elf_ = Dart_LoadELF(
+        key->path.c_str(),          // file path
+        0,                          // file offset
+        error,                      // error (out)
+        &elf->vm_snapshot_data_,    // vm snapshot data (out)
+        &elf->vm_snapshot_instrs_,  // vm snapshot instr (out)
+        &elf->vm_isolate_data_,     // vm isolate data (out)
+        &elf->vm_isolate_instrs_    // vm isolate instr (out)
+    );
+#endif
+    if (elf->loaded_elf_ == nullptr) {
+      return nullptr;
+    }
+    elf->key_ = std::make_unique<Key>(*key);
+    cache.elfs[*key] = elf;
+  }
+  if (warm_page_cache && !elf->page_cache_mapping_) {
+    elf->page_cache_mapping_ = WarmPageCache(key->path);
+  }
+  return elf;
+}
+
+}  // namespace flutter
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_AOT_ELF_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_AOT_ELF_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/dart/runtime/bin/elf_loader.h"
+
+namespace flutter {
+
+// An AOT ELF loaded by the Dart ELF loader, and the snapshots in it.
+class EmbedderAOTElf {
+ public:
+  // Identifies the file an ELF was loaded from.
+  struct Key;
+
+  // Returns the ELF at `path`, loading it if needed.
+  //
+  // Loaded ELFs are cached for as long as they are referenced, by canonical
+  // path and by the identity, size and modification time of the file, so all
+  // the engines in the process running the same app share one copy of it. A
+  // file that has been replaced or modified since it was loaded is loaded
+  // again.
+  //
+  // If `warm_page_cache` is true, every page of the file is read into the
+  // page cache when it is loaded, and a separate mapping of the file is kept
+  // while the ELF is in use, so that engines launched from it rarely have to
+  // wait for the disk. The segments mapped by the ELF loader are not
+  // pre-faulted.
+  //
+  // Returns null and sets `error` if the ELF could not be loaded. Thread-safe.
+  static std::shared_ptr<const EmbedderAOTElf> Load(const std::string& path,
+                                                    bool warm_page_cache,
+                                                    const char** error);
+
+  ~EmbedderAOTElf();
+
+  const uint8_t* vm_snapshot_data() const { return vm_snapshot_data_; }
+  const uint8_t* vm_snapshot_instrs() const { return vm_snapshot_instrs_; }
+  const uint8_t* vm_isolate_data() const { return vm_isolate_data_; }
+  const uint8_t* vm_isolate_instrs() const { return vm_isolate_instrs_; }
+
+ private:
+  EmbedderAOTElf();
+
+  std::unique_ptr<Key> key_;
+  Dart_LoadedElf* loaded_elf_ = nullptr;
+  const uint8_t* vm_snapshot_data_ = nullptr;
+  const uint8_t* vm_snapshot_instrs_ = nullptr;
+  const uint8_t* vm_isolate_data_ = nullptr;
+  const uint8_t* vm_isolate_instrs_ = nullptr;
+  // Only set while the cache is locked.
+  std::unique_ptr<fml::FileMapping> page_cache_mapping_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderAOTElf);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_AOT_ELF_H_
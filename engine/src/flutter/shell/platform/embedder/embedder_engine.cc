@@ -3,10 +3,17 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/embedder/embedder_engine.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 
+#if defined(FML_OS_LINUX)
+#include "flutter/shell/profiling/profiler_metrics_linux.h"
+#endif  // defined(FML_OS_LINUX)
+
 namespace flutter {
 
+static constexpr int kNumProfilerSamplesPerSec = 5;
+
 struct ShellArgs {
   Settings settings;
   Shell::CreateCallback<PlatformView> on_create_platform_view;
@@ -48,10 +55,43 @@ bool EmbedderEngine::LaunchShell() {
   // shell again.
   shell_args_.reset();
 
+  if (IsValid()) {
+    StartProfiler();
+  }
+
   return IsValid();
 }
 
+void EmbedderEngine::StartProfiler() {
+#if defined(FML_OS_LINUX)
+  auto profiler_task_runner = thread_host_->GetProfilerTaskRunner();
+  if (!profiler_task_runner) {
+    return;
+  }
+
+  auto metrics = std::make_shared<ProfilerMetricsLinux>();
+  auto add_thread = [metrics](const fml::RefPtr<fml::TaskRunner>& runner,
+                              const char* label) {
+    runner->PostTask(
+        [metrics, label]() { metrics->AddCurrentThread(label); });
+  };
+  add_thread(task_runners_.GetPlatformTaskRunner(), "platform");
+  if (task_runners_.GetUITaskRunner()->GetTaskQueueId() !=
+      task_runners_.GetPlatformTaskRunner()->GetTaskQueueId()) {
+    add_thread(task_runners_.GetUITaskRunner(), "ui");
+  }
+  add_thread(profiler_task_runner, "profiler");
+
+  profiler_ = std::make_unique<SamplingProfiler>(
+      task_runners_.GetLabel().c_str(), std::move(profiler_task_runner),
+      [metrics]() { return metrics->GenerateSample(); },
+      kNumProfilerSamplesPerSec);
+  profiler_->Start();
+#endif  // defined(FML_OS_LINUX)
+}
+
 bool EmbedderEngine::CollectShell() {
+  profiler_.reset();
   shell_.reset();
   return IsValid();
 }
@@ -11,6 +11,8 @@
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
+#include "flutter/shell/profiling/sampling_profiler.h"
+
 namespace flutter {
 
 struct ShellArgs;
@@ -61,6 +63,9 @@ class EmbedderEngine {
   RunConfiguration run_configuration_;
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
+  std::unique_ptr<SamplingProfiler> profiler_;
+
+  void StartProfiler();
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -13,6 +13,11 @@ EmbedderPlatformMessageResponse::EmbedderPlatformMessageResponse(
     const Callback& callback)
     : runner_(std::move(runner)), callback_(callback) {}
 
+EmbedderPlatformMessageResponse::EmbedderPlatformMessageResponse(
+    fml::RefPtr<fml::TaskRunner> runner,
+    const OwnedDataCallback& callback)
+    : runner_(std::move(runner)), owned_data_callback_(callback) {}
+
 EmbedderPlatformMessageResponse::~EmbedderPlatformMessageResponse() = default;
 
 // |PlatformMessageResponse|
@@ -23,6 +28,16 @@ void EmbedderPlatformMessageResponse::Complete(
     return;
   }
 
+  if (owned_data_callback_) {
+    runner_->PostTask(
+        // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+        fml::MakeCopyable([data = std::move(data),
+                           callback = owned_data_callback_]() mutable {
+          callback(std::move(data));
+        }));
+    return;
+  }
+
   runner_->PostTask(
       // The static leak checker gets confused by the use of fml::MakeCopyable.
       // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
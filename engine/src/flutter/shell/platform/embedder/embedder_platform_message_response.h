@@ -18,6 +18,8 @@ namespace flutter {
 class EmbedderPlatformMessageResponse : public PlatformMessageResponse {
  public:
   using Callback = std::function<void(const uint8_t* data, size_t size)>;
+  using OwnedDataCallback =
+      std::function<void(std::unique_ptr<fml::Mapping> data)>;
 
   //----------------------------------------------------------------------------
   /// @param[in]  runner    The task runner on which to execute the callback.
@@ -29,6 +31,15 @@ class EmbedderPlatformMessageResponse : public PlatformMessageResponse {
   EmbedderPlatformMessageResponse(fml::RefPtr<fml::TaskRunner> runner,
                                   const Callback& callback);
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  runner    The task runner on which to execute the callback.
+  /// @param[in]  callback  The callback that is handed the mapping containing
+  ///                       the response sent by the framework. This allows
+  ///                       the embedder to reference the response without
+  ///                       copying it.
+  EmbedderPlatformMessageResponse(fml::RefPtr<fml::TaskRunner> runner,
+                                  const OwnedDataCallback& callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys the message response. Can be called on any thread.
   ///             Does not execute unfulfilled callbacks.
@@ -38,6 +49,7 @@ class EmbedderPlatformMessageResponse : public PlatformMessageResponse {
  private:
   fml::RefPtr<fml::TaskRunner> runner_;
   Callback callback_;
+  OwnedDataCallback owned_data_callback_;
 
   // |PlatformMessageResponse|
   void Complete(std::unique_ptr<fml::Mapping> data) override;
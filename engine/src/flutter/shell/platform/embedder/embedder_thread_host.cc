@@ -6,6 +6,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
 
@@ -93,10 +94,11 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
     const FlutterCustomTaskRunners* custom_task_runners,
-    const flutter::ThreadConfigSetter& config_setter) {
+    const flutter::ThreadConfigSetter& config_setter,
+    std::optional<fml::CpuAffinity> ui_thread_affinity) {
   {
-    auto host =
-        CreateEmbedderManagedThreadHost(custom_task_runners, config_setter);
+    auto host = CreateEmbedderManagedThreadHost(
+        custom_task_runners, config_setter, ui_thread_affinity);
     if (host && host->IsValid()) {
       return host;
     }
@@ -107,7 +109,8 @@ EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
   // configuration if the embedder attempted to specify a configuration but
   // messed up with an incorrect configuration.
   if (custom_task_runners == nullptr) {
-    auto host = CreateEngineManagedThreadHost(config_setter);
+    auto host =
+        CreateEngineManagedThreadHost(config_setter, ui_thread_affinity);
     if (host && host->IsValid()) {
       return host;
     }
@@ -125,18 +128,31 @@ constexpr const char* kFlutterThreadName = "io.flutter";
 
 fml::Thread::ThreadConfig MakeThreadConfig(
     flutter::ThreadHost::Type type,
-    fml::Thread::ThreadPriority priority) {
+    fml::Thread::ThreadPriority priority,
+    std::optional<fml::CpuAffinity> affinity = std::nullopt) {
   return fml::Thread::ThreadConfig(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(type,
                                                             kFlutterThreadName),
-      priority);
+      priority, affinity);
+}
+
+// Adds a thread for the |SamplingProfiler| in debug and profile builds on
+// platforms that have a profiling sampler.
+static void SetUpProfilerThread(ThreadHost::ThreadHostConfig& config) {
+#if defined(FML_OS_LINUX) &&                                \
+    (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG || \
+     FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_PROFILE)
+  config.SetProfilerConfig(MakeThreadConfig(
+      ThreadHost::Type::kProfiler, fml::Thread::ThreadPriority::kBackground));
+#endif
 }
 
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderManagedThreadHost(
     const FlutterCustomTaskRunners* custom_task_runners,
-    const flutter::ThreadConfigSetter& config_setter) {
+    const flutter::ThreadConfigSetter& config_setter,
+    std::optional<fml::CpuAffinity> ui_thread_affinity) {
   if (custom_task_runners == nullptr) {
     return nullptr;
   }
@@ -159,10 +175,14 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
   // If the embedder has not supplied a UI task runner, one needs to be created.
   if (!ui_task_runner_pair.second) {
-    thread_host_config.SetUIConfig(MakeThreadConfig(
-        ThreadHost::Type::kUi, fml::Thread::ThreadPriority::kDisplay));
+    thread_host_config.SetUIConfig(
+        MakeThreadConfig(ThreadHost::Type::kUi,
+                         fml::Thread::ThreadPriority::kDisplay,
+                         ui_thread_affinity));
   }
 
+  SetUpProfilerThread(thread_host_config);
+
   // If both the platform task runner and the raster task runner are specified
   // and have the same identifier, store only one.
   if (platform_task_runner_pair.second && render_task_runner_pair.second) {
@@ -235,11 +255,14 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEngineManagedThreadHost(
-    const flutter::ThreadConfigSetter& config_setter) {
+    const flutter::ThreadConfigSetter& config_setter,
+    std::optional<fml::CpuAffinity> ui_thread_affinity) {
   // Crate a thraed host config, and specified the thread name and priority.
   auto thread_host_config = ThreadHost::ThreadHostConfig(config_setter);
   thread_host_config.SetUIConfig(MakeThreadConfig(
-      flutter::ThreadHost::kUi, fml::Thread::ThreadPriority::kDisplay));
+      flutter::ThreadHost::kUi, fml::Thread::ThreadPriority::kDisplay,
+      ui_thread_affinity));
+  SetUpProfilerThread(thread_host_config);
 
   // Create a thread host with the current thread as the platform thread and all
   // other threads managed.
@@ -307,6 +330,11 @@ const flutter::TaskRunners& EmbedderThreadHost::GetTaskRunners() const {
   return runners_;
 }
 
+fml::RefPtr<fml::TaskRunner> EmbedderThreadHost::GetProfilerTaskRunner() const {
+  return host_.profiler_thread ? host_.profiler_thread->GetTaskRunner()
+                               : nullptr;
+}
+
 bool EmbedderThreadHost::PostTask(intptr_t runner, uint64_t task) const {
   auto found = runners_map_.find(runner);
   if (found == runners_map_.end()) {
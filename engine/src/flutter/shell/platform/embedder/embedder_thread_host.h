@@ -7,9 +7,11 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -23,7 +25,8 @@ class EmbedderThreadHost {
   CreateEmbedderOrEngineManagedThreadHost(
       const FlutterCustomTaskRunners* custom_task_runners,
       const flutter::ThreadConfigSetter& config_setter =
-          fml::Thread::SetCurrentThreadName);
+          fml::Thread::SetCurrentThreadName,
+      std::optional<fml::CpuAffinity> ui_thread_affinity = std::nullopt);
 
   EmbedderThreadHost(
       ThreadHost host,
@@ -36,6 +39,13 @@ class EmbedderThreadHost {
 
   const flutter::TaskRunners& GetTaskRunners() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The task runner of the thread that samples profiling metrics,
+  ///             or nullptr if profiling is unavailable in this build or on
+  ///             this platform.
+  ///
+  fml::RefPtr<fml::TaskRunner> GetProfilerTaskRunner() const;
+
   bool PostTask(intptr_t runner, uint64_t task) const;
 
   static bool RunnerIsValid(intptr_t runner);
@@ -53,11 +63,13 @@ class EmbedderThreadHost {
   static std::unique_ptr<EmbedderThreadHost> CreateEmbedderManagedThreadHost(
       const FlutterCustomTaskRunners* custom_task_runners,
       const flutter::ThreadConfigSetter& config_setter =
-          fml::Thread::SetCurrentThreadName);
+          fml::Thread::SetCurrentThreadName,
+      std::optional<fml::CpuAffinity> ui_thread_affinity = std::nullopt);
 
   static std::unique_ptr<EmbedderThreadHost> CreateEngineManagedThreadHost(
       const flutter::ThreadConfigSetter& config_setter =
-          fml::Thread::SetCurrentThreadName);
+          fml::Thread::SetCurrentThreadName,
+      std::optional<fml::CpuAffinity> ui_thread_affinity = std::nullopt);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderThreadHost);
 };
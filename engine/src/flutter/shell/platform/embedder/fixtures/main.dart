@@ -120,6 +120,17 @@ void platform_messages_no_response() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void coalesced_platform_messages() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+        final Uint8List list = data!.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+        signalNativeMessage(utf8.decode(list));
+      };
+  signalNativeTest();
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void null_platform_messages() {
@@ -0,0 +1,194 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context.h"
+#include "flutter/testing/test_dart_native_resolver.h"
+#include "flutter/testing/testing.h"
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+#include <unistd.h>
+#endif
+
+namespace flutter::testing {
+
+static size_t GetResidentBytes() {
+#if FML_OS_LINUX || FML_OS_ANDROID
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return resident_pages * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+// Launches the first argument's number of engines from the AOT test fixture,
+// each with AOT data of its own created from the app ELF, and waits for their
+// root isolates to start. The second argument is the AOT data source type.
+static void BM_LaunchEnginesFromAOTData(benchmark::State& state) {
+  if (!DartVM::IsRunningPrecompiledCode()) {
+    state.SkipWithError("The AOT app ELF is only built in AOT modes.");
+    return;
+  }
+  const int engine_count = state.range(0);
+  const auto source_type =
+      static_cast<FlutterEngineAOTDataSourceType>(state.range(1));
+  const std::string elf_path =
+      fml::paths::JoinPaths({GetFixturesPath(), kDefaultAOTAppELFFileName});
+
+  EmbedderTestContext context(GetFixturesPath());
+  fml::AutoResetWaitableEvent isolate_created;
+  context.AddIsolateCreateCallback(
+      [&isolate_created]() { isolate_created.Signal(); });
+
+  double resident_bytes = 0;
+  for (auto _ : state) {
+    const size_t resident_before = GetResidentBytes();
+    std::vector<UniqueAOTData> aot_datas;
+    std::vector<UniqueEngine> engines;
+    for (int i = 0; i < engine_count; i++) {
+      FlutterEngineAOTDataSource data_in = {};
+      data_in.type = source_type;
+      data_in.elf_path = elf_path.c_str();
+      FlutterEngineAOTData data_out = nullptr;
+      if (FlutterEngineCreateAOTData(&data_in, &data_out) != kSuccess) {
+        state.SkipWithError("Could not create the AOT data.");
+        return;
+      }
+      aot_datas.emplace_back(data_out);
+
+      EmbedderConfigBuilder builder(
+          context, EmbedderConfigBuilder::InitializationPreference::
+                       kAOTDataInitialize);
+      builder.GetProjectArgs().aot_data = data_out;
+      engines.push_back(builder.LaunchEngine());
+      if (!engines.back().is_valid()) {
+        state.SkipWithError("Could not launch the engine.");
+        return;
+      }
+      isolate_created.Wait();
+    }
+    resident_bytes += static_cast<double>(GetResidentBytes()) -
+                      static_cast<double>(resident_before);
+    // The engines are shut down before the AOT data they use is collected.
+    engines.clear();
+  }
+  state.counters["resident_bytes_per_engine"] = benchmark::Counter(
+      resident_bytes / engine_count, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_LaunchEnginesFromAOTData)
+    ->ArgsProduct({{1, 20},
+                   {kFlutterEngineAOTDataSourceTypeElfPath,
+                    kFlutterEngineAOTDataSourceTypeElfPathWarmPageCache}})
+    ->Unit(benchmark::kMillisecond);
+
+// Sends platform messages of the first argument's size to Dart code that
+// echoes them back, and waits for each response. The second argument selects
+// whether messages are sent with `FlutterEngineSendPlatformMessageWithRelease`,
+// which references the payload, or `FlutterEngineSendPlatformMessage`, which
+// copies it.
+static void BM_PlatformMessageRoundTrip(benchmark::State& state) {
+  const size_t message_size = state.range(0);
+  const bool without_copies = state.range(1) != 0;
+  const std::vector<uint8_t> message_data(message_size, 0x42);
+
+  struct Captures {
+    fml::AutoResetWaitableEvent response_latch;
+    size_t response_size = 0;
+  };
+  Captures captures;
+
+  // Responses are delivered on the platform thread, which must not be the
+  // thread waiting for them.
+  fml::Thread platform_thread("platform");
+  EmbedderTestContext context(GetFixturesPath());
+  fml::AutoResetWaitableEvent ready;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+  UniqueEngine engine;
+  fml::AutoResetWaitableEvent launched;
+  platform_thread.GetTaskRunner()->PostTask([&]() {
+    EmbedderConfigBuilder builder(context);
+    builder.SetDartEntrypoint("platform_messages_response");
+    engine = builder.LaunchEngine();
+    launched.Signal();
+  });
+  launched.Wait();
+  if (!engine.is_valid()) {
+    state.SkipWithError("Could not launch the engine.");
+    return;
+  }
+  ready.Wait();
+
+  size_t bytes_copied = 0;
+  for (auto _ : state) {
+    platform_thread.GetTaskRunner()->PostTask([&]() {
+      FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+      FlutterPlatformMessageCreateResponseHandle(
+          engine.get(),
+          [](const uint8_t* data, size_t size, void* user_data) {
+            auto captures = reinterpret_cast<Captures*>(user_data);
+            captures->response_size = size;
+            captures->response_latch.Signal();
+          },
+          &captures, &response_handle);
+
+      FlutterPlatformMessage message = {};
+      message.struct_size = sizeof(FlutterPlatformMessage);
+      message.channel = "test_channel";
+      message.message = message_data.data();
+      message.message_size = message_data.size();
+      message.response_handle = response_handle;
+      if (without_copies) {
+        // The buffer outlives the benchmark, so there is nothing to release.
+        FlutterEngineSendPlatformMessageWithRelease(
+            engine.get(), &message, [](void* user_data) {}, nullptr);
+      } else {
+        FlutterEngineSendPlatformMessage(engine.get(), &message);
+        bytes_copied += message_data.size();
+      }
+      FlutterPlatformMessageReleaseResponseHandle(engine.get(),
+                                                  response_handle);
+    });
+    captures.response_latch.Wait();
+    if (captures.response_size != message_size) {
+      state.SkipWithError("The response did not echo the message.");
+      break;
+    }
+  }
+  // The payload bytes copied out of the embedder's buffer when sending.
+  state.counters["bytes_copied_per_round_trip"] = benchmark::Counter(
+      static_cast<double>(bytes_copied), benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() * message_size);
+
+  fml::AutoResetWaitableEvent shut_down;
+  platform_thread.GetTaskRunner()->PostTask([&]() {
+    engine.reset();
+    shut_down.Signal();
+  });
+  shut_down.Wait();
+}
+
+BENCHMARK(BM_PlatformMessageRoundTrip)
+    ->ArgsProduct({{64, 64 * 1024, 1024 * 1024}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter::testing
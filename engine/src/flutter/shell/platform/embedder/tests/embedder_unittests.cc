@@ -4,11 +4,16 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "embedder.h"
 #include "embedder_engine.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
@@ -19,6 +24,7 @@
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/platform/embedder/embedder_aot_elf.h"
 #include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
 #include "flutter/shell/platform/embedder/tests/embedder_test.h"
 #include "flutter/shell/platform/embedder/tests/embedder_unittests_util.h"
@@ -57,6 +63,19 @@ TEST_F(EmbedderTest, CanLaunchAndShutdownWithValidProjectArgs) {
   engine.reset();
 }
 
+TEST_F(EmbedderTest, CanLaunchAndShutdownWithCpuAffinity) {
+  auto& context = GetEmbedderContext();
+  fml::AutoResetWaitableEvent latch;
+  context.AddIsolateCreateCallback([&latch]() { latch.Signal(); });
+  EmbedderConfigBuilder builder(context);
+  builder.GetProjectArgs().enable_cpu_affinity = true;
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  // Wait for the root isolate to launch.
+  latch.Wait();
+  engine.reset();
+}
+
 // TODO(41999): Disabled because flaky.
 TEST_F(EmbedderTest, DISABLED_CanLaunchAndShutdownMultipleTimes) {
   auto& context = GetEmbedderContext();
@@ -459,6 +478,7 @@ TEST_F(EmbedderTest, IsolateServiceIdSent) {
   fml::Thread thread;
   UniqueEngine engine;
   std::string isolate_message;
+  uint32_t isolate_channel_id = 0;
 
   thread.GetTaskRunner()->PostTask([&]() {
     EmbedderConfigBuilder builder(context);
@@ -468,6 +488,7 @@ TEST_F(EmbedderTest, IsolateServiceIdSent) {
           if (strcmp(message->channel, "flutter/isolate") == 0) {
             isolate_message = {reinterpret_cast<const char*>(message->message),
                                message->message_size};
+            isolate_channel_id = message->channel_id;
             latch.Signal();
           }
         });
@@ -478,6 +499,7 @@ TEST_F(EmbedderTest, IsolateServiceIdSent) {
   // Wait for the isolate ID message and check its format.
   latch.Wait();
   ASSERT_EQ(isolate_message.find("isolates/"), 0ul);
+  EXPECT_NE(isolate_channel_id, 0u);
 
   // Since the engine was started on its own thread, it must be killed there as
   // well.
@@ -581,6 +603,160 @@ TEST_F(EmbedderTest, PlatformMessagesCanReceiveResponse) {
   captures.latch.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Like `PlatformMessagesCanReceiveResponse` but the embedder takes ownership of
+/// the response buffer and releases it on another thread after the callback
+/// has returned.
+///
+TEST_F(EmbedderTest, PlatformMessageResponsesCanBeOwnedByTheEmbedder) {
+  struct Captures {
+    fml::AutoResetWaitableEvent latch;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    FlutterPlatformMessageData* owner = nullptr;
+  };
+  Captures captures;
+  static std::string kMessageData = "Hello from embedder.";
+
+  CreateNewThread()->PostTask([&]() {
+    auto& context = GetEmbedderContext();
+    EmbedderConfigBuilder builder(context);
+    builder.SetDartEntrypoint("platform_messages_response");
+
+    fml::AutoResetWaitableEvent ready;
+    context.AddNativeCallback(
+        "SignalNativeTest",
+        CREATE_NATIVE_ENTRY(
+            [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+    auto engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+
+    FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+    auto callback = [](const uint8_t* data, size_t size,
+                       FlutterPlatformMessageData* owner,
+                       void* user_data) -> void {
+      auto captures = reinterpret_cast<Captures*>(user_data);
+      captures->data = data;
+      captures->size = size;
+      captures->owner = owner;
+      captures->latch.Signal();
+    };
+    auto result = FlutterPlatformMessageCreateResponseHandleWithOwnedData(
+        engine.get(), callback, &captures, &response_handle);
+    ASSERT_EQ(result, kSuccess);
+
+    FlutterPlatformMessage message = {};
+    message.struct_size = sizeof(FlutterPlatformMessage);
+    message.channel = "test_channel";
+    message.message = reinterpret_cast<const uint8_t*>(kMessageData.data());
+    message.message_size = kMessageData.size();
+    message.response_handle = response_handle;
+
+    ready.Wait();
+    result = FlutterEngineSendPlatformMessage(engine.get(), &message);
+    ASSERT_EQ(result, kSuccess);
+
+    result = FlutterPlatformMessageReleaseResponseHandle(engine.get(),
+                                                         response_handle);
+    ASSERT_EQ(result, kSuccess);
+  });
+
+  captures.latch.Wait();
+  ASSERT_NE(captures.owner, nullptr);
+  ASSERT_EQ(captures.size, kMessageData.size());
+  ASSERT_EQ(strncmp(kMessageData.data(),
+                    reinterpret_cast<const char*>(captures.data),
+                    captures.size),
+            0);
+  ASSERT_EQ(FlutterPlatformMessageReleaseData(captures.owner), kSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Like `PlatformMessagesCanReceiveResponse` but the engine references the
+/// message buffer instead of copying it, and releases it exactly once.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopies) {
+  struct Captures {
+    fml::AutoResetWaitableEvent response_latch;
+    fml::AutoResetWaitableEvent release_latch;
+    std::string response;
+    std::atomic<int> release_count = 0;
+  };
+  Captures captures;
+  static std::string kMessageData = "Hello from embedder.";
+
+  CreateNewThread()->PostTask([&]() {
+    auto& context = GetEmbedderContext();
+    EmbedderConfigBuilder builder(context);
+    builder.SetDartEntrypoint("platform_messages_response");
+
+    fml::AutoResetWaitableEvent ready;
+    context.AddNativeCallback(
+        "SignalNativeTest",
+        CREATE_NATIVE_ENTRY(
+            [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+    auto engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+
+    FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+    auto callback = [](const uint8_t* data, size_t size,
+                       void* user_data) -> void {
+      auto captures = reinterpret_cast<Captures*>(user_data);
+      captures->response.assign(reinterpret_cast<const char*>(data), size);
+      captures->response_latch.Signal();
+    };
+    auto result = FlutterPlatformMessageCreateResponseHandle(
+        engine.get(), callback, &captures, &response_handle);
+    ASSERT_EQ(result, kSuccess);
+
+    FlutterPlatformMessage message = {};
+    message.struct_size = sizeof(FlutterPlatformMessage);
+    message.channel = "test_channel";
+    message.message = reinterpret_cast<const uint8_t*>(kMessageData.data());
+    message.message_size = kMessageData.size();
+    message.response_handle = response_handle;
+
+    ready.Wait();
+    ASSERT_EQ(FlutterEngineSendPlatformMessageWithRelease(
+                  engine.get(), &message, nullptr, nullptr),
+              kInvalidArguments);
+    result = FlutterEngineSendPlatformMessageWithRelease(
+        engine.get(), &message,
+        [](void* user_data) {
+          auto captures = reinterpret_cast<Captures*>(user_data);
+          captures->release_count++;
+          captures->release_latch.Signal();
+        },
+        &captures);
+    ASSERT_EQ(result, kSuccess);
+
+    result = FlutterPlatformMessageReleaseResponseHandle(engine.get(),
+                                                         response_handle);
+    ASSERT_EQ(result, kSuccess);
+
+    // The release callback is also invoked when the message is rejected.
+    bool rejected_message_released = false;
+    FlutterPlatformMessage invalid_message = {};
+    invalid_message.struct_size = sizeof(FlutterPlatformMessage);
+    invalid_message.channel = "test_channel";
+    invalid_message.message = nullptr;
+    invalid_message.message_size = 1;
+    result = FlutterEngineSendPlatformMessageWithRelease(
+        engine.get(), &invalid_message,
+        [](void* user_data) { *reinterpret_cast<bool*>(user_data) = true; },
+        &rejected_message_released);
+    ASSERT_EQ(result, kInvalidArguments);
+    ASSERT_TRUE(rejected_message_released);
+  });
+
+  captures.response_latch.Wait();
+  captures.release_latch.Wait();
+  ASSERT_EQ(captures.response, kMessageData);
+  ASSERT_EQ(captures.release_count, 1);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a platform message can be sent with no response handle. Instead
 /// of the platform message integrity checked via a response handle, a native
@@ -690,6 +866,164 @@ TEST_F(EmbedderTest, InvalidPlatformMessages) {
   ASSERT_EQ(result, kInvalidArguments);
 }
 
+//------------------------------------------------------------------------------
+/// Tests that coalescing counters are only available for channels that have
+/// been configured.
+///
+TEST_F(EmbedderTest, CanConfigurePlatformMessageCoalescing) {
+  auto& context = GetEmbedderContext();
+  EmbedderConfigBuilder builder(context);
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterPlatformMessageCoalescingStats stats = {};
+  stats.struct_size = sizeof(FlutterPlatformMessageCoalescingStats);
+  ASSERT_EQ(FlutterEngineGetPlatformMessageCoalescingStats(
+                engine.get(), "test_channel", &stats),
+            kInvalidArguments);
+  ASSERT_EQ(
+      FlutterEngineSetPlatformMessageCoalescing(engine.get(), nullptr, 1),
+      kInvalidArguments);
+
+  ASSERT_EQ(FlutterEngineSetPlatformMessageCoalescing(engine.get(),
+                                                      "test_channel", 1),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineGetPlatformMessageCoalescingStats(
+                engine.get(), "test_channel", &stats),
+            kSuccess);
+  EXPECT_EQ(stats.capacity, 1u);
+  EXPECT_EQ(stats.pending_count, 0u);
+  EXPECT_EQ(stats.delivered_count, 0u);
+  EXPECT_EQ(stats.dropped_count, 0u);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that a burst of messages on a channel with a capacity of one, sent
+/// while the UI thread is busy, only delivers the last message to the
+/// framework.
+///
+TEST_F(EmbedderTest, CoalescedPlatformMessagesDeliverOnlyTheLatest) {
+  auto& context = GetEmbedderContext();
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("coalesced_platform_messages");
+
+  fml::AutoResetWaitableEvent ready, burst_sent, last_received;
+  std::mutex received_mutex;
+  std::vector<std::string> received;
+  // Keeps the UI thread busy until the whole burst has been sent.
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY([&ready, &burst_sent](Dart_NativeArguments args) {
+        ready.Signal();
+        burst_sent.Wait();
+      }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        auto message = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        std::scoped_lock lock(received_mutex);
+        received.push_back(message);
+        if (message == "9") {
+          last_received.Signal();
+        }
+      })));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ASSERT_EQ(FlutterEngineSetPlatformMessageCoalescing(engine.get(),
+                                                      "test_channel", 1),
+            kSuccess);
+  ready.Wait();
+
+  for (int i = 0; i < 10; i++) {
+    const std::string message_data = std::to_string(i);
+    FlutterPlatformMessage platform_message = {};
+    platform_message.struct_size = sizeof(FlutterPlatformMessage);
+    platform_message.channel = "test_channel";
+    platform_message.message =
+        reinterpret_cast<const uint8_t*>(message_data.data());
+    platform_message.message_size = message_data.size();
+    ASSERT_EQ(
+        FlutterEngineSendPlatformMessage(engine.get(), &platform_message),
+        kSuccess);
+  }
+  burst_sent.Signal();
+  last_received.Wait();
+
+  {
+    std::scoped_lock lock(received_mutex);
+    EXPECT_EQ(received, std::vector<std::string>{"9"});
+  }
+  FlutterPlatformMessageCoalescingStats stats = {};
+  stats.struct_size = sizeof(FlutterPlatformMessageCoalescingStats);
+  ASSERT_EQ(FlutterEngineGetPlatformMessageCoalescingStats(
+                engine.get(), "test_channel", &stats),
+            kSuccess);
+  EXPECT_EQ(stats.pending_count, 0u);
+  EXPECT_EQ(stats.delivered_count, 1u);
+  EXPECT_EQ(stats.dropped_count, 9u);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that the metrics count the platform messages sent on each channel.
+///
+TEST_F(EmbedderTest, MetricsCountPlatformMessages) {
+  auto& context = GetEmbedderContext();
+  EmbedderConfigBuilder builder(context);
+  builder.SetDartEntrypoint("null_platform_messages");
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          [&message](Dart_NativeArguments args) { message.Signal(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  ASSERT_EQ(FlutterEngineGetMetrics(engine.get(), nullptr, nullptr),
+            kInvalidArguments);
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_metrics_channel";
+  platform_message.message = nullptr;
+  platform_message.message_size = 0;
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  ASSERT_EQ(FlutterEngineSendPlatformMessage(engine.get(), &platform_message),
+            kSuccess);
+  message.Wait();
+
+  std::optional<FlutterEngineChannelMetrics> channel_metrics;
+  ASSERT_EQ(FlutterEngineGetMetrics(
+                engine.get(),
+                [](const FlutterEngineMetrics* metrics, void* user_data) {
+                  auto* result =
+                      static_cast<std::optional<FlutterEngineChannelMetrics>*>(
+                          user_data);
+                  for (size_t i = 0; i < metrics->channels_count; i++) {
+                    if (std::string_view(metrics->channels[i].channel) ==
+                        "test_metrics_channel") {
+                      *result = metrics->channels[i];
+                    }
+                  }
+                },
+                &channel_metrics),
+            kSuccess);
+  ASSERT_TRUE(channel_metrics.has_value());
+  EXPECT_EQ(channel_metrics->messages_to_framework, 1u);
+  EXPECT_EQ(channel_metrics->bytes_to_framework, 0u);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that setting a custom log callback works as expected and defaults to
 /// using tag "flutter".
@@ -1131,6 +1465,41 @@ TEST_F(EmbedderTest, CanCreateAndCollectAValidElfSource) {
   ASSERT_EQ(FlutterEngineCollectAOTData(data_out), kSuccess);
 }
 
+TEST_F(EmbedderTest, AOTDataCreatedFromTheSameElfShareIt) {
+  if (!DartVM::IsRunningPrecompiledCode()) {
+    GTEST_SKIP();
+    return;
+  }
+  const auto elf_path =
+      fml::paths::JoinPaths({GetFixturesPath(), kDefaultAOTAppELFFileName});
+
+  const char* error = nullptr;
+  auto elf = EmbedderAOTElf::Load(elf_path, false, &error);
+  ASSERT_NE(elf, nullptr) << error;
+  auto warmed_elf = EmbedderAOTElf::Load(elf_path, true, &error);
+  EXPECT_EQ(warmed_elf, elf);
+
+  // A copy of the file is a different file, and is loaded separately.
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto elf_mapping = fml::FileMapping::CreateReadOnly(elf_path);
+  ASSERT_NE(elf_mapping, nullptr);
+  ASSERT_TRUE(
+      fml::WriteAtomically(temp_dir.fd(), "app_copy.so", *elf_mapping));
+  auto copied_elf = EmbedderAOTElf::Load(
+      fml::paths::JoinPaths({temp_dir.path(), "app_copy.so"}), false, &error);
+  ASSERT_NE(copied_elf, nullptr) << error;
+  EXPECT_NE(copied_elf, elf);
+  EXPECT_NE(copied_elf->vm_snapshot_data(), elf->vm_snapshot_data());
+
+  FlutterEngineAOTDataSource data_in = {};
+  data_in.type = kFlutterEngineAOTDataSourceTypeElfPathWarmPageCache;
+  data_in.elf_path = elf_path.c_str();
+  FlutterEngineAOTData data_out = nullptr;
+  ASSERT_EQ(FlutterEngineCreateAOTData(&data_in, &data_out), kSuccess);
+  ASSERT_NE(data_out, nullptr);
+  ASSERT_EQ(FlutterEngineCollectAOTData(data_out), kSuccess);
+}
+
 TEST_F(EmbedderTest, CanLaunchAndShutdownWithAValidElfSource) {
   if (!DartVM::IsRunningPrecompiledCode()) {
     GTEST_SKIP();
@@ -43,6 +43,11 @@ struct _FlBinaryMessengerImpl {
 
   // PlatformMessageHandler keyed by channel name.
   GHashTable* platform_message_handlers;
+
+  // The PlatformMessageHandler in platform_message_handlers for each channel
+  // id the engine has sent a message with, or nullptr if none has been found
+  // yet. Cleared whenever platform_message_handlers changes.
+  GPtrArray* platform_message_handlers_by_channel_id;
 };
 
 static void fl_binary_messenger_impl_iface_init(
@@ -152,20 +157,51 @@ static void platform_message_handler_free(gpointer data) {
 static gboolean fl_binary_messenger_platform_message_cb(
     FlEngine* engine,
     const gchar* channel,
+    guint32 channel_id,
     GBytes* message,
     const FlutterPlatformMessageResponseHandle* response_handle,
     void* user_data) {
   FlBinaryMessenger* self = FL_BINARY_MESSENGER(user_data);
-  return fl_binary_messenger_handle_message(self, channel, message,
+  return fl_binary_messenger_handle_message(self, channel, channel_id, message,
                                             response_handle);
 }
 
+// Returns the handler for messages on @channel, which has the id @channel_id.
+//
+// The first message with a channel id finds the handler by name and keeps it
+// by id, so that later messages on the channel find it without hashing the
+// channel name.
+static PlatformMessageHandler* lookup_handler(FlBinaryMessengerImpl* self,
+                                              const gchar* channel,
+                                              guint32 channel_id) {
+  GPtrArray* handlers_by_id = self->platform_message_handlers_by_channel_id;
+  if (channel_id != 0 && channel_id < handlers_by_id->len) {
+    gpointer handler = g_ptr_array_index(handlers_by_id, channel_id);
+    if (handler != nullptr) {
+      return static_cast<PlatformMessageHandler*>(handler);
+    }
+  }
+
+  PlatformMessageHandler* handler = static_cast<PlatformMessageHandler*>(
+      g_hash_table_lookup(self->platform_message_handlers, channel));
+  if (handler != nullptr && channel_id != 0) {
+    // Ids are small and dense, as the engine assigns them in order.
+    if (channel_id >= handlers_by_id->len) {
+      g_ptr_array_set_size(handlers_by_id, channel_id + 1);
+    }
+    g_ptr_array_index(handlers_by_id, channel_id) = handler;
+  }
+  return handler;
+}
+
 static void fl_binary_messenger_impl_dispose(GObject* object) {
   FlBinaryMessengerImpl* self = FL_BINARY_MESSENGER_IMPL(object);
 
   g_weak_ref_clear(&self->engine);
 
   g_clear_pointer(&self->platform_message_handlers, g_hash_table_unref);
+  g_clear_pointer(&self->platform_message_handlers_by_channel_id,
+                  g_ptr_array_unref);
 
   G_OBJECT_CLASS(fl_binary_messenger_impl_parent_class)->dispose(object);
 }
@@ -192,6 +228,8 @@ static void set_message_handler_on_channel(
     return;
   }
 
+  // The handler kept for the channel's id may be freed.
+  g_ptr_array_set_size(self->platform_message_handlers_by_channel_id, 0);
   if (handler != nullptr) {
     g_hash_table_replace(
         self->platform_message_handlers, g_strdup(channel),
@@ -201,11 +239,42 @@ static void set_message_handler_on_channel(
   }
 }
 
-static gboolean do_unref(gpointer value) {
-  g_object_unref(value);
+// Engine references dropped by responses sent from other threads. These are
+// released together by a single idle source, so a burst of responses wakes
+// the main loop once rather than once per response.
+static GMutex pending_unrefs_mutex;
+static GPtrArray* pending_unrefs = nullptr;
+
+static gboolean release_pending_unrefs(gpointer user_data) {
+  g_autoptr(GPtrArray) objects = nullptr;
+  {
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&pending_unrefs_mutex);
+    objects = pending_unrefs;
+    pending_unrefs = nullptr;
+  }
+  // Freeing the array unrefs the objects, outside of the lock in case one of
+  // them is disposed and sends more responses.
   return G_SOURCE_REMOVE;
 }
 
+// Drops a reference to |object| on the platform thread.
+//
+// This guarantees that the dispose method for the object is executed on the
+// platform thread in the rare chance this is the last ref.
+static void unref_on_platform_thread(gpointer object) {
+  if (g_main_context_is_owner(g_main_context_default())) {
+    g_object_unref(object);
+    return;
+  }
+
+  g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&pending_unrefs_mutex);
+  if (pending_unrefs == nullptr) {
+    pending_unrefs = g_ptr_array_new_with_free_func(g_object_unref);
+    g_idle_add(release_pending_unrefs, nullptr);
+  }
+  g_ptr_array_add(pending_unrefs, object);
+}
+
 // Note: This function can be called from any thread.
 static gboolean send_response(FlBinaryMessenger* messenger,
                               FlBinaryMessengerResponseHandle* response_handle_,
@@ -238,9 +307,7 @@ static gboolean send_response(FlBinaryMessenger* messenger,
     response_handle->response_handle = nullptr;
   }
 
-  // This guarantees that the dispose method for the engine is executed
-  // on the platform thread in the rare chance this is the last ref.
-  g_idle_add(do_unref, engine);
+  unref_on_platform_thread(engine);
 
   return result;
 }
@@ -364,6 +431,7 @@ static void shutdown(FlBinaryMessenger* messenger) {
   g_autoptr(GHashTable) handlers = self->platform_message_handlers;
   self->platform_message_handlers = g_hash_table_new_full(
       g_str_hash, g_str_equal, g_free, platform_message_handler_free);
+  g_ptr_array_set_size(self->platform_message_handlers_by_channel_id, 0);
   g_hash_table_remove_all(handlers);
 }
 
@@ -386,6 +454,7 @@ static void fl_binary_messenger_impl_iface_init(
 static void fl_binary_messenger_impl_init(FlBinaryMessengerImpl* self) {
   self->platform_message_handlers = g_hash_table_new_full(
       g_str_hash, g_str_equal, g_free, platform_message_handler_free);
+  self->platform_message_handlers_by_channel_id = g_ptr_array_new();
 }
 
 FlBinaryMessenger* fl_binary_messenger_new(FlEngine* engine) {
@@ -478,12 +547,12 @@ G_MODULE_EXPORT void fl_binary_messenger_set_warns_on_channel_overflow(
 gboolean fl_binary_messenger_handle_message(
     FlBinaryMessenger* messenger,
     const gchar* channel,
+    guint32 channel_id,
     GBytes* message,
     const FlutterPlatformMessageResponseHandle* response_handle) {
   FlBinaryMessengerImpl* self = FL_BINARY_MESSENGER_IMPL(messenger);
 
-  PlatformMessageHandler* handler = static_cast<PlatformMessageHandler*>(
-      g_hash_table_lookup(self->platform_message_handlers, channel));
+  PlatformMessageHandler* handler = lookup_handler(self, channel, channel_id);
   if (handler == nullptr) {
     return FALSE;
   }
@@ -27,6 +27,7 @@ FlBinaryMessenger* fl_binary_messenger_new(FlEngine* engine);
  * fl_binary_messenger_handle_message:
  * @messenger: an #FlBinaryMessenger.
  * @channel: channel message received on.
+ * @channel_id: the id the engine assigned to @channel, or 0.
  * @message: message data.
  * @response_handle: handle to provide to
  * fl_engine_send_platform_message_response().
@@ -38,6 +39,7 @@ FlBinaryMessenger* fl_binary_messenger_new(FlEngine* engine);
 gboolean fl_binary_messenger_handle_message(
     FlBinaryMessenger* messenger,
     const gchar* channel,
+    guint32 channel_id,
     GBytes* message,
     const FlutterPlatformMessageResponseHandle* response_handle);
 
@@ -38,22 +38,26 @@ TEST(FlBinaryMessengerTest, Send) {
             response_callback_user_data = user_data;
             return kSuccess;
           }));
-  fl_engine_get_embedder_api(engine)->SendPlatformMessage = MOCK_ENGINE_PROC(
-      SendPlatformMessage,
-      ([&response_callback, &response_callback_user_data](
-           auto engine, const FlutterPlatformMessage* message) {
-        EXPECT_STREQ(message->channel, "test");
-        g_autofree gchar* text =
-            g_strndup(reinterpret_cast<const gchar*>(message->message),
-                      message->message_size);
-        EXPECT_STREQ(text, "Marco!");
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&response_callback, &response_callback_user_data](
+               auto engine, const FlutterPlatformMessage* message,
+               VoidCallback release_callback, void* release_user_data) {
+            EXPECT_STREQ(message->channel, "test");
+            g_autofree gchar* text =
+                g_strndup(reinterpret_cast<const gchar*>(message->message),
+                          message->message_size);
+            EXPECT_STREQ(text, "Marco!");
 
-        const gchar* response = "Polo!";
-        response_callback(reinterpret_cast<const uint8_t*>(response),
-                          strlen(response), response_callback_user_data);
+            const gchar* response = "Polo!";
+            response_callback(reinterpret_cast<const uint8_t*>(response),
+                              strlen(response), response_callback_user_data);
 
-        return kSuccess;
-      }));
+            release_callback(release_user_data);
+
+            return kSuccess;
+          }));
 
   g_autoptr(FlBinaryMessenger) messenger = fl_binary_messenger_new(engine);
   const char* text = "Marco!";
@@ -158,20 +162,24 @@ TEST(FlBinaryMessengerTest, NullptrResponse) {
             response_callback_user_data = user_data;
             return kSuccess;
           }));
-  fl_engine_get_embedder_api(engine)->SendPlatformMessage = MOCK_ENGINE_PROC(
-      SendPlatformMessage,
-      ([&response_callback, &response_callback_user_data](
-           auto engine, const FlutterPlatformMessage* message) {
-        EXPECT_STREQ(message->channel, "test");
-        g_autofree gchar* text =
-            g_strndup(reinterpret_cast<const gchar*>(message->message),
-                      message->message_size);
-        EXPECT_STREQ(text, "Hello World!");
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&response_callback, &response_callback_user_data](
+               auto engine, const FlutterPlatformMessage* message,
+               VoidCallback release_callback, void* release_user_data) {
+            EXPECT_STREQ(message->channel, "test");
+            g_autofree gchar* text =
+                g_strndup(reinterpret_cast<const gchar*>(message->message),
+                          message->message_size);
+            EXPECT_STREQ(text, "Hello World!");
 
-        response_callback(nullptr, 0, response_callback_user_data);
+            response_callback(nullptr, 0, response_callback_user_data);
 
-        return kSuccess;
-      }));
+            release_callback(release_user_data);
+
+            return kSuccess;
+          }));
 
   g_autoptr(FlBinaryMessenger) messenger = fl_binary_messenger_new(engine);
   const char* text = "Hello World!";
@@ -240,12 +248,13 @@ TEST(FlBinaryMessengerTest, Receive) {
   EXPECT_EQ(error, nullptr);
 
   bool called = false;
-  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponse =
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
       MOCK_ENGINE_PROC(
-          SendPlatformMessageResponse,
+          SendPlatformMessageResponseWithRelease,
           ([&called](auto engine,
                      const FlutterPlatformMessageResponseHandle* handle,
-                     const uint8_t* data, size_t data_length) {
+                     const uint8_t* data, size_t data_length,
+                     VoidCallback release_callback, void* release_user_data) {
             called = true;
 
             int fake_handle = *reinterpret_cast<const int*>(handle);
@@ -255,6 +264,8 @@ TEST(FlBinaryMessengerTest, Receive) {
                 g_strndup(reinterpret_cast<const gchar*>(data), data_length);
             EXPECT_STREQ(text, "Polo!");
 
+            release_callback(release_user_data);
+
             return kSuccess;
           }));
 
@@ -285,13 +296,66 @@ TEST(FlBinaryMessengerTest, Receive) {
   g_autoptr(GBytes) message = g_bytes_new(message_text, strlen(message_text));
   int fake_handle = 42;
   fl_binary_messenger_handle_message(
-      messenger, "test", message,
+      messenger, "test", 0, message,
       reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(
           &fake_handle));
 
   EXPECT_TRUE(called);
 }
 
+// Checks messages are routed by the channel ids the engine supplies.
+TEST(FlBinaryMessengerTest, ReceiveByChannelId) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  g_autoptr(FlEngine) engine = fl_engine_new(project);
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageResponseWithRelease,
+          ([](auto engine, const FlutterPlatformMessageResponseHandle* handle,
+              const uint8_t* data, size_t data_length,
+              VoidCallback release_callback,
+              void* release_user_data) { return kSuccess; }));
+
+  FlBinaryMessenger* messenger = fl_engine_get_binary_messenger(engine);
+
+  int calls = 0;
+  fl_binary_messenger_set_message_handler_on_channel(
+      messenger, "test",
+      [](FlBinaryMessenger* messenger, const gchar* channel, GBytes* message,
+         FlBinaryMessengerResponseHandle* response_handle, gpointer user_data) {
+        (*static_cast<int*>(user_data))++;
+        g_autoptr(GError) error = nullptr;
+        EXPECT_TRUE(fl_binary_messenger_send_response(
+            messenger, response_handle, nullptr, &error));
+      },
+      &calls, nullptr);
+
+  g_autoptr(GBytes) message = g_bytes_new(nullptr, 0);
+  int fake_handle = 42;
+  const FlutterPlatformMessageResponseHandle* response_handle =
+      reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(
+          &fake_handle);
+  EXPECT_TRUE(fl_binary_messenger_handle_message(messenger, "test", 7, message,
+                                                 response_handle));
+  EXPECT_EQ(calls, 1);
+
+  // Once found, the handler is kept by channel id.
+  EXPECT_TRUE(fl_binary_messenger_handle_message(messenger, "unused", 7,
+                                                 message, response_handle));
+  EXPECT_EQ(calls, 2);
+
+  // Removing the handler forgets it.
+  fl_binary_messenger_set_message_handler_on_channel(messenger, "test", nullptr,
+                                                     nullptr, nullptr);
+  EXPECT_FALSE(fl_binary_messenger_handle_message(messenger, "test", 7,
+                                                  message, response_handle));
+  EXPECT_EQ(calls, 2);
+}
+
 // Checks receieved messages can be responded to on a thread.
 TEST(FlBinaryMessengerTest, ReceiveRespondThread) {
   g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, 0);
@@ -303,12 +367,13 @@ TEST(FlBinaryMessengerTest, ReceiveRespondThread) {
   EXPECT_TRUE(fl_engine_start(engine, &error));
   EXPECT_EQ(error, nullptr);
 
-  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponse =
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
       MOCK_ENGINE_PROC(
-          SendPlatformMessageResponse,
+          SendPlatformMessageResponseWithRelease,
           ([&loop](auto engine,
                    const FlutterPlatformMessageResponseHandle* handle,
-                   const uint8_t* data, size_t data_length) {
+                   const uint8_t* data, size_t data_length,
+                   VoidCallback release_callback, void* release_user_data) {
             int fake_handle = *reinterpret_cast<const int*>(handle);
             EXPECT_EQ(fake_handle, 42);
 
@@ -318,6 +383,8 @@ TEST(FlBinaryMessengerTest, ReceiveRespondThread) {
 
             g_main_loop_quit(loop);
 
+            release_callback(release_user_data);
+
             return kSuccess;
           }));
 
@@ -370,13 +437,164 @@ TEST(FlBinaryMessengerTest, ReceiveRespondThread) {
   g_autoptr(GBytes) message = g_bytes_new(message_text, strlen(message_text));
   int fake_handle = 42;
   fl_binary_messenger_handle_message(
-      messenger, "test", message,
+      messenger, "test", 0, message,
       reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(
           &fake_handle));
 
   g_main_loop_run(loop);
 }
 
+// Checks many responses sent from a thread release the engine references they
+// hold from a single main loop source.
+TEST(FlBinaryMessengerTest, RespondFromThreadReleasesInBatches) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  g_autoptr(FlEngine) engine = fl_engine_new(project);
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+
+  guint response_count = 0;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageResponseWithRelease,
+          ([&response_count](auto engine,
+                             const FlutterPlatformMessageResponseHandle* handle,
+                             const uint8_t* data, size_t data_length,
+                             VoidCallback release_callback,
+                             void* release_user_data) {
+            response_count++;
+            release_callback(release_user_data);
+            return kSuccess;
+          }));
+
+  FlBinaryMessenger* messenger = fl_engine_get_binary_messenger(engine);
+
+  // Keep the response handles to respond to them from a thread.
+  g_autoptr(GPtrArray) response_handles =
+      g_ptr_array_new_with_free_func(g_object_unref);
+  fl_binary_messenger_set_message_handler_on_channel(
+      messenger, "test",
+      [](FlBinaryMessenger* messenger, const gchar* channel, GBytes* message,
+         FlBinaryMessengerResponseHandle* response_handle, gpointer user_data) {
+        g_ptr_array_add(static_cast<GPtrArray*>(user_data),
+                        g_object_ref(response_handle));
+      },
+      response_handles, nullptr);
+
+  constexpr guint kMessageCount = 1000;
+  const char* message_text = "Marco!";
+  g_autoptr(GBytes) message = g_bytes_new(message_text, strlen(message_text));
+  int fake_handle = 42;
+  for (guint i = 0; i < kMessageCount; i++) {
+    fl_binary_messenger_handle_message(
+        messenger, "test", 0, message,
+        reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(
+            &fake_handle));
+  }
+  ASSERT_EQ(response_handles->len, kMessageCount);
+
+  while (g_main_context_iteration(nullptr, FALSE)) {
+  }
+  const guint engine_ref_count = G_OBJECT(engine)->ref_count;
+
+  // Source ids are allocated in sequence, so these bracket the sources added
+  // while responding.
+  GSourceFunc noop = [](gpointer user_data) -> gboolean {
+    return G_SOURCE_REMOVE;
+  };
+  const guint first_source_id = g_idle_add(noop, nullptr);
+
+  typedef struct {
+    FlBinaryMessenger* messenger;
+    GPtrArray* response_handles;
+  } ThreadData;
+  ThreadData data = {messenger, response_handles};
+  GThread* thread = g_thread_new(
+      nullptr,
+      [](gpointer user_data) {
+        ThreadData* data = static_cast<ThreadData*>(user_data);
+        const char* response_text = "Polo!";
+        g_autoptr(GBytes) response =
+            g_bytes_new(response_text, strlen(response_text));
+        for (guint i = 0; i < data->response_handles->len; i++) {
+          g_autoptr(GError) error = nullptr;
+          EXPECT_TRUE(fl_binary_messenger_send_response(
+              data->messenger,
+              FL_BINARY_MESSENGER_RESPONSE_HANDLE(
+                  g_ptr_array_index(data->response_handles, i)),
+              response, &error));
+          EXPECT_EQ(error, nullptr);
+        }
+        return static_cast<gpointer>(nullptr);
+      },
+      &data);
+  g_thread_join(thread);
+  EXPECT_EQ(response_count, kMessageCount);
+
+  const guint last_source_id = g_idle_add(noop, nullptr);
+  EXPECT_LE(last_source_id - first_source_id, 2u);
+
+  // The references are held until the main loop runs.
+  EXPECT_EQ(G_OBJECT(engine)->ref_count, engine_ref_count + kMessageCount);
+  while (g_main_context_iteration(nullptr, FALSE)) {
+  }
+  EXPECT_EQ(G_OBJECT(engine)->ref_count, engine_ref_count);
+}
+
+// Checks responses sent on the platform thread release the engine reference
+// they hold straight away.
+TEST(FlBinaryMessengerTest, RespondOnPlatformThreadReleasesImmediately) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  g_autoptr(FlEngine) engine = fl_engine_new(project);
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageResponseWithRelease,
+          ([](auto engine, const FlutterPlatformMessageResponseHandle* handle,
+              const uint8_t* data, size_t data_length,
+              VoidCallback release_callback, void* release_user_data) {
+            release_callback(release_user_data);
+            return kSuccess;
+          }));
+
+  FlBinaryMessenger* messenger = fl_engine_get_binary_messenger(engine);
+  fl_binary_messenger_set_message_handler_on_channel(
+      messenger, "test",
+      [](FlBinaryMessenger* messenger, const gchar* channel, GBytes* message,
+         FlBinaryMessengerResponseHandle* response_handle, gpointer user_data) {
+        const char* response_text = "Polo!";
+        g_autoptr(GBytes) response =
+            g_bytes_new(response_text, strlen(response_text));
+        g_autoptr(GError) error = nullptr;
+        EXPECT_TRUE(fl_binary_messenger_send_response(
+            messenger, response_handle, response, &error));
+        EXPECT_EQ(error, nullptr);
+      },
+      nullptr, nullptr);
+
+  // Own the main context, as the platform thread does while it runs.
+  ASSERT_TRUE(g_main_context_acquire(nullptr));
+  while (g_main_context_iteration(nullptr, FALSE)) {
+  }
+  const guint engine_ref_count = G_OBJECT(engine)->ref_count;
+
+  const char* message_text = "Marco!";
+  g_autoptr(GBytes) message = g_bytes_new(message_text, strlen(message_text));
+  int fake_handle = 42;
+  fl_binary_messenger_handle_message(
+      messenger, "test", 0, message,
+      reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(
+          &fake_handle));
+
+  EXPECT_EQ(G_OBJECT(engine)->ref_count, engine_ref_count);
+  g_main_context_release(nullptr);
+}
+
 // MOCK_ENGINE_PROC is leaky by design.
 // NOLINTBEGIN(clang-analyzer-core.StackAddressEscape)
 
@@ -387,35 +605,44 @@ TEST(FlBinaryMessengerTest, ResizeChannel) {
 
   bool called = false;
 
-  FlutterEngineSendPlatformMessageFnPtr old_handler =
-      fl_engine_get_embedder_api(engine)->SendPlatformMessage;
-  fl_engine_get_embedder_api(engine)->SendPlatformMessage = MOCK_ENGINE_PROC(
-      SendPlatformMessage,
-      ([&called, old_handler](auto engine,
-                              const FlutterPlatformMessage* message) {
-        // Expect to receive a message on the "control" channel.
-        if (strcmp(message->channel, "dev.flutter/channel-buffers") != 0) {
-          return old_handler(engine, message);
-        }
+  FlutterEngineSendPlatformMessageWithReleaseFnPtr old_handler =
+      fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&called, old_handler](auto engine,
+                                  const FlutterPlatformMessage* message,
+                                  VoidCallback release_callback,
+                                  void* release_user_data) {
+            // Expect to receive a message on the "control" channel.
+            if (strcmp(message->channel, "dev.flutter/channel-buffers") != 0) {
+              return old_handler(engine, message, release_callback,
+                                 release_user_data);
+            }
 
-        called = true;
+            called = true;
 
-        // The expected content was created from the following Dart code:
-        //   MethodCall call = MethodCall('resize', ['flutter/test',3]);
-        //   StandardMethodCodec().encodeMethodCall(call).buffer.asUint8List();
-        const int expected_message_size = 29;
-        EXPECT_EQ(message->message_size,
-                  static_cast<size_t>(expected_message_size));
-        int expected[expected_message_size] = {
-            7,   6,   114, 101, 115, 105, 122, 101, 12,  2,
-            7,   12,  102, 108, 117, 116, 116, 101, 114, 47,
-            116, 101, 115, 116, 3,   3,   0,   0,   0};
-        for (size_t i = 0; i < expected_message_size; i++) {
-          EXPECT_EQ(message->message[i], expected[i]);
-        }
+            // The expected content was created from the following Dart code:
+            //   MethodCall call = MethodCall('resize', ['flutter/test',3]);
+            //   StandardMethodCodec()
+            //       .encodeMethodCall(call)
+            //       .buffer
+            //       .asUint8List();
+            const int expected_message_size = 29;
+            EXPECT_EQ(message->message_size,
+                      static_cast<size_t>(expected_message_size));
+            int expected[expected_message_size] = {
+                7,   6,   114, 101, 115, 105, 122, 101, 12,  2,
+                7,   12,  102, 108, 117, 116, 116, 101, 114, 47,
+                116, 101, 115, 116, 3,   3,   0,   0,   0};
+            for (size_t i = 0; i < expected_message_size; i++) {
+              EXPECT_EQ(message->message[i], expected[i]);
+            }
+
+            release_callback(release_user_data);
 
-        return kSuccess;
-      }));
+            return kSuccess;
+          }));
 
   g_autoptr(GError) error = nullptr;
   EXPECT_TRUE(fl_engine_start(engine, &error));
@@ -434,34 +661,45 @@ TEST(FlBinaryMessengerTest, WarnsOnOverflowChannel) {
 
   bool called = false;
 
-  FlutterEngineSendPlatformMessageFnPtr old_handler =
-      fl_engine_get_embedder_api(engine)->SendPlatformMessage;
-  fl_engine_get_embedder_api(engine)->SendPlatformMessage = MOCK_ENGINE_PROC(
-      SendPlatformMessage,
-      ([&called, old_handler](auto engine,
-                              const FlutterPlatformMessage* message) {
-        // Expect to receive a message on the "control" channel.
-        if (strcmp(message->channel, "dev.flutter/channel-buffers") != 0) {
-          return old_handler(engine, message);
-        }
+  FlutterEngineSendPlatformMessageWithReleaseFnPtr old_handler =
+      fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&called, old_handler](auto engine,
+                                  const FlutterPlatformMessage* message,
+                                  VoidCallback release_callback,
+                                  void* release_user_data) {
+            // Expect to receive a message on the "control" channel.
+            if (strcmp(message->channel, "dev.flutter/channel-buffers") != 0) {
+              return old_handler(engine, message, release_callback,
+                                 release_user_data);
+            }
 
-        called = true;
+            called = true;
 
-        // The expected content was created from the following Dart code:
-        //   MethodCall call = MethodCall('overflow',['flutter/test', true]);
-        //   StandardMethodCodec().encodeMethodCall(call).buffer.asUint8List();
-        const int expected_message_size = 27;
-        EXPECT_EQ(message->message_size,
-                  static_cast<size_t>(expected_message_size));
-        int expected[expected_message_size] = {
-            7,   8,   111, 118, 101, 114, 102, 108, 111, 119, 12,  2,   7, 12,
-            102, 108, 117, 116, 116, 101, 114, 47,  116, 101, 115, 116, 1};
-        for (size_t i = 0; i < expected_message_size; i++) {
-          EXPECT_EQ(message->message[i], expected[i]);
-        }
+            // The expected content was created from the following Dart code:
+            //   MethodCall call =
+            //       MethodCall('overflow', ['flutter/test', true]);
+            //   StandardMethodCodec()
+            //       .encodeMethodCall(call)
+            //       .buffer
+            //       .asUint8List();
+            const int expected_message_size = 27;
+            EXPECT_EQ(message->message_size,
+                      static_cast<size_t>(expected_message_size));
+            int expected[expected_message_size] = {
+                7,   8,   111, 118, 101, 114, 102, 108, 111, 119,
+                12,  2,   7,   12,  102, 108, 117, 116, 116, 101,
+                114, 47,  116, 101, 115, 116, 1};
+            for (size_t i = 0; i < expected_message_size; i++) {
+              EXPECT_EQ(message->message[i], expected[i]);
+            }
+
+            release_callback(release_user_data);
 
-        return kSuccess;
-      }));
+            return kSuccess;
+          }));
 
   g_autoptr(GError) error = nullptr;
   EXPECT_TRUE(fl_engine_start(engine, &error));
@@ -488,31 +726,36 @@ TEST(FlBinaryMessengerTest, ControlChannelErrorResponse) {
 
   g_autoptr(FlBinaryMessenger) messenger = fl_binary_messenger_new(engine);
   bool called = false;
-  FlutterEngineSendPlatformMessageFnPtr old_handler =
-      fl_engine_get_embedder_api(engine)->SendPlatformMessage;
-  fl_engine_get_embedder_api(engine)->SendPlatformMessage = MOCK_ENGINE_PROC(
-      SendPlatformMessage,
-      ([&called, old_handler, loop](auto engine,
-                                    const FlutterPlatformMessage* message) {
-        // Expect to receive a message on the "control" channel.
-        if (strcmp(message->channel, "dev.flutter/channel-buffers") != 0) {
-          return old_handler(engine, message);
-        }
-
-        called = true;
+  FlutterEngineSendPlatformMessageWithReleaseFnPtr old_handler =
+      fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&called, old_handler, loop](auto engine,
+                                        const FlutterPlatformMessage* message,
+                                        VoidCallback release_callback,
+                                        void* release_user_data) {
+            // Expect to receive a message on the "control" channel.
+            if (strcmp(message->channel, "dev.flutter/channel-buffers") != 0) {
+              return old_handler(engine, message, release_callback,
+                                 release_user_data);
+            }
 
-        // Register a callback to quit the main loop when binary messenger work
-        // ends.
-        g_idle_add(
-            [](gpointer user_data) {
-              g_main_loop_quit(static_cast<GMainLoop*>(user_data));
-              return FALSE;
-            },
-            loop);
+            called = true;
 
-        // Simulates an internal error.
-        return kInvalidArguments;
-      }));
+            // Register a callback to quit the main loop when binary messenger
+            // work ends.
+            g_idle_add(
+                [](gpointer user_data) {
+                  g_main_loop_quit(static_cast<GMainLoop*>(user_data));
+                  return FALSE;
+                },
+                loop);
+
+            // Simulates an internal error.
+            release_callback(release_user_data);
+            return kInvalidArguments;
+          }));
 
   fl_binary_messenger_set_warns_on_channel_overflow(messenger, "flutter/test",
                                                     false);
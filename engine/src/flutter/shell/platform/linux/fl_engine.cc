@@ -184,6 +184,55 @@ static void fl_engine_post_task(FlutterTask task,
   fl_task_runner_post_flutter_task(self->task_runner, task, target_time_nanos);
 }
 
+// An engine owned buffer referenced by a GBytes.
+typedef struct {
+  FlutterEnginePlatformMessageReleaseDataFnPtr release;
+  FlutterPlatformMessageData* data;
+} FlEngineOwnedData;
+
+static void fl_engine_owned_data_free(gpointer user_data) {
+  FlEngineOwnedData* owned_data = static_cast<FlEngineOwnedData*>(user_data);
+  if (owned_data->release(owned_data->data) != kSuccess) {
+    g_warning("Failed to release platform message data");
+  }
+  g_free(owned_data);
+}
+
+// Creates a GBytes that references a buffer owned by the engine. The buffer is
+// returned to the engine when the GBytes is freed, which may happen after the
+// engine has been shut down.
+static GBytes* fl_engine_wrap_owned_data(FlEngine* self,
+                                         const uint8_t* data,
+                                         size_t data_length,
+                                         FlutterPlatformMessageData* owner) {
+  FlEngineOwnedData* owned_data = g_new(FlEngineOwnedData, 1);
+  owned_data->release = self->embedder_api.PlatformMessageReleaseData;
+  owned_data->data = owner;
+  return g_bytes_new_with_free_func(data, data_length,
+                                    fl_engine_owned_data_free, owned_data);
+}
+
+// Returns the payload of a message from the engine, taking ownership of the
+// engine's buffer where possible rather than copying it.
+static GBytes* fl_engine_get_message_data(
+    FlEngine* self,
+    const FlutterPlatformMessage* message) {
+  FlutterPlatformMessageData* owner = nullptr;
+  if (message->message_size > 0 && message->response_handle != nullptr &&
+      self->embedder_api.PlatformMessageAcquireData(
+          self->engine, message->response_handle, &owner) == kSuccess) {
+    return fl_engine_wrap_owned_data(self, message->message,
+                                     message->message_size, owner);
+  }
+
+  return g_bytes_new(message->message, message->message_size);
+}
+
+// Called by the engine once it no longer references a message or response.
+static void fl_engine_release_bytes_cb(void* user_data) {
+  g_bytes_unref(static_cast<GBytes*>(user_data));
+}
+
 // Called when a platform message is received from the engine.
 static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
                                           void* user_data) {
@@ -191,11 +240,10 @@ static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
 
   gboolean handled = FALSE;
   if (self->platform_message_handler != nullptr) {
-    g_autoptr(GBytes) data =
-        g_bytes_new(message->message, message->message_size);
+    g_autoptr(GBytes) data = fl_engine_get_message_data(self, message);
     handled = self->platform_message_handler(
-        self, message->channel, data, message->response_handle,
-        self->platform_message_handler_data);
+        self, message->channel, message->channel_id, data,
+        message->response_handle, self->platform_message_handler_data);
   }
 
   if (!handled) {
@@ -217,12 +265,16 @@ static void fl_engine_on_pre_engine_restart_cb(void* user_data) {
 
 // Called when a response to a sent platform message is received from the
 // engine.
-static void fl_engine_platform_message_response_cb(const uint8_t* data,
-                                                   size_t data_length,
-                                                   void* user_data) {
+static void fl_engine_platform_message_response_cb(
+    const uint8_t* data,
+    size_t data_length,
+    FlutterPlatformMessageData* owner,
+    void* user_data) {
   g_autoptr(GTask) task = G_TASK(user_data);
-  g_task_return_pointer(task, g_bytes_new(data, data_length),
-                        reinterpret_cast<GDestroyNotify>(g_bytes_unref));
+  FlEngine* self = FL_ENGINE(g_task_get_source_object(task));
+  g_task_return_pointer(
+      task, fl_engine_wrap_owned_data(self, data, data_length, owner),
+      reinterpret_cast<GDestroyNotify>(g_bytes_unref));
 }
 
 // Implements FlPluginRegistry::get_registrar_for_plugin.
@@ -478,14 +530,19 @@ gboolean fl_engine_send_platform_message_response(
     return FALSE;
   }
 
-  gsize data_length = 0;
-  const uint8_t* data = nullptr;
+  FlutterEngineResult result;
   if (response != nullptr) {
-    data =
+    gsize data_length = 0;
+    const uint8_t* data =
         static_cast<const uint8_t*>(g_bytes_get_data(response, &data_length));
+    // The engine references the response until it has been delivered.
+    result = self->embedder_api.SendPlatformMessageResponseWithRelease(
+        self->engine, handle, data, data_length, fl_engine_release_bytes_cb,
+        g_bytes_ref(response));
+  } else {
+    result = self->embedder_api.SendPlatformMessageResponse(
+        self->engine, handle, nullptr, 0);
   }
-  FlutterEngineResult result = self->embedder_api.SendPlatformMessageResponse(
-      self->engine, handle, data, data_length);
 
   if (result != kSuccess) {
     g_set_error(error, fl_engine_error_quark(), FL_ENGINE_ERROR_FAILED,
@@ -516,7 +573,7 @@ void fl_engine_send_platform_message(FlEngine* self,
     }
 
     FlutterEngineResult result =
-        self->embedder_api.PlatformMessageCreateResponseHandle(
+        self->embedder_api.PlatformMessageCreateResponseHandleWithOwnedData(
             self->engine, fl_engine_platform_message_response_cb, task,
             &response_handle);
     if (result != kSuccess) {
@@ -539,8 +596,13 @@ void fl_engine_send_platform_message(FlEngine* self,
           : nullptr;
   fl_message.message_size = message != nullptr ? g_bytes_get_size(message) : 0;
   fl_message.response_handle = response_handle;
+  // The engine references the message until it releases the GBytes.
   FlutterEngineResult result =
-      self->embedder_api.SendPlatformMessage(self->engine, &fl_message);
+      fl_message.message_size > 0
+          ? self->embedder_api.SendPlatformMessageWithRelease(
+                self->engine, &fl_message, fl_engine_release_bytes_cb,
+                g_bytes_ref(message))
+          : self->embedder_api.SendPlatformMessage(self->engine, &fl_message);
 
   if (result != kSuccess && task != nullptr) {
     g_task_return_new_error(task, fl_engine_error_quark(),
@@ -29,6 +29,7 @@ GQuark fl_engine_error_quark(void) G_GNUC_CONST;
  * FlEnginePlatformMessageHandler:
  * @engine: an #FlEngine.
  * @channel: channel message received on.
+ * @channel_id: the id the engine assigned to @channel, or 0.
  * @message: message content received from Dart.
  * @response_handle: a handle to respond to the message with.
  * @user_data: (closure): data provided when registering this handler.
@@ -40,6 +41,7 @@ GQuark fl_engine_error_quark(void) G_GNUC_CONST;
 typedef gboolean (*FlEnginePlatformMessageHandler)(
     FlEngine* engine,
     const gchar* channel,
+    guint32 channel_id,
     GBytes* message,
     const FlutterPlatformMessageResponseHandle* response_handle,
     gpointer user_data);
@@ -5,6 +5,8 @@
 // Included first as it collides with the X11 headers.
 #include "gtest/gtest.h"
 
+#include <vector>
+
 #include "flutter/shell/platform/embedder/test_utils/proc_table_replacement.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_engine.h"
@@ -20,26 +22,32 @@ TEST(FlEngineTest, PlatformMessage) {
   g_autoptr(FlEngine) engine = fl_engine_new(project);
 
   bool called = false;
-  FlutterEngineSendPlatformMessageFnPtr old_handler =
-      fl_engine_get_embedder_api(engine)->SendPlatformMessage;
-  fl_engine_get_embedder_api(engine)->SendPlatformMessage = MOCK_ENGINE_PROC(
-      SendPlatformMessage,
-      ([&called, old_handler](auto engine,
-                              const FlutterPlatformMessage* message) {
-        if (strcmp(message->channel, "test") != 0) {
-          return old_handler(engine, message);
-        }
+  FlutterEngineSendPlatformMessageWithReleaseFnPtr old_handler =
+      fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&called, old_handler](auto engine,
+                                  const FlutterPlatformMessage* message,
+                                  VoidCallback release_callback,
+                                  void* release_user_data) {
+            if (strcmp(message->channel, "test") != 0) {
+              return old_handler(engine, message, release_callback,
+                                 release_user_data);
+            }
 
-        called = true;
+            called = true;
 
-        EXPECT_EQ(message->message_size, static_cast<size_t>(4));
-        EXPECT_EQ(message->message[0], 't');
-        EXPECT_EQ(message->message[1], 'e');
-        EXPECT_EQ(message->message[2], 's');
-        EXPECT_EQ(message->message[3], 't');
+            EXPECT_EQ(message->message_size, static_cast<size_t>(4));
+            EXPECT_EQ(message->message[0], 't');
+            EXPECT_EQ(message->message[1], 'e');
+            EXPECT_EQ(message->message[2], 's');
+            EXPECT_EQ(message->message[3], 't');
 
-        return kSuccess;
-      }));
+            release_callback(release_user_data);
+
+            return kSuccess;
+          }));
 
   g_autoptr(GError) error = nullptr;
   EXPECT_TRUE(fl_engine_start(engine, &error));
@@ -57,12 +65,13 @@ TEST(FlEngineTest, PlatformMessageResponse) {
   g_autoptr(FlEngine) engine = fl_engine_new(project);
 
   bool called = false;
-  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponse =
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
       MOCK_ENGINE_PROC(
-          SendPlatformMessageResponse,
+          SendPlatformMessageResponseWithRelease,
           ([&called](auto engine,
                      const FlutterPlatformMessageResponseHandle* handle,
-                     const uint8_t* data, size_t data_length) {
+                     const uint8_t* data, size_t data_length,
+                     VoidCallback release_callback, void* release_user_data) {
             called = true;
 
             EXPECT_EQ(
@@ -75,6 +84,8 @@ TEST(FlEngineTest, PlatformMessageResponse) {
             EXPECT_EQ(data[2], 's');
             EXPECT_EQ(data[3], 't');
 
+            release_callback(release_user_data);
+
             return kSuccess;
           }));
 
@@ -90,6 +101,173 @@ TEST(FlEngineTest, PlatformMessageResponse) {
   EXPECT_TRUE(called);
 }
 
+// Checks messages to and from the engine, and responses to and from them,
+// reference the buffers they were created from rather than being copied.
+TEST(FlEngineTest, PlatformMessageRoundTripDoesNotCopy) {
+  g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, 0);
+
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  g_autoptr(FlEngine) engine = fl_engine_new(project);
+
+  static const uint8_t kEngineMessage[] = {'M', 'a', 'r', 'c', 'o'};
+  static const uint8_t kEngineResponse[] = {'P', 'o', 'l', 'o'};
+  int message_owner = 0;
+  int response_owner = 0;
+  int fake_handle = 42;
+
+  FlutterPlatformMessageCallback platform_message_cb = nullptr;
+  void* platform_message_user_data = nullptr;
+  FlutterEngineInitializeFnPtr old_initialize =
+      fl_engine_get_embedder_api(engine)->Initialize;
+  fl_engine_get_embedder_api(engine)->Initialize = MOCK_ENGINE_PROC(
+      Initialize,
+      ([&platform_message_cb, &platform_message_user_data, old_initialize](
+           size_t version, const FlutterProjectArgs* args, void* user_data,
+           FLUTTER_API_SYMBOL(FlutterEngine) * engine_out) {
+        platform_message_cb = args->platform_message_callback;
+        platform_message_user_data = user_data;
+        return old_initialize(version, args, user_data, engine_out);
+      }));
+
+  std::vector<FlutterPlatformMessageData*> released;
+  fl_engine_get_embedder_api(engine)->PlatformMessageAcquireData =
+      MOCK_ENGINE_PROC(
+          PlatformMessageAcquireData,
+          ([&message_owner](auto engine,
+                            const FlutterPlatformMessageResponseHandle* handle,
+                            FlutterPlatformMessageData** data_out) {
+            *data_out =
+                reinterpret_cast<FlutterPlatformMessageData*>(&message_owner);
+            return kSuccess;
+          }));
+  fl_engine_get_embedder_api(engine)->PlatformMessageReleaseData =
+      MOCK_ENGINE_PROC(PlatformMessageReleaseData,
+                       ([&released](FlutterPlatformMessageData* data) {
+                         released.push_back(data);
+                         return kSuccess;
+                       }));
+
+  const void* sent_response = nullptr;
+  VoidCallback release_response = nullptr;
+  void* release_response_user_data = nullptr;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageResponseWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageResponseWithRelease,
+          ([&](auto engine, const FlutterPlatformMessageResponseHandle* handle,
+               const uint8_t* data, size_t data_length,
+               VoidCallback release_callback, void* release_user_data) {
+            sent_response = data;
+            release_response = release_callback;
+            release_response_user_data = release_user_data;
+            return kSuccess;
+          }));
+
+  const void* sent_message = nullptr;
+  VoidCallback release_message = nullptr;
+  void* release_message_user_data = nullptr;
+  fl_engine_get_embedder_api(engine)->SendPlatformMessageWithRelease =
+      MOCK_ENGINE_PROC(
+          SendPlatformMessageWithRelease,
+          ([&](auto engine, const FlutterPlatformMessage* message,
+               VoidCallback release_callback, void* release_user_data) {
+            sent_message = message->message;
+            release_message = release_callback;
+            release_message_user_data = release_user_data;
+            return kSuccess;
+          }));
+
+  FlutterOwnedDataCallback response_cb = nullptr;
+  void* response_user_data = nullptr;
+  fl_engine_get_embedder_api(engine)
+      ->PlatformMessageCreateResponseHandleWithOwnedData = MOCK_ENGINE_PROC(
+      PlatformMessageCreateResponseHandleWithOwnedData,
+      ([&](auto engine, FlutterOwnedDataCallback data_callback, void* user_data,
+           FlutterPlatformMessageResponseHandle** response_out) {
+        response_cb = data_callback;
+        response_user_data = user_data;
+        *response_out =
+            reinterpret_cast<FlutterPlatformMessageResponseHandle*>(
+                &fake_handle);
+        return kSuccess;
+      }));
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(platform_message_cb, nullptr);
+
+  // Message from the engine, responded to by the shell.
+  g_autoptr(GBytes) response = g_bytes_new("Polo!", 5);
+  g_autoptr(GBytes) received_message = nullptr;
+  typedef struct {
+    GBytes* response;
+    GBytes** received_message;
+  } HandlerData;
+  HandlerData handler_data = {response, &received_message};
+  fl_engine_set_platform_message_handler(
+      engine,
+      [](FlEngine* engine, const gchar* channel, guint32 channel_id,
+         GBytes* message,
+         const FlutterPlatformMessageResponseHandle* response_handle,
+         gpointer user_data) -> gboolean {
+        HandlerData* data = static_cast<HandlerData*>(user_data);
+        *data->received_message = g_bytes_ref(message);
+        EXPECT_TRUE(fl_engine_send_platform_message_response(
+            engine, response_handle, data->response, nullptr));
+        return TRUE;
+      },
+      &handler_data, nullptr);
+
+  FlutterPlatformMessage message = {};
+  message.struct_size = sizeof(FlutterPlatformMessage);
+  message.channel = "test";
+  message.message = kEngineMessage;
+  message.message_size = sizeof(kEngineMessage);
+  message.response_handle =
+      reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(
+          &fake_handle);
+  platform_message_cb(&message, platform_message_user_data);
+
+  ASSERT_NE(received_message, nullptr);
+  EXPECT_EQ(g_bytes_get_data(received_message, nullptr), kEngineMessage);
+  EXPECT_EQ(sent_response, g_bytes_get_data(response, nullptr));
+  EXPECT_TRUE(released.empty());
+  g_clear_pointer(&received_message, g_bytes_unref);
+  ASSERT_EQ(released.size(), 1u);
+  EXPECT_EQ(released[0],
+            reinterpret_cast<FlutterPlatformMessageData*>(&message_owner));
+  // The response is referenced rather than copied until the engine is done.
+  ASSERT_NE(release_response, nullptr);
+  release_response(release_response_user_data);
+
+  // Message from the shell, responded to by the engine.
+  g_autoptr(GBytes) outgoing = g_bytes_new("Marco!", 6);
+  fl_engine_send_platform_message(
+      engine, "test", outgoing, nullptr,
+      [](GObject* object, GAsyncResult* result, gpointer user_data) {
+        g_autoptr(GError) error = nullptr;
+        g_autoptr(GBytes) response = fl_engine_send_platform_message_finish(
+            FL_ENGINE(object), result, &error);
+        EXPECT_EQ(error, nullptr);
+        EXPECT_EQ(g_bytes_get_data(response, nullptr), kEngineResponse);
+        g_main_loop_quit(static_cast<GMainLoop*>(user_data));
+      },
+      loop);
+  // The message is referenced rather than copied until the engine is done.
+  EXPECT_EQ(sent_message, g_bytes_get_data(outgoing, nullptr));
+  ASSERT_NE(release_message, nullptr);
+  release_message(release_message_user_data);
+  ASSERT_NE(response_cb, nullptr);
+  response_cb(kEngineResponse, sizeof(kEngineResponse),
+              reinterpret_cast<FlutterPlatformMessageData*>(&response_owner),
+              response_user_data);
+  g_main_loop_run(loop);
+
+  ASSERT_EQ(released.size(), 2u);
+  EXPECT_EQ(released[1],
+            reinterpret_cast<FlutterPlatformMessageData*>(&response_owner));
+}
+
 void on_pre_engine_restart_cb(FlEngine* engine, gpointer user_data) {
   int* count = reinterpret_cast<int*>(user_data);
   *count += 1;
@@ -8,7 +8,7 @@
 
 #include <cstring>
 
-#include "rapidjson/reader.h"
+#include "flutter/fml/json_reader.h"
 #include "rapidjson/writer.h"
 
 G_DEFINE_QUARK(fl_json_message_codec_error_quark, fl_json_message_codec_error)
@@ -120,7 +120,7 @@ static gboolean write_value(rapidjson::Writer<rapidjson::StringBuffer>& writer,
   return TRUE;
 }
 
-// Handler to parse JSON using rapidjson in SAX mode.
+// Handler to build #FlValue objects from a parsed fml::JsonDocument.
 struct FlValueHandler {
   GPtrArray* stack;
   FlValue* key;
@@ -182,43 +182,27 @@ struct FlValueHandler {
     return true;
   }
 
-  // The following implements the rapidjson SAX API.
+  // The following implements the handler API of fml::JsonDocument::Accept.
 
   bool Null() { return add(fl_value_new_null()); }
 
   bool Bool(bool b) { return add(fl_value_new_bool(b)); }
 
-  bool Int(int i) { return add(fl_value_new_int(i)); }
-
-  bool Uint(unsigned i) { return add(fl_value_new_int(i)); }
-
   bool Int64(int64_t i) { return add(fl_value_new_int(i)); }
 
-  bool Uint64(uint64_t i) {
-    // For some reason (bug in rapidjson?) this is not returned in Int64.
-    if (i == G_MAXINT64) {
-      return add(fl_value_new_int(i));
-    } else {
-      return add(fl_value_new_float(i));
-    }
-  }
+  // Only called for integers that don't fit in an int64_t.
+  bool Uint64(uint64_t i) { return add(fl_value_new_float(i)); }
 
   bool Double(double d) { return add(fl_value_new_float(d)); }
 
-  bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
-    g_set_error(&error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "RawNumber not supported");
-    return false;
-  }
-
-  bool String(const char* str, rapidjson::SizeType length, bool copy) {
+  bool String(const char* str, uint32_t length, bool copy) {
     FlValue* v = fl_value_new_string_sized(str, length);
     return add(v);
   }
 
   bool StartObject() { return add(fl_value_new_map()); }
 
-  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+  bool Key(const char* str, uint32_t length, bool copy) {
     if (key != nullptr) {
       fl_value_unref(key);
     }
@@ -226,14 +210,14 @@ struct FlValueHandler {
     return true;
   }
 
-  bool EndObject(rapidjson::SizeType memberCount) {
+  bool EndObject(uint32_t memberCount) {
     pop();
     return true;
   }
 
   bool StartArray() { return add(fl_value_new_list()); }
 
-  bool EndArray(rapidjson::SizeType elementCount) {
+  bool EndArray(uint32_t elementCount) {
     pop();
     return true;
   }
@@ -261,25 +245,28 @@ static FlValue* fl_json_message_codec_decode_message(FlMessageCodec* codec,
   gsize data_length;
   const gchar* data =
       static_cast<const char*>(g_bytes_get_data(message, &data_length));
-  if (!g_utf8_validate(data, data_length, nullptr)) {
-    g_set_error(error, FL_JSON_MESSAGE_CODEC_ERROR,
-                FL_JSON_MESSAGE_CODEC_ERROR_INVALID_UTF8,
-                "Message is not valid UTF8");
-    return nullptr;
-  }
-
-  FlValueHandler handler;
-  rapidjson::Reader reader;
-  rapidjson::MemoryStream ss(data, data_length);
-  if (!reader.Parse(ss, handler)) {
-    if (handler.error != nullptr) {
-      g_propagate_error(error, handler.error);
-      handler.error = nullptr;
-    } else {
+  // The document checks the encoding and the syntax before any value is
+  // built, so nothing is allocated for a message that turns out to be invalid.
+  fml::JsonDocument document;
+  switch (document.Parse(data, data_length)) {
+    case fml::JsonParseStatus::kOk:
+      break;
+    case fml::JsonParseStatus::kInvalidUtf8:
+      g_set_error(error, FL_JSON_MESSAGE_CODEC_ERROR,
+                  FL_JSON_MESSAGE_CODEC_ERROR_INVALID_UTF8,
+                  "Message is not valid UTF8");
+      return nullptr;
+    case fml::JsonParseStatus::kInvalidJson:
       g_set_error(error, FL_JSON_MESSAGE_CODEC_ERROR,
                   FL_JSON_MESSAGE_CODEC_ERROR_INVALID_JSON,
                   "Message is not valid JSON");
-    }
+      return nullptr;
+  }
+
+  FlValueHandler handler;
+  if (!document.Accept(handler)) {
+    g_propagate_error(error, handler.error);
+    handler.error = nullptr;
     return nullptr;
   }
 
@@ -149,6 +149,13 @@ TEST(FlJsonMessageCodecTest, DecodeIntMax) {
   EXPECT_EQ(fl_value_get_int(value), G_MAXINT64);
 }
 
+TEST(FlJsonMessageCodecTest, DecodeIntLarge) {
+  // This doesn't fit in 32 bits, but is still an integer.
+  g_autoptr(FlValue) value = decode_message("5000000000");
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_INT);
+  EXPECT_EQ(fl_value_get_int(value), 5000000000);
+}
+
 TEST(FlJsonMessageCodecTest, DecodeUintMax) {
   // This is bigger than an signed 64 bit integer, so we expect it to be
   // represented as a double.
@@ -8,146 +8,96 @@
 
 #include <cstring>
 
+#include "flutter/shell/platform/common/client_wrapper/standard_codec_core.h"
+
 // See lib/src/services/message_codecs.dart in Flutter source for description of
 // encoding.
 
-// Type values.
-static constexpr int kValueNull = 0;
-static constexpr int kValueTrue = 1;
-static constexpr int kValueFalse = 2;
-static constexpr int kValueInt32 = 3;
-static constexpr int kValueInt64 = 4;
-static constexpr int kValueFloat64 = 6;
-static constexpr int kValueString = 7;
-static constexpr int kValueUint8List = 8;
-static constexpr int kValueInt32List = 9;
-static constexpr int kValueInt64List = 10;
-static constexpr int kValueFloat64List = 11;
-static constexpr int kValueList = 12;
-static constexpr int kValueMap = 13;
-static constexpr int kValueFloat32List = 14;
+using flutter::StandardCodecType;
 
 G_DEFINE_TYPE(FlStandardMessageCodec,
               fl_standard_message_codec,
               fl_message_codec_get_type())
 
-// Functions to write standard C number types.
-
-static void write_uint8(GByteArray* buffer, uint8_t value) {
-  g_byte_array_append(buffer, &value, sizeof(uint8_t));
-}
-
-static void write_uint16(GByteArray* buffer, uint16_t value) {
-  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
-                      sizeof(uint16_t));
-}
-
-static void write_uint32(GByteArray* buffer, uint32_t value) {
-  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
-                      sizeof(uint32_t));
-}
+namespace {
 
-static void write_int32(GByteArray* buffer, int32_t value) {
-  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
-                      sizeof(int32_t));
-}
+// Adapts a GByteArray for use with flutter::StandardCodecWriter.
+class ByteArrayBuffer {
+ public:
+  explicit ByteArrayBuffer(GByteArray* buffer) : buffer_(buffer) {}
 
-static void write_int64(GByteArray* buffer, int64_t value) {
-  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
-                      sizeof(int64_t));
-}
+  size_t size() const { return buffer_->len; }
 
-static void write_float64(GByteArray* buffer, double value) {
-  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
-                      sizeof(double));
-}
+  void AppendByte(uint8_t byte) { g_byte_array_append(buffer_, &byte, 1); }
 
-// Write padding bytes to align to @align multiple of bytes.
-static void write_align(GByteArray* buffer, guint align) {
-  while (buffer->len % align != 0) {
-    write_uint8(buffer, 0);
+  void Append(const uint8_t* bytes, size_t length) {
+    g_byte_array_append(buffer_, bytes, length);
   }
-}
 
-// Checks there is enough data in @buffer to be read.
-static gboolean check_size(GBytes* buffer,
-                           size_t offset,
-                           size_t required,
-                           GError** error) {
-  if (offset + required > g_bytes_get_size(buffer)) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR,
-                FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
-    return FALSE;
-  }
-  return TRUE;
-}
+ private:
+  GByteArray* buffer_;
+};
 
-// Skip bytes to align next read on @align multiple of bytes.
-static gboolean read_align(GBytes* buffer,
-                           size_t* offset,
-                           size_t align,
-                           GError** error) {
-  if ((*offset) % align == 0) {
-    return TRUE;
-  }
+using Writer = flutter::StandardCodecWriter<ByteArrayBuffer>;
 
-  size_t required = align - (*offset) % align;
-  if (!check_size(buffer, *offset, required, error)) {
-    return FALSE;
-  }
+}  // namespace
 
-  (*offset) += required;
-  return TRUE;
+// Gets a reader for @buffer positioned at @offset.
+static flutter::StandardCodecReader get_reader(GBytes* buffer, size_t offset) {
+  size_t size;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(buffer, &size));
+  return flutter::StandardCodecReader(data, size, offset);
 }
 
-// Gets a pointer to the given offset in @buffer.
-static const uint8_t* get_data(GBytes* buffer, size_t* offset) {
-  return static_cast<const uint8_t*>(g_bytes_get_data(buffer, nullptr)) +
-         *offset;
+// Sets the error for reading past the end of the data.
+static void set_out_of_data_error(GError** error) {
+  g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA,
+              "Unexpected end of data");
 }
 
-// Reads an unsigned 8 bit number from @buffer and writes it to @value.
-// Returns TRUE if successful, otherwise sets an error.
-static gboolean read_uint8(GBytes* buffer,
-                           size_t* offset,
-                           uint8_t* value,
-                           GError** error) {
-  if (!check_size(buffer, *offset, sizeof(uint8_t), error)) {
-    return FALSE;
-  }
-
-  *value = get_data(buffer, offset)[0];
-  (*offset)++;
-  return TRUE;
+// Writes the type, size, padding and elements of a typed list.
+template <typename T>
+static void write_list(GByteArray* buffer,
+                       StandardCodecType type,
+                       const T* elements,
+                       size_t length) {
+  ByteArrayBuffer adapter(buffer);
+  Writer writer(&adapter);
+  writer.WriteType(type);
+  writer.WriteList(elements, length);
 }
 
-// Reads an unsigned 16 bit integer from @buffer and writes it to @value.
+// Reads a scalar of type T from @buffer and writes it to @value.
 // Returns TRUE if successful, otherwise sets an error.
-static gboolean read_uint16(GBytes* buffer,
+template <typename T>
+static gboolean read_scalar(GBytes* buffer,
                             size_t* offset,
-                            uint16_t* value,
+                            T* value,
                             GError** error) {
-  if (!check_size(buffer, *offset, sizeof(uint16_t), error)) {
+  flutter::StandardCodecReader reader = get_reader(buffer, *offset);
+  if (!reader.ReadScalar(value)) {
+    set_out_of_data_error(error);
     return FALSE;
   }
-
-  *value = reinterpret_cast<const uint16_t*>(get_data(buffer, offset))[0];
-  *offset += sizeof(uint16_t);
+  *offset = reader.offset();
   return TRUE;
 }
 
-// Reads an unsigned 32 bit integer from @buffer and writes it to @value.
+// Reads the size, padding and elements of a list of T from @buffer.
 // Returns TRUE if successful, otherwise sets an error.
-static gboolean read_uint32(GBytes* buffer,
-                            size_t* offset,
-                            uint32_t* value,
-                            GError** error) {
-  if (!check_size(buffer, *offset, sizeof(uint32_t), error)) {
+template <typename T>
+static gboolean read_list(GBytes* buffer,
+                          size_t* offset,
+                          uint32_t* length,
+                          const uint8_t** elements,
+                          GError** error) {
+  flutter::StandardCodecReader reader = get_reader(buffer, *offset);
+  if (!reader.ReadList<T>(length, elements)) {
+    set_out_of_data_error(error);
     return FALSE;
   }
-
-  *value = reinterpret_cast<const uint32_t*>(get_data(buffer, offset))[0];
-  *offset += sizeof(uint32_t);
+  *offset = reader.offset();
   return TRUE;
 }
 
@@ -157,14 +107,11 @@ static gboolean read_uint32(GBytes* buffer,
 static FlValue* read_int32_value(GBytes* buffer,
                                  size_t* offset,
                                  GError** error) {
-  if (!check_size(buffer, *offset, sizeof(int32_t), error)) {
+  int32_t value;
+  if (!read_scalar(buffer, offset, &value, error)) {
     return nullptr;
   }
-
-  FlValue* value = fl_value_new_int(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset))[0]);
-  *offset += sizeof(int32_t);
-  return value;
+  return fl_value_new_int(value);
 }
 
 // Reads a #FL_VALUE_TYPE_INT stored as a signed 64 bit integer from @buffer.
@@ -173,14 +120,11 @@ static FlValue* read_int32_value(GBytes* buffer,
 static FlValue* read_int64_value(GBytes* buffer,
                                  size_t* offset,
                                  GError** error) {
-  if (!check_size(buffer, *offset, sizeof(int64_t), error)) {
+  int64_t value;
+  if (!read_scalar(buffer, offset, &value, error)) {
     return nullptr;
   }
-
-  FlValue* value = fl_value_new_int(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset))[0]);
-  *offset += sizeof(int64_t);
-  return value;
+  return fl_value_new_int(value);
 }
 
 // Reads a 64 bit floating point number from @buffer and writes it to @value.
@@ -189,154 +133,103 @@ static FlValue* read_int64_value(GBytes* buffer,
 static FlValue* read_float64_value(GBytes* buffer,
                                    size_t* offset,
                                    GError** error) {
-  if (!read_align(buffer, offset, 8, error)) {
+  flutter::StandardCodecReader reader = get_reader(buffer, *offset);
+  double value;
+  if (!reader.ReadAlignment(alignof(double)) || !reader.ReadScalar(&value)) {
+    set_out_of_data_error(error);
     return nullptr;
   }
-  if (!check_size(buffer, *offset, sizeof(double), error)) {
-    return nullptr;
-  }
-
-  FlValue* value = fl_value_new_float(
-      reinterpret_cast<const double*>(get_data(buffer, offset))[0]);
-  *offset += sizeof(double);
-  return value;
+  *offset = reader.offset();
+  return fl_value_new_float(value);
 }
 
 // Reads an UTF-8 text string from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_STRING if successful or %NULL
 // on error.
-static FlValue* read_string_value(FlStandardMessageCodec* self,
-                                  GBytes* buffer,
+static FlValue* read_string_value(GBytes* buffer,
                                   size_t* offset,
                                   GError** error) {
   uint32_t length;
-  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
-                                           error)) {
-    return nullptr;
-  }
-  if (!check_size(buffer, *offset, length, error)) {
+  const uint8_t* text;
+  if (!read_list<uint8_t>(buffer, offset, &length, &text, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_string_sized(
-      reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
-  *offset += length;
-  return value;
+  return fl_value_new_string_sized(reinterpret_cast<const gchar*>(text),
+                                   length);
 }
 
 // Reads an unsigned 8 bit list from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_UINT8_LIST if successful or
 // %NULL on error.
-static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
-                                      GBytes* buffer,
+static FlValue* read_uint8_list_value(GBytes* buffer,
                                       size_t* offset,
                                       GError** error) {
   uint32_t length;
-  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
-                                           error)) {
+  const uint8_t* elements;
+  if (!read_list<uint8_t>(buffer, offset, &length, &elements, error)) {
     return nullptr;
   }
-  if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
-    return nullptr;
-  }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
-  *offset += length;
-  return value;
+  return fl_value_new_uint8_list(elements, length);
 }
 
 // Reads a signed 32 bit list from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_INT32_LIST if successful or
 // %NULL on error.
-static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
-                                      GBytes* buffer,
+static FlValue* read_int32_list_value(GBytes* buffer,
                                       size_t* offset,
                                       GError** error) {
   uint32_t length;
-  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
-                                           error)) {
+  const uint8_t* elements;
+  if (!read_list<int32_t>(buffer, offset, &length, &elements, error)) {
     return nullptr;
   }
-  if (!read_align(buffer, offset, 4, error)) {
-    return nullptr;
-  }
-  if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
-    return nullptr;
-  }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
-  *offset += sizeof(int32_t) * length;
-  return value;
+  return fl_value_new_int32_list(reinterpret_cast<const int32_t*>(elements),
+                                 length);
 }
 
 // Reads a signed 64 bit list from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_INT64_LIST if successful or
 // %NULL on error.
-static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
-                                      GBytes* buffer,
+static FlValue* read_int64_list_value(GBytes* buffer,
                                       size_t* offset,
                                       GError** error) {
   uint32_t length;
-  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
-                                           error)) {
-    return nullptr;
-  }
-  if (!read_align(buffer, offset, 8, error)) {
-    return nullptr;
-  }
-  if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
+  const uint8_t* elements;
+  if (!read_list<int64_t>(buffer, offset, &length, &elements, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
-  *offset += sizeof(int64_t) * length;
-  return value;
+  return fl_value_new_int64_list(reinterpret_cast<const int64_t*>(elements),
+                                 length);
 }
 
 // Reads a 32 bit floating point number list from @buffer in standard codec
 // format. Returns a new #FlValue of type #FL_VALUE_TYPE_FLOAT32_LIST if
 // successful or %NULL on error.
-static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
-                                        GBytes* buffer,
+static FlValue* read_float32_list_value(GBytes* buffer,
                                         size_t* offset,
                                         GError** error) {
   uint32_t length;
-  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
-                                           error)) {
+  const uint8_t* elements;
+  if (!read_list<float>(buffer, offset, &length, &elements, error)) {
     return nullptr;
   }
-  if (!read_align(buffer, offset, 4, error)) {
-    return nullptr;
-  }
-  if (!check_size(buffer, *offset, sizeof(float) * length, error)) {
-    return nullptr;
-  }
-  FlValue* value = fl_value_new_float32_list(
-      reinterpret_cast<const float*>(get_data(buffer, offset)), length);
-  *offset += sizeof(float) * length;
-  return value;
+  return fl_value_new_float32_list(reinterpret_cast<const float*>(elements),
+                                   length);
 }
 
 // Reads a floating point number list from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_FLOAT_LIST if successful or
 // %NULL on error.
-static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
-                                        GBytes* buffer,
+static FlValue* read_float64_list_value(GBytes* buffer,
                                         size_t* offset,
                                         GError** error) {
   uint32_t length;
-  if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
-                                           error)) {
+  const uint8_t* elements;
+  if (!read_list<double>(buffer, offset, &length, &elements, error)) {
     return nullptr;
   }
-  if (!read_align(buffer, offset, 8, error)) {
-    return nullptr;
-  }
-  if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
-    return nullptr;
-  }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
-  *offset += sizeof(double) * length;
-  return value;
+  return fl_value_new_float_list(reinterpret_cast<const double*>(elements),
+                                 length);
 }
 
 // Reads a list from @buffer in standard codec format.
@@ -446,101 +339,70 @@ static gboolean fl_standard_message_codec_real_write_value(
     GByteArray* buffer,
     FlValue* value,
     GError** error) {
+  ByteArrayBuffer adapter(buffer);
+  Writer writer(&adapter);
   if (value == nullptr) {
-    write_uint8(buffer, kValueNull);
+    writer.WriteType(StandardCodecType::kNull);
     return TRUE;
   }
 
   switch (fl_value_get_type(value)) {
     case FL_VALUE_TYPE_NULL:
-      write_uint8(buffer, kValueNull);
+      writer.WriteType(StandardCodecType::kNull);
       return TRUE;
     case FL_VALUE_TYPE_BOOL:
       if (fl_value_get_bool(value)) {
-        write_uint8(buffer, kValueTrue);
+        writer.WriteType(StandardCodecType::kTrue);
       } else {
-        write_uint8(buffer, kValueFalse);
+        writer.WriteType(StandardCodecType::kFalse);
       }
       return TRUE;
     case FL_VALUE_TYPE_INT: {
       int64_t v = fl_value_get_int(value);
       if (v >= INT32_MIN && v <= INT32_MAX) {
-        write_uint8(buffer, kValueInt32);
-        write_int32(buffer, v);
+        writer.WriteType(StandardCodecType::kInt32);
+        writer.WriteScalar(static_cast<int32_t>(v));
       } else {
-        write_uint8(buffer, kValueInt64);
-        write_int64(buffer, v);
+        writer.WriteType(StandardCodecType::kInt64);
+        writer.WriteScalar(v);
       }
       return TRUE;
     }
     case FL_VALUE_TYPE_FLOAT:
-      write_uint8(buffer, kValueFloat64);
-      write_align(buffer, 8);
-      write_float64(buffer, fl_value_get_float(value));
+      writer.WriteType(StandardCodecType::kFloat64);
+      writer.WriteAlignment(alignof(double));
+      writer.WriteScalar(fl_value_get_float(value));
       return TRUE;
     case FL_VALUE_TYPE_STRING: {
-      write_uint8(buffer, kValueString);
+      writer.WriteType(StandardCodecType::kString);
       const char* text = fl_value_get_string(value);
       size_t length = strlen(text);
       fl_standard_message_codec_write_size(self, buffer, length);
-      g_byte_array_append(buffer, reinterpret_cast<const uint8_t*>(text),
-                          length);
+      writer.WriteBytes(text, length);
       return TRUE;
     }
-    case FL_VALUE_TYPE_UINT8_LIST: {
-      write_uint8(buffer, kValueUint8List);
-      size_t length = fl_value_get_length(value);
-      fl_standard_message_codec_write_size(self, buffer, length);
-      g_byte_array_append(buffer, fl_value_get_uint8_list(value),
-                          sizeof(uint8_t) * length);
+    case FL_VALUE_TYPE_UINT8_LIST:
+      write_list(buffer, StandardCodecType::kUInt8List,
+                 fl_value_get_uint8_list(value), fl_value_get_length(value));
       return TRUE;
-    }
-    case FL_VALUE_TYPE_INT32_LIST: {
-      write_uint8(buffer, kValueInt32List);
-      size_t length = fl_value_get_length(value);
-      fl_standard_message_codec_write_size(self, buffer, length);
-      write_align(buffer, 4);
-      g_byte_array_append(
-          buffer,
-          reinterpret_cast<const uint8_t*>(fl_value_get_int32_list(value)),
-          sizeof(int32_t) * length);
+    case FL_VALUE_TYPE_INT32_LIST:
+      write_list(buffer, StandardCodecType::kInt32List,
+                 fl_value_get_int32_list(value), fl_value_get_length(value));
       return TRUE;
-    }
-    case FL_VALUE_TYPE_INT64_LIST: {
-      write_uint8(buffer, kValueInt64List);
-      size_t length = fl_value_get_length(value);
-      fl_standard_message_codec_write_size(self, buffer, length);
-      write_align(buffer, 8);
-      g_byte_array_append(
-          buffer,
-          reinterpret_cast<const uint8_t*>(fl_value_get_int64_list(value)),
-          sizeof(int64_t) * length);
+    case FL_VALUE_TYPE_INT64_LIST:
+      write_list(buffer, StandardCodecType::kInt64List,
+                 fl_value_get_int64_list(value), fl_value_get_length(value));
       return TRUE;
-    }
-    case FL_VALUE_TYPE_FLOAT32_LIST: {
-      write_uint8(buffer, kValueFloat32List);
-      size_t length = fl_value_get_length(value);
-      fl_standard_message_codec_write_size(self, buffer, length);
-      write_align(buffer, 4);
-      g_byte_array_append(
-          buffer,
-          reinterpret_cast<const uint8_t*>(fl_value_get_float32_list(value)),
-          sizeof(float) * length);
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      write_list(buffer, StandardCodecType::kFloat32List,
+                 fl_value_get_float32_list(value), fl_value_get_length(value));
       return TRUE;
-    }
-    case FL_VALUE_TYPE_FLOAT_LIST: {
-      write_uint8(buffer, kValueFloat64List);
-      size_t length = fl_value_get_length(value);
-      fl_standard_message_codec_write_size(self, buffer, length);
-      write_align(buffer, 8);
-      g_byte_array_append(
-          buffer,
-          reinterpret_cast<const uint8_t*>(fl_value_get_float_list(value)),
-          sizeof(double) * length);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      write_list(buffer, StandardCodecType::kFloat64List,
+                 fl_value_get_float_list(value), fl_value_get_length(value));
       return TRUE;
-    }
     case FL_VALUE_TYPE_LIST:
-      write_uint8(buffer, kValueList);
+      writer.WriteType(StandardCodecType::kList);
       fl_standard_message_codec_write_size(self, buffer,
                                            fl_value_get_length(value));
       for (size_t i = 0; i < fl_value_get_length(value); i++) {
@@ -551,7 +413,7 @@ static gboolean fl_standard_message_codec_real_write_value(
       }
       return TRUE;
     case FL_VALUE_TYPE_MAP:
-      write_uint8(buffer, kValueMap);
+      writer.WriteType(StandardCodecType::kMap);
       fl_standard_message_codec_write_size(self, buffer,
                                            fl_value_get_length(value));
       for (size_t i = 0; i < fl_value_get_length(value); i++) {
@@ -584,39 +446,51 @@ static FlValue* fl_standard_message_codec_read_value_of_type(
     int type,
     GError** error) {
   g_autoptr(FlValue) value = nullptr;
-  if (type == kValueNull) {
-    return fl_value_new_null();
-  } else if (type == kValueTrue) {
-    return fl_value_new_bool(TRUE);
-  } else if (type == kValueFalse) {
-    return fl_value_new_bool(FALSE);
-  } else if (type == kValueInt32) {
-    value = read_int32_value(buffer, offset, error);
-  } else if (type == kValueInt64) {
-    value = read_int64_value(buffer, offset, error);
-  } else if (type == kValueFloat64) {
-    value = read_float64_value(buffer, offset, error);
-  } else if (type == kValueString) {
-    value = read_string_value(self, buffer, offset, error);
-  } else if (type == kValueUint8List) {
-    value = read_uint8_list_value(self, buffer, offset, error);
-  } else if (type == kValueInt32List) {
-    value = read_int32_list_value(self, buffer, offset, error);
-  } else if (type == kValueInt64List) {
-    value = read_int64_list_value(self, buffer, offset, error);
-  } else if (type == kValueFloat32List) {
-    value = read_float32_list_value(self, buffer, offset, error);
-  } else if (type == kValueFloat64List) {
-    value = read_float64_list_value(self, buffer, offset, error);
-  } else if (type == kValueList) {
-    value = read_list_value(self, buffer, offset, error);
-  } else if (type == kValueMap) {
-    value = read_map_value(self, buffer, offset, error);
-  } else {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR,
-                FL_MESSAGE_CODEC_ERROR_UNSUPPORTED_TYPE,
-                "Unexpected standard codec type %02x", type);
-    return nullptr;
+  switch (static_cast<StandardCodecType>(type)) {
+    case StandardCodecType::kNull:
+      return fl_value_new_null();
+    case StandardCodecType::kTrue:
+      return fl_value_new_bool(TRUE);
+    case StandardCodecType::kFalse:
+      return fl_value_new_bool(FALSE);
+    case StandardCodecType::kInt32:
+      value = read_int32_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kInt64:
+      value = read_int64_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kFloat64:
+      value = read_float64_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kString:
+      value = read_string_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kUInt8List:
+      value = read_uint8_list_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kInt32List:
+      value = read_int32_list_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kInt64List:
+      value = read_int64_list_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kFloat32List:
+      value = read_float32_list_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kFloat64List:
+      value = read_float64_list_value(buffer, offset, error);
+      break;
+    case StandardCodecType::kList:
+      value = read_list_value(self, buffer, offset, error);
+      break;
+    case StandardCodecType::kMap:
+      value = read_map_value(self, buffer, offset, error);
+      break;
+    default:
+      g_set_error(error, FL_MESSAGE_CODEC_ERROR,
+                  FL_MESSAGE_CODEC_ERROR_UNSUPPORTED_TYPE,
+                  "Unexpected standard codec type %02x", type);
+      return nullptr;
   }
 
   return value == nullptr ? nullptr : fl_value_ref(value);
@@ -643,15 +517,8 @@ G_MODULE_EXPORT void fl_standard_message_codec_write_size(
     FlStandardMessageCodec* codec,
     GByteArray* buffer,
     uint32_t size) {
-  if (size < 254) {
-    write_uint8(buffer, size);
-  } else if (size <= 0xffff) {
-    write_uint8(buffer, 254);
-    write_uint16(buffer, size);
-  } else {
-    write_uint8(buffer, 255);
-    write_uint32(buffer, size);
-  }
+  ByteArrayBuffer adapter(buffer);
+  Writer(&adapter).WriteSize(size);
 }
 
 G_MODULE_EXPORT gboolean
@@ -660,25 +527,12 @@ fl_standard_message_codec_read_size(FlStandardMessageCodec* codec,
                                     size_t* offset,
                                     uint32_t* value,
                                     GError** error) {
-  uint8_t value8;
-  if (!read_uint8(buffer, offset, &value8, error)) {
+  flutter::StandardCodecReader reader = get_reader(buffer, *offset);
+  if (!reader.ReadSize(value)) {
+    set_out_of_data_error(error);
     return FALSE;
   }
-
-  if (value8 == 255) {
-    if (!read_uint32(buffer, offset, value, error)) {
-      return FALSE;
-    }
-  } else if (value8 == 254) {
-    uint16_t value16;
-    if (!read_uint16(buffer, offset, &value16, error)) {
-      return FALSE;
-    }
-    *value = value16;
-  } else {
-    *value = value8;
-  }
-
+  *offset = reader.offset();
   return TRUE;
 }
 
@@ -697,7 +551,7 @@ G_MODULE_EXPORT FlValue* fl_standard_message_codec_read_value(
     size_t* offset,
     GError** error) {
   uint8_t type;
-  if (!read_uint8(buffer, offset, &type, error)) {
+  if (!read_scalar(buffer, offset, &type, error)) {
     return nullptr;
   }
 
@@ -72,6 +72,15 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessageWithRelease(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  release_callback(release_user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -94,6 +103,37 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterPlatformMessageAcquireData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    FlutterPlatformMessageData** data_out) {
+  return kInvalidArguments;
+}
+
+FlutterEngineResult FlutterPlatformMessageReleaseData(
+    FlutterPlatformMessageData* data) {
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterPlatformMessageCreateResponseHandleWithOwnedData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterOwnedDataCallback data_callback,
+    void* user_data,
+    FlutterPlatformMessageResponseHandle** response_out) {
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseWithRelease(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  release_callback(release_user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task) {
@@ -136,6 +176,14 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
       &FlutterPlatformMessageReleaseResponseHandle;
   table->SendPlatformMessageResponse =
       &FlutterEngineSendPlatformMessageResponse;
+  table->PlatformMessageAcquireData = &FlutterPlatformMessageAcquireData;
+  table->PlatformMessageReleaseData = &FlutterPlatformMessageReleaseData;
+  table->PlatformMessageCreateResponseHandleWithOwnedData =
+      &FlutterPlatformMessageCreateResponseHandleWithOwnedData;
+  table->SendPlatformMessageResponseWithRelease =
+      &FlutterEngineSendPlatformMessageResponseWithRelease;
+  table->SendPlatformMessageWithRelease =
+      &FlutterEngineSendPlatformMessageWithRelease;
   table->RunTask = &FlutterEngineRunTask;
   table->UpdateLocales = &FlutterEngineUpdateLocales;
   table->RunsAOTCompiledDartCode = &FlutterEngineRunsAOTCompiledDartCode;
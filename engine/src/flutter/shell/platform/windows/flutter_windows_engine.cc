@@ -32,6 +32,8 @@ static FlutterDesktopMessage ConvertToDesktopMessage(
   message.message = engine_message.message;
   message.message_size = engine_message.message_size;
   message.response_handle = engine_message.response_handle;
+  const FlutterPlatformMessage* engine_message_pointer = &engine_message;
+  message.channel_id = SAFE_ACCESS(engine_message_pointer, channel_id, 0);
   return message;
 }
 
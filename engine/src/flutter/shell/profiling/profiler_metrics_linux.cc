@@ -0,0 +1,275 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/profiling/profiler_metrics_linux.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+
+#include "flutter/fml/eintr_wrapper.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr double kKilobytesPerMegabyte = 1024.0;
+
+bool ParseUnsigned(std::string_view token, uint64_t* value) {
+  auto result =
+      std::from_chars(token.data(), token.data() + token.size(), *value);
+  return result.ec == std::errc();
+}
+
+// Invokes `callback` with the key and the value of each "Key:   value kB" line
+// of a procfs file such as `/proc/self/status` or `/proc/self/smaps_rollup`.
+// Lines without a numeric value are skipped.
+template <typename Callback>
+void ForEachField(std::string_view contents, const Callback& callback) {
+  while (!contents.empty()) {
+    size_t line_end = contents.find('\n');
+    std::string_view line = contents.substr(0, line_end);
+    contents = line_end == std::string_view::npos
+                   ? std::string_view()
+                   : contents.substr(line_end + 1);
+
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    std::string_view value = line.substr(colon + 1);
+    size_t value_start = value.find_first_not_of(" \t");
+    if (value_start == std::string_view::npos) {
+      continue;
+    }
+    value = value.substr(value_start);
+    value = value.substr(0, value.find(' '));
+    uint64_t number = 0;
+    if (ParseUnsigned(value, &number)) {
+      callback(line.substr(0, colon), number);
+    }
+  }
+}
+
+double ToMegabytes(uint64_t kilobytes) {
+  return kilobytes / kKilobytesPerMegabyte;
+}
+
+}  // namespace
+
+ProfilerMetricsLinux::ProfilerMetricsLinux()
+    : ticks_per_second_(std::max(1L, sysconf(_SC_CLK_TCK))),
+      num_cpus_(std::max(1L, sysconf(_SC_NPROCESSORS_ONLN))),
+      stat_fd_(fml::OpenFile("/proc/self/stat",
+                             false,
+                             fml::FilePermission::kRead)),
+      smaps_rollup_fd_(fml::OpenFile("/proc/self/smaps_rollup",
+                                     false,
+                                     fml::FilePermission::kRead)) {
+  if (!smaps_rollup_fd_.is_valid()) {
+    status_fd_ = fml::OpenFile("/proc/self/status", false,
+                               fml::FilePermission::kRead);
+  }
+  threads_.reserve(ProfileSample::kMaxThreadCpuUsage);
+}
+
+ProfilerMetricsLinux::~ProfilerMetricsLinux() = default;
+
+void ProfilerMetricsLinux::AddCurrentThread(std::string label) {
+  const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+  fml::UniqueFD fd = fml::OpenFile(path, false, fml::FilePermission::kRead);
+  if (!fd.is_valid()) {
+    FML_DLOG(ERROR) << "Could not open " << path;
+    return;
+  }
+
+  std::scoped_lock lock(threads_mutex_);
+  if (threads_.size() >= ProfileSample::kMaxThreadCpuUsage) {
+    FML_DLOG(ERROR) << "Too many threads to profile, ignoring " << label;
+    return;
+  }
+  threads_.push_back({std::move(label), std::move(fd)});
+}
+
+ProfileSample ProfilerMetricsLinux::GenerateSample() {
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const double elapsed_seconds =
+      has_last_sample_ ? (now - last_sample_time_).ToSecondsF() : 0.0;
+
+  ProfileSample sample;
+  sample.cpu_usage = CpuUsage(elapsed_seconds);
+  sample.memory_usage = MemoryUsage();
+  ThreadCpuUsage(elapsed_seconds, &sample);
+
+  last_sample_time_ = now;
+  has_last_sample_ = true;
+  return sample;
+}
+
+std::string_view ProfilerMetricsLinux::Read(const fml::UniqueFD& fd) {
+  if (!fd.is_valid()) {
+    return {};
+  }
+  // procfs regenerates the contents of the file when it is read from offset
+  // zero, so the descriptors are kept open across samples.
+  ssize_t size = FML_HANDLE_EINTR(
+      ::pread(fd.get(), buffer_, sizeof(buffer_) - 1, /*offset=*/0));
+  if (size <= 0) {
+    return {};
+  }
+  return std::string_view(buffer_, size);
+}
+
+std::optional<CpuUsageInfo> ProfilerMetricsLinux::CpuUsage(
+    double elapsed_seconds) {
+  StatInfo stat;
+  if (!ParseStat(Read(stat_fd_), &stat)) {
+    return std::nullopt;
+  }
+
+  const bool has_interval = has_last_sample_ && elapsed_seconds > 0.0;
+  const uint64_t ticks = stat.cpu_ticks - last_cpu_ticks_;
+  last_cpu_ticks_ = stat.cpu_ticks;
+  if (!has_interval) {
+    return std::nullopt;
+  }
+
+  const double usage =
+      ticks / ticks_per_second_ / elapsed_seconds / num_cpus_ * 100.0;
+  return CpuUsageInfo{
+      .num_threads = stat.num_threads,
+      .total_cpu_usage = std::clamp(usage, 0.0, 100.0),
+  };
+}
+
+std::optional<MemoryUsageInfo> ProfilerMetricsLinux::MemoryUsage() {
+  MemoryInfo memory;
+  bool parsed = smaps_rollup_fd_.is_valid()
+                    ? ParseSmapsRollup(Read(smaps_rollup_fd_), &memory)
+                    : ParseStatus(Read(status_fd_), &memory);
+  if (!parsed) {
+    return std::nullopt;
+  }
+
+  const uint64_t dirty_kb = std::min(memory.dirty_kb, memory.rss_kb);
+  return MemoryUsageInfo{
+      .dirty_memory_usage = ToMegabytes(dirty_kb),
+      .owned_shared_memory_usage = ToMegabytes(memory.rss_kb - dirty_kb),
+  };
+}
+
+void ProfilerMetricsLinux::ThreadCpuUsage(double elapsed_seconds,
+                                          ProfileSample* sample) {
+  std::scoped_lock lock(threads_mutex_);
+  for (ThreadEntry& thread : threads_) {
+    StatInfo stat;
+    if (!ParseStat(Read(thread.stat_fd), &stat)) {
+      // The thread has exited.
+      thread.stat_fd.reset();
+      continue;
+    }
+
+    const uint64_t ticks = stat.cpu_ticks - thread.last_cpu_ticks;
+    const bool has_interval =
+        thread.has_last_cpu_ticks && has_last_sample_ && elapsed_seconds > 0.0;
+    thread.last_cpu_ticks = stat.cpu_ticks;
+    thread.has_last_cpu_ticks = true;
+    if (!has_interval) {
+      continue;
+    }
+
+    const double usage = ticks / ticks_per_second_ / elapsed_seconds * 100.0;
+    sample->thread_cpu_usage[sample->thread_cpu_usage_count++] = {
+        .thread_label = thread.label.c_str(),
+        .cpu_usage = std::clamp(usage, 0.0, 100.0),
+    };
+  }
+}
+
+bool ProfilerMetricsLinux::ParseStat(std::string_view contents,
+                                     StatInfo* info) {
+  // The second field is the executable name in parentheses, which may itself
+  // contain spaces and parentheses. Count fields from the last ')' instead.
+  size_t name_end = contents.rfind(')');
+  if (name_end == std::string_view::npos) {
+    return false;
+  }
+  contents = contents.substr(name_end + 1);
+
+  // Fields as documented in proc(5), numbered from 1.
+  constexpr int kUserTimeField = 14;
+  constexpr int kSystemTimeField = 15;
+  constexpr int kNumThreadsField = 20;
+  uint64_t user_time = 0;
+  uint64_t system_time = 0;
+  uint64_t num_threads = 0;
+  int field = 2;
+  while (field < kNumThreadsField) {
+    size_t start = contents.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+      return false;
+    }
+    contents = contents.substr(start);
+    std::string_view token = contents.substr(0, contents.find(' '));
+    contents = contents.substr(token.size());
+    field++;
+
+    uint64_t* value = nullptr;
+    switch (field) {
+      case kUserTimeField:
+        value = &user_time;
+        break;
+      case kSystemTimeField:
+        value = &system_time;
+        break;
+      case kNumThreadsField:
+        value = &num_threads;
+        break;
+    }
+    if (value && !ParseUnsigned(token, value)) {
+      return false;
+    }
+  }
+
+  info->cpu_ticks = user_time + system_time;
+  info->num_threads = static_cast<uint32_t>(num_threads);
+  return true;
+}
+
+bool ProfilerMetricsLinux::ParseSmapsRollup(std::string_view contents,
+                                            MemoryInfo* info) {
+  bool has_rss = false;
+  ForEachField(contents, [&](std::string_view key, uint64_t value) {
+    if (key == "Rss") {
+      info->rss_kb = value;
+      has_rss = true;
+    } else if (key == "Private_Dirty") {
+      info->dirty_kb = value;
+    }
+  });
+  return has_rss;
+}
+
+bool ProfilerMetricsLinux::ParseStatus(std::string_view contents,
+                                       MemoryInfo* info) {
+  bool has_rss = false;
+  ForEachField(contents, [&](std::string_view key, uint64_t value) {
+    if (key == "VmRSS") {
+      info->rss_kb = value;
+      has_rss = true;
+    } else if (key == "RssAnon") {
+      info->dirty_kb = value;
+    }
+  });
+  return has_rss;
+}
+
+}  // namespace flutter
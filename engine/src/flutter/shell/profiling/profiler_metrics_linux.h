@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PROFILING_PROFILER_METRICS_LINUX_H_
+#define FLUTTER_SHELL_PROFILING_PROFILER_METRICS_LINUX_H_
+
+#include <sys/types.h>
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_fd.h"
+#include "flutter/shell/profiling/sampling_profiler.h"
+
+namespace flutter {
+
+/**
+ * @brief Gathers the profiling metrics used by `flutter::SamplingProfiler`
+ * from procfs.
+ *
+ * Process wide CPU usage is read from `/proc/self/stat` and memory usage from
+ * `/proc/self/smaps_rollup` (falling back to `/proc/self/status` on kernels
+ * that don't provide it). In addition, CPU time is attributed to each thread
+ * registered via `AddCurrentThread` using `/proc/self/task/<tid>/stat`.
+ *
+ * The procfs files are opened once and re-read in place, so generating a
+ * sample doesn't allocate. CPU usage is computed over the interval since the
+ * previous sample and is therefore absent from the first one.
+ *
+ * @see flutter::SamplingProfiler
+ */
+class ProfilerMetricsLinux {
+ public:
+  /**
+   * @brief Fields of `/proc/<pid>/stat` (or `/proc/<pid>/task/<tid>/stat`)
+   * used by the sampler.
+   */
+  struct StatInfo {
+    uint64_t cpu_ticks = 0;
+    uint32_t num_threads = 0;
+  };
+
+  /**
+   * @brief Resident memory, in kB.
+   */
+  struct MemoryInfo {
+    uint64_t rss_kb = 0;
+    uint64_t dirty_kb = 0;
+  };
+
+  ProfilerMetricsLinux();
+
+  ~ProfilerMetricsLinux();
+
+  /**
+   * @brief Starts attributing CPU time to the calling thread. At most
+   * `ProfileSample::kMaxThreadCpuUsage` threads are tracked. This may be called
+   * from any thread.
+   */
+  void AddCurrentThread(std::string label);
+
+  /**
+   * @brief Must be called on the thread that generates the samples.
+   */
+  ProfileSample GenerateSample();
+
+  static bool ParseStat(std::string_view contents, StatInfo* info);
+
+  static bool ParseSmapsRollup(std::string_view contents, MemoryInfo* info);
+
+  static bool ParseStatus(std::string_view contents, MemoryInfo* info);
+
+ private:
+  struct ThreadEntry {
+    std::string label;
+    fml::UniqueFD stat_fd;
+    uint64_t last_cpu_ticks = 0;
+    bool has_last_cpu_ticks = false;
+  };
+
+  const double ticks_per_second_;
+  const double num_cpus_;
+  fml::UniqueFD stat_fd_;
+  fml::UniqueFD smaps_rollup_fd_;
+  fml::UniqueFD status_fd_;
+  fml::TimePoint last_sample_time_;
+  uint64_t last_cpu_ticks_ = 0;
+  bool has_last_sample_ = false;
+  std::mutex threads_mutex_;
+  std::vector<ThreadEntry> threads_;
+  char buffer_[4096];
+
+  std::string_view Read(const fml::UniqueFD& fd);
+
+  std::optional<CpuUsageInfo> CpuUsage(double elapsed_seconds);
+
+  std::optional<MemoryUsageInfo> MemoryUsage();
+
+  void ThreadCpuUsage(double elapsed_seconds, ProfileSample* sample);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProfilerMetricsLinux);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PROFILING_PROFILER_METRICS_LINUX_H_
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/profiling/profiler_metrics_linux.h"
+
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ProfilerMetricsLinuxTest, ParsesStat) {
+  // The executable name may contain spaces and parentheses.
+  constexpr std::string_view kStat =
+      "1234 (flutter (ui) x) S 1 1234 1234 0 -1 4194560 100 0 0 0 "
+      "250 50 0 0 20 0 12 0 5000 100000 200 18446744073709551615\n";
+  ProfilerMetricsLinux::StatInfo info;
+  ASSERT_TRUE(ProfilerMetricsLinux::ParseStat(kStat, &info));
+  EXPECT_EQ(info.cpu_ticks, 300u);
+  EXPECT_EQ(info.num_threads, 12u);
+
+  EXPECT_FALSE(ProfilerMetricsLinux::ParseStat("1234 (truncated", &info));
+  EXPECT_FALSE(ProfilerMetricsLinux::ParseStat("1234 (a) S 1 2 3", &info));
+}
+
+TEST(ProfilerMetricsLinuxTest, ParsesMemory) {
+  constexpr std::string_view kSmapsRollup =
+      "00400000-7ffd4a1b4000 ---p 00000000 00:00 0    [rollup]\n"
+      "Rss:               20480 kB\n"
+      "Pss:               10240 kB\n"
+      "Shared_Dirty:        512 kB\n"
+      "Private_Dirty:      8192 kB\n";
+  ProfilerMetricsLinux::MemoryInfo info;
+  ASSERT_TRUE(ProfilerMetricsLinux::ParseSmapsRollup(kSmapsRollup, &info));
+  EXPECT_EQ(info.rss_kb, 20480u);
+  EXPECT_EQ(info.dirty_kb, 8192u);
+
+  constexpr std::string_view kStatus =
+      "Name:\tflutter\n"
+      "VmRSS:\t    4096 kB\n"
+      "RssAnon:\t    1024 kB\n"
+      "RssFile:\t    3072 kB\n";
+  info = {};
+  ASSERT_TRUE(ProfilerMetricsLinux::ParseStatus(kStatus, &info));
+  EXPECT_EQ(info.rss_kb, 4096u);
+  EXPECT_EQ(info.dirty_kb, 1024u);
+
+  EXPECT_FALSE(ProfilerMetricsLinux::ParseStatus("Name:\tflutter\n", &info));
+}
+
+TEST(ProfilerMetricsLinuxTest, SamplesProcessAndThreads) {
+  ProfilerMetricsLinux metrics;
+  metrics.AddCurrentThread("test");
+
+  ProfileSample first = metrics.GenerateSample();
+  EXPECT_FALSE(first.cpu_usage.has_value());
+  EXPECT_EQ(first.thread_cpu_usage_count, 0u);
+  ASSERT_TRUE(first.memory_usage.has_value());
+  EXPECT_GT(first.memory_usage->dirty_memory_usage +
+                first.memory_usage->owned_shared_memory_usage,
+            0.0);
+
+  // Burn some CPU on this thread so that the next sample has an interval.
+  const fml::TimePoint deadline =
+      fml::TimePoint::Now() + fml::TimeDelta::FromMilliseconds(50);
+  volatile uint64_t counter = 0;
+  while (fml::TimePoint::Now() < deadline) {
+    counter = counter + 1;
+  }
+
+  ProfileSample second = metrics.GenerateSample();
+  ASSERT_TRUE(second.cpu_usage.has_value());
+  EXPECT_GE(second.cpu_usage->num_threads, 1u);
+  EXPECT_GE(second.cpu_usage->total_cpu_usage, 0.0);
+  EXPECT_LE(second.cpu_usage->total_cpu_usage, 100.0);
+  ASSERT_EQ(second.thread_cpu_usage_count, 1u);
+  EXPECT_STREQ(second.thread_cpu_usage[0].thread_label, "test");
+  EXPECT_GE(second.thread_cpu_usage[0].cpu_usage, 0.0);
+  EXPECT_LE(second.thread_cpu_usage[0].cpu_usage, 100.0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -63,6 +63,13 @@ void SamplingProfiler::SampleRepeatedly(fml::TimeDelta task_delay) const {
                                "total_cpu_usage", total_cpu_usage.c_str(),
                                "num_threads", num_threads.c_str());
         }
+        for (size_t i = 0; i < usage.thread_cpu_usage_count; i++) {
+          const auto& thread_usage = usage.thread_cpu_usage[i];
+          std::string cpu_usage = std::to_string(thread_usage.cpu_usage);
+          TRACE_EVENT_INSTANT2("flutter::profiling", "ThreadCpuUsage",
+                               "thread", thread_usage.thread_label,
+                               "cpu_usage", cpu_usage.c_str());
+        }
         if (usage.memory_usage) {
           std::string dirty_memory_usage =
               std::to_string(usage.memory_usage->dirty_memory_usage);
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_PROFILING_SAMPLING_PROFILER_H_
 #define FLUTTER_SHELL_PROFILING_SAMPLING_PROFILER_H_
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -50,6 +51,16 @@ struct GpuUsageInfo {
   double percent_usage;
 };
 
+/**
+ * @brief CPU usage of a single engine thread. `cpu_usage` is the percentage of
+ * a single core used by the thread, between [0, 100]. `thread_label` refers to
+ * storage owned by the `Sampler` and must outlive the sample.
+ */
+struct ThreadCpuUsageInfo {
+  const char* thread_label;
+  double cpu_usage;
+};
+
 /**
  * @brief Container for the metrics we collect during each run of `Sampler`.
  * This currently holds `CpuUsageInfo` and `MemoryUsageInfo` but the intent
@@ -58,9 +69,15 @@ struct GpuUsageInfo {
  * @see flutter::Sampler
  */
 struct ProfileSample {
+  static constexpr size_t kMaxThreadCpuUsage = 8;
+
   std::optional<CpuUsageInfo> cpu_usage;
   std::optional<MemoryUsageInfo> memory_usage;
   std::optional<GpuUsageInfo> gpu_usage;
+  // Only the first `thread_cpu_usage_count` entries are valid. Samplers that
+  // cannot attribute CPU time to individual threads leave this empty.
+  std::array<ThreadCpuUsageInfo, kMaxThreadCpuUsage> thread_cpu_usage = {};
+  size_t thread_cpu_usage_count = 0;
 };
 
 /**
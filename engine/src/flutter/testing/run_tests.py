@@ -594,10 +594,14 @@ def run_engine_benchmarks(build_dir, executable_filter):
 
   run_engine_executable(build_dir, 'shell_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(build_dir, 'shell_allocation_benchmarks', executable_filter, icu_flags)
+
   run_engine_executable(build_dir, 'fml_benchmarks', executable_filter, icu_flags)
 
   run_engine_executable(build_dir, 'ui_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(build_dir, 'client_wrapper_benchmarks', executable_filter, icu_flags)
+
   run_engine_executable(build_dir, 'display_list_builder_benchmarks', executable_filter, icu_flags)
 
   run_engine_executable(build_dir, 'geometry_benchmarks', executable_filter, icu_flags)
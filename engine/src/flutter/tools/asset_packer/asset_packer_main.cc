@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Packs the files of an assets directory into an archive that
+// |PackedAssetBundle| serves them from. Assets whose names match the
+// optional --compress pattern are compressed for |CompressedAssetBundle|
+// when that makes them smaller.
+//
+// Usage: asset_packer --input-dir=<flutter_assets> --output=<assets.pack>
+//                     [--compress=<regex>]
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <regex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "flutter/assets/compressed_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/string_conversion.h"
+
+namespace flutter {
+
+bool AssetPackerMain(const fml::CommandLine& command_line) {
+  std::string input_dir;
+  std::string output_path;
+
+  if (!command_line.GetOptionValue("input-dir", &input_dir)) {
+    FML_LOG(ERROR) << "Assets directory not specified. Use --input-dir.";
+    return false;
+  }
+  if (!command_line.GetOptionValue("output", &output_path)) {
+    FML_LOG(ERROR) << "Output path not specified. Use --output.";
+    return false;
+  }
+  std::optional<std::regex> compress_pattern;
+  std::string compress;
+  if (command_line.GetOptionValue("compress", &compress)) {
+    compress_pattern.emplace(compress);
+  }
+
+  const std::filesystem::path root(input_dir);
+  std::vector<PackedAssetBundle::Asset> assets;
+  std::error_code error;
+  for (auto it = std::filesystem::recursive_directory_iterator(root, error);
+       !error && it != std::filesystem::recursive_directory_iterator();
+       it.increment(error)) {
+    if (!it->is_regular_file()) {
+      continue;
+    }
+    std::string name = fml::PathToUtf8(it->path().lexically_relative(root));
+    std::replace(name.begin(), name.end(), '\\', '/');
+    // An archive packed into the assets directory by an earlier run.
+    if (name == PackedAssetBundle::kFileName) {
+      continue;
+    }
+    std::shared_ptr<const fml::Mapping> data =
+        fml::FileMapping::CreateReadOnly(fml::PathToUtf8(it->path()));
+    if (!data) {
+      FML_LOG(ERROR) << "Could not read asset: " << name;
+      return false;
+    }
+    if (compress_pattern.has_value() &&
+        std::regex_match(name, compress_pattern.value())) {
+      std::shared_ptr<const fml::Mapping> compressed =
+          CompressedAssetBundle::Compress(*data);
+      if (compressed->GetSize() < data->GetSize()) {
+        name += CompressedAssetBundle::kSuffix;
+        data = std::move(compressed);
+      }
+    }
+    assets.push_back({std::move(name), std::move(data)});
+  }
+  if (error) {
+    FML_LOG(ERROR) << "Could not list assets directory: " << input_dir << ": "
+                   << error.message();
+    return false;
+  }
+  // Keeps the archive the same across runs, with the assets of a directory
+  // next to each other.
+  std::sort(assets.begin(), assets.end(),
+            [](const PackedAssetBundle::Asset& a,
+               const PackedAssetBundle::Asset& b) { return a.name < b.name; });
+
+  auto archive = PackedAssetBundle::Pack(assets);
+  if (!archive) {
+    FML_LOG(ERROR) << "Could not pack assets.";
+    return false;
+  }
+
+  auto current_dir = fml::OpenDirectory(
+      fml::PathToUtf8(std::filesystem::current_path()).c_str(), false,
+      fml::FilePermission::kReadWrite);
+  if (!current_dir.is_valid()) {
+    FML_LOG(ERROR) << "Could not open current directory.";
+    return false;
+  }
+  if (!fml::WriteAtomically(current_dir, output_path.c_str(), *archive)) {
+    FML_LOG(ERROR) << "Could not write output to path: " << output_path;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
+
+int main(int argc, char const* argv[]) {
+  return flutter::AssetPackerMain(fml::CommandLineFromArgcArgv(argc, argv))
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}